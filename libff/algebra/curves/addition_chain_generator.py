@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+
+"""
+Generate exponentiation plans (see libff/algebra/exponentiation) for fixed
+exponents, as C++ initializers of libff::exponentiation_plan.
+
+Plans use the same register layout as the sliding-window plans built at
+runtime (register 0 holds the base, register 1 its square, registers 2, 3,
+... the odd powers base^3, base^5, ..., and a final accumulator), but the
+windows are chosen by dynamic programming to minimize the total number of
+steps, rather than greedily.
+
+Usage:
+
+  addition_chain_generator.py --prime p [--degree k] [--name prefix]
+      Plans for the exponents euler and t_minus_1_over_2 of F_{p^k}, as used
+      by is_square() and sqrt().
+
+  addition_chain_generator.py --exponent e [--name name]
+      A plan for the exponent e.
+"""
+
+import argparse
+import sys
+
+MAX_WINDOW_SIZE = 10
+
+
+def table_register(digit):
+    return 0 if digit == 1 else 1 + (digit - 1) // 2
+
+
+def optimal_windows(e, w):
+    """
+    Split the bits of e into windows of at most w bits, each starting and
+    ending with a set bit, minimizing (number of windows - 1) plus the number
+    of squarings (the position of the lowest bit of the top window). Returns
+    the windows as (position, digit) pairs, most significant first.
+    """
+    bits = [(e >> i) & 1 for i in range(e.bit_length())]
+    n = len(bits)
+
+    # cost[i] = minimal number of windows covering the bits below i, and
+    # choice[i] the lowest bit of the topmost of these windows (or None).
+    cost = [0] * (n + 1)
+    choice = [None] * (n + 1)
+    for i in range(1, n + 1):
+        if not bits[i - 1]:
+            cost[i] = cost[i - 1]
+            choice[i] = choice[i - 1] if i > 1 else None
+            continue
+        best = None
+        for j in range(max(i - w, 0), i):
+            if bits[j] and (best is None or cost[j] < cost[best]):
+                best = j
+        cost[i] = 1 + cost[best]
+        choice[i] = best
+
+    # Top window, whose low bit also determines the number of squarings.
+    top = n - 1
+    best = None
+    for j in range(max(n - w, 0), n):
+        if bits[j] and (best is None or j + cost[j] < best + cost[best]):
+            best = j
+
+    windows = []
+    hi, lo = top, best
+    while True:
+        digit = (e >> lo) & ((1 << (hi - lo + 1)) - 1)
+        windows.append((lo, digit))
+        # Next window down: skip zero bits below lo.
+        i = lo
+        while i > 0 and not bits[i - 1]:
+            i -= 1
+        if i == 0:
+            break
+        hi, lo = i - 1, choice[i]
+    return windows
+
+
+def emit(windows):
+    """
+    Steps (dst, lhs, rhs) evaluating the windows, with the number of
+    registers and the result register.
+    """
+    steps = []
+    max_digit = max(d for _, d in windows)
+    if max_digit > 1:
+        steps.append((1, 0, 0))
+        for k in range(1, (max_digit - 1) // 2 + 1):
+            steps.append((1 + k, table_register(2 * k - 1), 1))
+    acc = table_register(max_digit) + 1
+
+    current = table_register(windows[0][1])
+    position = windows[0][0]
+    for lo, digit in windows[1:]:
+        while position > lo:
+            steps.append((acc, current, current))
+            current = acc
+            position -= 1
+        steps.append((acc, current, table_register(digit)))
+    while position > 0:
+        steps.append((acc, current, current))
+        current = acc
+        position -= 1
+    return steps, acc + 1, current
+
+
+def check(e, steps, num_registers, result):
+    """Evaluate the plan on exponents, checking that it computes e."""
+    registers = [None] * num_registers
+    registers[0] = 1
+    for dst, lhs, rhs in steps:
+        assert dst != 0
+        registers[dst] = registers[lhs] + registers[rhs]
+    assert registers[result] == e
+
+
+def generate_plan(name, e):
+    if e == 0:
+        print('// {} = 0'.format(name))
+        print('exponentiation_plan {};'.format(name))
+        return
+
+    best = None
+    for w in range(1, MAX_WINDOW_SIZE + 1):
+        plan = emit(optimal_windows(e, w))
+        if best is None or len(plan[0]) < len(best[0]):
+            best = plan
+    steps, num_registers, result = best
+    check(e, steps, num_registers, result)
+
+    num_squarings = sum(1 for _, lhs, rhs in steps if lhs == rhs)
+    print('// {} = {}'.format(name, e))
+    print('// {} squarings, {} multiplications'.format(
+        num_squarings, len(steps) - num_squarings))
+    if not steps:
+        print('exponentiation_plan {}(1, 0, {{}});'.format(name))
+        return
+    print('exponentiation_plan {}({}, {}, {{'.format(
+        name, num_registers, result))
+    line = '   '
+    for s in steps:
+        entry = ' {{{}, {}, {}}},'.format(*s)
+        if len(line) + len(entry) > 80:
+            print(line)
+            line = '   '
+        line += entry
+    print(line)
+    print('});')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate libff exponentiation plans')
+    parser.add_argument('--prime', type=int)
+    parser.add_argument('--degree', type=int, default=1)
+    parser.add_argument('--exponent', type=int)
+    parser.add_argument('--name', default=None)
+    args = parser.parse_args()
+
+    if args.exponent is not None:
+        generate_plan(args.name or 'plan', args.exponent)
+    elif args.prime is not None:
+        q = args.prime ** args.degree
+        t = q - 1
+        while t % 2 == 0:
+            t //= 2
+        prefix = (args.name + '_') if args.name else ''
+        generate_plan(prefix + 'euler_plan', (q - 1) // 2)
+        print()
+        generate_plan(prefix + 't_minus_1_over_2_plan', (t - 1) // 2)
+    else:
+        parser.print_usage()
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
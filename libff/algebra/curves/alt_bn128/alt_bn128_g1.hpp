@@ -9,6 +9,7 @@
 #define ALT_BN128_G1_HPP_
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -31,6 +32,7 @@ public:
     static alt_bn128_G1 G1_one;
     static alt_bn128_Fq coeff_a;
     static alt_bn128_Fq coeff_b;
+    static const bool coeff_a_is_zero = true;
 
     typedef alt_bn128_Fq base_field;
     typedef alt_bn128_Fr scalar_field;
@@ -95,6 +97,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<alt_bn128_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(alt_bn128_G1);
+
 template<mp_size_t m>
 alt_bn128_G1 operator*(const bigint<m> &lhs, const alt_bn128_G1 &rhs)
 {
@@ -9,6 +9,7 @@
 #define BLS12_377_G2_HPP_
 #include <libff/algebra/curves/bls12_377/bls12_377_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -31,6 +32,7 @@ public:
     static bls12_377_G2 G2_one;
     static bls12_377_Fq2 coeff_a;
     static bls12_377_Fq2 coeff_b;
+    static const bool coeff_a_is_zero = true;
 
     typedef bls12_377_Fq base_field;
     typedef bls12_377_Fq2 twist_field;
@@ -100,6 +102,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<bls12_377_G2> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(bls12_377_G2);
+
 template<mp_size_t m>
 bls12_377_G2 operator*(const bigint<m> &lhs, const bls12_377_G2 &rhs)
 {
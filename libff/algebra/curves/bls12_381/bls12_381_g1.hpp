@@ -9,8 +9,9 @@
 #define BLS12_381_G1_HPP_
 #include <libff/algebra/curves/bls12_381/bls12_381_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
-static long int _add_ec_point_count=0;
+
 namespace libff
 {
 
@@ -31,6 +32,7 @@ public:
     static bls12_381_G1 G1_one;
     static bls12_381_Fq coeff_a;
     static bls12_381_Fq coeff_b;
+    static const bool coeff_a_is_zero = true;
 
     typedef bls12_381_Fq base_field;
     typedef bls12_381_Fr scalar_field;
@@ -70,6 +72,10 @@ public:
     bls12_381_G1 dbl() const;
     bls12_381_G1 mul_by_cofactor() const;
 
+    // Endomorphism (x, y) -> (\beta * x, y) for \beta an element of Fq with
+    // order 3. Computed without leaving Jacobian coordinates.
+    bls12_381_G1 sigma() const;
+
     bool is_well_formed() const;
     bool is_in_safe_subgroup() const;
 
@@ -95,6 +101,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<bls12_381_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(bls12_381_G1);
+
 template<mp_size_t m>
 bls12_381_G1 operator*(const bigint<m> &lhs, const bls12_381_G1 &rhs)
 {
@@ -0,0 +1,639 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of hashing to BLS12-381 (RFC 9380).
+
+ See bls12_381_hash_to_curve.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/algebra/curves/bls12_381/bls12_381_hash_to_curve.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/expand_message.hpp>
+
+namespace libff
+{
+
+namespace
+{
+
+/// Number of bytes of uniform output per base field element (the parameter
+/// L of hash_to_field, ceil((381 + 128) / 8)).
+const size_t HASH_TO_FIELD_L = 64;
+
+// Coefficients of the rational maps of the 11-isogeny E1' -> E (RFC 9380,
+// Appendix E.2) and of the 3-isogeny E2' -> E' (Appendix E.3), lowest degree
+// first. The leading coefficient (1) of each denominator is omitted.
+
+const char *const G1_ISO_X_NUM[] = {
+    "27129592852903059706610817721241441791938191924232762183702811587061915199"
+    "95889425075952244140278856085036081760695",
+    "35648594275496398352530278467042057259510332355398162431318742373888320819"
+    "54622352624080767121604606753339903542203",
+    "20513870466883394817147264797230763057563846191350446728318829176864319126"
+    "82625619320120082313093891743187631791280",
+    "36127139415210310127803258931810113925200794021533545957757351423592401104"
+    "23346445050803899623018402874731133626465",
+    "22470536378227689817928338802709963984708285648094397283726348119760898740"
+    "56583714987807553397615562273407692740057",
+    "34154271044831874898597408716400643484926114445528624482955714382708219949"
+    "00526625562705192993481400731539293415811",
+    "20675214564834325838604056341255130599127655262230157046160506045912070463"
+    "92807563217109432457129564962571408764292",
+    "36507212920690129828222256378490188282719364053820826492918912456233050846"
+    "33066170122780668657208923883092359301262",
+    "12392717757870300392694607636524558681489710860168320543541477301550613493"
+    "88626624328773377658494412538595239256855",
+    "34793741857110342939567315839122445648913708430711374839624152227334704019"
+    "48838363051960066766720884717833231600798",
+    "24927563122731615366856600274401589567219811294298696016383624075156275294"
+    "61742974364729223659746272460004902959995",
+    "10584884774139946825567708630045366364447954565127954738068252921980910150"
+    "05841418695586811009326456605062948114985",
+};
+
+const char *const G1_ISO_X_DEN[] = {
+    "13530924478501722189050950410597844861691317097109914284151614665751416753"
+    "51394082965234118340787683181925558786844",
+    "28222209979083971209565010315917723548600045349301740577935393725523957297"
+    "21474912921980407622851861692773516917759",
+    "17179377472083859879460729441313789498492829305386429831492963047096332813"
+    "82731764122371874602115081850953846504985",
+    "50162405108973415781658294402569086831753691568446786834638876043501604402"
+    "7032505306995281054569109955275640941784",
+    "30259030879985938269237382903051871978298999483353706929272410155842335593"
+    "65859980023579293766193297662657497834014",
+    "22241402169751894378341611368189430394447410351689926294376403029641642271"
+    "38031844090123490881551522278632040105125",
+    "11464144658482848374845084200476746638769928086922092387632939359055065324"
+    "11661921697047880549716175045414621825594",
+    "31790909668643996343969936773779033836569080368274529864675814785095130583"
+    "47781039562481806409014718357094150199902",
+    "15493170165406280146743021407864629384104293595299232074421519396963449887"
+    "07002602944342203885692366490121021806145",
+    "14427971434274914326306263900664220215935051655886303983374911000885572780"
+    "58060064930663878153124164818522816175370",
+};
+
+const char *const G1_ISO_Y_NUM[] = {
+    "13933991957766466419631506588166154106920497233058613074909804098348429118"
+    "16308830479576739332720113414154429643571",
+    "29686109697527629461341060911521028462254117406897249090580167294557365979"
+    "29366401532929068084731548131227395540630",
+    "12293310068328484521959964439687453087126139608407022215579612316188109432"
+    "3788483360414289333111221370374027338230",
+    "30325195478207785546208382322856990106430136550705749056731430200668128322"
+    "8886645653148231378803311079384246777035",
+    "13539723567247356443982790283785556275912606763831506672379754153182269739"
+    "94509601413730187583692624416197017403099",
+    "34439775036538950284172609794212406558440348809502511047246098852242594842"
+    "62346958661845148165419691583810082940400",
+    "71849341030185049615679271384528223594297587228205233561290845806156095815"
+    "9410402177452633054233549648465863759602",
+    "14668640764158843131417278771561675086449603170461603983426348616481530524"
+    "36926062434809922037623519108138661903145",
+    "15368864931371063373395314613441589735545749875507509100273652372553470205"
+    "72858445054025958480906372033954157667719",
+    "21714682889732485199120688846671339031011716703979919795822058552984654140"
+    "47741472281361964966463442016062407908400",
+    "39159370737302210721896460578989660112924340453889863943736827152666644983"
+    "92389619761133407846638689998746172899634",
+    "38024091948274075981564077095103508511734047952622026531497677391631175546"
+    "48574333789388883640862266596657730112910",
+    "17075893137578124931026950211342580219692831510939814983940950623973934996"
+    "01961942449581422761005023512037430861560",
+    "34969700598754541586058333531337010932549007385635296758119727358489169847"
+    "3628451945217286148025358795756956811571",
+    "88570443647656758137774316179673587908348144764121056640505734685995352453"
+    "8988296201011389016649354976986251207243",
+    "33709249522190001112106253904206976404960673487239878583450316833922159881"
+    "29398381698161406651860675722373763741188",
+};
+
+const char *const G1_ISO_Y_DEN[] = {
+    "33964348000205077175522095077494857727881654844154957166889896138753696125"
+    "29138640646200921379825018840894888371137",
+    "39072781858683979069918684667579787326889574198737718812400867303848950605"
+    "95583602347317992689443299391009456758845",
+    "85491456645482395547942741203600216530446626854733476089427024096618260554"
+    "2146252771872707010378658178126128834546",
+    "34966288763821379611194235661872587952360271831121310175195360566288288303"
+    "23846696121917502443333849318934945158166",
+    "18282569662333319919276099176443440115036100081349157529905815907996563053"
+    "31275863706710232159635159092657073225757",
+    "13623171276491438945426214131338490525533330998833643009466232086433442988"
+    "04722863920546222860227051989127113848748",
+    "34438458961888105837486983428585548568239666115389322452846651327242808831"
+    "15455093457486044009395063504744802318172",
+    "34846712742834705727287328635579458979029204399752036102750061038182881598"
+    "99345245633896492713412187296754791689945",
+    "37557351094294185870654370670676406342110157836366753721655994707719759191"
+    "72394156249639331555277748466603540045130",
+    "34596611022223018070838703071272728902837092992026265308363357798167261015"
+    "22661683404130556379097384249447658110805",
+    "74248316841103207232373324964434733316843266541534124907315065901570779554"
+    "9260947228694495111018381111866512337576",
+    "16622312798580957628338296985373048077414426699926462879505132379891587772"
+    "54081548205552083108208170765474149568658",
+    "16682386501128234193882059929528529124075720452577061389253792685088600231"
+    "91233729074751042562151098884528280913356",
+    "36916271992897611919508732705592632660162774836276954419881306913342955702"
+    "6740823593067700396825489145575282378487",
+    "21641957151412371489459395850996330323902577483829455975062366501328359170"
+    "87090097395995817229686247227784224263055",
+};
+
+const char *const G2_ISO_X_NUM[][2] = {
+    {
+        "8894243456048149763150644057190898125681961822086684189626795858053403"
+        "66775741747653930584250892369786198727235542",
+        "8894243456048149763150644057190898125681961822086684189626795858053403"
+        "66775741747653930584250892369786198727235542",
+    },
+    {
+        "0",
+        "2668273036814444928945193217157269437704588546626005256888038757416021"
+        "100327225242961791752752677109358596181706522",
+    },
+    {
+        "2668273036814444928945193217157269437704588546626005256888038757416021"
+        "100327225242961791752752677109358596181706526",
+        "1334136518407222464472596608578634718852294273313002628444019378708010"
+        "550163612621480895876376338554679298090853261",
+    },
+    {
+        "3557697382419259905260257622876359250272784728834673675850718343221361"
+        "467102966990615722337003569479144794908942033",
+        "0",
+    },
+};
+
+const char *const G2_ISO_X_DEN[][2] = {
+    {
+        "0",
+        "4002409555221667393417789825735904156556882819939007885332058136124031"
+        "650490837864442687629129015664037894272559715",
+    },
+    {
+        "12",
+        "4002409555221667393417789825735904156556882819939007885332058136124031"
+        "650490837864442687629129015664037894272559775",
+    },
+};
+
+const char *const G2_ISO_Y_NUM[][2] = {
+    {
+        "3261222600550988246488569487636662646083386001431784202863158481286248"
+        "011511053074731078808919938689216061999863558",
+        "3261222600550988246488569487636662646083386001431784202863158481286248"
+        "011511053074731078808919938689216061999863558",
+    },
+    {
+        "0",
+        "8894243456048149763150644057190898125681961822086684189626795858053403"
+        "66775741747653930584250892369786198727235518",
+    },
+    {
+        "2668273036814444928945193217157269437704588546626005256888038757416021"
+        "100327225242961791752752677109358596181706524",
+        "1334136518407222464472596608578634718852294273313002628444019378708010"
+        "550163612621480895876376338554679298090853263",
+    },
+    {
+        "2816510427748580758331037284777117739799287910327449993381818688383577"
+        "828123182200904113516794492504322962636245776",
+        "0",
+    },
+};
+
+const char *const G2_ISO_Y_DEN[][2] = {
+    {
+        "4002409555221667393417789825735904156556882819939007885332058136124031"
+        "650490837864442687629129015664037894272559355",
+        "4002409555221667393417789825735904156556882819939007885332058136124031"
+        "650490837864442687629129015664037894272559355",
+    },
+    {
+        "0",
+        "4002409555221667393417789825735904156556882819939007885332058136124031"
+        "650490837864442687629129015664037894272559571",
+    },
+    {
+        "18",
+        "4002409555221667393417789825735904156556882819939007885332058136124031"
+        "650490837864442687629129015664037894272559769",
+    },
+};
+
+/// Constants used by the maps, created on first use (i.e. after the curve
+/// parameters have been initialized).
+class hash_to_curve_constants
+{
+public:
+    // Simplified SWU map to E1': y^2 = x^3 + A x + B, with parameter Z.
+    bls12_381_Fq g1_A;
+    bls12_381_Fq g1_B;
+    bls12_381_Fq g1_Z;
+    // sqrt_ratio for Fq (p = 3 mod 4): (p - 3) / 4 and sqrt(-Z).
+    bigint<bls12_381_q_limbs> g1_c1;
+    exponentiation_plan g1_c1_plan;
+    bls12_381_Fq g1_c2;
+
+    std::vector<bls12_381_Fq> g1_x_num;
+    std::vector<bls12_381_Fq> g1_x_den;
+    std::vector<bls12_381_Fq> g1_y_num;
+    std::vector<bls12_381_Fq> g1_y_den;
+
+    // Simplified SWU map to E2': y^2 = x^3 + A x + B, with parameter Z.
+    bls12_381_Fq2 g2_A;
+    bls12_381_Fq2 g2_B;
+    bls12_381_Fq2 g2_Z;
+    // sqrt_ratio for Fq2 (q = p^2, with 2^3 || q - 1): c3 = (c2 - 1) / 2
+    // where c2 = (q - 1) / 2^3, c6 = Z^c2 and c7 = Z^((c2 + 1) / 2).
+    bigint<2 * bls12_381_q_limbs> g2_c3;
+    exponentiation_plan g2_c3_plan;
+    bls12_381_Fq2 g2_c6;
+    bls12_381_Fq2 g2_c7;
+
+    std::vector<bls12_381_Fq2> g2_x_num;
+    std::vector<bls12_381_Fq2> g2_x_den;
+    std::vector<bls12_381_Fq2> g2_y_num;
+    std::vector<bls12_381_Fq2> g2_y_den;
+
+    /// 2^256, for hash_to_field.
+    bls12_381_Fq two_to_256;
+
+    hash_to_curve_constants();
+};
+
+template<size_t N>
+std::vector<bls12_381_Fq> fq_coefficients(const char *const (&c)[N])
+{
+    std::vector<bls12_381_Fq> result;
+    result.reserve(N);
+    for (const char *s : c) {
+        result.emplace_back(bigint<bls12_381_q_limbs>(s));
+    }
+    return result;
+}
+
+template<size_t N>
+std::vector<bls12_381_Fq2> fq2_coefficients(const char *const (&c)[N][2])
+{
+    std::vector<bls12_381_Fq2> result;
+    result.reserve(N);
+    for (size_t i = 0; i < N; ++i) {
+        result.emplace_back(
+            bls12_381_Fq(bigint<bls12_381_q_limbs>(c[i][0])),
+            bls12_381_Fq(bigint<bls12_381_q_limbs>(c[i][1])));
+    }
+    return result;
+}
+
+hash_to_curve_constants::hash_to_curve_constants()
+    : g1_A(bigint<bls12_381_q_limbs>(
+          "1219033631889361952922887736186903142061561234842984605198672627528"
+          "3378313155663745811710833465465981901188123677"))
+    , g1_B(bigint<bls12_381_q_limbs>(
+          "2906670324641927570491258158026293881577086121416628140204402091718"
+          "288198173574630967936031029026176254968826637280"))
+    , g1_Z(11)
+    , g1_c1(
+          "1000602388805416848354447456433976039139220704984751971333014534031"
+          "007912622709466110671907282253916009473568139946")
+    , g1_c1_plan(g1_c1)
+    , g1_c2((-g1_Z).sqrt())
+    , g1_x_num(fq_coefficients(G1_ISO_X_NUM))
+    , g1_x_den(fq_coefficients(G1_ISO_X_DEN))
+    , g1_y_num(fq_coefficients(G1_ISO_Y_NUM))
+    , g1_y_den(fq_coefficients(G1_ISO_Y_DEN))
+    , g2_A(bls12_381_Fq::zero(), bls12_381_Fq(240))
+    , g2_B(bls12_381_Fq(1012), bls12_381_Fq(1012))
+    , g2_Z(-bls12_381_Fq(2), -bls12_381_Fq::one())
+    , g2_c3(
+          "1001205140483106588246484290269935788605945006208159541241399033561"
+          "6235467807098214625410049563870893734346490962606706581939927837316"
+          "8162101251265131477723819331331464198829737602549809352072883865881"
+          "3979860931248214124593092835")
+    , g2_c3_plan(g2_c3)
+    , g2_x_num(fq2_coefficients(G2_ISO_X_NUM))
+    , g2_x_den(fq2_coefficients(G2_ISO_X_DEN))
+    , g2_y_num(fq2_coefficients(G2_ISO_Y_NUM))
+    , g2_y_den(fq2_coefficients(G2_ISO_Y_DEN))
+    , two_to_256(bls12_381_Fq(2) ^ 256)
+{
+    // c2 = 2 c3 + 1 and (c2 + 1) / 2 = c3 + 1.
+    const bls12_381_Fq2 z_c3 = power(g2_Z, g2_c3_plan);
+    g2_c6 = z_c3.squared() * g2_Z;
+    g2_c7 = z_c3 * g2_Z;
+}
+
+const hash_to_curve_constants &constants()
+{
+    static const hash_to_curve_constants c;
+    return c;
+}
+
+/// sgn0 (RFC 9380, Section 4.1).
+bool sgn0(const bls12_381_Fq &x) { return x.as_bigint().test_bit(0); }
+
+bool sgn0(const bls12_381_Fq2 &x)
+{
+    const bool sign_0 = sgn0(x.coeffs[0]);
+    const bool zero_0 = x.coeffs[0].is_zero();
+    const bool sign_1 = sgn0(x.coeffs[1]);
+    return sign_0 || (zero_0 && sign_1);
+}
+
+/// sqrt_ratio (RFC 9380, Appendix F.2.1.2) for Fq, where p = 3 mod 4. Sets y
+/// to sqrt(u / v) if u / v is square, and to sqrt(Z u / v) otherwise,
+/// returning whether u / v is square.
+bool sqrt_ratio(
+    const hash_to_curve_constants &c,
+    const bls12_381_Fq &u,
+    const bls12_381_Fq &v,
+    bls12_381_Fq &y)
+{
+    const bls12_381_Fq tv2 = u * v;
+    const bls12_381_Fq tv1 = v.squared() * tv2;
+    const bls12_381_Fq y1 = power(tv1, c.g1_c1_plan) * tv2;
+    if (y1.squared() * v == u) {
+        y = y1;
+        return true;
+    }
+    y = y1 * c.g1_c2;
+    return false;
+}
+
+/// sqrt_ratio (RFC 9380, Appendix F.2.1.1) for Fq2.
+bool sqrt_ratio(
+    const hash_to_curve_constants &c,
+    const bls12_381_Fq2 &u,
+    const bls12_381_Fq2 &v,
+    bls12_381_Fq2 &y)
+{
+    // c1 = 3, c4 = 2^c1 - 1 = 7, c5 = 2^(c1 - 1) = 4.
+    bls12_381_Fq2 tv1 = c.g2_c6;
+    const bls12_381_Fq2 v2 = v.squared();
+    bls12_381_Fq2 tv2 = v2.squared() * v2 * v;
+    bls12_381_Fq2 tv3 = tv2.squared() * v;
+    bls12_381_Fq2 tv5 = power(u * tv3, c.g2_c3_plan) * tv2;
+    tv2 = tv5 * v;
+    tv3 = tv5 * u;
+    bls12_381_Fq2 tv4 = tv3 * tv2;
+    const bool is_qr = tv4.squared().squared() == bls12_381_Fq2::one();
+    if (!is_qr) {
+        tv3 = tv3 * c.g2_c7;
+        tv4 = tv4 * tv1;
+    }
+
+    for (size_t i = 3; i >= 2; --i) {
+        tv5 = tv4;
+        for (size_t j = 2; j < i; ++j) {
+            tv5 = tv5.squared();
+        }
+        const bool e1 = tv5 == bls12_381_Fq2::one();
+        tv2 = tv3 * tv1;
+        tv1 = tv1.squared();
+        if (!e1) {
+            tv3 = tv2;
+            tv4 = tv4 * tv1;
+        }
+    }
+
+    y = tv3;
+    return is_qr;
+}
+
+/// Simplified SWU map (RFC 9380, Section 6.6.2 and Appendix F.2) to the
+/// isogenous curve, returning the x-coordinate as the fraction xn / xd, to
+/// avoid an inversion.
+template<typename FieldT>
+void map_to_curve_simple_swu(
+    const hash_to_curve_constants &c,
+    const FieldT &A,
+    const FieldT &B,
+    const FieldT &Z,
+    const FieldT &u,
+    FieldT &xn,
+    FieldT &xd,
+    FieldT &y)
+{
+    const FieldT tv1 = Z * u.squared();
+    const FieldT tv2 = tv1.squared() + tv1;
+    const FieldT x1n = B * (tv2 + FieldT::one());
+    xd = A * (tv2.is_zero() ? Z : -tv2);
+
+    // g(x1) = gx1n / gxd.
+    const FieldT xd2 = xd.squared();
+    const FieldT gxd = xd2 * xd;
+    const FieldT gx1n = (x1n.squared() + A * xd2) * x1n + B * gxd;
+
+    FieldT y1;
+    if (sqrt_ratio(c, gx1n, gxd, y1)) {
+        xn = x1n;
+        y = y1;
+    } else {
+        // x2 = Z u^2 x1 and g(x2) = Z^3 u^6 g(x1), where y1 = sqrt(Z g(x1)),
+        // so y2 = Z u^3 y1.
+        xn = tv1 * x1n;
+        y = tv1 * u * y1;
+    }
+
+    if (sgn0(u) != sgn0(y)) {
+        y = -y;
+    }
+}
+
+/// xd^d p(xn / xd), where p has degree d = coefficients.size() - 1 (or
+/// coefficients.size(), with an implicit leading coefficient 1, if monic),
+/// given the powers xd^0, ..., xd^d.
+template<typename FieldT>
+FieldT evaluate_homogeneous(
+    const std::vector<FieldT> &coefficients,
+    const bool monic,
+    const FieldT &xn,
+    const std::vector<FieldT> &xd_powers)
+{
+    const size_t d = monic ? coefficients.size() : coefficients.size() - 1;
+    FieldT result = monic ? FieldT::one() : coefficients[d];
+    for (size_t i = d; i > 0; --i) {
+        result = result * xn + coefficients[i - 1] * xd_powers[d - i + 1];
+    }
+    return result;
+}
+
+/// Apply the isogeny to the point (xn / xd, y) of the isogenous curve,
+/// returning the Jacobian coordinates of the image. For both isogenies, the
+/// x-denominator has degree one less than the x-numerator, and the
+/// y-numerator and y-denominator have equal degree, so that
+///
+///   x = Xn / (Xd xd),  y = y' Yn / Yd
+///
+/// for the homogenized polynomials Xn, Xd, Yn, Yd. The exceptional points of
+/// the isogeny (Xd = 0 or Yd = 0) are mapped to Z = 0, i.e. to zero.
+template<typename GroupT, typename FieldT>
+GroupT iso_map(
+    const std::vector<FieldT> &x_num,
+    const std::vector<FieldT> &x_den,
+    const std::vector<FieldT> &y_num,
+    const std::vector<FieldT> &y_den,
+    const FieldT &xn,
+    const FieldT &xd,
+    const FieldT &y)
+{
+    std::vector<FieldT> xd_powers(y_den.size() + 1);
+    xd_powers[0] = FieldT::one();
+    for (size_t i = 1; i < xd_powers.size(); ++i) {
+        xd_powers[i] = xd_powers[i - 1] * xd;
+    }
+
+    const FieldT Xn = evaluate_homogeneous(x_num, false, xn, xd_powers);
+    const FieldT Xd = evaluate_homogeneous(x_den, true, xn, xd_powers) * xd;
+    const FieldT Yn = evaluate_homogeneous(y_num, false, xn, xd_powers);
+    const FieldT Yd = evaluate_homogeneous(y_den, true, xn, xd_powers);
+
+    // With Z = Xd Yd: X / Z^2 = Xn / Xd and Y / Z^3 = y Yn / Yd.
+    const FieldT Yd2 = Yd.squared();
+    return GroupT(
+        Xn * Xd * Yd2, y * Yn * Xd.squared() * Xd * Yd2, Xd * Yd);
+}
+
+/// Convert 64 big-endian bytes to an element of Fq, reducing mod p.
+bls12_381_Fq fq_from_bytes(const hash_to_curve_constants &c, const uint8_t *b)
+{
+    // Split into two 256-bit halves (each less than p).
+    bigint<bls12_381_q_limbs> hi;
+    bigint<bls12_381_q_limbs> lo;
+    for (size_t i = 0; i < 32; ++i) {
+        const size_t limb = (31 - i) / 8;
+        const size_t shift = 8 * ((31 - i) % 8);
+        hi.data[limb] |= ((mp_limb_t)b[i]) << shift;
+        lo.data[limb] |= ((mp_limb_t)b[32 + i]) << shift;
+    }
+    return bls12_381_Fq(hi) * c.two_to_256 + bls12_381_Fq(lo);
+}
+
+template<typename GroupT, typename HashT>
+std::vector<GroupT> hash_batch(
+    const std::vector<std::string> &msgs, const std::string &dst, HashT hash)
+{
+    // Create the constants before entering the parallel region.
+    constants();
+
+    std::vector<GroupT> result(msgs.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        result[i] = hash(msgs[i], dst);
+    }
+
+    batch_to_special(result);
+    return result;
+}
+
+} // namespace
+
+std::vector<bls12_381_Fq> bls12_381_hash_to_field_Fq(
+    const std::string &msg, const std::string &dst, const size_t count)
+{
+    const hash_to_curve_constants &c = constants();
+    const std::vector<uint8_t> bytes =
+        expand_message_xmd_sha256(msg, dst, count * HASH_TO_FIELD_L);
+
+    std::vector<bls12_381_Fq> result(count);
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = fq_from_bytes(c, &bytes[i * HASH_TO_FIELD_L]);
+    }
+    return result;
+}
+
+std::vector<bls12_381_Fq2> bls12_381_hash_to_field_Fq2(
+    const std::string &msg, const std::string &dst, const size_t count)
+{
+    const hash_to_curve_constants &c = constants();
+    const std::vector<uint8_t> bytes =
+        expand_message_xmd_sha256(msg, dst, 2 * count * HASH_TO_FIELD_L);
+
+    std::vector<bls12_381_Fq2> result(count);
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = bls12_381_Fq2(
+            fq_from_bytes(c, &bytes[2 * i * HASH_TO_FIELD_L]),
+            fq_from_bytes(c, &bytes[(2 * i + 1) * HASH_TO_FIELD_L]));
+    }
+    return result;
+}
+
+bls12_381_G1 bls12_381_map_to_curve_G1(const bls12_381_Fq &u)
+{
+    const hash_to_curve_constants &c = constants();
+    bls12_381_Fq xn, xd, y;
+    map_to_curve_simple_swu(c, c.g1_A, c.g1_B, c.g1_Z, u, xn, xd, y);
+    return iso_map<bls12_381_G1>(
+        c.g1_x_num, c.g1_x_den, c.g1_y_num, c.g1_y_den, xn, xd, y);
+}
+
+bls12_381_G2 bls12_381_map_to_curve_G2(const bls12_381_Fq2 &u)
+{
+    const hash_to_curve_constants &c = constants();
+    bls12_381_Fq2 xn, xd, y;
+    map_to_curve_simple_swu(c, c.g2_A, c.g2_B, c.g2_Z, u, xn, xd, y);
+    return iso_map<bls12_381_G2>(
+        c.g2_x_num, c.g2_x_den, c.g2_y_num, c.g2_y_den, xn, xd, y);
+}
+
+bls12_381_G1 bls12_381_clear_cofactor_G1(const bls12_381_G1 &P)
+{
+    // h_eff = 1 - x = 0xd201000000010001.
+    const bigint<1> h_eff("15132376222941642753");
+    return h_eff * P;
+}
+
+bls12_381_G2 bls12_381_clear_cofactor_G2(const bls12_381_G2 &P)
+{
+    // Budroni-Pintore method (RFC 9380, Appendix G.3), where psi is
+    // mul_by_q() and c1 = x = -0xd201000000010000.
+    const bigint<1> minus_x("15132376222941642752");
+    const bls12_381_G2 t1 = -(minus_x * P);
+    bls12_381_G2 t2 = P.mul_by_q();
+    bls12_381_G2 t3 = P.dbl().mul_by_q().mul_by_q() - t2;
+    t2 = -(minus_x * (t1 + t2));
+    t3 = t3 + t2 - t1;
+    return t3 - P;
+}
+
+bls12_381_G1 bls12_381_hash_to_G1(
+    const std::string &msg, const std::string &dst)
+{
+    const std::vector<bls12_381_Fq> u = bls12_381_hash_to_field_Fq(msg, dst, 2);
+    return bls12_381_clear_cofactor_G1(
+        bls12_381_map_to_curve_G1(u[0]) + bls12_381_map_to_curve_G1(u[1]));
+}
+
+bls12_381_G2 bls12_381_hash_to_G2(
+    const std::string &msg, const std::string &dst)
+{
+    const std::vector<bls12_381_Fq2> u =
+        bls12_381_hash_to_field_Fq2(msg, dst, 2);
+    return bls12_381_clear_cofactor_G2(
+        bls12_381_map_to_curve_G2(u[0]) + bls12_381_map_to_curve_G2(u[1]));
+}
+
+std::vector<bls12_381_G1> bls12_381_hash_to_G1_batch(
+    const std::vector<std::string> &msgs, const std::string &dst)
+{
+    return hash_batch<bls12_381_G1>(msgs, dst, bls12_381_hash_to_G1);
+}
+
+std::vector<bls12_381_G2> bls12_381_hash_to_G2_batch(
+    const std::vector<std::string> &msgs, const std::string &dst)
+{
+    return hash_batch<bls12_381_G2>(msgs, dst, bls12_381_hash_to_G2);
+}
+
+} // namespace libff
@@ -0,0 +1,87 @@
+/** @file
+ *****************************************************************************
+
+ Hashing to the BLS12-381 groups G1 and G2, following the suites
+ BLS12381G1_XMD:SHA-256_SSWU_RO_ and BLS12381G2_XMD:SHA-256_SSWU_RO_ of
+ RFC 9380 ("Hashing to Elliptic Curves").
+
+ A message is expanded with expand_message_xmd (SHA-256) into two field
+ elements u0, u1, each of which is mapped to a point on a curve isogenous to
+ E (resp. E') with the simplified SWU map, then to E (resp. E') via the 11-
+ (resp. 3-) isogeny. The sum of the two points is mapped into the prime-order
+ subgroup by clearing the cofactor with the effective scalar h_eff (using the
+ psi endomorphism for G2).
+
+ The maps are computed without field inversions: the square root and the
+ division of the SWU map are combined into a single exponentiation
+ (sqrt_ratio), and the isogeny is evaluated in projective form, producing a
+ point in Jacobian coordinates. The batched functions hash messages in
+ parallel (when MULTICORE is enabled) and normalize all results with a single
+ batched inversion.
+
+ init_bls12_381_params() (or bls12_381_pp::init_public_params()) must be
+ called before using these functions.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BLS12_381_HASH_TO_CURVE_HPP_
+#define BLS12_381_HASH_TO_CURVE_HPP_
+
+#include <libff/algebra/curves/bls12_381/bls12_381_g1.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
+#include <string>
+#include <vector>
+
+namespace libff
+{
+
+/// Suite identifiers, for use in constructing domain separation tags.
+static const char BLS12_381_G1_HASH_TO_CURVE_SUITE[] =
+    "BLS12381G1_XMD:SHA-256_SSWU_RO_";
+static const char BLS12_381_G2_HASH_TO_CURVE_SUITE[] =
+    "BLS12381G2_XMD:SHA-256_SSWU_RO_";
+
+/// hash_to_field for Fq (RFC 9380, Section 5.2), returning count elements.
+std::vector<bls12_381_Fq> bls12_381_hash_to_field_Fq(
+    const std::string &msg, const std::string &dst, const size_t count);
+
+/// hash_to_field for Fq2, returning count elements.
+std::vector<bls12_381_Fq2> bls12_381_hash_to_field_Fq2(
+    const std::string &msg, const std::string &dst, const size_t count);
+
+/// Map a field element to a point of E (not necessarily in G1).
+bls12_381_G1 bls12_381_map_to_curve_G1(const bls12_381_Fq &u);
+
+/// Map a field element to a point of E' (not necessarily in G2).
+bls12_381_G2 bls12_381_map_to_curve_G2(const bls12_381_Fq2 &u);
+
+/// Multiply a point of E by h_eff = 1 - x, mapping it into G1.
+bls12_381_G1 bls12_381_clear_cofactor_G1(const bls12_381_G1 &P);
+
+/// Multiply a point of E' by h_eff (RFC 9380, Section 8.8.2), mapping it into
+/// G2.
+bls12_381_G2 bls12_381_clear_cofactor_G2(const bls12_381_G2 &P);
+
+/// Hash msg to G1, with domain separation tag dst (of at most 255 bytes).
+bls12_381_G1 bls12_381_hash_to_G1(
+    const std::string &msg, const std::string &dst);
+
+/// Hash msg to G2, with domain separation tag dst (of at most 255 bytes).
+bls12_381_G2 bls12_381_hash_to_G2(
+    const std::string &msg, const std::string &dst);
+
+/// Hash each of msgs to G1. The results are in special (affine) form.
+std::vector<bls12_381_G1> bls12_381_hash_to_G1_batch(
+    const std::vector<std::string> &msgs, const std::string &dst);
+
+/// Hash each of msgs to G2. The results are in special (affine) form.
+std::vector<bls12_381_G2> bls12_381_hash_to_G2_batch(
+    const std::vector<std::string> &msgs, const std::string &dst);
+
+} // namespace libff
+
+#endif // BLS12_381_HASH_TO_CURVE_HPP_
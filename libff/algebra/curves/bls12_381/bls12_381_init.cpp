@@ -17,6 +17,8 @@ bls12_381_Fq bls12_381_twist_mul_by_b_c1;
 bls12_381_Fq2 bls12_381_twist_mul_by_q_X;
 bls12_381_Fq2 bls12_381_twist_mul_by_q_Y;
 
+bls12_381_Fq bls12_381_g1_endomorphism_beta;
+
 bigint<bls12_381_q_limbs> bls12_381_ate_loop_count;
 bool bls12_381_ate_is_loop_count_neg;
 bigint<12 * bls12_381_q_limbs> bls12_381_final_exponent;
@@ -456,6 +458,11 @@ void init_bls12_381_params()
     bls12_381_G1::h =
         bigint<bls12_381_G1::h_limbs>("76329603384216526031706109802092473003");
 
+    // G1 fast subgroup check: 0 == P + [z^2]sigma(P)
+    bls12_381_g1_endomorphism_beta = bls12_381_Fq(
+        "4002409555221667392624310435006688643935503118305586438271171395842971"
+        "157480381377015405980053539358417135540939436");
+
     // TODO: wNAF window table
     bls12_381_G1::wnaf_window_table.resize(0);
     bls12_381_G1::wnaf_window_table.push_back(11);
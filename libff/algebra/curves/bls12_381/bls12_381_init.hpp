@@ -46,6 +46,9 @@ extern bls12_381_Fq bls12_381_twist_mul_by_b_c1;
 extern bls12_381_Fq2 bls12_381_twist_mul_by_q_X;
 extern bls12_381_Fq2 bls12_381_twist_mul_by_q_Y;
 
+// Coefficient \beta in endomorphism (x, y) -> (\beta * x, y)
+extern bls12_381_Fq bls12_381_g1_endomorphism_beta;
+
 // parameters for pairing
 extern bigint<bls12_381_q_limbs> bls12_381_ate_loop_count;
 extern bool bls12_381_ate_is_loop_count_neg;
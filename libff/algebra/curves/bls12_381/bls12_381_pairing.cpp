@@ -471,6 +471,68 @@ bls12_381_Fq12 bls12_381_ate_double_miller_loop(
     return f;
 }
 
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(
+    const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+    const std::vector<bls12_381_ate_G2_precomp> &prec_Q)
+{
+    std::vector<const bls12_381_ate_G2_precomp *> prec_Q_ptrs;
+    prec_Q_ptrs.reserve(prec_Q.size());
+    for (const bls12_381_ate_G2_precomp &Q : prec_Q) {
+        prec_Q_ptrs.push_back(&Q);
+    }
+    return bls12_381_ate_multi_miller_loop(prec_P, prec_Q_ptrs);
+}
+
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(
+    const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+    const std::vector<const bls12_381_ate_G2_precomp *> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+    enter_block("Call to bls12_381_ate_multi_miller_loop");
+
+    bls12_381_Fq12 f = bls12_381_Fq12::one();
+
+    bool found_one = false;
+    size_t idx = 0;
+
+    const bigint<bls12_381_Fq::num_limbs> &loop_count =
+        bls12_381_ate_loop_count;
+    for (long i = loop_count.max_bits(); i >= 0; --i) {
+        const bool bit = loop_count.test_bit(i);
+        if (!found_one) {
+            /* this skips the MSB itself */
+            found_one |= bit;
+            continue;
+        }
+
+        f = f.squared();
+
+        for (size_t j = 0; j < prec_P.size(); ++j) {
+            const bls12_381_ate_ell_coeffs &c = prec_Q[j]->coeffs[idx];
+            f = f.mul_by_045(
+                c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+        }
+        ++idx;
+
+        if (bit) {
+            for (size_t j = 0; j < prec_P.size(); ++j) {
+                const bls12_381_ate_ell_coeffs &c = prec_Q[j]->coeffs[idx];
+                f = f.mul_by_045(
+                    c.ell_0, prec_P[j].PY * c.ell_VW, prec_P[j].PX * c.ell_VV);
+            }
+            ++idx;
+        }
+    }
+
+    if (bls12_381_ate_is_loop_count_neg) {
+        f = f.inverse();
+    }
+
+    leave_block("Call to bls12_381_ate_multi_miller_loop");
+
+    return f;
+}
+
 bls12_381_Fq12 bls12_381_ate_pairing(
     const bls12_381_G1 &P, const bls12_381_G2 &Q)
 {
@@ -519,6 +581,20 @@ bls12_381_Fq12 bls12_381_double_miller_loop(
     return bls12_381_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bls12_381_Fq12 bls12_381_multi_miller_loop(
+    const std::vector<bls12_381_G1_precomp> &prec_P,
+    const std::vector<bls12_381_G2_precomp> &prec_Q)
+{
+    return bls12_381_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
+bls12_381_Fq12 bls12_381_multi_miller_loop(
+    const std::vector<bls12_381_G1_precomp> &prec_P,
+    const std::vector<const bls12_381_G2_precomp *> &prec_Q)
+{
+    return bls12_381_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1 &P, const bls12_381_G2 &Q)
 {
     return bls12_381_ate_pairing(P, Q);
@@ -75,6 +75,17 @@ bls12_381_Fq12 bls12_381_ate_double_miller_loop(
     const bls12_381_ate_G1_precomp &prec_P2,
     const bls12_381_ate_G2_precomp &prec_Q2);
 
+/// The product of the Miller loops of the pairs (prec_P[i], prec_Q[i]),
+/// sharing the squarings of the accumulator between all pairs.
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(
+    const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+    const std::vector<bls12_381_ate_G2_precomp> &prec_Q);
+/// As above, for the pairs (prec_P[i], *prec_Q[i]), so that (large) G2
+/// precomputations shared between calls need not be copied.
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(
+    const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+    const std::vector<const bls12_381_ate_G2_precomp *> &prec_Q);
+
 bls12_381_Fq12 bls12_381_final_exponentiation_first_chunk(
     const bls12_381_Fq12 &elt);
 bls12_381_Fq12 bls12_381_exp_by_z(const bls12_381_Fq12 &elt);
@@ -104,6 +115,14 @@ bls12_381_Fq12 bls12_381_double_miller_loop(
     const bls12_381_G1_precomp &prec_P2,
     const bls12_381_G2_precomp &prec_Q2);
 
+bls12_381_Fq12 bls12_381_multi_miller_loop(
+    const std::vector<bls12_381_G1_precomp> &prec_P,
+    const std::vector<bls12_381_G2_precomp> &prec_Q);
+
+bls12_381_Fq12 bls12_381_multi_miller_loop(
+    const std::vector<bls12_381_G1_precomp> &prec_P,
+    const std::vector<const bls12_381_G2_precomp *> &prec_Q);
+
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1 &P, const bls12_381_G2 &Q);
 
 bls12_381_GT bls12_381_reduced_pairing(
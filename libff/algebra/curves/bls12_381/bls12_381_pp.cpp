@@ -37,6 +37,13 @@ bls12_381_Fq12 bls12_381_pp::double_miller_loop(
     return bls12_381_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bls12_381_Fq12 bls12_381_pp::multi_miller_loop(
+    const std::vector<bls12_381_G1_precomp> &prec_P,
+    const std::vector<const bls12_381_G2_precomp *> &prec_Q)
+{
+    return bls12_381_multi_miller_loop(prec_P, prec_Q);
+}
+
 bls12_381_Fq12 bls12_381_pp::pairing(
     const bls12_381_G1 &P, const bls12_381_G2 &Q)
 {
@@ -0,0 +1,342 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of BLS signatures over BLS12-381.
+
+ See bls12_381_signature.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/algebra/curves/bls12_381/bls12_381_hash_to_curve.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pairing.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_signature.hpp>
+#include <libff/algebra/fields/field_utils.hpp>
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace
+{
+
+static_assert(
+    BLS12_381_SIGNATURE_BATCH_SCALAR_BITS > 0 &&
+        BLS12_381_SIGNATURE_BATCH_SCALAR_BITS < bls12_381_r_bitcount,
+    "invalid BLS12_381_SIGNATURE_BATCH_SCALAR_BITS");
+
+/// The distinct messages of a batch, hashed to G2 and precomputed for
+/// pairing.
+class hashed_messages
+{
+public:
+    /// Index of the (distinct) message of each signature.
+    std::vector<size_t> message_index;
+    std::vector<bls12_381_G2_precomp> precomp;
+
+    hashed_messages(
+        const std::vector<std::string> &msgs, const std::string &dst)
+    {
+        std::map<std::string, size_t> index;
+        std::vector<std::string> distinct;
+        message_index.reserve(msgs.size());
+        for (const std::string &msg : msgs) {
+            const auto it = index.emplace(msg, distinct.size());
+            if (it.second) {
+                distinct.push_back(msg);
+            }
+            message_index.push_back(it.first->second);
+        }
+
+        const std::vector<bls12_381_G2> hashes =
+            bls12_381_hash_to_G2_batch(distinct, dst);
+        precomp.resize(hashes.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            precomp[i] = bls12_381_precompute_G2(hashes[i]);
+        }
+    }
+
+    size_t num_messages() const { return precomp.size(); }
+};
+
+void check_sizes(
+    const size_t num_public_keys,
+    const size_t num_msgs,
+    const size_t num_signatures,
+    const char *function)
+{
+    if (num_msgs != num_public_keys || num_signatures != num_public_keys) {
+        throw std::invalid_argument(
+            std::string("libff::") + function +
+            ": expected one message and signature per public key");
+    }
+}
+
+/// KeyValidate of the IETF BLS signature draft, for keys known to be in G1:
+/// the zero key, under which the zero signature verifies for any message,
+/// is rejected.
+bool public_key_is_valid(const bls12_381_G1 &public_key)
+{
+    return !public_key.is_zero();
+}
+
+bool public_keys_are_valid(const std::vector<bls12_381_G1> &public_keys)
+{
+    for (const bls12_381_G1 &public_key : public_keys) {
+        if (!public_key_is_valid(public_key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Check e(g1, signature) == \prod_m e(points[m], H(m)), where H(m) is the
+/// m-th hashed message, with a single Miller loop and final exponentiation.
+bool check_pairing_product(
+    const bls12_381_G2 &signature,
+    const std::vector<bls12_381_G1> &points,
+    const hashed_messages &hashed)
+{
+    // Pairs with a zero element contribute 1 to the product, and are
+    // skipped. The hashed messages are referenced rather than copied.
+    bls12_381_G2_precomp prec_signature;
+    std::vector<bls12_381_G1_precomp> prec_P;
+    std::vector<const bls12_381_G2_precomp *> prec_Q;
+    prec_P.reserve(points.size() + 1);
+    prec_Q.reserve(points.size() + 1);
+    if (!signature.is_zero()) {
+        prec_signature = bls12_381_precompute_G2(signature);
+        prec_P.push_back(bls12_381_precompute_G1(-bls12_381_G1::one()));
+        prec_Q.push_back(&prec_signature);
+    }
+    for (size_t m = 0; m < points.size(); ++m) {
+        if (!points[m].is_zero()) {
+            prec_P.push_back(bls12_381_precompute_G1(points[m]));
+            prec_Q.push_back(&hashed.precomp[m]);
+        }
+    }
+
+    if (prec_P.empty()) {
+        return true;
+    }
+    return bls12_381_final_exponentiation(bls12_381_multi_miller_loop(
+               prec_P, prec_Q)) == bls12_381_GT::one();
+}
+
+/// Batch-verify the signatures with the given indices.
+bool batch_check(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<bls12_381_G2> &signatures,
+    const hashed_messages &hashed,
+    const std::vector<size_t> &indices)
+{
+    // The first scalar can be 1 without loss of soundness, which makes the
+    // check for a single signature deterministic.
+    std::vector<bls12_381_Fr> r(indices.size());
+    std::vector<bls12_381_G2> batch_signatures(indices.size());
+    std::vector<std::vector<bls12_381_G1>> bases(hashed.num_messages());
+    std::vector<std::vector<bls12_381_Fr>> scalars(hashed.num_messages());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        r[i] = (i == 0) ? bls12_381_Fr::one()
+                        : random_field_element_bits<bls12_381_Fr>(
+                              BLS12_381_SIGNATURE_BATCH_SCALAR_BITS);
+        batch_signatures[i] = signatures[indices[i]];
+        const size_t m = hashed.message_index[indices[i]];
+        bases[m].push_back(public_keys[indices[i]]);
+        scalars[m].push_back(r[i]);
+    }
+
+    bls12_381_G2 signature = bls12_381_G2::zero();
+    if (!indices.empty()) {
+        signature = multi_exp<
+            bls12_381_G2,
+            bls12_381_Fr,
+            BLS12_381_SIGNATURE_MULTI_EXP_METHOD>(
+            batch_signatures.begin(),
+            batch_signatures.end(),
+            r.begin(),
+            r.end(),
+            1);
+    }
+
+    std::vector<bls12_381_G1> points(hashed.num_messages());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t m = 0; m < points.size(); ++m) {
+        if (bases[m].empty()) {
+            points[m] = bls12_381_G1::zero();
+            continue;
+        }
+        points[m] = multi_exp<
+            bls12_381_G1,
+            bls12_381_Fr,
+            BLS12_381_SIGNATURE_MULTI_EXP_METHOD>(
+            bases[m].begin(),
+            bases[m].end(),
+            scalars[m].begin(),
+            scalars[m].end(),
+            1);
+    }
+
+    return check_pairing_product(signature, points, hashed);
+}
+
+/// Append to invalid the indices of the invalid signatures among the given
+/// indices, which are known to fail batch verification.
+void bisect(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<bls12_381_G2> &signatures,
+    const hashed_messages &hashed,
+    const std::vector<size_t> &indices,
+    std::vector<size_t> &invalid)
+{
+    if (indices.size() == 1) {
+        invalid.push_back(indices[0]);
+        return;
+    }
+
+    const std::vector<size_t> left(
+        indices.begin(), indices.begin() + indices.size() / 2);
+    const std::vector<size_t> right(
+        indices.begin() + indices.size() / 2, indices.end());
+    if (batch_check(public_keys, signatures, hashed, left)) {
+        // The invalid signatures are all in the right half.
+        bisect(public_keys, signatures, hashed, right, invalid);
+        return;
+    }
+
+    bisect(public_keys, signatures, hashed, left, invalid);
+    if (!batch_check(public_keys, signatures, hashed, right)) {
+        bisect(public_keys, signatures, hashed, right, invalid);
+    }
+}
+
+} // namespace
+
+bls12_381_G1 bls12_381_signature_public_key(const bls12_381_Fr &secret_key)
+{
+    return secret_key * bls12_381_G1::one();
+}
+
+bls12_381_G2 bls12_381_signature_sign(
+    const bls12_381_Fr &secret_key,
+    const std::string &msg,
+    const std::string &dst)
+{
+    return secret_key * bls12_381_hash_to_G2(msg, dst);
+}
+
+bool bls12_381_signature_verify(
+    const bls12_381_G1 &public_key,
+    const std::string &msg,
+    const bls12_381_G2 &signature,
+    const std::string &dst)
+{
+    if (!public_key_is_valid(public_key)) {
+        return false;
+    }
+
+    const hashed_messages hashed({msg}, dst);
+    return check_pairing_product(signature, {public_key}, hashed);
+}
+
+bls12_381_G2 bls12_381_signature_aggregate(
+    const std::vector<bls12_381_G2> &signatures)
+{
+    bls12_381_G2 result = bls12_381_G2::zero();
+    for (const bls12_381_G2 &signature : signatures) {
+        result = result + signature;
+    }
+    return result;
+}
+
+bool bls12_381_signature_aggregate_verify(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<std::string> &msgs,
+    const bls12_381_G2 &signature,
+    const std::string &dst)
+{
+    check_sizes(
+        public_keys.size(),
+        msgs.size(),
+        public_keys.size(),
+        "bls12_381_signature_aggregate_verify");
+    if (!public_keys_are_valid(public_keys)) {
+        return false;
+    }
+
+    const hashed_messages hashed(msgs, dst);
+    std::vector<bls12_381_G1> points(
+        hashed.num_messages(), bls12_381_G1::zero());
+    for (size_t i = 0; i < public_keys.size(); ++i) {
+        points[hashed.message_index[i]] =
+            points[hashed.message_index[i]] + public_keys[i];
+    }
+    return check_pairing_product(signature, points, hashed);
+}
+
+bool bls12_381_signature_batch_verify(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<std::string> &msgs,
+    const std::vector<bls12_381_G2> &signatures,
+    const std::string &dst)
+{
+    check_sizes(
+        public_keys.size(),
+        msgs.size(),
+        signatures.size(),
+        "bls12_381_signature_batch_verify");
+    if (!public_keys_are_valid(public_keys)) {
+        return false;
+    }
+
+    const hashed_messages hashed(msgs, dst);
+    std::vector<size_t> indices(public_keys.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    return batch_check(public_keys, signatures, hashed, indices);
+}
+
+std::vector<size_t> bls12_381_signature_find_invalid(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<std::string> &msgs,
+    const std::vector<bls12_381_G2> &signatures,
+    const std::string &dst)
+{
+    check_sizes(
+        public_keys.size(),
+        msgs.size(),
+        signatures.size(),
+        "bls12_381_signature_find_invalid");
+
+    // Signatures under invalid public keys are reported without being
+    // checked.
+    std::vector<size_t> indices;
+    std::vector<size_t> invalid;
+    for (size_t i = 0; i < public_keys.size(); ++i) {
+        if (public_key_is_valid(public_keys[i])) {
+            indices.push_back(i);
+        } else {
+            invalid.push_back(i);
+        }
+    }
+
+    const hashed_messages hashed(msgs, dst);
+    if (!batch_check(public_keys, signatures, hashed, indices)) {
+        bisect(public_keys, signatures, hashed, indices, invalid);
+        std::sort(invalid.begin(), invalid.end());
+    }
+    return invalid;
+}
+
+} // namespace libff
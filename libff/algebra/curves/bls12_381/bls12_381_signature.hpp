@@ -0,0 +1,126 @@
+/** @file
+ *****************************************************************************
+
+ BLS signatures [BLS01] over BLS12-381, in the "minimal public key size"
+ variant: secret keys are elements of Fr, public keys are in G1 and
+ signatures are in G2. Messages are hashed to G2 with
+ bls12_381_hash_to_G2 (see bls12_381_hash_to_curve.hpp).
+
+ A signature sig on msg is valid for the public key pk iff
+
+     e(pk, H(msg)) == e(g1, sig).
+
+ Aggregation: signatures (on any messages) are aggregated by adding them,
+ and an aggregate signature sig on msgs[i] under pks[i] is valid iff
+
+     e(g1, sig) == \prod_i e(pks[i], H(msgs[i])).
+
+ Public keys of equal messages are added before pairing, so that one pair is
+ evaluated per distinct message.
+
+ Batch verification: N independent triples (pks[i], msgs[i], sigs[i]) are
+ checked together by drawing random scalars r_i of
+ BLS12_381_SIGNATURE_BATCH_SCALAR_BITS bits, and checking
+
+     e(g1, \sum_i r_i sigs[i]) == \prod_m e(\sum_{i : msgs[i] = m} r_i pks[i],
+                                           H(m))
+
+ where the linear combinations are computed with multi_exp. All pairings of
+ an equation share a single Miller loop and one final exponentiation. If a
+ batch contains an invalid signature, the check fails except with
+ probability 2^-BLS12_381_SIGNATURE_BATCH_SCALAR_BITS;
+ bls12_381_signature_find_invalid then locates the invalid signatures by
+ bisection.
+
+ Public keys and signatures are assumed to be elements of G1 and G2
+ respectively (i.e. checked with is_in_safe_subgroup() when deserialized).
+ The zero public key is rejected, as in KeyValidate of the IETF draft: no
+ signature verifies under it. Callers using aggregate
+ signatures on distinct messages must enforce distinctness, or use proofs
+ of possession, to prevent rogue key attacks.
+
+ References:
+
+ [BLS01]:
+   "Short signatures from the Weil pairing",
+   Dan Boneh, Ben Lynn, Hovav Shacham,
+   ASIACRYPT 2001
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BLS12_381_SIGNATURE_HPP_
+#define BLS12_381_SIGNATURE_HPP_
+
+#include <libff/algebra/curves/bls12_381/bls12_381_g1.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <string>
+#include <vector>
+
+namespace libff
+{
+
+/// Domain separation tag of the basic scheme of the IETF BLS signature draft.
+static const char BLS12_381_SIGNATURE_DST[] =
+    "BLS_SIG_BLS12381G2_XMD:SHA-256_SSWU_RO_NUL_";
+
+/// Size of the random scalars used to combine signatures in batch
+/// verification.
+static const size_t BLS12_381_SIGNATURE_BATCH_SCALAR_BITS = 128;
+
+/// Method used for the multi-exponentiations of batch verification.
+static const multi_exp_method BLS12_381_SIGNATURE_MULTI_EXP_METHOD =
+    multi_exp_method_auto;
+
+bls12_381_G1 bls12_381_signature_public_key(const bls12_381_Fr &secret_key);
+
+bls12_381_G2 bls12_381_signature_sign(
+    const bls12_381_Fr &secret_key,
+    const std::string &msg,
+    const std::string &dst = BLS12_381_SIGNATURE_DST);
+
+bool bls12_381_signature_verify(
+    const bls12_381_G1 &public_key,
+    const std::string &msg,
+    const bls12_381_G2 &signature,
+    const std::string &dst = BLS12_381_SIGNATURE_DST);
+
+/// The aggregate (sum) of the given signatures.
+bls12_381_G2 bls12_381_signature_aggregate(
+    const std::vector<bls12_381_G2> &signatures);
+
+/// Verify an aggregate signature on msgs[i] under public_keys[i], which
+/// fails if any public key is zero. Throws std::invalid_argument if the
+/// sizes differ.
+bool bls12_381_signature_aggregate_verify(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<std::string> &msgs,
+    const bls12_381_G2 &signature,
+    const std::string &dst = BLS12_381_SIGNATURE_DST);
+
+/// Verify that each signatures[i] is a valid signature on msgs[i] under
+/// public_keys[i], which fails if any public key is zero. Throws
+/// std::invalid_argument if the sizes differ.
+bool bls12_381_signature_batch_verify(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<std::string> &msgs,
+    const std::vector<bls12_381_G2> &signatures,
+    const std::string &dst = BLS12_381_SIGNATURE_DST);
+
+/// The indices (in increasing order) of the invalid signatures of a batch,
+/// found by recursively batch-verifying halves of the failing sub-batches.
+/// Signatures under a zero public key are always invalid.
+/// Messages are hashed (and the hashes precomputed for pairing) only once.
+std::vector<size_t> bls12_381_signature_find_invalid(
+    const std::vector<bls12_381_G1> &public_keys,
+    const std::vector<std::string> &msgs,
+    const std::vector<bls12_381_G2> &signatures,
+    const std::string &dst = BLS12_381_SIGNATURE_DST);
+
+} // namespace libff
+
+#endif // BLS12_381_SIGNATURE_HPP_
@@ -160,13 +160,15 @@ bool bn128_G1::operator!=(const bn128_G1 &other) const
 
 bn128_G1 bn128_G1::operator+(const bn128_G1 &other) const
 {
+    LIBFF_TRACE_ADD(*this, other);
+
     // handle special cases having to do with O
     if (this->is_zero()) {
-        return other;
+        return LIBFF_TRACE_RESULT(other);
     }
 
     if (other.is_zero()) {
-        return *this;
+        return LIBFF_TRACE_RESULT(*this);
     }
 
     // no need to handle points of order 2,4
@@ -174,9 +176,9 @@ bn128_G1 bn128_G1::operator+(const bn128_G1 &other) const
 
     // handle double case, and then all the rest
     if (this->operator==(other)) {
-        return this->dbl();
+        return LIBFF_TRACE_RESULT(this->dbl());
     } else {
-        return this->add(other);
+        return LIBFF_TRACE_RESULT(this->add(other));
     }
 }
 
@@ -194,6 +196,8 @@ bn128_G1 bn128_G1::operator-(const bn128_G1 &other) const
 
 bn128_G1 bn128_G1::add(const bn128_G1 &other) const
 {
+    LIBFF_TRACE_ADD(*this, other);
+
 #ifdef PROFILE_OP_COUNTS
     this->add_cnt++;
 #endif
@@ -204,17 +208,19 @@ bn128_G1 bn128_G1::add(const bn128_G1 &other) const
     bn::ecop::ECAdd(result_coord, this_coord, other_coord);
 
     bn128_G1 result(result_coord);
-    return result;
+    return LIBFF_TRACE_RESULT(result);
 }
 
 bn128_G1 bn128_G1::mixed_add(const bn128_G1 &other) const
 {
+    LIBFF_TRACE_MIXED_ADD(*this, other);
+
     if (this->is_zero()) {
-        return other;
+        return LIBFF_TRACE_RESULT(other);
     }
 
     if (other.is_zero()) {
-        return *this;
+        return LIBFF_TRACE_RESULT(*this);
     }
 
     // no need to handle points of order 2,4
@@ -249,7 +255,7 @@ bn128_G1 bn128_G1::mixed_add(const bn128_G1 &other) const
 
     if (U1 == U2 && S1 == S2) {
         // dbl case; nothing of above can be reused
-        return this->dbl();
+        return LIBFF_TRACE_RESULT(this->dbl());
     }
 
 #ifdef PROFILE_OP_COUNTS
@@ -288,11 +294,13 @@ bn128_G1 bn128_G1::mixed_add(const bn128_G1 &other) const
     bn::Fp::square(result.Z, tmp);
     bn::Fp::sub(result.Z, result.Z, Z1Z1);
     bn::Fp::sub(result.Z, result.Z, HH);
-    return result;
+    return LIBFF_TRACE_RESULT(result);
 }
 
 bn128_G1 bn128_G1::dbl() const
 {
+    LIBFF_TRACE_DBL(*this);
+
 #ifdef PROFILE_OP_COUNTS
     this->dbl_cnt++;
 #endif
@@ -302,7 +310,7 @@ bn128_G1 bn128_G1::dbl() const
     bn::ecop::ECDouble(result_coord, this_coord);
 
     bn128_G1 result(result_coord);
-    return result;
+    return LIBFF_TRACE_RESULT(result);
 }
 
 bn128_G1 bn128_G1::mul_by_cofactor() const
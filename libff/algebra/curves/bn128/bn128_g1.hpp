@@ -11,6 +11,7 @@
 
 #include <libff/algebra/curves/bn128/bn128_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -102,6 +103,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<bn128_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(bn128_G1);
+
 template<mp_size_t m>
 bn128_G1 operator*(const bigint<m> &lhs, const bn128_G1 &rhs)
 {
@@ -2,6 +2,7 @@
 #define BW6_761_G1_HPP_
 #include <libff/algebra/curves/bw6_761/bw6_761_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -24,6 +25,7 @@ public:
     static bw6_761_G1 G1_one;
     static bw6_761_Fq coeff_a;
     static bw6_761_Fq coeff_b;
+    static const bool coeff_a_is_zero = true;
 
     typedef bw6_761_Fq base_field;
     typedef bw6_761_Fr scalar_field;
@@ -62,6 +64,10 @@ public:
     bw6_761_G1 dbl() const;
     bw6_761_G1 mul_by_cofactor() const;
 
+    // Endomorphism (x, y) -> (\beta * x, y) for \beta an element of Fq with
+    // order 3. Computed without leaving projective coordinates.
+    bw6_761_G1 sigma() const;
+
     bool is_well_formed() const;
     bool is_in_safe_subgroup() const;
 
@@ -90,6 +96,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<bw6_761_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(bw6_761_G1);
+
 template<mp_size_t m>
 bw6_761_G1 operator*(const bigint<m> &lhs, const bw6_761_G1 &rhs)
 {
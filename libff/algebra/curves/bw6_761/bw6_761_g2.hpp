@@ -3,6 +3,7 @@
 
 #include <libff/algebra/curves/bw6_761/bw6_761_init.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -25,6 +26,7 @@ public:
     static bw6_761_G2 G2_one;
     static bw6_761_Fq coeff_a;
     static bw6_761_Fq coeff_b;
+    static const bool coeff_a_is_zero = true;
 
     typedef bw6_761_Fq base_field;
     typedef bw6_761_Fq twist_field;
@@ -94,6 +96,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<bw6_761_G2> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(bw6_761_G2);
+
 template<mp_size_t m>
 bw6_761_G2 operator*(const bigint<m> &lhs, const bw6_761_G2 &rhs)
 {
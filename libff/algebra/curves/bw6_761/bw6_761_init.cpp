@@ -18,6 +18,8 @@ bw6_761_Fq bw6_761_coeff_b;
 bw6_761_Fq bw6_761_twist;
 bw6_761_Fq bw6_761_twist_coeff_b;
 
+bw6_761_Fq bw6_761_g1_endomorphism_beta;
+
 bigint<bw6_761_q_limbs> bw6_761_ate_loop_count1;
 bigint<bw6_761_q_limbs> bw6_761_ate_loop_count2;
 bool bw6_761_ate_is_loop_count_neg;
@@ -225,6 +227,7 @@ void init_bw6_761_params()
                    "48548642823052024664478336818169867474395270858391911405337"
                    "70724773573982666493944449046954210939153048282672820358254"
                    "9674992333383150446779312029624171857054392282775648");
+    bw6_761_Fq3::static_init();
 
     // Parameters for the field Fq^6
     bw6_761_Fq6::non_residue =
@@ -304,6 +307,13 @@ void init_bw6_761_params()
         "2664243587933581668398767770148807386775111827005265065594210250231297"
         "7592501693353047140953112195348280268661194876");
 
+    // G1 fast subgroup check: [z + 1]P == sigma([z^3 - z^2 - z]P)
+    bw6_761_g1_endomorphism_beta = bw6_761_Fq(
+        "4922464560225523242118178942575080391082002530232324381063048548642823"
+        "0520246644783368181698674743952708583919114053377072477357398266649394"
+        "4449046954210939153048282672820358254967499233338315044677931202962417"
+        "1857054392282775648");
+
     // WNAF
     //
     // Below we use the same `wnaf_window_table` as used for alt_bn_128
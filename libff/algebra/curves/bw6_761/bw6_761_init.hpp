@@ -1,6 +1,7 @@
 #ifndef BW6_761_INIT_HPP_
 #define BW6_761_INIT_HPP_
 
+#include <cstdint>
 #include <libff/algebra/curves/public_params.hpp>
 #include <libff/algebra/fields/fp.hpp>
 #include <libff/algebra/fields/fp3.hpp>
@@ -32,6 +33,9 @@ extern bw6_761_Fq bw6_761_coeff_b;
 extern bw6_761_Fq bw6_761_twist;
 extern bw6_761_Fq bw6_761_twist_coeff_b;
 
+// Coefficient \beta in endomorphism (x, y) -> (\beta * x, y)
+extern bw6_761_Fq bw6_761_g1_endomorphism_beta;
+
 // parameters for pairing
 extern bigint<bw6_761_q_limbs> bw6_761_ate_loop_count1;
 extern bigint<bw6_761_q_limbs> bw6_761_ate_loop_count2;
@@ -39,6 +43,25 @@ extern bool bw6_761_ate_is_loop_count_neg;
 extern bigint<bw6_761_q_limbs> bw6_761_final_exponent_z;
 extern bool bw6_761_final_exponent_is_z_neg;
 
+/// Non-adjacent forms of bw6_761_ate_loop_count1 and bw6_761_ate_loop_count2
+/// (as computed by find_wnaf(1, ...)), most significant digit first. The
+/// Miller loop and G2 precomputation iterate over these directly.
+constexpr int8_t bw6_761_ate_loop_count1_naf[] = {
+    1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, -1, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+};
+constexpr int8_t bw6_761_ate_loop_count2_naf[] = {
+    1, 0, 0, 1, 0, 0, 0, 0, 0, -1, 0, -1, 0, 1, 0, 0, 0, 1, 0, 1, 0, -1, 0, 1,
+    0, 0, 1, 0, 0, 0, -1, 0, 1, 0, -1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1, 0, 0, 0,
+    0, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, -1, 0, 0, 0, 0, -1, 0, 1, 0, -1, 0, 0, 1, 0, 0, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1,
+};
+
 void init_bw6_761_params();
 
 class bw6_761_G1;
@@ -367,7 +367,7 @@ bw6_761_ate_G1_precomp bw6_761_ate_precompute_G1(const bw6_761_G1 &P)
 }
 
 static bw6_761_ate_G2_precomp_iteration bw6_761_ate_precompute_G2_internal(
-    const bw6_761_G2 &Q, const bigint<bw6_761_Fq::num_limbs> &loop_count)
+    const bw6_761_G2 &Q, const int8_t *naf, const size_t naf_size)
 {
     enter_block("Call to bw6_761_ate_precompute_G2");
 
@@ -383,22 +383,15 @@ static bw6_761_ate_G2_precomp_iteration bw6_761_ate_precompute_G2_internal(
     R.Y = Qcopy.Y;
     R.Z = bw6_761_Fq::one();
 
-    bool found_nonzero = false;
     bw6_761_ate_ell_coeffs c;
 
-    std::vector<long> NAF = find_wnaf(1, loop_count);
-    for (long i = NAF.size() - 1; i >= 0; --i) {
-        if (!found_nonzero) {
-            // This skips the MSB itself
-            found_nonzero |= (NAF[i] != 0);
-            continue;
-        }
-
+    // naf[0] is the (nonzero) most significant digit, which is skipped.
+    for (size_t i = 1; i < naf_size; ++i) {
         doubling_step_for_miller_loop(R, c);
         result.coeffs.push_back(c);
 
-        if (NAF[i] != 0) {
-            if (NAF[i] > 0) {
+        if (naf[i] != 0) {
+            if (naf[i] > 0) {
                 mixed_addition_step_for_miller_loop(Qcopy, R, c);
             } else {
                 mixed_addition_step_for_miller_loop(-Qcopy, R, c);
@@ -414,95 +407,126 @@ static bw6_761_ate_G2_precomp_iteration bw6_761_ate_precompute_G2_internal(
 bw6_761_ate_G2_precomp bw6_761_ate_precompute_G2(const bw6_761_G2 &Q)
 {
     return {
-        bw6_761_ate_precompute_G2_internal(Q, bw6_761_ate_loop_count1),
-        bw6_761_ate_precompute_G2_internal(Q, bw6_761_ate_loop_count2),
+        bw6_761_ate_precompute_G2_internal(
+            Q,
+            bw6_761_ate_loop_count1_naf,
+            sizeof(bw6_761_ate_loop_count1_naf)),
+        bw6_761_ate_precompute_G2_internal(
+            Q,
+            bw6_761_ate_loop_count2_naf,
+            sizeof(bw6_761_ate_loop_count2_naf)),
     };
 }
 
-// https://gitlab.inria.fr/zk-curves/bw6-761/-/blob/master/sage/pairing.py#L344
-bw6_761_Fq6 bw6_761_ate_miller_loop(
-    const bw6_761_ate_G1_precomp &prec_P, const bw6_761_ate_G2_precomp &prec_Q)
-{
-    enter_block("Call to bw6_761_ate_miller_loop");
+// The lines of the second loop are multiplied into the result after
+// applying the q-power Frobenius map. This fixes Fq and maps the sparse
+// elements (ell_VW * PY, 0, 0, 0, ell_0, ell_VV * PX) of Fq6 (as used by
+// mul_by_045) to sparse elements, by scaling ell_0 and ell_VV * PX by
+// constants. The scaling of PX is applied once per Miller loop.
+struct bw6_761_ate_frobenius_G1_precomp {
+    bw6_761_Fq PX;
+    bw6_761_Fq PY;
+    bw6_761_Fq ell_0_coeff;
+};
+
+static inline bw6_761_Fq6 bw6_761_ate_mul_by_line(
+    const bw6_761_Fq6 &f,
+    const bw6_761_ate_G1_precomp &prec_P,
+    const bw6_761_ate_ell_coeffs &c)
+{
+    return f.mul_by_045(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+}
 
-    const bw6_761_ate_G2_precomp_iteration &prec_Q_1 = prec_Q.precomp_1;
-    const bw6_761_ate_G2_precomp_iteration &prec_Q_2 = prec_Q.precomp_2;
+static inline bw6_761_Fq6 bw6_761_ate_mul_by_frobenius_line(
+    const bw6_761_Fq6 &f,
+    const bw6_761_ate_frobenius_G1_precomp &prec_P,
+    const bw6_761_ate_ell_coeffs &c)
+{
+    return f.mul_by_045(
+        prec_P.ell_0_coeff * c.ell_0,
+        prec_P.PY * c.ell_VW,
+        prec_P.PX * c.ell_VV);
+}
 
-    // f_{u+1,Q}(P)
-    bw6_761_Fq6 f_1 = bw6_761_Fq6::one();
+// Compute \prod_j f_{u+1,Q_j}(P_j) * f_{u^3-u^2-u,Q_j}(P_j)^q (see Algorithm
+// 5 of https://eprint.iacr.org/2020/351.pdf) in a single loop over the NAF
+// of u^3-u^2-u. The NAF of u+1 is aligned with its least significant digits,
+// so that both Miller loops (for all pairs) share the squarings of the
+// accumulator, and no final Frobenius map is required.
+template<size_t N>
+static bw6_761_Fq6 bw6_761_ate_combined_miller_loop(
+    const bw6_761_ate_G1_precomp *const (&prec_P)[N],
+    const bw6_761_ate_G2_precomp *const (&prec_Q)[N])
+{
+    const int8_t *naf_1 = bw6_761_ate_loop_count1_naf;
+    const int8_t *naf_2 = bw6_761_ate_loop_count2_naf;
+    const size_t naf_1_size = sizeof(bw6_761_ate_loop_count1_naf);
+    const size_t naf_2_size = sizeof(bw6_761_ate_loop_count2_naf);
+    static_assert(naf_1_size <= naf_2_size, "loop counts out of order");
+    const size_t offset = naf_2_size - naf_1_size;
+
+    const bw6_761_Fq frobenius_coeff = bw6_761_Fq6::Frobenius_coeffs_c1[1];
+    bw6_761_ate_frobenius_G1_precomp prec_P_frobenius[N];
+    for (size_t j = 0; j < N; ++j) {
+        prec_P_frobenius[j].PX = frobenius_coeff *
+                                 bw6_761_Fq3::Frobenius_coeffs_c2[1] *
+                                 prec_P[j]->PX;
+        prec_P_frobenius[j].PY = prec_P[j]->PY;
+        prec_P_frobenius[j].ell_0_coeff =
+            frobenius_coeff * bw6_761_Fq3::Frobenius_coeffs_c1[1];
+    }
 
-    bool found_nonzero_1 = false;
+    bw6_761_Fq6 f = bw6_761_Fq6::one();
     size_t idx_1 = 0;
+    size_t idx_2 = 0;
 
-    const bigint<bw6_761_Fq::num_limbs> &loop_count_1 = bw6_761_ate_loop_count1;
-    bw6_761_ate_ell_coeffs c_1;
-
-    // Get the Non-Adjacent Form of the loop count
-    // loop_count_1 = u+1
-    // This allows to cover steps 2 to 11 Algorithm 5:
-    // https://eprint.iacr.org/2020/351.pdf
-    std::vector<long> NAF_1 = find_wnaf(1, loop_count_1);
-    for (long i = NAF_1.size() - 1; i >= 0; --i) {
-        if (!found_nonzero_1) {
-            // This skips the MSB itself
-            found_nonzero_1 |= (NAF_1[i] != 0);
-            continue;
+    // The most significant digit of each NAF is skipped.
+    for (size_t i = 1; i < naf_2_size; ++i) {
+        const bool in_loop_1 = i > offset;
+
+        f = f.squared();
+        for (size_t j = 0; j < N; ++j) {
+            f = bw6_761_ate_mul_by_frobenius_line(
+                f, prec_P_frobenius[j], prec_Q[j]->precomp_2.coeffs[idx_2]);
+            if (in_loop_1) {
+                f = bw6_761_ate_mul_by_line(
+                    f, *prec_P[j], prec_Q[j]->precomp_1.coeffs[idx_1]);
+            }
         }
+        ++idx_2;
+        idx_1 += in_loop_1 ? 1 : 0;
 
-        // The code below gets executed for all bits (EXCEPT the MSB itself) of
-        // bw6_761_param_p (skipping leading zeros) in MSB to LSB
-        // order
-        c_1 = prec_Q_1.coeffs[idx_1];
-        ++idx_1;
-        f_1 = f_1.squared();
-        f_1 = f_1.mul_by_045(
-            c_1.ell_0, prec_P.PY * c_1.ell_VW, prec_P.PX * c_1.ell_VV);
-
-        if (NAF_1[i] != 0) {
-            c_1 = prec_Q_1.coeffs[idx_1];
+        if (naf_2[i] != 0) {
+            for (size_t j = 0; j < N; ++j) {
+                f = bw6_761_ate_mul_by_frobenius_line(
+                    f, prec_P_frobenius[j], prec_Q[j]->precomp_2.coeffs[idx_2]);
+            }
+            ++idx_2;
+        }
+
+        if (in_loop_1 && naf_1[i - offset] != 0) {
+            for (size_t j = 0; j < N; ++j) {
+                f = bw6_761_ate_mul_by_line(
+                    f, *prec_P[j], prec_Q[j]->precomp_1.coeffs[idx_1]);
+            }
             ++idx_1;
-            f_1 = f_1.mul_by_045(
-                c_1.ell_0, prec_P.PY * c_1.ell_VW, prec_P.PX * c_1.ell_VV);
         }
     }
 
-    // f_{u^3-u^2-u,Q}(P)
-    bw6_761_Fq6 f_2 = bw6_761_Fq6::one();
-
-    bool found_nonzero_2 = false;
-    size_t idx_2 = 0;
-
-    const bigint<bw6_761_Fq::num_limbs> &loop_count_2 = bw6_761_ate_loop_count2;
-    bw6_761_ate_ell_coeffs c_2;
+    return f;
+}
 
-    std::vector<long> NAF_2 = find_wnaf(1, loop_count_2);
-    for (long i = NAF_2.size() - 1; i >= 0; --i) {
-        if (!found_nonzero_2) {
-            // This skips the MSB itself
-            found_nonzero_2 |= (NAF_2[i] != 0);
-            continue;
-        }
+bw6_761_Fq6 bw6_761_ate_miller_loop(
+    const bw6_761_ate_G1_precomp &prec_P, const bw6_761_ate_G2_precomp &prec_Q)
+{
+    enter_block("Call to bw6_761_ate_miller_loop");
 
-        // The code below gets executed for all bits (EXCEPT the MSB itself) of
-        // bw6_761_param_p (skipping leading zeros) in MSB to LSB
-        // order
-        c_2 = prec_Q_2.coeffs[idx_2++];
-        f_2 = f_2.squared();
-        f_2 = f_2.mul_by_045(
-            c_2.ell_0, prec_P.PY * c_2.ell_VW, prec_P.PX * c_2.ell_VV);
-
-        if (NAF_2[i] != 0) {
-            c_2 = prec_Q_2.coeffs[idx_2++];
-            f_2 = f_2.mul_by_045(
-                c_2.ell_0, prec_P.PY * c_2.ell_VW, prec_P.PX * c_2.ell_VV);
-        }
-    }
+    const bw6_761_ate_G1_precomp *const prec_Ps[] = {&prec_P};
+    const bw6_761_ate_G2_precomp *const prec_Qs[] = {&prec_Q};
+    const bw6_761_Fq6 f = bw6_761_ate_combined_miller_loop(prec_Ps, prec_Qs);
 
     leave_block("Call to bw6_761_ate_miller_loop");
-
-    f_2 = f_2.Frobenius_map(1);
-
-    return f_1 * f_2;
+    return f;
 }
 
 bw6_761_Fq6 bw6_761_ate_double_miller_loop(
@@ -513,113 +537,12 @@ bw6_761_Fq6 bw6_761_ate_double_miller_loop(
 {
     enter_block("Call to bw6_761_ate_double_miller_loop");
 
-    const bw6_761_ate_G2_precomp_iteration &prec_Q1_1 = prec_Q1.precomp_1;
-    const bw6_761_ate_G2_precomp_iteration &prec_Q2_1 = prec_Q1.precomp_2;
-    const bw6_761_ate_G2_precomp_iteration &prec_Q1_2 = prec_Q2.precomp_1;
-    const bw6_761_ate_G2_precomp_iteration &prec_Q2_2 = prec_Q2.precomp_2;
-
-    // f_{u+1,Q}(P)
-    bw6_761_Fq6 f_1 = bw6_761_Fq6::one();
-
-    bool found_nonzero_1 = false;
-    size_t idx_1 = 0;
-
-    bw6_761_ate_ell_coeffs c_1_1;
-    bw6_761_ate_ell_coeffs c_1_2;
-
-    const bigint<bw6_761_Fq::num_limbs> &loop_count_1 = bw6_761_ate_loop_count1;
-    // Get the Non-Adjacent Form of the 1st loop count
-    std::vector<long> NAF_1 = find_wnaf(1, loop_count_1);
-    for (long i = NAF_1.size() - 1; i >= 0; --i) {
-        if (!found_nonzero_1) {
-            // This skips the MSB itself
-            found_nonzero_1 |= (NAF_1[i] != 0);
-            continue;
-        }
-
-        // The code below gets executed for all bits (EXCEPT the MSB itself) of
-        // bw6_761_param_p (skipping leading zeros) in MSB to LSB
-        // order
-        c_1_1 = prec_Q1_1.coeffs[idx_1];
-        c_1_2 = prec_Q1_2.coeffs[idx_1];
-        ++idx_1;
-
-        f_1 = f_1.squared();
-        f_1 = f_1.mul_by_045(
-            c_1_1.ell_0, prec_P1.PY * c_1_1.ell_VW, prec_P1.PX * c_1_1.ell_VV);
-        f_1 = f_1.mul_by_045(
-            c_1_2.ell_0, prec_P2.PY * c_1_2.ell_VW, prec_P2.PX * c_1_2.ell_VV);
-
-        if (NAF_1[i] != 0) {
-            c_1_1 = prec_Q1_1.coeffs[idx_1];
-            c_1_2 = prec_Q1_2.coeffs[idx_1];
-            ++idx_1;
-
-            f_1 = f_1.mul_by_045(
-                c_1_1.ell_0,
-                prec_P1.PY * c_1_1.ell_VW,
-                prec_P1.PX * c_1_1.ell_VV);
-            f_1 = f_1.mul_by_045(
-                c_1_2.ell_0,
-                prec_P2.PY * c_1_2.ell_VW,
-                prec_P2.PX * c_1_2.ell_VV);
-        }
-    }
-
-    // f_{u^3-u^2-u,Q}(P)
-    bw6_761_Fq6 f_2 = bw6_761_Fq6::one();
-
-    bool found_nonzero_2 = false;
-    size_t idx_2 = 0;
-
-    bw6_761_ate_ell_coeffs c_2_1;
-    bw6_761_ate_ell_coeffs c_2_2;
-
-    const bigint<bw6_761_Fq::num_limbs> &loop_count_2 = bw6_761_ate_loop_count2;
-    // Get the Non-Adjacent Form of the 1st loop count
-    std::vector<long> NAF_2 = find_wnaf(1, loop_count_2);
-    for (long i = NAF_2.size() - 1; i >= 0; --i) {
-        if (!found_nonzero_2) {
-            // This skips the MSB itself
-            found_nonzero_2 |= (NAF_2[i] != 0);
-            continue;
-        }
-
-        // The code below gets executed for all bits (EXCEPT the MSB itself) of
-        // bw6_761_param_p (skipping leading zeros) in MSB to LSB
-        // order
-        c_2_1 = prec_Q2_1.coeffs[idx_2];
-        c_2_2 = prec_Q2_2.coeffs[idx_2];
-        ++idx_2;
-
-        f_2 = f_2.squared();
-
-        f_2 = f_2.mul_by_045(
-            c_2_1.ell_0, prec_P1.PY * c_2_1.ell_VW, prec_P1.PX * c_2_1.ell_VV);
-        f_2 = f_2.mul_by_045(
-            c_2_2.ell_0, prec_P2.PY * c_2_2.ell_VW, prec_P2.PX * c_2_2.ell_VV);
-
-        if (NAF_2[i] != 0) {
-            c_2_1 = prec_Q2_1.coeffs[idx_2];
-            c_2_2 = prec_Q2_2.coeffs[idx_2];
-            ++idx_2;
-
-            f_2 = f_2.mul_by_045(
-                c_2_1.ell_0,
-                prec_P1.PY * c_2_1.ell_VW,
-                prec_P1.PX * c_2_1.ell_VV);
-            f_2 = f_2.mul_by_045(
-                c_2_2.ell_0,
-                prec_P2.PY * c_2_2.ell_VW,
-                prec_P2.PX * c_2_2.ell_VV);
-        }
-    }
+    const bw6_761_ate_G1_precomp *const prec_Ps[] = {&prec_P1, &prec_P2};
+    const bw6_761_ate_G2_precomp *const prec_Qs[] = {&prec_Q1, &prec_Q2};
+    const bw6_761_Fq6 f = bw6_761_ate_combined_miller_loop(prec_Ps, prec_Qs);
 
     leave_block("Call to bw6_761_ate_double_miller_loop");
-
-    f_2 = f_2.Frobenius_map(1);
-
-    return f_1 * f_2;
+    return f;
 }
 
 bw6_761_Fq6 bw6_761_ate_pairing(const bw6_761_G1 &P, const bw6_761_G2 &Q)
@@ -12,6 +12,7 @@
 #include "libff/algebra/serialization.hpp"
 
 #include <iostream>
+#include <vector>
 
 namespace libff
 {
@@ -22,6 +23,17 @@ void group_read(GroupT &v, std::istream &in_s);
 template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
 void group_write(const GroupT &v, std::ostream &out_s);
 
+/// Read v.size() consecutive group elements, as written by group_write or
+/// group_write_vector.
+template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
+void group_read_vector(std::vector<GroupT> &v, std::istream &in_s);
+
+/// Write all elements of v, producing the same output as calling group_write
+/// on each element in turn. Elements are converted to affine coordinates in a
+/// single batch (one field inversion for the whole vector) before encoding.
+template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
+void group_write_vector(const std::vector<GroupT> &v, std::ostream &out_s);
+
 } // namespace libff
 
 #include "libff/algebra/curves/curve_serialization.tcc"
@@ -23,7 +23,11 @@ namespace internal
 // combinations of parameters. Expected to define at least methods:
 //
 //   static void write(const GroupT &group_el, std::ostream &out_s);
+//   static void write_affine(const GroupT &affine_el, std::ostream &out_s);
 //   static void read(GroupT &group_el, std::istream &in_s);
+//
+// where write_affine requires its argument to already be in affine
+// coordinates (as produced by to_affine_coordinates).
 template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
 class group_element_codec;
 
@@ -36,6 +40,10 @@ public:
     {
         GroupT affine_p = group_el;
         affine_p.to_affine_coordinates();
+        write_affine(affine_p, out_s);
+    }
+    static void write_affine(const GroupT &affine_p, std::ostream &out_s)
+    {
         out_s << "[";
         field_write<encoding_json, Form>(affine_p.X, out_s);
         out_s << ",";
@@ -84,6 +92,10 @@ public:
     {
         GroupT affine_p = group_el;
         affine_p.to_affine_coordinates();
+        write_affine(affine_p, out_s);
+    }
+    static void write_affine(const GroupT &affine_p, std::ostream &out_s)
+    {
         field_write<encoding_binary, Form>(affine_p.X, out_s);
         field_write<encoding_binary, Form>(affine_p.Y, out_s);
     }
@@ -116,7 +128,14 @@ public:
         if (!group_el.is_zero()) {
             GroupT affine(group_el);
             affine.to_affine_coordinates();
-
+            write_affine(affine, out_s);
+        } else {
+            write_affine(group_el, out_s);
+        }
+    }
+    static void write_affine(const GroupT &affine, std::ostream &out_s)
+    {
+        if (!affine.is_zero()) {
             const mp_limb_t flags =
                 field_get_component_0(affine.Y).mont_repr.data[0] & 1;
             field_write_with_flags<encoding_binary, Form>(
@@ -124,7 +143,7 @@ public:
         } else {
             // Use Montgomery encoding, to avoid wasting time reducing.
             field_write_with_flags<encoding_binary, form_montgomery>(
-                group_el.X, 0x2, out_s);
+                affine.X, 0x2, out_s);
         }
     }
     static void read(GroupT &group_el, std::istream &in_s)
@@ -146,7 +165,7 @@ public:
             Fq x_squared = x * x;
             Fq x_cubed = x_squared * x;
             Fq y_squared = x_cubed + (GroupT::coeff_a * x) + GroupT::coeff_b;
-            if ((y_squared ^ Fq::euler) != Fq::one()) {
+            if (y_squared.is_zero() || !y_squared.is_square()) {
                 throw std::runtime_error("curve eqn has no solution at x");
             }
 #endif // #ifdef DEBUG
@@ -179,6 +198,42 @@ void group_write(const GroupT &v, std::ostream &out_s)
     internal::group_element_codec<Enc, Form, Comp, GroupT>::write(v, out_s);
 }
 
+template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
+void group_read_vector(std::vector<GroupT> &v, std::istream &in_s)
+{
+    using codec = internal::group_element_codec<Enc, Form, Comp, GroupT>;
+    for (GroupT &el : v) {
+        codec::read(el, in_s);
+    }
+}
+
+template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
+void group_write_vector(const std::vector<GroupT> &v, std::ostream &out_s)
+{
+    using codec = internal::group_element_codec<Enc, Form, Comp, GroupT>;
+
+    // Convert the non-zero elements to affine coordinates with a single
+    // batch inversion.
+    std::vector<GroupT> non_zero;
+    non_zero.reserve(v.size());
+    for (const GroupT &el : v) {
+        if (!el.is_zero()) {
+            non_zero.push_back(el);
+        }
+    }
+    GroupT::batch_to_special_all_non_zeros(non_zero);
+
+    auto it = non_zero.begin();
+    for (const GroupT &el : v) {
+        if (!el.is_zero()) {
+            codec::write_affine(*it, out_s);
+            ++it;
+        } else {
+            codec::write(el, out_s);
+        }
+    }
+}
+
 } // namespace libff
 
 #endif // __LIBFF_ALGEBRA_CURVES_CURVE_SERIALIZATION_TCC__
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <libff/algebra/curves/public_params.hpp>
 #include <libff/algebra/fields/bigint.hpp>
+#include <vector>
 
 namespace libff
 {
@@ -35,6 +36,14 @@ GroupT g1_curve_point_at_x(const typename GroupT::base_field &x);
 template<typename GroupT>
 GroupT g2_curve_point_at_x(const typename GroupT::twist_field &x);
 
+// Check whether all of the given points are in the safe subgroup (see
+// is_in_safe_subgroup), using multiple threads if MULTICORE is enabled. Each
+// point is checked individually: a random linear combination of the points
+// would not reliably detect components of small order, which the cofactors of
+// the supported curves have (e.g. 2 for BLS12-377, 3 for BLS12-381).
+template<typename GroupT>
+bool batch_is_in_safe_subgroup(const std::vector<GroupT> &points);
+
 } // namespace libff
 #include <libff/algebra/curves/curve_utils.tcc>
 
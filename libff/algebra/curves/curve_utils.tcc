@@ -52,9 +52,9 @@ GroupT g1_curve_point_at_x(const typename GroupT::base_field &x)
     const typename GroupT::base_field x_cubed = x_squared * x;
     const typename GroupT::base_field y_squared =
         x_cubed + (GroupT::coeff_a * x) + GroupT::coeff_b;
-    // Check that y_squared is a quadratic residue (ensuring that sqrt()
-    // terminates).
-    if ((y_squared ^ GroupT::base_field::euler) != GroupT::base_field::one()) {
+    // Check that y_squared is a nonzero quadratic residue (ensuring that
+    // sqrt() terminates).
+    if (y_squared.is_zero() || !y_squared.is_square()) {
         throw std::runtime_error("curve eqn has no solution at x");
     }
 
@@ -69,5 +69,21 @@ GroupT g2_curve_point_at_x(const typename GroupT::twist_field &x)
     return GroupT(x, curve_point_y_at_x<GroupT>(x), GroupT::twist_field::one());
 }
 
+template<typename GroupT>
+bool batch_is_in_safe_subgroup(const std::vector<GroupT> &points)
+{
+    bool result = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : result)
+#endif
+    for (size_t i = 0; i < points.size(); ++i) {
+        // Once a thread has found a point outside the subgroup, it skips the
+        // remaining checks.
+        result = result && points[i].is_in_safe_subgroup();
+    }
+
+    return result;
+}
+
 } // namespace libff
 #endif // CURVE_UTILS_TCC_
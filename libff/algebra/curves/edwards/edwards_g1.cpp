@@ -140,16 +140,18 @@ bool edwards_G1::operator!=(const edwards_G1 &other) const
 
 edwards_G1 edwards_G1::operator+(const edwards_G1 &other) const
 {
+    LIBFF_TRACE_ADD(*this, other);
+
     // handle special cases having to do with O
     if (this->is_zero()) {
-        return other;
+        return LIBFF_TRACE_RESULT(other);
     }
 
     if (other.is_zero()) {
-        return (*this);
+        return LIBFF_TRACE_RESULT(*this);
     }
 
-    return this->add(other);
+    return LIBFF_TRACE_RESULT(this->add(other));
 }
 
 edwards_G1 edwards_G1::operator-() const
@@ -164,6 +166,8 @@ edwards_G1 edwards_G1::operator-(const edwards_G1 &other) const
 
 edwards_G1 edwards_G1::add(const edwards_G1 &other) const
 {
+    LIBFF_TRACE_ADD(*this, other);
+
 #ifdef PROFILE_OP_COUNTS
     this->add_cnt++;
 #endif
@@ -191,21 +195,23 @@ edwards_G1 edwards_G1::add(const edwards_G1 &other) const
     // Z3 = A*H*I
     edwards_Fq Z3 = A * H * I;
 
-    return edwards_G1(X3, Y3, Z3);
+    return LIBFF_TRACE_RESULT(edwards_G1(X3, Y3, Z3));
 }
 
 edwards_G1 edwards_G1::mixed_add(const edwards_G1 &other) const
 {
+    LIBFF_TRACE_MIXED_ADD(*this, other);
+
 #ifdef PROFILE_OP_COUNTS
     this->add_cnt++;
 #endif
     // handle special cases having to do with O
     if (this->is_zero()) {
-        return other;
+        return LIBFF_TRACE_RESULT(other);
     }
 
     if (other.is_zero()) {
-        return *this;
+        return LIBFF_TRACE_RESULT(*this);
     }
 
 #ifdef DEBUG
@@ -236,16 +242,18 @@ edwards_G1 edwards_G1::mixed_add(const edwards_G1 &other) const
     // Z3 = A*H*I
     edwards_Fq Z3 = A * H * I;
 
-    return edwards_G1(X3, Y3, Z3);
+    return LIBFF_TRACE_RESULT(edwards_G1(X3, Y3, Z3));
 }
 
 edwards_G1 edwards_G1::dbl() const
 {
+    LIBFF_TRACE_DBL(*this);
+
 #ifdef PROFILE_OP_COUNTS
     this->dbl_cnt++;
 #endif
     if (this->is_zero()) {
-        return (*this);
+        return LIBFF_TRACE_RESULT(*this);
     } else {
         // NOTE: does not handle O and pts of order 2,4
         // http://www.hyperelliptic.org/EFD/g1p/auto-edwards-inverted.html#doubling-dbl-2007-bl
@@ -268,7 +276,7 @@ edwards_G1 edwards_G1::dbl() const
         // Z3 = D*E
         edwards_Fq Z3 = D * E;
 
-        return edwards_G1(X3, Y3, Z3);
+        return LIBFF_TRACE_RESULT(edwards_G1(X3, Y3, Z3));
     }
 }
 
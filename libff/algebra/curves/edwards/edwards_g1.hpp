@@ -9,6 +9,7 @@
 #define EDWARDS_G1_HPP_
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -88,6 +89,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<edwards_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(edwards_G1);
+
 template<mp_size_t m>
 edwards_G1 operator*(const bigint<m> &lhs, const edwards_G1 &rhs)
 {
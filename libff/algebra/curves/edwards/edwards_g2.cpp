@@ -185,16 +185,18 @@ bool edwards_G2::operator!=(const edwards_G2 &other) const
 
 edwards_G2 edwards_G2::operator+(const edwards_G2 &other) const
 {
+    LIBFF_TRACE_ADD(*this, other);
+
     // handle special cases having to do with O
     if (this->is_zero()) {
-        return other;
+        return LIBFF_TRACE_RESULT(other);
     }
 
     if (other.is_zero()) {
-        return (*this);
+        return LIBFF_TRACE_RESULT(*this);
     }
 
-    return this->add(other);
+    return LIBFF_TRACE_RESULT(this->add(other));
 }
 
 edwards_G2 edwards_G2::operator-() const
@@ -209,6 +211,8 @@ edwards_G2 edwards_G2::operator-(const edwards_G2 &other) const
 
 edwards_G2 edwards_G2::add(const edwards_G2 &other) const
 {
+    LIBFF_TRACE_ADD(*this, other);
+
 #ifdef PROFILE_OP_COUNTS
     this->add_cnt++;
 #endif
@@ -236,21 +240,23 @@ edwards_G2 edwards_G2::add(const edwards_G2 &other) const
     // Z3 = A*H*I
     const edwards_Fq3 Z3 = A * H * I;
 
-    return edwards_G2(X3, Y3, Z3);
+    return LIBFF_TRACE_RESULT(edwards_G2(X3, Y3, Z3));
 }
 
 edwards_G2 edwards_G2::mixed_add(const edwards_G2 &other) const
 {
+    LIBFF_TRACE_MIXED_ADD(*this, other);
+
 #ifdef PROFILE_OP_COUNTS
     this->add_cnt++;
 #endif
     // handle special cases having to do with O
     if (this->is_zero()) {
-        return other;
+        return LIBFF_TRACE_RESULT(other);
     }
 
     if (other.is_zero()) {
-        return *this;
+        return LIBFF_TRACE_RESULT(*this);
     }
 
 #ifdef DEBUG
@@ -281,16 +287,18 @@ edwards_G2 edwards_G2::mixed_add(const edwards_G2 &other) const
     // Z3 = A*H*I
     const edwards_Fq3 Z3 = A * H * I;
 
-    return edwards_G2(X3, Y3, Z3);
+    return LIBFF_TRACE_RESULT(edwards_G2(X3, Y3, Z3));
 }
 
 edwards_G2 edwards_G2::dbl() const
 {
+    LIBFF_TRACE_DBL(*this);
+
 #ifdef PROFILE_OP_COUNTS
     this->dbl_cnt++;
 #endif
     if (this->is_zero()) {
-        return (*this);
+        return LIBFF_TRACE_RESULT(*this);
     } else {
         // NOTE: does not handle O and pts of order 2,4
         // http://www.hyperelliptic.org/EFD/g1p/auto-twisted-inverted.html#doubling-dbl-2008-bbjlp
@@ -315,7 +323,7 @@ edwards_G2 edwards_G2::dbl() const
         // Z3 = D*E
         const edwards_Fq3 Z3 = D * E;
 
-        return edwards_G2(X3, Y3, Z3);
+        return LIBFF_TRACE_RESULT(edwards_G2(X3, Y3, Z3));
     }
 }
 
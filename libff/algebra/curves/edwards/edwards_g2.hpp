@@ -10,6 +10,7 @@
 #include <iostream>
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -95,6 +96,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<edwards_G2> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(edwards_G2);
+
 template<mp_size_t m>
 edwards_G2 operator*(const bigint<m> &lhs, const edwards_G2 &rhs)
 {
@@ -144,6 +144,7 @@ void init_edwards_params()
         edwards_Fq("5136291436651207728317994048073823738016144056504959939");
     edwards_Fq3::Frobenius_coeffs_c2[2] =
         edwards_Fq("1073752683758513276629212192812154536507607213288832061");
+    edwards_Fq3::static_init();
 
     /* parameters for Fq6 */
 
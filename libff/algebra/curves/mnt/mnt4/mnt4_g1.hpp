@@ -14,6 +14,7 @@
 
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_init.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -36,6 +37,7 @@ public:
     static mnt4_G1 G1_one;
     static mnt4_Fq coeff_a;
     static mnt4_Fq coeff_b;
+    static const bool coeff_a_is_zero = false;
 
     typedef mnt4_Fq base_field;
     typedef mnt4_Fr scalar_field;
@@ -59,6 +61,8 @@ public:
     {
     }
 
+    static mnt4_Fq mul_by_a(const mnt4_Fq &elt);
+
     void print() const;
     void print_coordinates() const;
 
@@ -102,6 +106,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<mnt4_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(mnt4_G1);
+
 template<mp_size_t m>
 mnt4_G1 operator*(const bigint<m> &lhs, const mnt4_G1 &rhs)
 {
@@ -14,6 +14,7 @@
 
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_init.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -37,6 +38,7 @@ public:
     static mnt4_Fq2 twist;
     static mnt4_Fq2 coeff_a;
     static mnt4_Fq2 coeff_b;
+    static const bool coeff_a_is_zero = false;
 
     typedef mnt4_Fq base_field;
     typedef mnt4_Fq2 twist_field;
@@ -102,6 +104,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<mnt4_G2> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(mnt4_G2);
+
 template<mp_size_t m>
 mnt4_G2 operator*(const bigint<m> &lhs, const mnt4_G2 &rhs)
 {
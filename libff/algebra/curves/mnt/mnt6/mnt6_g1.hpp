@@ -14,6 +14,7 @@
 
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_init.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -36,6 +37,7 @@ public:
     static mnt6_G1 G1_one;
     static mnt6_Fq coeff_a;
     static mnt6_Fq coeff_b;
+    static const bool coeff_a_is_zero = false;
 
     typedef mnt6_Fq base_field;
     typedef mnt6_Fr scalar_field;
@@ -59,6 +61,8 @@ public:
     {
     }
 
+    static mnt6_Fq mul_by_a(const mnt6_Fq &elt);
+
     void print() const;
     void print_coordinates() const;
 
@@ -105,6 +109,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<mnt6_G1> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(mnt6_G1);
+
 template<mp_size_t m>
 mnt6_G1 operator*(const bigint<m> &lhs, const mnt6_G1 &rhs)
 {
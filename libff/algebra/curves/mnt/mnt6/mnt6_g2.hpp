@@ -14,6 +14,7 @@
 
 #include <libff/algebra/curves/curve_utils.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_init.hpp>
+#include <libff/common/trace.hpp>
 #include <vector>
 
 namespace libff
@@ -37,6 +38,7 @@ public:
     static mnt6_Fq3 twist;
     static mnt6_Fq3 coeff_a;
     static mnt6_Fq3 coeff_b;
+    static const bool coeff_a_is_zero = false;
 
     typedef mnt6_Fq base_field;
     typedef mnt6_Fq3 twist_field;
@@ -107,6 +109,8 @@ public:
     static void batch_to_special_all_non_zeros(std::vector<mnt6_G2> &vec);
 };
 
+LIBFF_TRACE_DECLARE_TYPE(mnt6_G2);
+
 template<mp_size_t m>
 mnt6_G2 operator*(const bigint<m> &lhs, const mnt6_G2 &rhs)
 {
@@ -167,6 +167,7 @@ void init_mnt6_params()
     mnt6_Fq3::Frobenius_coeffs_c2[2] =
         mnt6_Fq("47173889896752102913304085131844916599730410872955897377007731"
                 "9830005517129946578866686956");
+    mnt6_Fq3::static_init();
 
     /* parameters for Fq6 */
     mnt6_Fq6::non_residue = mnt6_Fq("5");
@@ -0,0 +1,109 @@
+/** @file
+ *****************************************************************************
+
+ Randomized batch evaluation of pairing product equations, of the form
+
+     \prod_j e(P_j, Q_j) == 1
+
+ over the pairing-friendly curves defined via public_params.hpp, as used to
+ verify many proofs (e.g. Groth16) against one verification key.
+
+ Several equations are checked together by raising the k-th equation to a
+ random power r_k (with r_0 = 1) of pairing_batcher::scalar_bits bits, and
+ checking the product of the results. An invalid equation is detected
+ except with probability 2^-scalar_bits. Since e(P, Q)^r = e(r P, Q), the
+ random scalars are applied in G1.
+
+ The G2 element of each term is either:
+   - fixed: registered once with add_fixed_G2 (e.g. elements of a
+     verification key), and precomputed for the Miller loop. All terms
+     sharing a fixed G2 element, across all equations, are merged into a
+     single pair e(\sum_j r_j s_j P_j, Q) with one G1 multi-exponentiation.
+   - variable: given with each term (e.g. proof elements), and evaluated as
+     its own pair e(r P, Q).
+
+ The resulting pairs (skipping those with a zero element) are evaluated with
+ a single final exponentiation, and a single Miller loop shared by all pairs
+ for curves providing ppT::multi_miller_loop (currently BLS12-381). Other
+ curves use ppT::double_miller_loop, two pairs at a time, in parallel when
+ MULTICORE is enabled (as are the variable-term scalar multiplications).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PAIRING_BATCHER_HPP_
+#define PAIRING_BATCHER_HPP_
+
+#include "libff/algebra/curves/public_params.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace libff
+{
+
+/// Method used for the multi-exponentiations of fixed G2 terms.
+static const multi_exp_method PAIRING_BATCHER_MULTI_EXP_METHOD =
+    multi_exp_method_auto;
+
+template<typename ppT> class pairing_batcher
+{
+public:
+    /// Size of the random scalar applied to each equation after the first.
+    const size_t scalar_bits;
+
+    /// Throws std::invalid_argument if scalar_bits is zero, or not smaller
+    /// than the size of Fr<ppT>.
+    explicit pairing_batcher(const size_t scalar_bits = 128);
+
+    /// Register a fixed G2 element, returning its index for use with
+    /// add_term.
+    size_t add_fixed_G2(const G2<ppT> &Q);
+
+    /// Start a new equation. Terms added before the first call belong to
+    /// the first equation.
+    void begin_equation();
+
+    /// Add the term e(scalar * P, Q) to the current equation, where Q is the
+    /// fixed G2 element with the given index. Throws std::invalid_argument
+    /// if there is no such element.
+    void add_term(
+        const G1<ppT> &P,
+        const size_t fixed_Q_index,
+        const Fr<ppT> &scalar = Fr<ppT>::one());
+
+    /// Add the term e(P, Q) to the current equation.
+    void add_term(const G1<ppT> &P, const G2<ppT> &Q);
+
+    /// The number of pairs evaluated by verify (before skipping zeros).
+    size_t num_pairs() const;
+
+    /// Check that all equations hold (with the given number of chunks for
+    /// each multi-exponentiation). Returns true if there are no equations.
+    bool verify(const size_t chunks = 1) const;
+
+    /// Remove all equations, keeping the fixed G2 elements.
+    void clear();
+
+private:
+    std::vector<G2_precomp<ppT>> _fixed_Q_precomp;
+    std::vector<std::vector<G1<ppT>>> _fixed_bases;
+    std::vector<std::vector<Fr<ppT>>> _fixed_scalars;
+
+    std::vector<G1<ppT>> _variable_P;
+    std::vector<Fr<ppT>> _variable_scalars;
+    std::vector<G2<ppT>> _variable_Q;
+
+    Fr<ppT> _equation_scalar;
+    size_t _num_equations;
+};
+
+} // namespace libff
+
+#include "libff/algebra/curves/pairing_batcher.tcc"
+
+#endif // PAIRING_BATCHER_HPP_
@@ -0,0 +1,235 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of pairing_batcher.
+
+ See pairing_batcher.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PAIRING_BATCHER_TCC_
+#define PAIRING_BATCHER_TCC_
+
+#include "libff/algebra/curves/pairing_batcher.hpp"
+#include "libff/algebra/fields/field_utils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Detects ppT::multi_miller_loop, which evaluates the Miller loops of any
+/// number of pairs as a single loop.
+template<typename ppT, typename = void>
+class has_multi_miller_loop : public std::false_type
+{
+};
+
+template<typename ppT>
+class has_multi_miller_loop<ppT, decltype((void)&ppT::multi_miller_loop)>
+    : public std::true_type
+{
+};
+
+/// The product of the Miller loops of the pairs (prec_P[k], *prec_Q[k]),
+/// as a single multi-Miller loop.
+template<typename ppT>
+Fqk<ppT> pairing_batcher_miller_loop(
+    const std::vector<G1_precomp<ppT>> &prec_P,
+    const std::vector<const G2_precomp<ppT> *> &prec_Q,
+    std::true_type)
+{
+    return ppT::multi_miller_loop(prec_P, prec_Q);
+}
+
+/// The product of the Miller loops of the pairs (prec_P[k], *prec_Q[k]),
+/// for curves without a multi-Miller loop: evaluated with
+/// ppT::double_miller_loop, two pairs at a time (in parallel).
+template<typename ppT>
+Fqk<ppT> pairing_batcher_miller_loop(
+    const std::vector<G1_precomp<ppT>> &prec_P,
+    const std::vector<const G2_precomp<ppT> *> &prec_Q,
+    std::false_type)
+{
+    const size_t num_loops = (prec_P.size() + 1) / 2;
+    std::vector<Fqk<ppT>> loops(num_loops);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t k = 0; k < num_loops; ++k) {
+        loops[k] = (2 * k + 1 < prec_P.size())
+                       ? ppT::double_miller_loop(
+                             prec_P[2 * k],
+                             *prec_Q[2 * k],
+                             prec_P[2 * k + 1],
+                             *prec_Q[2 * k + 1])
+                       : ppT::miller_loop(prec_P[2 * k], *prec_Q[2 * k]);
+    }
+
+    Fqk<ppT> f = Fqk<ppT>::one();
+    for (const Fqk<ppT> &loop : loops) {
+        f = f * loop;
+    }
+    return f;
+}
+
+} // namespace internal
+
+template<typename ppT>
+pairing_batcher<ppT>::pairing_batcher(const size_t scalar_bits)
+    : scalar_bits(scalar_bits)
+    , _equation_scalar(Fr<ppT>::one())
+    , _num_equations(0)
+{
+    if (scalar_bits == 0 || scalar_bits >= Fr<ppT>::size_in_bits()) {
+        throw std::invalid_argument(
+            "libff::pairing_batcher: invalid scalar_bits");
+    }
+}
+
+template<typename ppT>
+size_t pairing_batcher<ppT>::add_fixed_G2(const G2<ppT> &Q)
+{
+    _fixed_Q_precomp.push_back(ppT::precompute_G2(Q));
+    _fixed_bases.emplace_back();
+    _fixed_scalars.emplace_back();
+    return _fixed_Q_precomp.size() - 1;
+}
+
+template<typename ppT> void pairing_batcher<ppT>::begin_equation()
+{
+    _equation_scalar =
+        (_num_equations == 0)
+            ? Fr<ppT>::one()
+            : random_field_element_bits<Fr<ppT>>(scalar_bits);
+    ++_num_equations;
+}
+
+template<typename ppT>
+void pairing_batcher<ppT>::add_term(
+    const G1<ppT> &P, const size_t fixed_Q_index, const Fr<ppT> &scalar)
+{
+    if (fixed_Q_index >= _fixed_Q_precomp.size()) {
+        throw std::invalid_argument(
+            "libff::pairing_batcher::add_term: invalid fixed G2 index");
+    }
+    if (_num_equations == 0) {
+        begin_equation();
+    }
+
+    _fixed_bases[fixed_Q_index].push_back(P);
+    _fixed_scalars[fixed_Q_index].push_back(_equation_scalar * scalar);
+}
+
+template<typename ppT>
+void pairing_batcher<ppT>::add_term(const G1<ppT> &P, const G2<ppT> &Q)
+{
+    if (_num_equations == 0) {
+        begin_equation();
+    }
+
+    _variable_P.push_back(P);
+    _variable_scalars.push_back(_equation_scalar);
+    _variable_Q.push_back(Q);
+}
+
+template<typename ppT> size_t pairing_batcher<ppT>::num_pairs() const
+{
+    size_t result = _variable_P.size();
+    for (const std::vector<G1<ppT>> &bases : _fixed_bases) {
+        result += bases.empty() ? 0 : 1;
+    }
+    return result;
+}
+
+template<typename ppT>
+bool pairing_batcher<ppT>::verify(const size_t chunks) const
+{
+    // Compute the G1 element of each pair.
+    const size_t num_fixed = _fixed_Q_precomp.size();
+    const size_t num_variable = _variable_P.size();
+    std::vector<G1<ppT>> P(num_fixed + num_variable);
+    for (size_t i = 0; i < num_fixed; ++i) {
+        P[i] = _fixed_bases[i].empty()
+                   ? G1<ppT>::zero()
+                   : multi_exp<
+                         G1<ppT>,
+                         Fr<ppT>,
+                         PAIRING_BATCHER_MULTI_EXP_METHOD>(
+                         _fixed_bases[i].begin(),
+                         _fixed_bases[i].end(),
+                         _fixed_scalars[i].begin(),
+                         _fixed_scalars[i].end(),
+                         chunks);
+    }
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_variable; ++i) {
+        P[num_fixed + i] = _variable_scalars[i] * _variable_P[i];
+    }
+
+    // Indices of the non-trivial pairs, where index i < num_fixed refers to
+    // the i-th fixed element, and index num_fixed + j to the j-th variable
+    // term.
+    std::vector<size_t> pairs;
+    for (size_t i = 0; i < P.size(); ++i) {
+        if (!P[i].is_zero() &&
+            (i < num_fixed || !_variable_Q[i - num_fixed].is_zero())) {
+            pairs.push_back(i);
+        }
+    }
+    if (pairs.empty()) {
+        return true;
+    }
+
+    // Precompute the pairs. Fixed G2 elements are precomputed once, and
+    // referenced rather than copied.
+    std::vector<G1_precomp<ppT>> prec_P(pairs.size());
+    std::vector<G2_precomp<ppT>> variable_prec_Q(num_variable);
+    std::vector<const G2_precomp<ppT> *> prec_Q(pairs.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        const size_t i = pairs[k];
+        prec_P[k] = ppT::precompute_G1(P[i]);
+        if (i < num_fixed) {
+            prec_Q[k] = &_fixed_Q_precomp[i];
+        } else {
+            variable_prec_Q[i - num_fixed] =
+                ppT::precompute_G2(_variable_Q[i - num_fixed]);
+            prec_Q[k] = &variable_prec_Q[i - num_fixed];
+        }
+    }
+
+    const Fqk<ppT> f = internal::pairing_batcher_miller_loop<ppT>(
+        prec_P, prec_Q, internal::has_multi_miller_loop<ppT>());
+    return ppT::final_exponentiation(f) == GT<ppT>::one();
+}
+
+template<typename ppT> void pairing_batcher<ppT>::clear()
+{
+    for (size_t i = 0; i < _fixed_bases.size(); ++i) {
+        _fixed_bases[i].clear();
+        _fixed_scalars[i].clear();
+    }
+    _variable_P.clear();
+    _variable_scalars.clear();
+    _variable_Q.clear();
+    _equation_scalar = Fr<ppT>::one();
+    _num_equations = 0;
+}
+
+} // namespace libff
+
+#endif // PAIRING_BATCHER_TCC_
@@ -0,0 +1,411 @@
+/** @file
+ *****************************************************************************
+
+ Measure encode and decode throughput of field and group elements, for every
+ supported combination of encoding_t, form_t and compression_t, using both
+ single-element and bulk (vector) APIs, sequentially and in parallel.
+
+ Only group encoding has a bulk path that differs from the single-element
+ API (group_write_vector batches the conversion to affine coordinates).
+ group_read_vector decodes element by element, so bulk rows report encode
+ throughput only.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/curve_serialization.hpp"
+#include "libff/algebra/fields/field_serialization.hpp"
+#include "libff/common/profiling.hpp"
+
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <thread>
+
+using namespace libff;
+
+/// Number of random elements to generate (since this process is expensive).
+/// These are repeated to fill the input vector.
+static const size_t NUM_DIFFERENT_ELEMENTS = 1024;
+
+/// Default number of elements to encode / decode in a single measurement.
+static const size_t DEFAULT_NUM_ELEMENTS = 64 * 1024;
+
+template<encoding_t Enc, form_t Form, compression_t Comp>
+std::string config_name()
+{
+    return std::string((Enc == encoding_binary) ? "binary" : "json") + "/" +
+           ((Form == form_plain) ? "plain" : "montgomery") + "/" +
+           ((Comp == compression_on) ? "compressed" : "uncompressed");
+}
+
+/// Adapts the group element serialization functions to a common interface.
+template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
+class group_profile_codec
+{
+public:
+    static const bool has_bulk_api = true;
+
+    static std::string name() { return config_name<Enc, Form, Comp>(); }
+    static void write(const GroupT &v, std::ostream &out_s)
+    {
+        group_write<Enc, Form, Comp>(v, out_s);
+    }
+    static void read(GroupT &v, std::istream &in_s)
+    {
+        group_read<Enc, Form, Comp>(v, in_s);
+    }
+    static void write_vector(const std::vector<GroupT> &v, std::ostream &out_s)
+    {
+        group_write_vector<Enc, Form, Comp>(v, out_s);
+    }
+};
+
+/// Adapts the field element serialization functions to a common interface.
+/// Field elements have no bulk API (encoding is independent per element), so
+/// only the single-element API is profiled.
+template<encoding_t Enc, form_t Form, typename FieldT>
+class field_profile_codec
+{
+public:
+    static const bool has_bulk_api = false;
+
+    static std::string name()
+    {
+        return config_name<Enc, Form, compression_off>();
+    }
+    static void write(const FieldT &v, std::ostream &out_s)
+    {
+        field_write<Enc, Form>(v, out_s);
+    }
+    static void read(FieldT &v, std::istream &in_s)
+    {
+        field_read<Enc, Form>(v, in_s);
+    }
+    static void write_vector(const std::vector<FieldT> &, std::ostream &)
+    {
+        throw std::runtime_error("no bulk api for field elements");
+    }
+};
+
+template<typename T>
+std::vector<T> generate_elements(const size_t num_elements)
+{
+    std::vector<T> elements;
+    elements.reserve(num_elements);
+    size_t i = 0;
+    for (; i < std::min(num_elements, NUM_DIFFERENT_ELEMENTS); ++i) {
+        elements.push_back(T::random_element());
+    }
+    for (; i < num_elements; ++i) {
+        elements.push_back(elements[i % NUM_DIFFERENT_ELEMENTS]);
+    }
+
+    return elements;
+}
+
+/// Split elements into num_chunks contiguous vectors of (almost) equal size.
+template<typename T>
+std::vector<std::vector<T>> split_elements(
+    const std::vector<T> &elements, const size_t num_chunks)
+{
+    std::vector<std::vector<T>> chunks(num_chunks);
+    const size_t one = elements.size() / num_chunks;
+    for (size_t i = 0; i < num_chunks; ++i) {
+        const size_t begin = i * one;
+        const size_t end =
+            (i == num_chunks - 1) ? elements.size() : (begin + one);
+        chunks[i].assign(elements.begin() + begin, elements.begin() + end);
+    }
+
+    return chunks;
+}
+
+void print_header()
+{
+    printf(
+        "  %-14s %-30s %-6s %-7s %9s %12s %14s %12s %14s\n",
+        "element",
+        "config",
+        "api",
+        "threads",
+        "bytes/el",
+        "enc MB/s",
+        "enc el/s",
+        "dec MB/s",
+        "dec el/s");
+}
+
+/// Decode throughput is omitted for the bulk api, which decodes with the
+/// single-element api.
+void print_result(
+    const std::string &tag,
+    const std::string &config,
+    const bool bulk,
+    const size_t num_chunks,
+    const size_t num_elements,
+    const size_t num_bytes,
+    const long long encode_nsec,
+    const long long decode_nsec)
+{
+    const double encode_sec = encode_nsec * 1e-9;
+    const double decode_sec = decode_nsec * 1e-9;
+    printf(
+        "  %-14s %-30s %-6s %7zu %9.1f %12.2f %14.0f",
+        tag.c_str(),
+        config.c_str(),
+        bulk ? "bulk" : "single",
+        num_chunks,
+        (double)num_bytes / num_elements,
+        num_bytes * 1e-6 / encode_sec,
+        num_elements / encode_sec);
+    if (bulk) {
+        printf(" %12s %14s\n", "-", "-");
+    } else {
+        printf(
+            " %12.2f %14.0f\n",
+            num_bytes * 1e-6 / decode_sec,
+            num_elements / decode_sec);
+    }
+    fflush(stdout);
+}
+
+/// Encode all chunks (in parallel, one chunk per iteration), then decode the
+/// resulting buffers (always with the single-element api) and check the
+/// decoded values against the originals.
+template<typename Codec, typename T>
+void profile_codec_run(
+    const std::string &tag,
+    const std::vector<std::vector<T>> &chunks,
+    const size_t num_elements,
+    const bool bulk)
+{
+    const size_t num_chunks = chunks.size();
+    std::vector<std::string> buffers(num_chunks);
+    std::vector<std::vector<T>> decoded(num_chunks);
+    for (size_t i = 0; i < num_chunks; ++i) {
+        decoded[i].resize(chunks[i].size());
+    }
+
+    const long long encode_start = get_nsec_time();
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i) {
+        std::ostringstream out_s;
+        if (bulk) {
+            Codec::write_vector(chunks[i], out_s);
+        } else {
+            for (const T &el : chunks[i]) {
+                Codec::write(el, out_s);
+            }
+        }
+        buffers[i] = out_s.str();
+    }
+    const long long encode_nsec = get_nsec_time() - encode_start;
+
+    const long long decode_start = get_nsec_time();
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i) {
+        std::istringstream in_s(buffers[i]);
+        for (T &el : decoded[i]) {
+            Codec::read(el, in_s);
+        }
+    }
+    const long long decode_nsec = get_nsec_time() - decode_start;
+
+    size_t num_bytes = 0;
+    for (size_t i = 0; i < num_chunks; ++i) {
+        num_bytes += buffers[i].size();
+        if (decoded[i] != chunks[i]) {
+            throw std::runtime_error(
+                "decoded values do not match (" + tag + ", " + Codec::name() +
+                ")");
+        }
+    }
+
+    print_result(
+        tag,
+        Codec::name(),
+        bulk,
+        num_chunks,
+        num_elements,
+        num_bytes,
+        encode_nsec,
+        decode_nsec);
+}
+
+template<typename Codec, typename T>
+void profile_codec(
+    const std::string &tag,
+    const std::vector<T> &elements,
+    const size_t num_threads)
+{
+    const std::vector<std::vector<T>> sequential = split_elements(elements, 1);
+    const std::vector<std::vector<T>> parallel =
+        split_elements(elements, num_threads);
+
+    profile_codec_run<Codec>(tag, sequential, elements.size(), false);
+    if (num_threads > 1) {
+        profile_codec_run<Codec>(tag, parallel, elements.size(), false);
+    }
+
+    if (Codec::has_bulk_api) {
+        profile_codec_run<Codec>(tag, sequential, elements.size(), true);
+        if (num_threads > 1) {
+            profile_codec_run<Codec>(tag, parallel, elements.size(), true);
+        }
+    }
+}
+
+template<typename FieldT>
+void profile_field_serialization(
+    const std::string &tag,
+    const size_t num_elements,
+    const size_t num_threads)
+{
+    const std::vector<FieldT> elements =
+        generate_elements<FieldT>(num_elements);
+
+    profile_codec<field_profile_codec<encoding_binary, form_plain, FieldT>>(
+        tag, elements, num_threads);
+    profile_codec<
+        field_profile_codec<encoding_binary, form_montgomery, FieldT>>(
+        tag, elements, num_threads);
+    profile_codec<field_profile_codec<encoding_json, form_plain, FieldT>>(
+        tag, elements, num_threads);
+    profile_codec<field_profile_codec<encoding_json, form_montgomery, FieldT>>(
+        tag, elements, num_threads);
+}
+
+template<typename GroupT>
+void profile_group_serialization(
+    const std::string &tag,
+    const size_t num_elements,
+    const size_t num_threads)
+{
+    const std::vector<GroupT> elements =
+        generate_elements<GroupT>(num_elements);
+
+    // Json encoding supports only compression_off.
+    profile_codec<group_profile_codec<
+        encoding_binary,
+        form_plain,
+        compression_off,
+        GroupT>>(tag, elements, num_threads);
+    profile_codec<group_profile_codec<
+        encoding_binary,
+        form_plain,
+        compression_on,
+        GroupT>>(tag, elements, num_threads);
+    profile_codec<group_profile_codec<
+        encoding_binary,
+        form_montgomery,
+        compression_off,
+        GroupT>>(tag, elements, num_threads);
+    profile_codec<group_profile_codec<
+        encoding_binary,
+        form_montgomery,
+        compression_on,
+        GroupT>>(tag, elements, num_threads);
+    profile_codec<group_profile_codec<
+        encoding_json,
+        form_plain,
+        compression_off,
+        GroupT>>(tag, elements, num_threads);
+    profile_codec<group_profile_codec<
+        encoding_json,
+        form_montgomery,
+        compression_off,
+        GroupT>>(tag, elements, num_threads);
+}
+
+template<typename ppT>
+void profile_curve_serialization(
+    const std::string &curve,
+    const size_t num_elements,
+    const size_t num_threads)
+{
+    std::cout << curve << " (" << num_elements << " elements)\n";
+    print_header();
+    profile_field_serialization<Fr<ppT>>(
+        curve + "_Fr", num_elements, num_threads);
+    profile_field_serialization<Fq<ppT>>(
+        curve + "_Fq", num_elements, num_threads);
+    profile_group_serialization<G1<ppT>>(
+        curve + "_G1", num_elements, num_threads);
+    profile_group_serialization<G2<ppT>>(
+        curve + "_G2", num_elements, num_threads);
+}
+
+void usage(const char *const argv0)
+{
+    std::cout << "Usage: " << argv0 << " [flags]\n"
+              << "\n"
+              << "Flags:\n"
+              << "  --num-elements <n>    Number of elements to encode / "
+                 "decode (default "
+              << DEFAULT_NUM_ELEMENTS << ")\n"
+              << "  --threads <n>         Number of chunks processed in "
+                 "parallel (default: hardware concurrency)\n"
+              << "  --curve <curve>       One of alt_bn128, bls12_377, "
+                 "bls12_381 or all (default \"all\")\n";
+}
+
+int main(const int argc, char const *const *const argv)
+{
+    size_t num_elements = DEFAULT_NUM_ELEMENTS;
+    size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string curve = "all";
+
+    for (size_t i = 1; i < (size_t)argc; ++i) {
+        const char *const arg = argv[i];
+        if (!strcmp(arg, "--num-elements") && i + 1 < (size_t)argc) {
+            num_elements = std::stoul(std::string(argv[++i]));
+        } else if (!strcmp(arg, "--threads") && i + 1 < (size_t)argc) {
+            num_threads = std::stoul(std::string(argv[++i]));
+        } else if (!strcmp(arg, "--curve") && i + 1 < (size_t)argc) {
+            curve = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (num_elements == 0 || num_threads == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // The profiling output from the library (e.g. batch conversion to affine
+    // form) would otherwise be interleaved with the results.
+    inhibit_profiling_info = true;
+
+    if (curve == "all" || curve == "alt_bn128") {
+        alt_bn128_pp::init_public_params();
+        profile_curve_serialization<alt_bn128_pp>(
+            "alt_bn128", num_elements, num_threads);
+    }
+
+    if (curve == "all" || curve == "bls12_377") {
+        bls12_377_pp::init_public_params();
+        profile_curve_serialization<bls12_377_pp>(
+            "bls12_377", num_elements, num_threads);
+    }
+
+    if (curve == "all" || curve == "bls12_381") {
+        bls12_381_pp::init_public_params();
+        profile_curve_serialization<bls12_381_pp>(
+            "bls12_381", num_elements, num_threads);
+    }
+
+    return 0;
+}
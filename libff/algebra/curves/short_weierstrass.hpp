@@ -0,0 +1,147 @@
+/** @file
+ *****************************************************************************
+
+ The group law of short Weierstrass curves y^2 = x^3 + a x + b, implemented
+ once for each coordinate system (see
+ https://www.hyperelliptic.org/EFD/g1p/auto-shortw.html):
+
+ - sw_jacobian: (X, Y, Z) represents (X / Z^2, Y / Z^3).
+ - sw_projective: (X, Y, Z) represents (X / Z, Y / Z).
+ - sw_xyzz: (X, Y, ZZ, ZZZ) represents (X / ZZ, Y / ZZZ), where
+   ZZ^3 = ZZZ^2 (see xyzz_point.hpp).
+ - sw_affine: points in special form, i.e. (X, Y, 1) or zero, using a field
+   inversion per operation (or one per batch, with batch_add).
+
+ Each coordinate system is a class of static functions, parameterized by the
+ point type PointT, which holds the coordinates as public members (X, Y, Z,
+ or X, Y, ZZ, ZZZ), and also provides the base field (the type of X) and the
+ curve constants:
+
+   static const bool coeff_a_is_zero;
+   static FieldT coeff_a, coeff_b;
+   // Only used if coeff_a_is_zero is false.
+   static FieldT mul_by_a(const FieldT &elt);
+
+ The a = 0 formulas are selected at compile time from coeff_a_is_zero. The
+ curve groups (alt_bn128_G1, bls12_381_G2, mnt4_G1, ...) keep their own
+ interface, serialization and curve-specific maps, and implement their group
+ law with these functions. Zero is represented as (0 : 1 : 0) in Jacobian
+ and projective coordinates, and points of order 2 are not supported (they
+ cannot exist in the prime-order subgroups).
+
+ If PROFILE_OP_COUNTS is defined, additions and doublings are counted in
+ PointT::add_cnt and PointT::dbl_cnt. Doublings are computed by PointT::dbl(),
+ so that they are counted and traced by the point type.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef SHORT_WEIERSTRASS_HPP_
+#define SHORT_WEIERSTRASS_HPP_
+
+#include <type_traits>
+#include <vector>
+
+namespace libff
+{
+
+/// Jacobian coordinates, with the formulas add-2007-bl, madd-2007-bl and
+/// dbl-2009-l (or dbl-2007-bl if a is not zero).
+template<typename PointT> class sw_jacobian
+{
+public:
+    using field_type =
+        typename std::decay<decltype(((PointT *)nullptr)->X)>::type;
+
+    static bool is_zero(const PointT &P);
+    static bool equal(const PointT &P, const PointT &Q);
+    static PointT add(const PointT &P, const PointT &Q);
+    /// Add Q, which must be in special form.
+    static PointT mixed_add(const PointT &P, const PointT &Q);
+    static PointT dbl(const PointT &P);
+    static bool is_well_formed(const PointT &P);
+    static void to_affine_coordinates(PointT &P);
+    /// Convert all elements of vec, none of which may be zero, to special
+    /// form, using a single field inversion.
+    static void batch_to_affine_coordinates(std::vector<PointT> &vec);
+
+protected:
+    static PointT dbl(const PointT &P, std::true_type coeff_a_is_zero);
+    static PointT dbl(const PointT &P, std::false_type coeff_a_is_zero);
+};
+
+/// Projective coordinates, with the formulas add-1998-cmo-2, madd-1998-cmo
+/// and dbl-2007-bl.
+template<typename PointT> class sw_projective
+{
+public:
+    using field_type =
+        typename std::decay<decltype(((PointT *)nullptr)->X)>::type;
+
+    static bool is_zero(const PointT &P);
+    static bool equal(const PointT &P, const PointT &Q);
+    static PointT add(const PointT &P, const PointT &Q);
+    /// Add Q, which must be in special form.
+    static PointT mixed_add(const PointT &P, const PointT &Q);
+    static PointT dbl(const PointT &P);
+    static bool is_well_formed(const PointT &P);
+    static void to_affine_coordinates(PointT &P);
+    /// Convert all elements of vec, none of which may be zero, to special
+    /// form, using a single field inversion.
+    static void batch_to_affine_coordinates(std::vector<PointT> &vec);
+};
+
+/// Extended Jacobian (XYZZ) coordinates, with the formulas add-2008-s,
+/// madd-2008-s, dbl-2008-s-1 and mdbl-2008-s-1. PointT holds the coordinates
+/// X, Y, ZZ and ZZZ, and GroupT (any of the above) provides the curve
+/// constants and the points in special form added by mixed_add.
+template<typename PointT, typename GroupT> class sw_xyzz
+{
+public:
+    using field_type =
+        typename std::decay<decltype(((PointT *)nullptr)->X)>::type;
+
+    static bool is_zero(const PointT &P);
+    static bool equal(const PointT &P, const PointT &Q);
+    /// Unlike the other coordinate systems, the doubling and inverse cases
+    /// are detected from intermediate values, at no extra cost.
+    static PointT add(const PointT &P, const PointT &Q);
+    /// Add Q, which must be in special form.
+    static PointT mixed_add(const PointT &P, const GroupT &Q);
+    static PointT dbl(const PointT &P);
+    /// Convert to an element of GroupT in special form.
+    static GroupT to_affine(const PointT &P);
+
+protected:
+    /// Double the affine point (x, y).
+    static PointT dbl_affine(const field_type &x, const field_type &y);
+};
+
+/// Affine coordinates: PointT in special form. Each operation requires a
+/// field inversion, except in batch_add, which shares one inversion over
+/// many additions. This is faster than the other coordinate systems for
+/// large batches of independent additions.
+template<typename PointT> class sw_affine
+{
+public:
+    using field_type =
+        typename std::decay<decltype(((PointT *)nullptr)->X)>::type;
+
+    static bool equal(const PointT &P, const PointT &Q);
+    static PointT add(const PointT &P, const PointT &Q);
+    static PointT dbl(const PointT &P);
+    static bool is_well_formed(const PointT &P);
+
+    /// Set P[i] = P[i] + Q[i] for all i (in special form), using a single
+    /// field inversion. P and Q must have the same size.
+    static void batch_add(std::vector<PointT> &P, const std::vector<PointT> &Q);
+};
+
+} // namespace libff
+
+#include <libff/algebra/curves/short_weierstrass.tcc>
+
+#endif // SHORT_WEIERSTRASS_HPP_
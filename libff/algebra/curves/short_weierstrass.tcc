@@ -0,0 +1,684 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the short Weierstrass group law.
+
+ See short_weierstrass.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef SHORT_WEIERSTRASS_TCC_
+#define SHORT_WEIERSTRASS_TCC_
+
+#include <cassert>
+#include <libff/algebra/fields/field_utils.hpp>
+
+namespace libff
+{
+
+namespace internal
+{
+
+template<typename CurveT>
+using sw_coeff_a_is_zero =
+    std::integral_constant<bool, CurveT::coeff_a_is_zero>;
+
+/// x + a
+template<typename CurveT, typename FieldT>
+FieldT sw_add_a(const FieldT &x, std::true_type) { return x; }
+
+template<typename CurveT, typename FieldT>
+FieldT sw_add_a(const FieldT &x, std::false_type)
+{
+    return x + CurveT::coeff_a;
+}
+
+/// x + a w^2
+template<typename CurveT, typename FieldT>
+FieldT sw_add_a_ww(const FieldT &x, const FieldT &, std::true_type)
+{
+    return x;
+}
+
+template<typename CurveT, typename FieldT>
+FieldT sw_add_a_ww(const FieldT &x, const FieldT &w, std::false_type)
+{
+    return CurveT::mul_by_a(w.squared()) + x;
+}
+
+} // namespace internal
+
+template<typename PointT> bool sw_jacobian<PointT>::is_zero(const PointT &P)
+{
+    return P.Z.is_zero();
+}
+
+template<typename PointT>
+bool sw_jacobian<PointT>::equal(const PointT &P, const PointT &Q)
+{
+    if (is_zero(P)) {
+        return is_zero(Q);
+    }
+
+    if (is_zero(Q)) {
+        return false;
+    }
+
+    // (X1:Y1:Z1) = (X2:Y2:Z2)
+    //   iff
+    // X1 * Z2^2 == X2 * Z1^2 and Y1 * Z2^3 == Y2 * Z1^3
+    const field_type Z1Z1 = P.Z.squared();
+    const field_type Z2Z2 = Q.Z.squared();
+    if ((P.X * Z2Z2) != (Q.X * Z1Z1)) {
+        return false;
+    }
+
+    return (P.Y * (Q.Z * Z2Z2)) == (Q.Y * (P.Z * Z1Z1));
+}
+
+template<typename PointT>
+PointT sw_jacobian<PointT>::add(const PointT &P, const PointT &Q)
+{
+    if (is_zero(P)) {
+        return Q;
+    }
+
+    if (is_zero(Q)) {
+        return P;
+    }
+
+    // The doubling check reuses the values computed for the addition.
+    const field_type Z1Z1 = P.Z.squared();
+    const field_type Z2Z2 = Q.Z.squared();
+    const field_type U1 = P.X * Z2Z2;
+    const field_type U2 = Q.X * Z1Z1;
+    const field_type S1 = P.Y * (Q.Z * Z2Z2);
+    const field_type S2 = Q.Y * (P.Z * Z1Z1);
+    if (U1 == U2 && S1 == S2) {
+        return P.dbl();
+    }
+
+#ifdef PROFILE_OP_COUNTS
+    PointT::add_cnt++;
+#endif
+
+    // add-2007-bl. If P = -Q, then H = 0, and hence Z3 = 0.
+    const field_type H = U2 - U1;
+    const field_type I = (H + H).squared();
+    const field_type J = H * I;
+    const field_type S2_minus_S1 = S2 - S1;
+    const field_type r = S2_minus_S1 + S2_minus_S1;
+    const field_type V = U1 * I;
+    const field_type X3 = r.squared() - J - (V + V);
+    const field_type S1_J = S1 * J;
+    const field_type Y3 = r * (V - X3) - (S1_J + S1_J);
+    const field_type Z3 = ((P.Z + Q.Z).squared() - Z1Z1 - Z2Z2) * H;
+    return PointT(X3, Y3, Z3);
+}
+
+template<typename PointT>
+PointT sw_jacobian<PointT>::mixed_add(const PointT &P, const PointT &Q)
+{
+#ifdef DEBUG
+    assert(Q.is_special());
+#endif
+
+    if (is_zero(P)) {
+        return Q;
+    }
+
+    if (is_zero(Q)) {
+        return P;
+    }
+
+    // Since Z2 = 1, U1 = X1 and S1 = Y1.
+    const field_type Z1Z1 = P.Z.squared();
+    const field_type U2 = Q.X * Z1Z1;
+    const field_type S2 = Q.Y * (P.Z * Z1Z1);
+    if (P.X == U2 && P.Y == S2) {
+        return P.dbl();
+    }
+
+#ifdef PROFILE_OP_COUNTS
+    PointT::add_cnt++;
+#endif
+
+    // madd-2007-bl
+    const field_type H = U2 - P.X;
+    const field_type HH = H.squared();
+    field_type I = HH + HH;
+    I = I + I;
+    const field_type J = H * I;
+    field_type r = S2 - P.Y;
+    r = r + r;
+    const field_type V = P.X * I;
+    const field_type X3 = r.squared() - J - (V + V);
+    const field_type Y1_J = P.Y * J;
+    const field_type Y3 = r * (V - X3) - (Y1_J + Y1_J);
+    const field_type Z3 = (P.Z + H).squared() - Z1Z1 - HH;
+    return PointT(X3, Y3, Z3);
+}
+
+template<typename PointT> PointT sw_jacobian<PointT>::dbl(const PointT &P)
+{
+#ifdef PROFILE_OP_COUNTS
+    PointT::dbl_cnt++;
+#endif
+
+    if (is_zero(P)) {
+        return P;
+    }
+
+    return dbl(P, internal::sw_coeff_a_is_zero<PointT>());
+}
+
+template<typename PointT>
+PointT sw_jacobian<PointT>::dbl(const PointT &P, std::true_type)
+{
+    // dbl-2009-l
+    const field_type A = P.X.squared();
+    const field_type B = P.Y.squared();
+    const field_type C = B.squared();
+    field_type D = (P.X + B).squared() - A - C;
+    D = D + D;
+    const field_type E = A + A + A;
+    const field_type F = E.squared();
+    const field_type X3 = F - (D + D);
+    field_type eightC = C + C;
+    eightC = eightC + eightC;
+    eightC = eightC + eightC;
+    const field_type Y3 = E * (D - X3) - eightC;
+    const field_type Y1Z1 = P.Y * P.Z;
+    const field_type Z3 = Y1Z1 + Y1Z1;
+    return PointT(X3, Y3, Z3);
+}
+
+template<typename PointT>
+PointT sw_jacobian<PointT>::dbl(const PointT &P, std::false_type)
+{
+    // dbl-2007-bl
+    const field_type XX = P.X.squared();
+    const field_type YY = P.Y.squared();
+    const field_type YYYY = YY.squared();
+    const field_type ZZ = P.Z.squared();
+    field_type S = (P.X + YY).squared() - XX - YYYY;
+    S = S + S;
+    const field_type M = internal::sw_add_a_ww<PointT>(
+        XX + XX + XX, ZZ, std::false_type());
+    const field_type X3 = M.squared() - (S + S);
+    field_type eightYYYY = YYYY + YYYY;
+    eightYYYY = eightYYYY + eightYYYY;
+    eightYYYY = eightYYYY + eightYYYY;
+    const field_type Y3 = M * (S - X3) - eightYYYY;
+    const field_type Z3 = (P.Y + P.Z).squared() - YY - ZZ;
+    return PointT(X3, Y3, Z3);
+}
+
+template<typename PointT>
+bool sw_jacobian<PointT>::is_well_formed(const PointT &P)
+{
+    if (is_zero(P)) {
+        return true;
+    }
+
+    // y^2 = x^3 + a x + b, with x = X / Z^2 and y = Y / Z^3, becomes
+    //   Y^2 = X^3 + a X Z^4 + b Z^6
+    const field_type X2 = P.X.squared();
+    const field_type Y2 = P.Y.squared();
+    const field_type Z2 = P.Z.squared();
+    const field_type Z6 = Z2.squared() * Z2;
+    const field_type X2_plus_aZ4 = internal::sw_add_a_ww<PointT>(
+        X2, Z2, internal::sw_coeff_a_is_zero<PointT>());
+    return Y2 == P.X * X2_plus_aZ4 + PointT::coeff_b * Z6;
+}
+
+template<typename PointT>
+void sw_jacobian<PointT>::to_affine_coordinates(PointT &P)
+{
+    if (is_zero(P)) {
+        P.X = field_type::zero();
+        P.Y = field_type::one();
+        P.Z = field_type::zero();
+    } else {
+        const field_type Z_inv = P.Z.inverse();
+        const field_type Z2_inv = Z_inv.squared();
+        const field_type Z3_inv = Z2_inv * Z_inv;
+        P.X = P.X * Z2_inv;
+        P.Y = P.Y * Z3_inv;
+        P.Z = field_type::one();
+    }
+}
+
+template<typename PointT>
+void sw_jacobian<PointT>::batch_to_affine_coordinates(std::vector<PointT> &vec)
+{
+    std::vector<field_type> Z_vec;
+    Z_vec.reserve(vec.size());
+    for (const PointT &el : vec) {
+        Z_vec.emplace_back(el.Z);
+    }
+    batch_invert<field_type>(Z_vec);
+
+    const field_type one = field_type::one();
+    for (size_t i = 0; i < vec.size(); ++i) {
+        const field_type Z2 = Z_vec[i].squared();
+        const field_type Z3 = Z_vec[i] * Z2;
+        vec[i].X = vec[i].X * Z2;
+        vec[i].Y = vec[i].Y * Z3;
+        vec[i].Z = one;
+    }
+}
+
+template<typename PointT> bool sw_projective<PointT>::is_zero(const PointT &P)
+{
+    return P.X.is_zero() && P.Z.is_zero();
+}
+
+template<typename PointT>
+bool sw_projective<PointT>::equal(const PointT &P, const PointT &Q)
+{
+    if (is_zero(P)) {
+        return is_zero(Q);
+    }
+
+    if (is_zero(Q)) {
+        return false;
+    }
+
+    // (X1:Y1:Z1) = (X2:Y2:Z2)
+    //   iff
+    // X1 * Z2 == X2 * Z1 and Y1 * Z2 == Y2 * Z1
+    if ((P.X * Q.Z) != (Q.X * P.Z)) {
+        return false;
+    }
+
+    return (P.Y * Q.Z) == (Q.Y * P.Z);
+}
+
+template<typename PointT>
+PointT sw_projective<PointT>::add(const PointT &P, const PointT &Q)
+{
+    if (is_zero(P)) {
+        return Q;
+    }
+
+    if (is_zero(Q)) {
+        return P;
+    }
+
+    // The doubling check reuses the values computed for the addition.
+    const field_type X1Z2 = P.X * Q.Z;
+    const field_type X2Z1 = Q.X * P.Z;
+    const field_type Y1Z2 = P.Y * Q.Z;
+    const field_type Y2Z1 = Q.Y * P.Z;
+    if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1) {
+        return P.dbl();
+    }
+
+#ifdef PROFILE_OP_COUNTS
+    PointT::add_cnt++;
+#endif
+
+    // add-1998-cmo-2. If P = -Q, then v = 0, and hence X3 = Z3 = 0.
+    const field_type Z1Z2 = P.Z * Q.Z;
+    const field_type u = Y2Z1 - Y1Z2;
+    const field_type uu = u.squared();
+    const field_type v = X2Z1 - X1Z2;
+    const field_type vv = v.squared();
+    const field_type vvv = v * vv;
+    const field_type R = vv * X1Z2;
+    const field_type A = uu * Z1Z2 - (vvv + R + R);
+    const field_type X3 = v * A;
+    const field_type Y3 = u * (R - A) - vvv * Y1Z2;
+    const field_type Z3 = vvv * Z1Z2;
+    return PointT(X3, Y3, Z3);
+}
+
+template<typename PointT>
+PointT sw_projective<PointT>::mixed_add(const PointT &P, const PointT &Q)
+{
+#ifdef DEBUG
+    assert(Q.is_special());
+#endif
+
+    if (is_zero(P)) {
+        return Q;
+    }
+
+    if (is_zero(Q)) {
+        return P;
+    }
+
+    // Since Z2 = 1, X1Z2 = X1 and Y1Z2 = Y1.
+    const field_type X2Z1 = Q.X * P.Z;
+    const field_type Y2Z1 = Q.Y * P.Z;
+    if (P.X == X2Z1 && P.Y == Y2Z1) {
+        return P.dbl();
+    }
+
+#ifdef PROFILE_OP_COUNTS
+    PointT::add_cnt++;
+#endif
+
+    // madd-1998-cmo
+    const field_type u = Y2Z1 - P.Y;
+    const field_type uu = u.squared();
+    const field_type v = X2Z1 - P.X;
+    const field_type vv = v.squared();
+    const field_type vvv = v * vv;
+    const field_type R = vv * P.X;
+    const field_type A = uu * P.Z - (vvv + R + R);
+    const field_type X3 = v * A;
+    const field_type Y3 = u * (R - A) - vvv * P.Y;
+    const field_type Z3 = vvv * P.Z;
+    return PointT(X3, Y3, Z3);
+}
+
+template<typename PointT> PointT sw_projective<PointT>::dbl(const PointT &P)
+{
+#ifdef PROFILE_OP_COUNTS
+    PointT::dbl_cnt++;
+#endif
+
+    if (is_zero(P)) {
+        return P;
+    }
+
+    // dbl-2007-bl
+    const field_type XX = P.X.squared();
+    const field_type w = internal::sw_add_a_ww<PointT>(
+        XX + XX + XX, P.Z, internal::sw_coeff_a_is_zero<PointT>());
+    const field_type Y1Z1 = P.Y * P.Z;
+    const field_type s = Y1Z1 + Y1Z1;
+    const field_type ss = s.squared();
+    const field_type sss = s * ss;
+    const field_type R = P.Y * s;
+    const field_type RR = R.squared();
+    const field_type B = (P.X + R).squared() - XX - RR;
+    const field_type h = w.squared() - (B + B);
+    const field_type X3 = h * s;
+    const field_type Y3 = w * (B - h) - (RR + RR);
+    return PointT(X3, Y3, sss);
+}
+
+template<typename PointT>
+bool sw_projective<PointT>::is_well_formed(const PointT &P)
+{
+    if (is_zero(P)) {
+        return true;
+    }
+
+    // y^2 = x^3 + a x + b, with x = X / Z and y = Y / Z, becomes
+    //   Z (Y^2 - b Z^2) = X (X^2 + a Z^2)
+    const field_type X2 = P.X.squared();
+    const field_type Y2 = P.Y.squared();
+    const field_type Z2 = P.Z.squared();
+    const field_type X2_plus_aZ2 = internal::sw_add_a_ww<PointT>(
+        X2, P.Z, internal::sw_coeff_a_is_zero<PointT>());
+    return P.Z * (Y2 - PointT::coeff_b * Z2) == P.X * X2_plus_aZ2;
+}
+
+template<typename PointT>
+void sw_projective<PointT>::to_affine_coordinates(PointT &P)
+{
+    if (is_zero(P)) {
+        P.X = field_type::zero();
+        P.Y = field_type::one();
+        P.Z = field_type::zero();
+    } else {
+        const field_type Z_inv = P.Z.inverse();
+        P.X = P.X * Z_inv;
+        P.Y = P.Y * Z_inv;
+        P.Z = field_type::one();
+    }
+}
+
+template<typename PointT>
+void sw_projective<PointT>::batch_to_affine_coordinates(
+    std::vector<PointT> &vec)
+{
+    std::vector<field_type> Z_vec;
+    Z_vec.reserve(vec.size());
+    for (const PointT &el : vec) {
+        Z_vec.emplace_back(el.Z);
+    }
+    batch_invert<field_type>(Z_vec);
+
+    const field_type one = field_type::one();
+    for (size_t i = 0; i < vec.size(); ++i) {
+        vec[i].X = vec[i].X * Z_vec[i];
+        vec[i].Y = vec[i].Y * Z_vec[i];
+        vec[i].Z = one;
+    }
+}
+
+template<typename PointT, typename GroupT>
+bool sw_xyzz<PointT, GroupT>::is_zero(const PointT &P)
+{
+    return P.ZZ.is_zero();
+}
+
+template<typename PointT, typename GroupT>
+bool sw_xyzz<PointT, GroupT>::equal(const PointT &P, const PointT &Q)
+{
+    if (is_zero(P)) {
+        return is_zero(Q);
+    }
+
+    if (is_zero(Q)) {
+        return false;
+    }
+
+    // X1 / ZZ1 == X2 / ZZ2 and Y1 / ZZZ1 == Y2 / ZZZ2
+    return (P.X * Q.ZZ == Q.X * P.ZZ) && (P.Y * Q.ZZZ == Q.Y * P.ZZZ);
+}
+
+template<typename PointT, typename GroupT>
+PointT sw_xyzz<PointT, GroupT>::add(const PointT &P, const PointT &Q)
+{
+    if (is_zero(P)) {
+        return Q;
+    }
+
+    if (is_zero(Q)) {
+        return P;
+    }
+
+    // add-2008-s
+    const field_type U1 = P.X * Q.ZZ;
+    const field_type U2 = Q.X * P.ZZ;
+    const field_type S1 = P.Y * Q.ZZZ;
+    const field_type S2 = Q.Y * P.ZZZ;
+    const field_type M = U2 - U1;
+    const field_type R = S2 - S1;
+    if (M.is_zero()) {
+        return R.is_zero() ? dbl(P) : PointT::zero();
+    }
+
+    const field_type MM = M.squared();
+    const field_type MMM = M * MM;
+    const field_type V = U1 * MM;
+    const field_type X3 = R.squared() - MMM - (V + V);
+    const field_type Y3 = R * (V - X3) - S1 * MMM;
+    const field_type ZZ3 = P.ZZ * Q.ZZ * MM;
+    const field_type ZZZ3 = P.ZZZ * Q.ZZZ * MMM;
+    return PointT(X3, Y3, ZZ3, ZZZ3);
+}
+
+template<typename PointT, typename GroupT>
+PointT sw_xyzz<PointT, GroupT>::mixed_add(const PointT &P, const GroupT &Q)
+{
+    if (Q.is_zero()) {
+        return P;
+    }
+
+    if (is_zero(P)) {
+        return PointT(Q);
+    }
+
+    // madd-2008-s
+    const field_type U2 = Q.X * P.ZZ;
+    const field_type S2 = Q.Y * P.ZZZ;
+    const field_type M = U2 - P.X;
+    const field_type R = S2 - P.Y;
+    if (M.is_zero()) {
+        return R.is_zero() ? dbl_affine(Q.X, Q.Y) : PointT::zero();
+    }
+
+    const field_type MM = M.squared();
+    const field_type MMM = M * MM;
+    const field_type V = P.X * MM;
+    const field_type X3 = R.squared() - MMM - (V + V);
+    const field_type Y3 = R * (V - X3) - P.Y * MMM;
+    return PointT(X3, Y3, P.ZZ * MM, P.ZZZ * MMM);
+}
+
+template<typename PointT, typename GroupT>
+PointT sw_xyzz<PointT, GroupT>::dbl(const PointT &P)
+{
+    // dbl-2008-s-1. Zero and points of order 2 (Y = 0) give V = 0, and hence
+    // zero.
+    const field_type U = P.Y + P.Y;
+    const field_type V = U.squared();
+    const field_type W = U * V;
+    const field_type S = P.X * V;
+    const field_type XX = P.X.squared();
+    const field_type M = internal::sw_add_a_ww<GroupT>(
+        XX + XX + XX, P.ZZ, internal::sw_coeff_a_is_zero<GroupT>());
+    const field_type X3 = M.squared() - (S + S);
+    const field_type Y3 = M * (S - X3) - W * P.Y;
+    return PointT(X3, Y3, V * P.ZZ, W * P.ZZZ);
+}
+
+template<typename PointT, typename GroupT>
+PointT sw_xyzz<PointT, GroupT>::dbl_affine(
+    const field_type &x, const field_type &y)
+{
+    // mdbl-2008-s-1
+    const field_type U = y + y;
+    const field_type V = U.squared();
+    const field_type W = U * V;
+    const field_type S = x * V;
+    const field_type xx = x.squared();
+    const field_type M = internal::sw_add_a<GroupT>(
+        xx + xx + xx, internal::sw_coeff_a_is_zero<GroupT>());
+    const field_type X3 = M.squared() - (S + S);
+    const field_type Y3 = M * (S - X3) - W * y;
+    return PointT(X3, Y3, V, W);
+}
+
+template<typename PointT, typename GroupT>
+GroupT sw_xyzz<PointT, GroupT>::to_affine(const PointT &P)
+{
+    if (is_zero(P)) {
+        return GroupT::zero();
+    }
+
+    // Since ZZ^3 = ZZZ^2, 1 / ZZ = (ZZ / ZZZ)^2.
+    const field_type ZZZ_inverse = P.ZZZ.inverse();
+    const field_type ZZ_inverse = (P.ZZ * ZZZ_inverse).squared();
+    return GroupT(P.X * ZZ_inverse, P.Y * ZZZ_inverse, field_type::one());
+}
+
+template<typename PointT>
+bool sw_affine<PointT>::equal(const PointT &P, const PointT &Q)
+{
+    if (P.is_zero()) {
+        return Q.is_zero();
+    }
+
+    if (Q.is_zero()) {
+        return false;
+    }
+
+    return P.X == Q.X && P.Y == Q.Y;
+}
+
+template<typename PointT>
+PointT sw_affine<PointT>::add(const PointT &P, const PointT &Q)
+{
+    std::vector<PointT> sum(1, P);
+    batch_add(sum, std::vector<PointT>(1, Q));
+    return sum[0];
+}
+
+template<typename PointT> PointT sw_affine<PointT>::dbl(const PointT &P)
+{
+    return add(P, P);
+}
+
+template<typename PointT>
+bool sw_affine<PointT>::is_well_formed(const PointT &P)
+{
+    if (P.is_zero()) {
+        return true;
+    }
+
+    // y^2 = x^3 + a x + b
+    const field_type x_squared_plus_a = internal::sw_add_a<PointT>(
+        P.X.squared(), internal::sw_coeff_a_is_zero<PointT>());
+    return P.Z == field_type::one() &&
+           P.Y.squared() == P.X * x_squared_plus_a + PointT::coeff_b;
+}
+
+template<typename PointT>
+void sw_affine<PointT>::batch_add(
+    std::vector<PointT> &P, const std::vector<PointT> &Q)
+{
+    assert(P.size() == Q.size());
+
+    // The slope of each sum is numerator[i] / denominator[i]:
+    //   (y2 - y1) / (x2 - x1) for an addition, and
+    //   (3 x1^2 + a) / (2 y1) for a doubling.
+    // Sums involving zero, or of inverse points, need no slope, and get the
+    // denominator 1.
+    const size_t n = P.size();
+    std::vector<field_type> numerators(n);
+    std::vector<field_type> denominators(n, field_type::one());
+    std::vector<bool> trivial(n, true);
+    for (size_t i = 0; i < n; ++i) {
+        if (P[i].is_zero() || Q[i].is_zero()) {
+            continue;
+        }
+
+        if (P[i].X != Q[i].X) {
+            numerators[i] = Q[i].Y - P[i].Y;
+            denominators[i] = Q[i].X - P[i].X;
+            trivial[i] = false;
+        } else if (P[i].Y == Q[i].Y && !P[i].Y.is_zero()) {
+            const field_type xx = P[i].X.squared();
+            numerators[i] = internal::sw_add_a<PointT>(
+                xx + xx + xx, internal::sw_coeff_a_is_zero<PointT>());
+            denominators[i] = P[i].Y + P[i].Y;
+            trivial[i] = false;
+        }
+    }
+
+    batch_invert<field_type>(denominators);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (trivial[i]) {
+            if (P[i].is_zero()) {
+                P[i] = Q[i];
+            } else if (!Q[i].is_zero()) {
+                // P[i] = -Q[i], or a point of order 2 doubled.
+                P[i] = PointT::zero();
+            }
+            continue;
+        }
+
+        // x3 = lambda^2 - x1 - x2, y3 = lambda (x1 - x3) - y1
+        const field_type lambda = numerators[i] * denominators[i];
+        const field_type x3 = lambda.squared() - P[i].X - Q[i].X;
+        const field_type y3 = lambda * (P[i].X - x3) - P[i].Y;
+        P[i] = PointT(x3, y3, field_type::one());
+    }
+}
+
+} // namespace libff
+
+#endif // SHORT_WEIERSTRASS_TCC_
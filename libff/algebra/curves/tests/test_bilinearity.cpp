@@ -95,6 +95,76 @@ template<typename ppT> void double_miller_loop_test()
     ASSERT_EQ(ans_1 * ans_2, ans_12);
 }
 
+void bls12_381_multi_miller_loop_test()
+{
+    std::vector<bls12_381_G1_precomp> prec_P;
+    std::vector<bls12_381_G2_precomp> prec_Q;
+    bls12_381_Fq12 expected = bls12_381_Fq12::one();
+    ASSERT_EQ(expected, bls12_381_multi_miller_loop(prec_P, prec_Q));
+    for (size_t i = 0; i < 3; ++i) {
+        prec_P.push_back(bls12_381_precompute_G1(
+            bls12_381_Fr::random_element() * bls12_381_G1::one()));
+        prec_Q.push_back(bls12_381_precompute_G2(
+            bls12_381_Fr::random_element() * bls12_381_G2::one()));
+        expected =
+            expected * bls12_381_miller_loop(prec_P.back(), prec_Q.back());
+        ASSERT_EQ(expected, bls12_381_multi_miller_loop(prec_P, prec_Q));
+    }
+
+    // The same, with the G2 precomputations referenced by pointer.
+    std::vector<const bls12_381_G2_precomp *> prec_Q_ptrs;
+    for (const bls12_381_G2_precomp &Q : prec_Q) {
+        prec_Q_ptrs.push_back(&Q);
+    }
+    ASSERT_EQ(expected, bls12_381_multi_miller_loop(prec_P, prec_Q_ptrs));
+}
+
+/// f_{loop_count,Q}(P), computed from the given precomputed lines.
+bw6_761_Fq6 bw6_761_reference_miller_loop(
+    const bw6_761_ate_G1_precomp &prec_P,
+    const bw6_761_ate_G2_precomp_iteration &prec_Q,
+    const bigint<bw6_761_q_limbs> &loop_count)
+{
+    const std::vector<long> naf = find_wnaf(1, loop_count);
+    bw6_761_Fq6 f = bw6_761_Fq6::one();
+    size_t idx = 0;
+    for (long i = naf.size() - 2; i >= 0; --i) {
+        f = f.squared();
+        for (size_t k = 0; k < ((naf[i] != 0) ? 2u : 1u); ++k) {
+            const bw6_761_ate_ell_coeffs &c = prec_Q.coeffs[idx++];
+            f = f.mul_by_045(
+                c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
+        }
+    }
+    return f;
+}
+
+void bw6_761_combined_miller_loop_test()
+{
+    const std::vector<long> naf_1 = find_wnaf(1, bw6_761_ate_loop_count1);
+    const std::vector<long> naf_2 = find_wnaf(1, bw6_761_ate_loop_count2);
+    ASSERT_EQ(naf_1.size(), sizeof(bw6_761_ate_loop_count1_naf));
+    ASSERT_EQ(naf_2.size(), sizeof(bw6_761_ate_loop_count2_naf));
+    for (size_t i = 0; i < naf_1.size(); ++i) {
+        ASSERT_EQ(naf_1[naf_1.size() - 1 - i], bw6_761_ate_loop_count1_naf[i]);
+    }
+    for (size_t i = 0; i < naf_2.size(); ++i) {
+        ASSERT_EQ(naf_2[naf_2.size() - 1 - i], bw6_761_ate_loop_count2_naf[i]);
+    }
+
+    // The combined loop computes f_{u+1,Q}(P) * f_{u^3-u^2-u,Q}(P)^q.
+    const bw6_761_G1 P = bw6_761_Fr::random_element() * bw6_761_G1::one();
+    const bw6_761_G2 Q = bw6_761_Fr::random_element() * bw6_761_G2::one();
+    const bw6_761_ate_G1_precomp prec_P = bw6_761_ate_precompute_G1(P);
+    const bw6_761_ate_G2_precomp prec_Q = bw6_761_ate_precompute_G2(Q);
+    const bw6_761_Fq6 f_1 = bw6_761_reference_miller_loop(
+        prec_P, prec_Q.precomp_1, bw6_761_ate_loop_count1);
+    const bw6_761_Fq6 f_2 = bw6_761_reference_miller_loop(
+        prec_P, prec_Q.precomp_2, bw6_761_ate_loop_count2);
+    ASSERT_EQ(
+        f_1 * f_2.Frobenius_map(1), bw6_761_ate_miller_loop(prec_P, prec_Q));
+}
+
 template<typename ppT> void affine_pairing_test()
 {
     GT<ppT> GT_one = GT<ppT>::one();
@@ -168,6 +238,7 @@ TEST(TestBiliearity, BW6_761)
     bw6_761_pp::init_public_params();
     pairing_test<bw6_761_pp>();
     double_miller_loop_test<bw6_761_pp>();
+    bw6_761_combined_miller_loop_test();
 }
 
 // BN128 has fancy dependencies so it may be disabled
@@ -185,4 +256,5 @@ TEST(TestBiliearity, BLS12_381)
     bls12_381_pp::init_public_params();
     pairing_test<bls12_381_pp>();
     double_miller_loop_test<bls12_381_pp>();
+    bls12_381_multi_miller_loop_test();
 }
@@ -18,6 +18,8 @@
 #include <libff/algebra/curves/bw6_761/bw6_761_pp.hpp>
 #include <libff/algebra/curves/curve_serialization.hpp>
 #include <libff/algebra/curves/curve_utils.hpp>
+#include <libff/algebra/curves/short_weierstrass.hpp>
+#include <libff/algebra/curves/xyzz_point.hpp>
 #include <sstream>
 
 using namespace libff;
@@ -121,6 +123,165 @@ template<typename GroupT> void test_mul_by_q()
     ASSERT_EQ(a.mul_by_q(), (GroupT::base_field_char() * a));
 }
 
+template<typename GroupT> void test_xyzz_point()
+{
+    using xyzz = xyzz_point<GroupT>;
+
+    GroupT a = GroupT::random_element();
+    GroupT b = GroupT::random_element();
+    a.to_special();
+    b.to_special();
+    const xyzz a_xyzz(a);
+    const xyzz b_xyzz(b);
+
+    ASSERT_TRUE(xyzz::zero().is_zero());
+    ASSERT_TRUE(xyzz(GroupT::zero()).is_zero());
+    ASSERT_EQ(GroupT::zero(), xyzz::zero().to_group());
+    ASSERT_EQ(a, a_xyzz.to_group());
+
+    // Mixed addition, including the zero, doubling and inverse cases.
+    const xyzz sum = a_xyzz.mixed_add(b);
+    ASSERT_EQ(a + b, sum.to_group());
+    ASSERT_TRUE(sum.to_group().is_special());
+    ASSERT_EQ(a, xyzz::zero().mixed_add(a).to_group());
+    ASSERT_EQ(a, a_xyzz.mixed_add(GroupT::zero()).to_group());
+    ASSERT_EQ(a.dbl(), a_xyzz.mixed_add(a).to_group());
+    ASSERT_TRUE(a_xyzz.mixed_add(-a).is_zero());
+
+    // Addition and doubling of non-affine points.
+    const xyzz sum_dbl = sum.dbl();
+    ASSERT_EQ((a + b).dbl(), sum_dbl.to_group());
+    ASSERT_EQ(a + b + (a + b).dbl(), (sum + sum_dbl).to_group());
+    ASSERT_EQ(sum_dbl, sum + sum);
+    ASSERT_EQ(sum, sum_dbl + (-sum));
+    ASSERT_TRUE((sum + (-sum)).is_zero());
+    ASSERT_NE(sum, sum_dbl);
+    ASSERT_EQ(sum, xyzz::zero() + sum);
+    ASSERT_EQ(sum, sum + xyzz::zero());
+    ASSERT_TRUE(xyzz::zero().dbl().is_zero());
+}
+
+/// mnt4_G1 (where a is not zero) in Jacobian coordinates, to test the
+/// general sw_jacobian formulas, which no curve group uses.
+class mnt4_G1_jacobian
+{
+public:
+#ifdef PROFILE_OP_COUNTS
+    static long long add_cnt;
+    static long long dbl_cnt;
+#endif
+    static const bool coeff_a_is_zero = false;
+
+    mnt4_Fq X, Y, Z;
+
+    mnt4_G1_jacobian(const mnt4_G1 &P)
+        : X(P.X * P.Z), Y(P.Y * P.Z.squared()), Z(P.Z)
+    {
+    }
+    mnt4_G1_jacobian(const mnt4_Fq &X, const mnt4_Fq &Y, const mnt4_Fq &Z)
+        : X(X), Y(Y), Z(Z)
+    {
+    }
+
+    static mnt4_Fq mul_by_a(const mnt4_Fq &elt) { return coeff_a * elt; }
+    mnt4_G1_jacobian dbl() const
+    {
+        return sw_jacobian<mnt4_G1_jacobian>::dbl(*this);
+    }
+
+    mnt4_G1 to_group() const
+    {
+        if (Z.is_zero()) {
+            return mnt4_G1::zero();
+        }
+        return mnt4_G1(X * Z, Y, Z.squared() * Z);
+    }
+
+    static mnt4_Fq coeff_a;
+    static mnt4_Fq coeff_b;
+};
+
+#ifdef PROFILE_OP_COUNTS
+long long mnt4_G1_jacobian::add_cnt = 0;
+long long mnt4_G1_jacobian::dbl_cnt = 0;
+#endif
+mnt4_Fq mnt4_G1_jacobian::coeff_a;
+mnt4_Fq mnt4_G1_jacobian::coeff_b;
+
+void test_sw_jacobian_coeff_a()
+{
+    using jac = sw_jacobian<mnt4_G1_jacobian>;
+    mnt4_G1_jacobian::coeff_a = mnt4_G1::coeff_a;
+    mnt4_G1_jacobian::coeff_b = mnt4_G1::coeff_b;
+
+    mnt4_G1 a = mnt4_G1::random_element();
+    mnt4_G1 b = mnt4_G1::random_element();
+    const mnt4_G1_jacobian a_jac(a);
+    const mnt4_G1_jacobian b_jac(b);
+    b.to_special();
+    const mnt4_G1_jacobian b_special(b);
+    const mnt4_G1_jacobian zero(mnt4_G1::zero());
+
+    ASSERT_TRUE(jac::is_zero(zero));
+    ASSERT_TRUE(jac::is_well_formed(a_jac));
+    ASSERT_FALSE(jac::is_well_formed(
+        mnt4_G1_jacobian(a_jac.X, a_jac.Y + a_jac.Y, a_jac.Z)));
+    ASSERT_TRUE(jac::equal(a_jac, mnt4_G1_jacobian(a)));
+    ASSERT_FALSE(jac::equal(a_jac, b_jac));
+
+    ASSERT_EQ(a.dbl(), jac::dbl(a_jac).to_group());
+    ASSERT_EQ(a + b, jac::add(a_jac, b_jac).to_group());
+    ASSERT_EQ(a.dbl(), jac::add(a_jac, a_jac).to_group());
+    ASSERT_TRUE(jac::is_zero(jac::add(a_jac, mnt4_G1_jacobian(-a))));
+    ASSERT_EQ(a, jac::add(a_jac, zero).to_group());
+    ASSERT_EQ(a + b, jac::mixed_add(a_jac, b_special).to_group());
+    ASSERT_EQ(b.dbl(), jac::mixed_add(b_jac, b_special).to_group());
+    ASSERT_EQ(b, jac::mixed_add(zero, b_special).to_group());
+
+    mnt4_G1_jacobian c = jac::add(a_jac, b_jac);
+    jac::to_affine_coordinates(c);
+    ASSERT_EQ(mnt4_Fq::one(), c.Z);
+    ASSERT_EQ(a + b, c.to_group());
+}
+
+template<typename GroupT> void test_sw_affine()
+{
+    using affine = sw_affine<GroupT>;
+
+    std::vector<GroupT> P;
+    std::vector<GroupT> Q;
+    for (size_t i = 0; i < 4; ++i) {
+        P.push_back(GroupT::random_element());
+        Q.push_back(GroupT::random_element());
+    }
+    // Zero on either side, doubling and inverse cases.
+    P.push_back(GroupT::zero());
+    Q.push_back(GroupT::random_element());
+    P.push_back(GroupT::random_element());
+    Q.push_back(GroupT::zero());
+    P.push_back(GroupT::random_element());
+    Q.push_back(P.back());
+    P.push_back(GroupT::random_element());
+    Q.push_back(-P.back());
+    for (size_t i = 0; i < P.size(); ++i) {
+        P[i].to_special();
+        Q[i].to_special();
+    }
+
+    std::vector<GroupT> sums = P;
+    affine::batch_add(sums, Q);
+    for (size_t i = 0; i < P.size(); ++i) {
+        GroupT expected = P[i] + Q[i];
+        expected.to_special();
+        ASSERT_EQ(expected, sums[i]);
+        ASSERT_TRUE(sums[i].is_special());
+        ASSERT_TRUE(affine::is_well_formed(sums[i]));
+        ASSERT_TRUE(affine::equal(expected, sums[i]));
+        ASSERT_TRUE(affine::equal(expected, affine::add(P[i], Q[i])));
+    }
+    ASSERT_EQ(P[0].dbl(), affine::dbl(P[0]));
+}
+
 template<typename GroupT> void test_mul_by_cofactor()
 {
     const GroupT a = GroupT::random_element();
@@ -214,10 +375,66 @@ template<typename GroupT> void test_serialize_group()
     test_serialize_group_element(GroupT::random_element());
 }
 
+template<encoding_t Enc, form_t Form, compression_t Comp, typename GroupT>
+void test_serialize_group_vector_config(const std::vector<GroupT> &elements)
+{
+    // Vector output must match the output of individual group_write calls.
+    std::string expect_buffer;
+    {
+        std::ostringstream ss;
+        for (const GroupT &el : elements) {
+            group_write<Enc, Form, Comp>(el, ss);
+        }
+        expect_buffer = ss.str();
+    }
+
+    std::string buffer;
+    {
+        std::ostringstream ss;
+        group_write_vector<Enc, Form, Comp>(elements, ss);
+        buffer = ss.str();
+    }
+    ASSERT_EQ(expect_buffer, buffer);
+
+    std::vector<GroupT> elements_dec(elements.size());
+    {
+        std::istringstream ss(buffer);
+        group_read_vector<Enc, Form, Comp>(elements_dec, ss);
+    }
+    ASSERT_EQ(elements, elements_dec);
+}
+
+template<typename GroupT> void test_serialize_group_vector()
+{
+    const std::vector<GroupT> elements{
+        GroupT::random_element(),
+        GroupT::zero(),
+        GroupT::one(),
+        GroupT::random_element(),
+        GroupT::zero() - GroupT::one(),
+        GroupT::random_element(),
+    };
+
+    test_serialize_group_vector_config<
+        encoding_binary,
+        form_plain,
+        compression_on>(elements);
+    test_serialize_group_vector_config<
+        encoding_binary,
+        form_montgomery,
+        compression_off>(elements);
+    test_serialize_group_vector_config<
+        encoding_json,
+        form_plain,
+        compression_off>(elements);
+}
+
 template<typename ppT> void test_serialize()
 {
     test_serialize_group<G1<ppT>>();
     test_serialize_group<G2<ppT>>();
+    test_serialize_group_vector<G1<ppT>>();
+    test_serialize_group_vector<G2<ppT>>();
 }
 
 template<typename GroupT> void test_group_membership_valid()
@@ -243,6 +460,19 @@ void test_group_membership_invalid_g1(const typename GroupT::base_field &x)
     const GroupT g1_invalid = g1_curve_point_at_x<GroupT>(x);
     ASSERT_TRUE(g1_invalid.is_well_formed());
     ASSERT_FALSE(g1_invalid.is_in_safe_subgroup());
+
+    // Non-affine representations, and the batch check.
+    const GroupT g1_invalid_jac = g1_invalid + GroupT::random_element();
+    ASSERT_FALSE(g1_invalid_jac.is_in_safe_subgroup());
+    std::vector<GroupT> points(33);
+    for (GroupT &p : points) {
+        p = GroupT::random_element();
+    }
+    points.push_back(GroupT::zero());
+    ASSERT_TRUE(batch_is_in_safe_subgroup(points));
+    points[17] = g1_invalid_jac;
+    ASSERT_FALSE(batch_is_in_safe_subgroup(points));
+    ASSERT_TRUE(batch_is_in_safe_subgroup(std::vector<GroupT>()));
 }
 
 template<typename GroupT>
@@ -268,6 +498,19 @@ template<typename ppT> void test_check_membership()
     test_group_membership_valid<G2<ppT>>();
 }
 
+template<> void test_check_membership<bls12_381_pp>()
+{
+    test_group_membership_valid<bls12_381_G1>();
+    test_group_membership_valid<bls12_381_G2>();
+    test_group_membership_invalid_g1<bls12_381_G1>(bls12_381_Fq(4));
+
+    // Ensure sigma endomorphism results in multiplication by expected lambda.
+    const bls12_381_G1 g1 = bls12_381_G1::random_element();
+    ASSERT_EQ(
+        (bls12_381_Fr("228988810152649578064853576960394133503") * g1),
+        g1.sigma());
+}
+
 template<> void test_check_membership<alt_bn128_pp>()
 {
     test_group_membership_valid<alt_bn128_G1>();
@@ -295,6 +538,13 @@ template<> void test_check_membership<bw6_761_pp>()
     test_group_membership_valid<bw6_761_G2>();
     test_group_membership_invalid_g1<bw6_761_G1>(bw6_761_Fq(6));
     test_group_membership_invalid_g2<bw6_761_G2>(bw6_761_Fq(0));
+
+    // Ensure sigma endomorphism results in multiplication by expected lambda.
+    const bw6_761_G1 g1 = bw6_761_G1::random_element();
+    const bw6_761_Fr lambda(
+        "258664426012969093929703085429980814127835149614277183275038967946009"
+        "968870203535512256352201271898244626862047231");
+    ASSERT_EQ(lambda * g1, g1.sigma());
 }
 
 void test_bls12_377()
@@ -353,8 +603,11 @@ TEST(TestGroups, Mnt4)
     test_curve_equation<G1<mnt4_pp>>();
     test_curve_equation<G2<mnt4_pp>>();
     test_group<G1<mnt4_pp>>();
+    test_xyzz_point<G1<mnt4_pp>>();
+    test_sw_jacobian_coeff_a();
     test_output<G1<mnt4_pp>>();
     test_group<G2<mnt4_pp>>();
+    test_xyzz_point<G2<mnt4_pp>>();
     test_output<G2<mnt4_pp>>();
     test_serialize<mnt4_pp>();
     test_mul_by_q<G2<mnt4_pp>>();
@@ -369,8 +622,11 @@ TEST(TestGroups, Mnt6)
     test_curve_equation<G1<mnt6_pp>>();
     test_curve_equation<G2<mnt6_pp>>();
     test_group<G1<mnt6_pp>>();
+    test_xyzz_point<G1<mnt6_pp>>();
     test_output<G1<mnt6_pp>>();
     test_group<G2<mnt6_pp>>();
+    test_xyzz_point<G2<mnt6_pp>>();
+    test_sw_affine<G2<mnt6_pp>>();
     test_output<G2<mnt6_pp>>();
     test_serialize<mnt6_pp>();
     test_mul_by_q<G2<mnt6_pp>>();
@@ -385,8 +641,11 @@ TEST(TestGroups, Alt_BN128)
     test_curve_equation<G1<alt_bn128_pp>>();
     test_curve_equation<G2<alt_bn128_pp>>();
     test_group<G1<alt_bn128_pp>>();
+    test_xyzz_point<G1<alt_bn128_pp>>();
+    test_sw_affine<G1<alt_bn128_pp>>();
     test_output<G1<alt_bn128_pp>>();
     test_group<G2<alt_bn128_pp>>();
+    test_xyzz_point<G2<alt_bn128_pp>>();
     test_output<G2<alt_bn128_pp>>();
     test_serialize<alt_bn128_pp>();
     test_mul_by_q<G2<alt_bn128_pp>>();
@@ -402,8 +661,10 @@ TEST(TestGroups, BLS12_377)
     test_curve_equation<G1<bls12_377_pp>>();
     test_curve_equation<G2<bls12_377_pp>>();
     test_group<G1<bls12_377_pp>>();
+    test_xyzz_point<G1<bls12_377_pp>>();
     test_output<G1<bls12_377_pp>>();
     test_group<G2<bls12_377_pp>>();
+    test_xyzz_point<G2<bls12_377_pp>>();
     test_output<G2<bls12_377_pp>>();
     test_serialize<bls12_377_pp>();
     test_mul_by_q<G2<bls12_377_pp>>();
@@ -418,8 +679,11 @@ TEST(TestGroups, BW6_761)
     test_curve_equation<G1<bw6_761_pp>>();
     test_curve_equation<G2<bw6_761_pp>>();
     test_group<G1<bw6_761_pp>>();
+    test_xyzz_point<G1<bw6_761_pp>>();
+    test_sw_affine<G1<bw6_761_pp>>();
     test_output<G1<bw6_761_pp>>();
     test_group<G2<bw6_761_pp>>();
+    test_xyzz_point<G2<bw6_761_pp>>();
     test_output<G2<bw6_761_pp>>();
     test_serialize<bw6_761_pp>();
     test_mul_by_q<G2<bw6_761_pp>>();
@@ -449,8 +713,11 @@ TEST(TestGroups, BLS12_381)
     test_curve_equation<G1<bls12_381_pp>>();
     test_curve_equation<G2<bls12_381_pp>>();
     test_group<G1<bls12_381_pp>>();
+    test_xyzz_point<G1<bls12_381_pp>>();
     test_output<G1<bls12_381_pp>>();
     test_group<G2<bls12_381_pp>>();
+    test_xyzz_point<G2<bls12_381_pp>>();
+    test_sw_affine<G2<bls12_381_pp>>();
     test_output<G2<bls12_381_pp>>();
     test_serialize<bls12_381_pp>();
     test_mul_by_q<G2<bls12_381_pp>>();
@@ -0,0 +1,178 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/bls12_381/bls12_381_hash_to_curve.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libff;
+
+namespace
+{
+
+const std::string G1_DST = std::string("QUUX-V01-CS02-with-") +
+                           BLS12_381_G1_HASH_TO_CURVE_SUITE;
+const std::string G2_DST = std::string("QUUX-V01-CS02-with-") +
+                           BLS12_381_G2_HASH_TO_CURVE_SUITE;
+
+class HashToCurveTest : public ::testing::Test
+{
+public:
+    HashToCurveTest() { bls12_381_pp::init_public_params(); }
+};
+
+template<typename GroupT, typename FieldT>
+void assert_affine_eq(const FieldT &x, const FieldT &y, GroupT P)
+{
+    P.to_affine_coordinates();
+    ASSERT_EQ(x, P.X);
+    ASSERT_EQ(y, P.Y);
+}
+
+TEST_F(HashToCurveTest, HashToField)
+{
+    // RFC 9380, Appendix J.9.1 (msg = "abc").
+    const std::vector<bls12_381_Fq> u =
+        bls12_381_hash_to_field_Fq("abc", G1_DST, 2);
+    ASSERT_EQ(2, u.size());
+    ASSERT_EQ(
+        bls12_381_Fq("2088728490498894818688784437928579501848367107744050576"
+                     "780266498473771518428420173373487118890161663886009635"
+                     "645777"),
+        u[0]);
+    ASSERT_EQ(
+        bls12_381_Fq("3213892493831086209316960640873433141017158792584421675"
+                     "273329354360198845384332787807729451466588948143655833"
+                     "2217"),
+        u[1]);
+
+    const std::vector<bls12_381_Fq2> u2 =
+        bls12_381_hash_to_field_Fq2("abc", G2_DST, 3);
+    ASSERT_EQ(3, u2.size());
+}
+
+TEST_F(HashToCurveTest, HashToG1)
+{
+    // RFC 9380, Appendix J.9.1.
+    assert_affine_eq(
+        bls12_381_Fq("7943115757214008313629570493037810448520063234226241118"
+                     "933528595574500083086209254514417469263951415987209281"
+                     "51969"),
+        bls12_381_Fq("1343412193624222137939591894701031123123641958980729764"
+                     "240763391191550653712890272928110356903136085217047453"
+                     "540965"),
+        bls12_381_hash_to_G1("", G1_DST));
+    assert_affine_eq(
+        bls12_381_Fq("5137384602176159439212852477034485676478758747455673727"
+                     "961641554723831277565677800591365215084286627659659974"
+                     "67907"),
+        bls12_381_Fq("1786897908129645780825838873875416513994655004408749907"
+                     "941296449131605892957529391590865627492442562626458913"
+                     "769565"),
+        bls12_381_hash_to_G1("abc", G1_DST));
+}
+
+TEST_F(HashToCurveTest, HashToG2)
+{
+    // RFC 9380, Appendix J.10.1.
+    assert_affine_eq(
+        bls12_381_Fq2(
+            bls12_381_Fq("19354805336845174941142151562851080662656573665208680"
+                         "74193543955773676937785714526284237270826689001870364"
+                         "82254730"),
+            bls12_381_Fq("89193000964309942330810277795125089969455920364772498"
+                         "83610228510249904734239385371139488503380982303967473"
+                         "96259901")),
+        bls12_381_Fq2(
+            bls12_381_Fq("77171727205583415237828170597267125700535714547880090"
+                         "83736594049915373541534554529617471747658593358197667"
+                         "15637138"),
+            bls12_381_Fq("28103101185821266340411334541807053043930791391032529"
+                         "56502404531123692847658283858246402311867775854528543"
+                         "237781718")),
+        bls12_381_hash_to_G2("", G2_DST));
+    assert_affine_eq(
+        bls12_381_Fq2(
+            bls12_381_Fq("42495834046307397554776273551719320683325510794179090"
+                         "90098276355566344147460560777144317863212478716285159"
+                         "67727334"),
+            bls12_381_Fq("30186798039701278772628263938144725285574135043291947"
+                         "40495363852840690589001358162447917674089074634504498"
+                         "585239512")),
+        bls12_381_Fq2(
+            bls12_381_Fq("36213081851283954598889955265271275566147686044721321"
+                         "76060423302734876099689739385100475320409412954617897"
+                         "892887112"),
+            bls12_381_Fq("10244778409683790871325706972787978264207524072457967"
+                         "06542268013457084520186765877717144576714321227519586"
+                         "33012502")),
+        bls12_381_hash_to_G2("abc", G2_DST));
+}
+
+TEST_F(HashToCurveTest, MapToCurve)
+{
+    for (size_t i = 0; i < 16; ++i) {
+        const bls12_381_G1 P =
+            bls12_381_map_to_curve_G1(bls12_381_Fq::random_element());
+        ASSERT_TRUE(P.is_well_formed());
+        const bls12_381_G1 Q = bls12_381_clear_cofactor_G1(P);
+        ASSERT_TRUE(Q.is_well_formed());
+        ASSERT_TRUE(Q.is_in_safe_subgroup());
+
+        const bls12_381_G2 R =
+            bls12_381_map_to_curve_G2(bls12_381_Fq2::random_element());
+        ASSERT_TRUE(R.is_well_formed());
+        const bls12_381_G2 S = bls12_381_clear_cofactor_G2(R);
+        ASSERT_TRUE(S.is_well_formed());
+        ASSERT_TRUE(S.is_in_safe_subgroup());
+    }
+
+    // The map is defined for u = 0 (the exceptional case of SWU).
+    ASSERT_TRUE(
+        bls12_381_map_to_curve_G1(bls12_381_Fq::zero()).is_well_formed());
+    ASSERT_TRUE(
+        bls12_381_map_to_curve_G2(bls12_381_Fq2::zero()).is_well_formed());
+}
+
+TEST_F(HashToCurveTest, ClearCofactorG2)
+{
+    // h_eff for G2 (RFC 9380, Section 8.8.2).
+    const bigint<10> h_eff(
+        "2098698478373356869050803414986584776638390672357034518753068515265997"
+        "8379657273880445933310903383423462252858887697898782244793646184663164"
+        "1690358257586228683615991308971558879306463436166481");
+    for (size_t i = 0; i < 4; ++i) {
+        const bls12_381_G2 P =
+            bls12_381_map_to_curve_G2(bls12_381_Fq2::random_element());
+        ASSERT_EQ(h_eff * P, bls12_381_clear_cofactor_G2(P));
+    }
+    ASSERT_TRUE(bls12_381_clear_cofactor_G2(bls12_381_G2::zero()).is_zero());
+}
+
+TEST_F(HashToCurveTest, Batch)
+{
+    const std::vector<std::string> msgs = {
+        "", "abc", "abcdef0123456789", std::string(200, 'q')};
+
+    const std::vector<bls12_381_G1> g1 =
+        bls12_381_hash_to_G1_batch(msgs, G1_DST);
+    const std::vector<bls12_381_G2> g2 =
+        bls12_381_hash_to_G2_batch(msgs, G2_DST);
+    ASSERT_EQ(msgs.size(), g1.size());
+    ASSERT_EQ(msgs.size(), g2.size());
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        ASSERT_TRUE(g1[i].is_special());
+        ASSERT_EQ(bls12_381_hash_to_G1(msgs[i], G1_DST), g1[i]);
+        ASSERT_TRUE(g2[i].is_special());
+        ASSERT_EQ(bls12_381_hash_to_G2(msgs[i], G2_DST), g2[i]);
+    }
+
+    ASSERT_TRUE(bls12_381_hash_to_G1_batch({}, G1_DST).empty());
+}
+
+} // namespace
@@ -0,0 +1,107 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp"
+#include "libff/algebra/curves/pairing_batcher.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libff;
+
+namespace
+{
+
+/// Checks Groth16-style equations
+///   e(A, B) == e(alpha, beta) * e(L, gamma) * e(C, delta)
+/// for a verification key (alpha, beta, gamma, delta) and proofs (A, B, C)
+/// with public input commitments L.
+template<typename ppT> void test_pairing_batcher()
+{
+    const Fr<ppT> alpha = Fr<ppT>::random_element();
+    const Fr<ppT> beta = Fr<ppT>::random_element();
+    const Fr<ppT> gamma = Fr<ppT>::random_element();
+    const Fr<ppT> delta = Fr<ppT>::random_element();
+    const G1<ppT> alpha_g1 = alpha * G1<ppT>::one();
+
+    pairing_batcher<ppT> batcher;
+    ASSERT_TRUE(batcher.verify());
+    const size_t beta_index = batcher.add_fixed_G2(beta * G2<ppT>::one());
+    const size_t gamma_index = batcher.add_fixed_G2(gamma * G2<ppT>::one());
+    const size_t delta_index = batcher.add_fixed_G2(delta * G2<ppT>::one());
+
+    const size_t num_proofs = 5;
+    std::vector<G1<ppT>> C(num_proofs);
+    for (size_t i = 0; i < num_proofs; ++i) {
+        const Fr<ppT> a = Fr<ppT>::random_element();
+        const Fr<ppT> b = Fr<ppT>::random_element();
+        const Fr<ppT> l = Fr<ppT>::random_element();
+        const Fr<ppT> c =
+            (a * b - alpha * beta - l * gamma) * delta.inverse();
+        C[i] = c * G1<ppT>::one();
+
+        batcher.begin_equation();
+        batcher.add_term(a * G1<ppT>::one(), b * G2<ppT>::one());
+        batcher.add_term(alpha_g1, beta_index, -Fr<ppT>::one());
+        // Split L = l [1]_1 into two terms, as if combining public inputs.
+        batcher.add_term(G1<ppT>::one(), gamma_index, -(l - Fr<ppT>::one()));
+        batcher.add_term(-G1<ppT>::one(), gamma_index);
+        batcher.add_term(-C[i], delta_index);
+    }
+
+    // One pair per proof, and one per fixed element.
+    ASSERT_EQ(num_proofs + 3, batcher.num_pairs());
+    ASSERT_TRUE(batcher.verify());
+    ASSERT_TRUE(batcher.verify(2));
+
+    // An invalid proof.
+    batcher.begin_equation();
+    batcher.add_term(G1<ppT>::one(), G2<ppT>::one());
+    batcher.add_term(-G1<ppT>::one(), beta_index);
+    ASSERT_FALSE(batcher.verify());
+
+    batcher.clear();
+    ASSERT_EQ(0, batcher.num_pairs());
+    ASSERT_TRUE(batcher.verify());
+
+    // A single equation with an odd number of pairs, and zero terms.
+    batcher.add_term(beta * G1<ppT>::one(), G2<ppT>::one());
+    batcher.add_term(G1<ppT>::zero(), G2<ppT>::one());
+    batcher.add_term(G1<ppT>::one(), G2<ppT>::zero());
+    batcher.add_term(-G1<ppT>::one(), beta_index);
+    ASSERT_TRUE(batcher.verify());
+    batcher.add_term(G1<ppT>::one(), delta_index, Fr<ppT>::zero());
+    ASSERT_TRUE(batcher.verify());
+    batcher.add_term(G1<ppT>::one(), delta_index);
+    ASSERT_FALSE(batcher.verify());
+
+    ASSERT_THROW(batcher.add_term(G1<ppT>::one(), 3), std::invalid_argument);
+    ASSERT_THROW(pairing_batcher<ppT>(0), std::invalid_argument);
+    ASSERT_THROW(
+        pairing_batcher<ppT>(Fr<ppT>::size_in_bits()), std::invalid_argument);
+}
+
+TEST(PairingBatcherTest, AltBN128)
+{
+    alt_bn128_pp::init_public_params();
+    test_pairing_batcher<alt_bn128_pp>();
+}
+
+TEST(PairingBatcherTest, BLS12_381)
+{
+    bls12_381_pp::init_public_params();
+    test_pairing_batcher<bls12_381_pp>();
+}
+
+TEST(PairingBatcherTest, MNT4)
+{
+    mnt4_pp::init_public_params();
+    test_pairing_batcher<mnt4_pp>();
+}
+
+} // namespace
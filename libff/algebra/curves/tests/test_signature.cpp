@@ -0,0 +1,157 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_signature.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libff;
+
+namespace
+{
+
+class SignatureTest : public ::testing::Test
+{
+public:
+    SignatureTest() { bls12_381_pp::init_public_params(); }
+
+    /// Sign msgs[i] with the i-th of a set of random keys, with some
+    /// messages repeated.
+    void sign(
+        const size_t n,
+        std::vector<bls12_381_G1> &public_keys,
+        std::vector<std::string> &msgs,
+        std::vector<bls12_381_G2> &signatures)
+    {
+        public_keys.clear();
+        msgs.clear();
+        signatures.clear();
+        for (size_t i = 0; i < n; ++i) {
+            const bls12_381_Fr sk = bls12_381_Fr::random_element();
+            public_keys.push_back(bls12_381_signature_public_key(sk));
+            msgs.push_back("message " + std::to_string(i % 5));
+            signatures.push_back(bls12_381_signature_sign(sk, msgs.back()));
+        }
+    }
+};
+
+TEST_F(SignatureTest, SignVerify)
+{
+    const bls12_381_Fr sk = bls12_381_Fr::random_element();
+    const bls12_381_G1 pk = bls12_381_signature_public_key(sk);
+    const bls12_381_G2 sig = bls12_381_signature_sign(sk, "abc");
+
+    ASSERT_TRUE(bls12_381_signature_verify(pk, "abc", sig));
+    ASSERT_FALSE(bls12_381_signature_verify(pk, "abd", sig));
+    ASSERT_FALSE(bls12_381_signature_verify(-pk, "abc", sig));
+    ASSERT_FALSE(bls12_381_signature_verify(pk, "abc", sig + sig));
+    ASSERT_FALSE(bls12_381_signature_verify(pk, "abc", bls12_381_G2::zero()));
+    ASSERT_FALSE(bls12_381_signature_verify(pk, "abc", sig, "OTHER_DST_"));
+}
+
+TEST_F(SignatureTest, AggregateVerify)
+{
+    std::vector<bls12_381_G1> public_keys;
+    std::vector<std::string> msgs;
+    std::vector<bls12_381_G2> signatures;
+    sign(8, public_keys, msgs, signatures);
+
+    const bls12_381_G2 aggregate = bls12_381_signature_aggregate(signatures);
+    ASSERT_TRUE(
+        bls12_381_signature_aggregate_verify(public_keys, msgs, aggregate));
+    ASSERT_FALSE(bls12_381_signature_aggregate_verify(
+        public_keys, msgs, aggregate + signatures[0]));
+    std::swap(msgs[0], msgs[1]);
+    ASSERT_FALSE(
+        bls12_381_signature_aggregate_verify(public_keys, msgs, aggregate));
+
+    ASSERT_TRUE(bls12_381_signature_aggregate_verify(
+        {}, {}, bls12_381_signature_aggregate({})));
+    ASSERT_THROW(
+        bls12_381_signature_aggregate_verify(public_keys, {}, aggregate),
+        std::invalid_argument);
+}
+
+TEST_F(SignatureTest, BatchVerify)
+{
+    std::vector<bls12_381_G1> public_keys;
+    std::vector<std::string> msgs;
+    std::vector<bls12_381_G2> signatures;
+    sign(13, public_keys, msgs, signatures);
+
+    ASSERT_TRUE(
+        bls12_381_signature_batch_verify(public_keys, msgs, signatures));
+    ASSERT_TRUE(bls12_381_signature_find_invalid(public_keys, msgs, signatures)
+                    .empty());
+    ASSERT_TRUE(bls12_381_signature_batch_verify({}, {}, {}));
+
+    // Signatures which are valid in aggregate, but not individually.
+    std::vector<bls12_381_G2> swapped = signatures;
+    std::swap(swapped[2], swapped[3]);
+    ASSERT_FALSE(bls12_381_signature_batch_verify(public_keys, msgs, swapped));
+    ASSERT_EQ(
+        std::vector<size_t>({2, 3}),
+        bls12_381_signature_find_invalid(public_keys, msgs, swapped));
+
+    std::vector<bls12_381_G2> invalid = signatures;
+    invalid[0] = invalid[0] + bls12_381_G2::one();
+    invalid[7] = bls12_381_G2::zero();
+    invalid[12] = -invalid[12];
+    ASSERT_FALSE(bls12_381_signature_batch_verify(public_keys, msgs, invalid));
+    ASSERT_EQ(
+        std::vector<size_t>({0, 7, 12}),
+        bls12_381_signature_find_invalid(public_keys, msgs, invalid));
+
+    signatures.pop_back();
+    ASSERT_THROW(
+        bls12_381_signature_batch_verify(public_keys, msgs, signatures),
+        std::invalid_argument);
+    ASSERT_THROW(
+        bls12_381_signature_find_invalid(public_keys, msgs, signatures),
+        std::invalid_argument);
+}
+
+TEST_F(SignatureTest, ZeroPublicKey)
+{
+    // With a zero public key, the zero signature satisfies the pairing
+    // equation for any message, so such keys must be rejected.
+    const bls12_381_G1 zero_pk = bls12_381_G1::zero();
+    const bls12_381_G2 zero_sig = bls12_381_G2::zero();
+    ASSERT_FALSE(bls12_381_signature_verify(zero_pk, "abc", zero_sig));
+    ASSERT_FALSE(bls12_381_signature_verify(
+        zero_pk, "abc", bls12_381_signature_sign(bls12_381_Fr::zero(), "abc")));
+
+    std::vector<bls12_381_G1> public_keys;
+    std::vector<std::string> msgs;
+    std::vector<bls12_381_G2> signatures;
+    sign(6, public_keys, msgs, signatures);
+
+    // A zero key added to a valid aggregate leaves the aggregate unchanged.
+    const bls12_381_G2 aggregate = bls12_381_signature_aggregate(signatures);
+    public_keys.push_back(zero_pk);
+    msgs.push_back("forged");
+    signatures.push_back(zero_sig);
+    ASSERT_FALSE(
+        bls12_381_signature_aggregate_verify(public_keys, msgs, aggregate));
+    ASSERT_FALSE(bls12_381_signature_aggregate_verify(
+        {zero_pk}, {"forged"}, zero_sig));
+
+    ASSERT_FALSE(
+        bls12_381_signature_batch_verify(public_keys, msgs, signatures));
+    ASSERT_FALSE(
+        bls12_381_signature_batch_verify({zero_pk}, {"forged"}, {zero_sig}));
+
+    public_keys.insert(public_keys.begin() + 2, zero_pk);
+    msgs.insert(msgs.begin() + 2, "forged too");
+    signatures.insert(signatures.begin() + 2, signatures[3]);
+    ASSERT_EQ(
+        std::vector<size_t>({2, 7}),
+        bls12_381_signature_find_invalid(public_keys, msgs, signatures));
+}
+
+} // namespace
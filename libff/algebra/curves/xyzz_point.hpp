@@ -0,0 +1,78 @@
+/** @file
+ *****************************************************************************
+
+ Points of a short Weierstrass curve y^2 = x^3 + a x + b in extended Jacobian
+ (XYZZ) coordinates (X, Y, ZZ, ZZZ), representing the affine point
+ (X / ZZ, Y / ZZZ), where ZZ^3 = ZZZ^2 (see
+ https://www.hyperelliptic.org/EFD/g1p/auto-shortw-xyzz.html).
+
+ Adding an affine point costs 8M + 2S (compared to 7M + 4S plus the doubling
+ check for the Jacobian mixed_add), and the zero, doubling and inverse cases
+ are detected from intermediate values that are computed anyway. This makes
+ XYZZ a good representation for accumulators, such as the buckets of
+ Pippenger-style multi-exponentiation, that mostly absorb affine points.
+
+ xyzz_point is parameterized by the group type GroupT (any of the short
+ Weierstrass G1 and G2 types), and is converted to and from elements of GroupT
+ in special (affine) form, so it does not depend on the coordinate system
+ used by GroupT. The group law is implemented by sw_xyzz (see
+ short_weierstrass.hpp).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef XYZZ_POINT_HPP_
+#define XYZZ_POINT_HPP_
+
+#include <libff/algebra/curves/short_weierstrass.hpp>
+#include <type_traits>
+
+namespace libff
+{
+
+template<typename GroupT> class xyzz_point
+{
+public:
+    using field_type =
+        typename std::decay<decltype(((GroupT *)nullptr)->X)>::type;
+
+    field_type X, Y, ZZ, ZZZ;
+
+    /// The zero point.
+    xyzz_point();
+    xyzz_point(
+        const field_type &X,
+        const field_type &Y,
+        const field_type &ZZ,
+        const field_type &ZZZ);
+
+    /// From an element of GroupT in special form.
+    explicit xyzz_point(const GroupT &special);
+
+    static xyzz_point zero();
+
+    bool is_zero() const;
+    bool operator==(const xyzz_point &other) const;
+    bool operator!=(const xyzz_point &other) const;
+
+    xyzz_point operator-() const;
+    xyzz_point operator+(const xyzz_point &other) const;
+    xyzz_point add(const xyzz_point &other) const;
+    xyzz_point dbl() const;
+
+    /// Add an element of GroupT in special form.
+    xyzz_point mixed_add(const GroupT &special) const;
+
+    /// Convert to an element of GroupT (in special form). This requires a
+    /// field inversion.
+    GroupT to_group() const;
+};
+
+} // namespace libff
+
+#include <libff/algebra/curves/xyzz_point.tcc>
+
+#endif // XYZZ_POINT_HPP_
@@ -0,0 +1,110 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of xyzz_point.
+
+ See xyzz_point.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef XYZZ_POINT_TCC_
+#define XYZZ_POINT_TCC_
+
+namespace libff
+{
+
+template<typename GroupT>
+xyzz_point<GroupT>::xyzz_point()
+    : X(field_type::one())
+    , Y(field_type::one())
+    , ZZ(field_type::zero())
+    , ZZZ(field_type::zero())
+{
+}
+
+template<typename GroupT>
+xyzz_point<GroupT>::xyzz_point(
+    const field_type &X,
+    const field_type &Y,
+    const field_type &ZZ,
+    const field_type &ZZZ)
+    : X(X), Y(Y), ZZ(ZZ), ZZZ(ZZZ)
+{
+}
+
+template<typename GroupT>
+xyzz_point<GroupT>::xyzz_point(const GroupT &special)
+{
+    if (special.is_zero()) {
+        *this = zero();
+    } else {
+        X = special.X;
+        Y = special.Y;
+        ZZ = field_type::one();
+        ZZZ = field_type::one();
+    }
+}
+
+template<typename GroupT> xyzz_point<GroupT> xyzz_point<GroupT>::zero()
+{
+    return xyzz_point();
+}
+
+template<typename GroupT> bool xyzz_point<GroupT>::is_zero() const
+{
+    return sw_xyzz<xyzz_point, GroupT>::is_zero(*this);
+}
+
+template<typename GroupT>
+bool xyzz_point<GroupT>::operator==(const xyzz_point &other) const
+{
+    return sw_xyzz<xyzz_point, GroupT>::equal(*this, other);
+}
+
+template<typename GroupT>
+bool xyzz_point<GroupT>::operator!=(const xyzz_point &other) const
+{
+    return !(operator==(other));
+}
+
+template<typename GroupT>
+xyzz_point<GroupT> xyzz_point<GroupT>::operator-() const
+{
+    return xyzz_point(X, -Y, ZZ, ZZZ);
+}
+
+template<typename GroupT>
+xyzz_point<GroupT> xyzz_point<GroupT>::operator+(const xyzz_point &other) const
+{
+    return add(other);
+}
+
+template<typename GroupT>
+xyzz_point<GroupT> xyzz_point<GroupT>::add(const xyzz_point &other) const
+{
+    return sw_xyzz<xyzz_point, GroupT>::add(*this, other);
+}
+
+template<typename GroupT>
+xyzz_point<GroupT> xyzz_point<GroupT>::mixed_add(const GroupT &special) const
+{
+    return sw_xyzz<xyzz_point, GroupT>::mixed_add(*this, special);
+}
+
+template<typename GroupT> xyzz_point<GroupT> xyzz_point<GroupT>::dbl() const
+{
+    return sw_xyzz<xyzz_point, GroupT>::dbl(*this);
+}
+
+template<typename GroupT> GroupT xyzz_point<GroupT>::to_group() const
+{
+    return sw_xyzz<xyzz_point, GroupT>::to_affine(*this);
+}
+
+} // namespace libff
+
+#endif // XYZZ_POINT_TCC_
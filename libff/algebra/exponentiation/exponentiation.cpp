@@ -0,0 +1,192 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of exponentiation plans.
+
+ See exponentiation.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/algebra/exponentiation/exponentiation.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace
+{
+
+/// Largest window size considered for sliding-window plans.
+const size_t MAX_WINDOW_SIZE = 10;
+
+class sliding_window
+{
+public:
+    /// Lowest bit of the window.
+    size_t position;
+    /// Value of the bits of the window (odd).
+    size_t digit;
+};
+
+/// Split the bits (least significant first, with the top bit set) into
+/// windows of at most w bits, each starting and ending with a set bit,
+/// greedily from the most significant bit.
+std::vector<sliding_window> split_windows(
+    const std::vector<bool> &bits, const size_t w)
+{
+    std::vector<sliding_window> windows;
+    long i = bits.size() - 1;
+    while (i >= 0) {
+        if (!bits[i]) {
+            --i;
+            continue;
+        }
+        long j = std::max<long>(i - w + 1, 0);
+        while (!bits[j]) {
+            ++j;
+        }
+        size_t digit = 0;
+        for (long k = i; k >= j; --k) {
+            digit = 2 * digit + (bits[k] ? 1 : 0);
+        }
+        windows.push_back({(size_t)j, digit});
+        i = j - 1;
+    }
+    return windows;
+}
+
+/// Register holding base^digit, for odd digits, where register 1 holds
+/// base^2 and registers 2, 3, ... hold base^3, base^5, ...
+uint32_t table_register(const size_t digit)
+{
+    return (digit == 1) ? 0 : 1 + (digit - 1) / 2;
+}
+
+/// Emit the steps evaluating the given windows, returning the result
+/// register and setting num_registers.
+uint32_t emit_windows(
+    const std::vector<sliding_window> &windows,
+    size_t &num_registers,
+    std::vector<exponentiation_plan::step> &steps)
+{
+    steps.clear();
+
+    // Odd powers of the base, up to the largest digit.
+    size_t max_digit = 1;
+    for (const sliding_window &w : windows) {
+        max_digit = std::max(max_digit, w.digit);
+    }
+    if (max_digit > 1) {
+        steps.push_back({1, 0, 0});
+        for (uint32_t k = 1; k <= (max_digit - 1) / 2; ++k) {
+            steps.push_back({1 + k, table_register(2 * k - 1), 1});
+        }
+    }
+    const uint32_t acc = table_register(max_digit) + 1;
+    num_registers = acc + 1;
+
+    uint32_t current = table_register(windows[0].digit);
+    size_t position = windows[0].position;
+    for (size_t i = 1; i < windows.size(); ++i) {
+        for (; position > windows[i].position; --position) {
+            steps.push_back({acc, current, current});
+            current = acc;
+        }
+        steps.push_back({acc, current, table_register(windows[i].digit)});
+    }
+    for (; position > 0; --position) {
+        steps.push_back({acc, current, current});
+        current = acc;
+    }
+    return current;
+}
+
+} // namespace
+
+exponentiation_plan::exponentiation_plan()
+    : _is_zero(true), _num_registers(1), _result(0)
+{
+}
+
+exponentiation_plan::exponentiation_plan(
+    const size_t num_registers, const size_t result, std::vector<step> &&steps)
+    : _is_zero(false)
+    , _num_registers(num_registers)
+    , _result(result)
+    , _steps(std::move(steps))
+{
+    std::vector<bool> written(num_registers, false);
+    if (num_registers == 0 || result >= num_registers) {
+        throw std::invalid_argument(
+            "libff::exponentiation_plan: invalid result register");
+    }
+    written[0] = true;
+    for (const step &s : _steps) {
+        if (s.dst == 0 || s.dst >= num_registers || s.lhs >= num_registers ||
+            s.rhs >= num_registers || !written[s.lhs] || !written[s.rhs]) {
+            throw std::invalid_argument(
+                "libff::exponentiation_plan: invalid step");
+        }
+        written[s.dst] = true;
+    }
+    if (!written[result]) {
+        throw std::invalid_argument(
+            "libff::exponentiation_plan: invalid result register");
+    }
+}
+
+bool exponentiation_plan::is_zero() const { return _is_zero; }
+
+size_t exponentiation_plan::num_registers() const { return _num_registers; }
+
+size_t exponentiation_plan::result_register() const { return _result; }
+
+const std::vector<exponentiation_plan::step> &exponentiation_plan::steps() const
+{
+    return _steps;
+}
+
+size_t exponentiation_plan::num_squarings() const
+{
+    size_t result = 0;
+    for (const step &s : _steps) {
+        result += (s.lhs == s.rhs) ? 1 : 0;
+    }
+    return result;
+}
+
+size_t exponentiation_plan::num_multiplications() const
+{
+    return _steps.size() - num_squarings();
+}
+
+void exponentiation_plan::build_sliding_window(const std::vector<bool> &bits)
+{
+    _num_registers = 1;
+    _result = 0;
+    _steps.clear();
+    _is_zero = bits.empty();
+    if (_is_zero) {
+        return;
+    }
+
+    // Keep the window size giving the fewest steps.
+    std::vector<step> steps;
+    size_t num_registers;
+    for (size_t w = 1; w <= MAX_WINDOW_SIZE; ++w) {
+        const uint32_t result =
+            emit_windows(split_windows(bits, w), num_registers, steps);
+        if (w == 1 || steps.size() < _steps.size()) {
+            _num_registers = num_registers;
+            _result = result;
+            _steps.swap(steps);
+        }
+    }
+}
+
+} // namespace libff
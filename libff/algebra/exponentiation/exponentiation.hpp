@@ -1,7 +1,8 @@
 /** @file
  *****************************************************************************
 
- Declaration of interfaces for (square-and-multiply) exponentiation.
+ Declaration of interfaces for (square-and-multiply) exponentiation, and for
+ exponentiation by fixed exponents using precomputed plans.
 
  *****************************************************************************
  * @author     This file is part of libff, developed by SCIPR Lab
@@ -14,6 +15,7 @@
 
 #include <cstdint>
 #include <libff/algebra/fields/bigint.hpp>
+#include <vector>
 
 namespace libff
 {
@@ -24,6 +26,63 @@ FieldT power(const FieldT &base, const bigint<m> &exponent);
 template<typename FieldT>
 FieldT power(const FieldT &base, const unsigned long exponent);
 
+/// A plan for raising elements to a fixed exponent e: an addition chain for
+/// e, given as a sequence of steps over a set of registers. Register 0 holds
+/// the base, each step sets one register to the product of two registers
+/// (or the square of one), and the result is read from a final register.
+///
+/// Plans are either built from the exponent using the sliding-window method,
+/// with the window size that minimizes the number of steps, or given
+/// explicitly (e.g. as generated offline by
+/// libff/algebra/curves/addition_chain_generator.py). A plan is built once
+/// per exponent, and can be used for any field, so that exponentiation by
+/// hot fixed exponents (square roots, Euler's criterion) avoids both the bit
+/// scanning of power() and most of its multiplications.
+class exponentiation_plan
+{
+public:
+    /// registers[dst] = registers[lhs] * registers[rhs]. Squaring is
+    /// indicated by lhs == rhs.
+    struct step {
+        uint32_t dst;
+        uint32_t lhs;
+        uint32_t rhs;
+    };
+
+    /// A plan for the exponent 0.
+    exponentiation_plan();
+
+    /// A sliding-window plan for the given exponent.
+    template<mp_size_t m> explicit exponentiation_plan(const bigint<m> &exponent);
+
+    /// An explicit plan. Throws std::invalid_argument if a step reads a
+    /// register which has not been written, or writes register 0, or if any
+    /// register index is out of range.
+    exponentiation_plan(
+        const size_t num_registers,
+        const size_t result,
+        std::vector<step> &&steps);
+
+    bool is_zero() const;
+    size_t num_registers() const;
+    size_t result_register() const;
+    const std::vector<step> &steps() const;
+    size_t num_squarings() const;
+    size_t num_multiplications() const;
+
+private:
+    bool _is_zero;
+    size_t _num_registers;
+    size_t _result;
+    std::vector<step> _steps;
+
+    void build_sliding_window(const std::vector<bool> &bits);
+};
+
+/// Raise base to the exponent of the given plan.
+template<typename FieldT>
+FieldT power(const FieldT &base, const exponentiation_plan &plan);
+
 } // namespace libff
 
 #include <libff/algebra/exponentiation/exponentiation.tcc>
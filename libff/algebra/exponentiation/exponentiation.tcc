@@ -46,6 +46,35 @@ FieldT power(const FieldT &base, const unsigned long exponent)
     return power<FieldT>(base, bigint<1>(exponent));
 }
 
+template<mp_size_t m>
+exponentiation_plan::exponentiation_plan(const bigint<m> &exponent)
+{
+    std::vector<bool> bits(exponent.num_bits());
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = exponent.test_bit(i);
+    }
+    build_sliding_window(bits);
+}
+
+template<typename FieldT>
+FieldT power(const FieldT &base, const exponentiation_plan &plan)
+{
+    if (plan.is_zero()) {
+        return FieldT::one();
+    }
+
+    std::vector<FieldT> registers(plan.num_registers());
+    registers[0] = base;
+    for (const exponentiation_plan::step &s : plan.steps()) {
+        if (s.lhs == s.rhs) {
+            registers[s.dst] = registers[s.lhs].squared();
+        } else {
+            registers[s.dst] = registers[s.lhs] * registers[s.rhs];
+        }
+    }
+    return registers[plan.result_register()];
+}
+
 } // namespace libff
 
 #endif // EXPONENTIATION_TCC_
@@ -27,7 +27,8 @@ template<typename FieldT>
 typename std::enable_if<!std::is_same<FieldT, Double>::value, bool>::type
 has_root_of_unity(const size_t n);
 
-// returns root of unity of order n (for n a power of 2), if one exists
+// returns root of unity of order n (for n a power of 2), if one exists. For
+// finite fields, values are cached (see root_of_unity_cache.hpp).
 template<typename FieldT>
 typename std::enable_if<std::is_same<FieldT, Double>::value, FieldT>::type
 get_root_of_unity(const size_t n);
@@ -85,8 +86,54 @@ bit_vector convert_field_element_to_bit_vector(
 template<typename FieldT>
 FieldT convert_bit_vector_to_field_element(const bit_vector &v);
 
+// Word-level equivalents of the bit_vector functions above. A bit string of
+// num_bits bits is held in div_ceil(num_bits, 64) words, with bit i at
+// position i % 64 of words[i / 64] (the order used by bit_vector). Bits of
+// the final word beyond num_bits are ignored on input. Large vectors are
+// processed in parallel when MULTICORE is enabled.
+
+/// Equivalent to pack_bit_vector_into_field_element_vector.
+template<typename FieldT>
+std::vector<FieldT> pack_words_into_field_element_vector(
+    const uint64_t *words, const size_t num_bits, const size_t chunk_bits);
+
+template<typename FieldT>
+std::vector<FieldT> pack_words_into_field_element_vector(
+    const uint64_t *words, const size_t num_bits);
+
+/// Equivalent to convert_bit_vector_to_field_element_vector.
+template<typename FieldT>
+std::vector<FieldT> convert_words_to_field_element_vector(
+    const uint64_t *words, const size_t num_bits);
+
+/// Equivalent to convert_bit_vector_to_field_element.
+template<typename FieldT>
+FieldT convert_words_to_field_element(
+    const uint64_t *words, const size_t num_bits);
+
+/// Number of words written by convert_field_element_vector_to_words for num
+/// elements.
+template<typename FieldT>
+size_t field_element_vector_num_words(const size_t num_elements);
+
+/// Write the FieldT::size_in_bits() bits of el (i.e.
+/// field_element_vector_num_words<FieldT>(1) words), taken directly from the
+/// limbs of el.as_bigint().
+template<typename FieldT>
+void convert_field_element_to_words(const FieldT &el, uint64_t *words);
+
+/// Equivalent to convert_field_element_vector_to_bit_vector. Writes
+/// field_element_vector_num_words<FieldT>(v.size()) words.
+template<typename FieldT>
+void convert_field_element_vector_to_words(
+    const std::vector<FieldT> &v, uint64_t *words);
+
 template<typename FieldT> void batch_invert(std::vector<FieldT> &vec);
 
+/// A uniformly random non-zero element of the prime field FieldT of at most
+/// num_bits bits (e.g. a short random scalar for batch verification).
+template<typename FieldT> FieldT random_field_element_bits(size_t num_bits);
+
 /// Rerturns a reference to the 0-th component of the element (or the element
 /// itself if FieldT is not an extension field).
 template<typename FieldT>
@@ -10,8 +10,10 @@
 #ifndef FIELD_UTILS_TCC_
 #define FIELD_UTILS_TCC_
 
+#include <algorithm>
 #include <complex>
 #include <libff/algebra/fields/fp.hpp>
+#include <libff/algebra/fields/root_of_unity_cache.hpp>
 #include <libff/common/double.hpp>
 #include <libff/common/utils.hpp>
 #include <stdexcept>
@@ -45,6 +47,62 @@ public:
     }
 };
 
+// The word-level bit conversions view a bigint as 64-bit words, each made
+// of one or two limbs (for 64- and 32-bit limbs respectively).
+static const size_t limbs_per_word = 64 / GMP_NUMB_BITS;
+
+/// The j-th 64-bit word of b (0 beyond the last limb).
+template<mp_size_t n>
+uint64_t bigint_get_word(const bigint<n> &b, const size_t j)
+{
+    uint64_t word = 0;
+    for (size_t k = 0; k < limbs_per_word; ++k) {
+        const size_t limb = j * limbs_per_word + k;
+        if (limb < (size_t)n) {
+            word |= (uint64_t)b.data[limb] << (k * GMP_NUMB_BITS);
+        }
+    }
+    return word;
+}
+
+/// Set the j-th 64-bit word of b, ignoring bits beyond the last limb.
+template<mp_size_t n>
+void bigint_set_word(bigint<n> &b, const size_t j, const uint64_t word)
+{
+    for (size_t k = 0; k < limbs_per_word; ++k) {
+        const size_t limb = j * limbs_per_word + k;
+        if (limb < (size_t)n) {
+            b.data[limb] = (mp_limb_t)(word >> (k * GMP_NUMB_BITS));
+        }
+    }
+}
+
+/// The (at most 64) bits [start, start + count) of a bit string of num_bits
+/// bits held in words. Bits beyond num_bits are 0.
+inline uint64_t words_get_bits(
+    const uint64_t *words,
+    const size_t num_bits,
+    const size_t start,
+    const size_t count)
+{
+    if (start >= num_bits) {
+        return 0;
+    }
+
+    const size_t word = start / 64;
+    const size_t shift = start % 64;
+    uint64_t value = words[word] >> shift;
+    if (shift != 0 && (word + 1) * 64 < num_bits) {
+        value |= words[word + 1] << (64 - shift);
+    }
+
+    const size_t available = std::min(count, num_bits - start);
+    if (available < 64) {
+        value &= (1ull << available) - 1;
+    }
+    return value;
+}
+
 } // namespace internal
 
 template<mp_size_t n>
@@ -256,7 +314,7 @@ has_root_of_unity(const size_t n)
 {
     const size_t logn = libff::log2(n);
 
-    if (n != (1u << logn)) {
+    if (n != ((size_t)1 << logn)) {
         return false;
     }
 
@@ -285,13 +343,7 @@ get_root_of_unity(const size_t n)
                                     "(1u << logn) && logn <= FieldT::s");
     }
 
-    const size_t logn = log2(n);
-    FieldT omega = FieldT::root_of_unity;
-    for (size_t i = FieldT::s; i > logn; --i) {
-        omega *= omega;
-    }
-
-    return omega;
+    return root_of_unity_cache<FieldT>::root_of_unity(log2(n));
 }
 
 template<typename FieldT>
@@ -416,6 +468,134 @@ FieldT convert_bit_vector_to_field_element(const bit_vector &v)
     return res;
 }
 
+template<typename FieldT>
+std::vector<FieldT> pack_words_into_field_element_vector(
+    const uint64_t *words, const size_t num_bits, const size_t chunk_bits)
+{
+    assert(chunk_bits <= FieldT::capacity());
+
+    const size_t repacked_size = div_ceil(num_bits, chunk_bits);
+    std::vector<FieldT> result(repacked_size);
+
+#ifdef MULTICORE
+#pragma omp parallel for if (repacked_size >= 1024)
+#endif
+    for (size_t i = 0; i < repacked_size; ++i) {
+        bigint<FieldT::num_limbs> b;
+        const size_t start = i * chunk_bits;
+        for (size_t j = 0; j * 64 < chunk_bits; ++j) {
+            internal::bigint_set_word(
+                b,
+                j,
+                internal::words_get_bits(
+                    words, num_bits, start + j * 64, chunk_bits - j * 64));
+        }
+        result[i] = FieldT(b);
+    }
+
+    return result;
+}
+
+template<typename FieldT>
+std::vector<FieldT> pack_words_into_field_element_vector(
+    const uint64_t *words, const size_t num_bits)
+{
+    return pack_words_into_field_element_vector<FieldT>(
+        words, num_bits, FieldT::capacity());
+}
+
+template<typename FieldT>
+std::vector<FieldT> convert_words_to_field_element_vector(
+    const uint64_t *words, const size_t num_bits)
+{
+    const FieldT values[2] = {FieldT::zero(), FieldT::one()};
+    std::vector<FieldT> result(num_bits);
+
+    const size_t num_words = div_ceil(num_bits, 64);
+#ifdef MULTICORE
+#pragma omp parallel for if (num_words >= 1024)
+#endif
+    for (size_t w = 0; w < num_words; ++w) {
+        const size_t end = std::min(num_bits, (w + 1) * 64);
+        uint64_t word = words[w];
+        for (size_t i = w * 64; i < end; ++i) {
+            result[i] = values[word & 1];
+            word >>= 1;
+        }
+    }
+
+    return result;
+}
+
+template<typename FieldT>
+FieldT convert_words_to_field_element(
+    const uint64_t *words, const size_t num_bits)
+{
+    assert(num_bits <= FieldT::size_in_bits());
+
+    // The FieldT constructor reduces values in
+    // [0, 2^(GMP_NUMB_BITS * num_limbs)).
+    bigint<FieldT::num_limbs> b;
+    for (size_t j = 0; j * 64 < num_bits; ++j) {
+        internal::bigint_set_word(
+            b, j, internal::words_get_bits(words, num_bits, j * 64, num_bits));
+    }
+    return FieldT(b);
+}
+
+template<typename FieldT>
+size_t field_element_vector_num_words(const size_t num_elements)
+{
+    return div_ceil(num_elements * FieldT::size_in_bits(), 64);
+}
+
+template<typename FieldT>
+void convert_field_element_to_words(const FieldT &el, uint64_t *words)
+{
+    const bigint<FieldT::num_limbs> b = el.as_bigint();
+    const size_t num_words = field_element_vector_num_words<FieldT>(1);
+    for (size_t j = 0; j < num_words; ++j) {
+        words[j] = internal::bigint_get_word(b, j);
+    }
+}
+
+template<typename FieldT>
+void convert_field_element_vector_to_words(
+    const std::vector<FieldT> &v, uint64_t *words)
+{
+    // Each block of 64 elements occupies exactly size_in_bits words, so
+    // blocks can be written independently.
+    const size_t element_bits = FieldT::size_in_bits();
+    const size_t element_words = field_element_vector_num_words<FieldT>(1);
+    const size_t num_words = field_element_vector_num_words<FieldT>(v.size());
+    const size_t num_blocks = div_ceil(v.size(), 64);
+
+#ifdef MULTICORE
+#pragma omp parallel for if (num_blocks >= 16)
+#endif
+    for (size_t block = 0; block < num_blocks; ++block) {
+        const size_t words_begin = block * element_bits;
+        const size_t words_end =
+            std::min(num_words, words_begin + element_bits);
+        std::fill(words + words_begin, words + words_end, 0);
+
+        const size_t elements_end = std::min(v.size(), (block + 1) * 64);
+        for (size_t i = block * 64; i < elements_end; ++i) {
+            const bigint<FieldT::num_limbs> b = v[i].as_bigint();
+            const size_t start = i * element_bits;
+            const size_t shift = start % 64;
+            for (size_t j = 0; j < element_words; ++j) {
+                const size_t word = start / 64 + j;
+                const uint64_t value = internal::bigint_get_word(b, j);
+                words[word] |= value << shift;
+                if (shift != 0 && word + 1 < words_end) {
+                    words[word + 1] |= value >> (64 - shift);
+                }
+            }
+        }
+    }
+}
+
 template<typename FieldT> void batch_invert(std::vector<FieldT> &vec)
 {
     std::vector<FieldT> prod;
@@ -438,6 +618,22 @@ template<typename FieldT> void batch_invert(std::vector<FieldT> &vec)
     }
 }
 
+template<typename FieldT> FieldT random_field_element_bits(size_t num_bits)
+{
+    bigint<FieldT::num_limbs> r;
+    do {
+        r.randomize();
+        for (size_t i = 0; i < FieldT::num_limbs; ++i) {
+            if (i * GMP_NUMB_BITS >= num_bits) {
+                r.data[i] = 0;
+            } else if ((i + 1) * GMP_NUMB_BITS > num_bits) {
+                r.data[i] &= (((mp_limb_t)1) << (num_bits % GMP_NUMB_BITS)) - 1;
+            }
+        }
+    } while (r.is_zero());
+    return FieldT(r);
+}
+
 template<typename FieldT>
 const typename FieldT::my_Fp &field_get_component_0(const FieldT &v)
 {
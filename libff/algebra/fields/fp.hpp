@@ -66,6 +66,10 @@ public:
     static bigint<n> t;
     /// (t-1)/2
     static bigint<n> t_minus_1_over_2;
+    /// Plans for raising to euler and t_minus_1_over_2, built by static_init
+    /// (after these have been set).
+    static exponentiation_plan euler_plan;
+    static exponentiation_plan t_minus_1_over_2_plan;
     /// a quadratic nonresidue
     static Fp_model<n, modulus> nqr;
     /// nqr^t
@@ -127,6 +131,8 @@ public:
     Fp_model inverse() const;
     /// HAS TO BE A SQUARE (else does not terminate)
     Fp_model sqrt() const;
+    /// Euler's criterion: true iff this is zero or a square.
+    bool is_square() const;
 
     Fp_model operator^(const unsigned long pow) const;
     template<mp_size_t m> Fp_model operator^(const bigint<m> &pow) const;
@@ -190,6 +196,12 @@ bigint<n> Fp_model<n, modulus>::t;
 template<mp_size_t n, const bigint<n> &modulus>
 bigint<n> Fp_model<n, modulus>::t_minus_1_over_2;
 
+template<mp_size_t n, const bigint<n> &modulus>
+exponentiation_plan Fp_model<n, modulus>::euler_plan;
+
+template<mp_size_t n, const bigint<n> &modulus>
+exponentiation_plan Fp_model<n, modulus>::t_minus_1_over_2_plan;
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp_model<n, modulus> Fp_model<n, modulus>::nqr;
 
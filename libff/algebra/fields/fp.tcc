@@ -44,6 +44,9 @@ void Fp_model<n, modulus>::static_init()
     s_one.mont_repr.data[0] = 1;
     s_one.mul_reduce(Rsquared);
 
+    euler_plan = exponentiation_plan(euler);
+    t_minus_1_over_2_plan = exponentiation_plan(t_minus_1_over_2);
+
     s_initialized = true;
 }
 
@@ -767,7 +770,7 @@ Fp_model<n, modulus> Fp_model<n, modulus>::sqrt() const
 
     size_t v = Fp_model<n, modulus>::s;
     Fp_model<n, modulus> z = Fp_model<n, modulus>::nqr_to_t;
-    Fp_model<n, modulus> w = (*this) ^ Fp_model<n, modulus>::t_minus_1_over_2;
+    Fp_model<n, modulus> w = power(*this, t_minus_1_over_2_plan);
     Fp_model<n, modulus> x = (*this) * w;
     Fp_model<n, modulus> b = x * w; // b = (*this)^t
 
@@ -811,6 +814,12 @@ Fp_model<n, modulus> Fp_model<n, modulus>::sqrt() const
     return x;
 }
 
+template<mp_size_t n, const bigint<n> &modulus>
+bool Fp_model<n, modulus>::is_square() const
+{
+    return this->is_zero() || power(*this, euler_plan) == one();
+}
+
 template<mp_size_t n, const bigint<n> &modulus>
 std::ostream &operator<<(std::ostream &out, const Fp_model<n, modulus> &p)
 {
@@ -50,6 +50,10 @@ public:
     static bigint<2 * n> t;
     /// (t-1)/2
     static bigint<2 * n> t_minus_1_over_2;
+    /// Plans for raising to euler and t_minus_1_over_2, built by static_init
+    /// (after these have been set).
+    static exponentiation_plan euler_plan;
+    static exponentiation_plan t_minus_1_over_2_plan;
     /// X^4-non_residue irreducible over Fp; used for constructing Fp2 = Fp[X] /
     /// (X^2 - non_residue)
     static my_Fp non_residue;
@@ -100,6 +104,8 @@ public:
     Fp2_model Frobenius_map(unsigned long power) const;
     /// HAS TO BE A SQUARE (else does not terminate)
     Fp2_model sqrt() const;
+    /// Euler's criterion: true iff this is zero or a square.
+    bool is_square() const;
     Fp2_model squared_karatsuba() const;
     Fp2_model squared_complex() const;
 
@@ -143,6 +149,12 @@ bigint<2 * n> Fp2_model<n, modulus>::t;
 template<mp_size_t n, const bigint<n> &modulus>
 bigint<2 * n> Fp2_model<n, modulus>::t_minus_1_over_2;
 
+template<mp_size_t n, const bigint<n> &modulus>
+exponentiation_plan Fp2_model<n, modulus>::euler_plan;
+
+template<mp_size_t n, const bigint<n> &modulus>
+exponentiation_plan Fp2_model<n, modulus>::t_minus_1_over_2_plan;
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp_model<n, modulus> Fp2_model<n, modulus>::non_residue;
 
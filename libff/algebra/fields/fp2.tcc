@@ -36,6 +36,8 @@ void Fp2_model<n, modulus>::static_init()
     // Initialize s_zero and s_one
     s_zero = Fp2_model<n, modulus>(my_Fp::zero(), my_Fp::zero());
     s_one = Fp2_model<n, modulus>(my_Fp::one(), my_Fp::zero());
+    euler_plan = exponentiation_plan(euler);
+    t_minus_1_over_2_plan = exponentiation_plan(t_minus_1_over_2);
     s_initialized = true;
 }
 
@@ -182,7 +184,7 @@ Fp2_model<n, modulus> Fp2_model<n, modulus>::sqrt() const
 
     size_t v = Fp2_model<n, modulus>::s;
     Fp2_model<n, modulus> z = Fp2_model<n, modulus>::nqr_to_t;
-    Fp2_model<n, modulus> w = (*this) ^ Fp2_model<n, modulus>::t_minus_1_over_2;
+    Fp2_model<n, modulus> w = power(*this, t_minus_1_over_2_plan);
     Fp2_model<n, modulus> x = (*this) * w;
     // b = (*this)^t
     Fp2_model<n, modulus> b = x * w;
@@ -227,6 +229,12 @@ Fp2_model<n, modulus> Fp2_model<n, modulus>::sqrt() const
     return x;
 }
 
+template<mp_size_t n, const bigint<n> &modulus>
+bool Fp2_model<n, modulus>::is_square() const
+{
+    return this->is_zero() || power(*this, euler_plan) == one();
+}
+
 template<mp_size_t n, const bigint<n> &modulus>
 template<mp_size_t m>
 Fp2_model<n, modulus> Fp2_model<n, modulus>::operator^(
@@ -34,6 +34,8 @@ template<mp_size_t n, const bigint<n> &modulus> class Fp3_model
 public:
     typedef Fp_model<n, modulus> my_Fp;
 
+    static void static_init();
+
     static const size_t tower_extension_degree = 3;
 
     /// (modulus^3-1)/2
@@ -44,9 +46,16 @@ public:
     static bigint<3 * n> t;
     /// (t-1)/2
     static bigint<3 * n> t_minus_1_over_2;
+    /// Plans for raising to euler and t_minus_1_over_2, built by static_init
+    /// (after these have been set).
+    static exponentiation_plan euler_plan;
+    static exponentiation_plan t_minus_1_over_2_plan;
     /// X^6-non_residue irreducible over Fp; used for constructing
     ///   aFp3 = Fp[X] / (X^3 - non_residue)
     static my_Fp non_residue;
+    /// non_residue as a small signed integer, or 0 if it is not one (set by
+    /// static_init). See mul_by_non_residue.
+    static long small_non_residue;
     /// a quadratic nonresidue in Fp3
     static Fp3_model<n, modulus> nqr;
     /// nqr^t
@@ -101,8 +110,13 @@ public:
     Fp3_model squared() const;
     Fp3_model inverse() const;
     Fp3_model Frobenius_map(unsigned long power) const;
+    /// non_residue * elem, computed with a few additions when non_residue is
+    /// small (as for MNT6 and BW6-761), rather than with a multiplication.
+    static my_Fp mul_by_non_residue(const my_Fp &elem);
     /// HAS TO BE A SQUARE (else does not terminate)
     Fp3_model sqrt() const;
+    /// Euler's criterion: true iff this is zero or a square.
+    bool is_square() const;
 
     template<mp_size_t m> Fp3_model operator^(const bigint<m> &other) const;
 
@@ -139,9 +153,18 @@ bigint<3 * n> Fp3_model<n, modulus>::t;
 template<mp_size_t n, const bigint<n> &modulus>
 bigint<3 * n> Fp3_model<n, modulus>::t_minus_1_over_2;
 
+template<mp_size_t n, const bigint<n> &modulus>
+exponentiation_plan Fp3_model<n, modulus>::euler_plan;
+
+template<mp_size_t n, const bigint<n> &modulus>
+exponentiation_plan Fp3_model<n, modulus>::t_minus_1_over_2_plan;
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp_model<n, modulus> Fp3_model<n, modulus>::non_residue;
 
+template<mp_size_t n, const bigint<n> &modulus>
+long Fp3_model<n, modulus>::small_non_residue = 0;
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp3_model<n, modulus> Fp3_model<n, modulus>::nqr;
 
@@ -15,6 +15,34 @@
 namespace libff
 {
 
+namespace internal
+{
+
+/// Largest absolute value of Fp3_model::non_residue for which multiplication
+/// by it is computed with additions.
+static const long FP3_MAX_SMALL_NON_RESIDUE = 8;
+
+} // namespace internal
+
+template<mp_size_t n, const bigint<n> &modulus>
+void Fp3_model<n, modulus>::static_init()
+{
+    small_non_residue = 0;
+    for (long k = 1; k <= internal::FP3_MAX_SMALL_NON_RESIDUE; ++k) {
+        if (non_residue == my_Fp(k)) {
+            small_non_residue = k;
+            break;
+        }
+        if (non_residue == -my_Fp(k)) {
+            small_non_residue = -k;
+            break;
+        }
+    }
+
+    euler_plan = exponentiation_plan(euler);
+    t_minus_1_over_2_plan = exponentiation_plan(t_minus_1_over_2);
+}
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp3_model<n, modulus> Fp3_model<n, modulus>::zero()
 {
@@ -95,11 +123,36 @@ Fp3_model<n, modulus> Fp3_model<n, modulus>::operator*(
     const my_Fp cC = c * C;
 
     return Fp3_model<n, modulus>(
-        aA + non_residue * ((b + c) * (B + C) - bB - cC),
-        (a + b) * (A + B) - aA - bB + non_residue * cC,
+        aA + mul_by_non_residue((b + c) * (B + C) - bB - cC),
+        (a + b) * (A + B) - aA - bB + mul_by_non_residue(cC),
         (a + c) * (A + C) - aA + bB - cC);
 }
 
+template<mp_size_t n, const bigint<n> &modulus>
+Fp_model<n, modulus> Fp3_model<n, modulus>::mul_by_non_residue(
+    const my_Fp &elem)
+{
+    if (small_non_residue == 0) {
+        return non_residue * elem;
+    }
+
+    // Double-and-add over the bits of |small_non_residue|.
+    const unsigned long k = (small_non_residue < 0) ? -small_non_residue
+                                                    : small_non_residue;
+    long i = 0;
+    while ((k >> (i + 1)) != 0) {
+        ++i;
+    }
+    my_Fp result = elem;
+    for (--i; i >= 0; --i) {
+        result += result;
+        if ((k >> i) & 1) {
+            result += elem;
+        }
+    }
+    return (small_non_residue < 0) ? -result : result;
+}
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp3_model<n, modulus> Fp3_model<n, modulus>::operator-() const
 {
@@ -123,7 +176,9 @@ Fp3_model<n, modulus> Fp3_model<n, modulus>::squared() const
     const my_Fp s4 = c.squared();
 
     return Fp3_model<n, modulus>(
-        s0 + non_residue * s3, s1 + non_residue * s4, s1 + s2 + s3 - s0 - s4);
+        s0 + mul_by_non_residue(s3),
+        s1 + mul_by_non_residue(s4),
+        s1 + s2 + s3 - s0 - s4);
 }
 
 template<mp_size_t n, const bigint<n> &modulus>
@@ -140,11 +195,11 @@ Fp3_model<n, modulus> Fp3_model<n, modulus>::inverse() const
     const my_Fp t3 = a * b;
     const my_Fp t4 = a * c;
     const my_Fp t5 = b * c;
-    const my_Fp c0 = t0 - non_residue * t5;
-    const my_Fp c1 = non_residue * t2 - t3;
+    const my_Fp c0 = t0 - mul_by_non_residue(t5);
+    const my_Fp c1 = mul_by_non_residue(t2) - t3;
     const my_Fp c2 = t1 - t4; // typo in paper referenced above. should be "-"
                               // as per Scott, but is "*"
-    const my_Fp t6 = (a * c0 + non_residue * (c * c1 + b * c2)).inverse();
+    const my_Fp t6 = (a * c0 + mul_by_non_residue(c * c1 + b * c2)).inverse();
     return Fp3_model<n, modulus>(t6 * c0, t6 * c1, t6 * c2);
 }
 
@@ -165,7 +220,7 @@ Fp3_model<n, modulus> Fp3_model<n, modulus>::sqrt() const
 
     size_t v = Fp3_model<n, modulus>::s;
     Fp3_model<n, modulus> z = Fp3_model<n, modulus>::nqr_to_t;
-    Fp3_model<n, modulus> w = (*this) ^ Fp3_model<n, modulus>::t_minus_1_over_2;
+    Fp3_model<n, modulus> w = power(*this, t_minus_1_over_2_plan);
     Fp3_model<n, modulus> x = (*this) * w;
     Fp3_model<n, modulus> b = x * w; // b = (*this)^t
 
@@ -208,6 +263,12 @@ Fp3_model<n, modulus> Fp3_model<n, modulus>::sqrt() const
     return x;
 }
 
+template<mp_size_t n, const bigint<n> &modulus>
+bool Fp3_model<n, modulus>::is_square() const
+{
+    return this->is_zero() || power(*this, euler_plan) == one();
+}
+
 template<mp_size_t n, const bigint<n> &modulus>
 template<mp_size_t m>
 Fp3_model<n, modulus> Fp3_model<n, modulus>::operator^(
@@ -15,12 +15,34 @@
 namespace libff
 {
 
+namespace internal
+{
+
+/// Squaring in Fp2 = Fp[Y]/(Y^2-non_residue), where non_residue is that of
+/// Fp3, as used by Fp6_2over3_model::cyclotomic_squared (Complex method).
+template<mp_size_t n, const bigint<n> &modulus>
+Fp2_model<n, modulus> fp6_2over3_Fp2_squared(const Fp2_model<n, modulus> &x)
+{
+    typedef Fp3_model<n, modulus> my_Fp3;
+    const Fp_model<n, modulus> &a = x.coeffs[0], &b = x.coeffs[1];
+    const Fp_model<n, modulus> ab = a * b;
+    return Fp2_model<n, modulus>(
+        (a + b) * (a + my_Fp3::mul_by_non_residue(b)) - ab -
+            my_Fp3::mul_by_non_residue(ab),
+        ab + ab);
+}
+
+} // namespace internal
+
 template<mp_size_t n, const bigint<n> &modulus>
 Fp3_model<n, modulus> Fp6_2over3_model<n, modulus>::mul_by_non_residue(
     const Fp3_model<n, modulus> &elem)
 {
+    // Fp6 = Fp3[Y]/(Y^2-X), so non_residue is that of Fp3.
     return Fp3_model<n, modulus>(
-        non_residue * elem.coeffs[2], elem.coeffs[0], elem.coeffs[1]);
+        my_Fp3::mul_by_non_residue(elem.coeffs[2]),
+        elem.coeffs[0],
+        elem.coeffs[1]);
 }
 
 template<mp_size_t n, const bigint<n> &modulus>
@@ -108,39 +130,25 @@ Fp6_2over3_model<n, modulus> Fp6_2over3_model<n, modulus>::mul_by_045(
     const Fp_model<n, modulus> &ell_VW,
     const Fp_model<n, modulus> &ell_VV) const
 {
-    // OLD
-    //   Fp6_2over3_model<n,modulus> a(
-    //     my_Fp3(ell_VW, my_Fp::zero(), my_Fp::zero()),
-    //     my_Fp3(my_Fp::zero(),
-    //     ell_0,
-    //     ell_VV));
-    //   return (*this) * a;
-
-    my_Fp z0 = this->coeffs[0].coeffs[0];
-    my_Fp z1 = this->coeffs[0].coeffs[1];
-    my_Fp z2 = this->coeffs[0].coeffs[2];
-    my_Fp z3 = this->coeffs[1].coeffs[0];
-    my_Fp z4 = this->coeffs[1].coeffs[1];
-    my_Fp z5 = this->coeffs[1].coeffs[2];
-
-    my_Fp x0 = ell_VW;
-    my_Fp x4 = ell_0;
-    my_Fp x5 = ell_VV;
-
-    my_Fp t0, t1, t2, t3, t4, t5;
-    my_Fp tmp1, tmp2;
-
-    tmp1 = my_Fp3::non_residue * x4;
-    tmp2 = my_Fp3::non_residue * x5;
-
-    t0 = x0 * z0 + tmp1 * z4 + tmp2 * z3;
-    t1 = x0 * z1 + tmp1 * z5 + tmp2 * z4;
-    t2 = x0 * z2 + x4 * z3 + tmp2 * z5;
-    t3 = x0 * z3 + tmp1 * z2 + tmp2 * z1;
-    t4 = x0 * z4 + x4 * z0 + tmp2 * z2;
-    t5 = x0 * z5 + x4 * z1 + x5 * z0;
-
-    return Fp6_2over3_model<n, modulus>(my_Fp3(t0, t1, t2), my_Fp3(t3, t4, t5));
+    // Karatsuba, as for operator*, with other = A + BY for A = (ell_VW, 0, 0)
+    // and B = (0, ell_0, ell_VV). aA takes 3 multiplications in Fp, bB takes
+    // 5 (Karatsuba over the two nonzero coefficients of B) and the cross
+    // term 6, rather than 18 for the schoolbook product.
+    const my_Fp3 &a = this->coeffs[0], &b = this->coeffs[1];
+    const my_Fp &b0 = b.coeffs[0], &b1 = b.coeffs[1], &b2 = b.coeffs[2];
+
+    const my_Fp3 aA = ell_VW * a;
+    const my_Fp b1B1 = b1 * ell_0;
+    const my_Fp b2B2 = b2 * ell_VV;
+    const my_Fp3 bB(
+        my_Fp3::mul_by_non_residue(
+            (b1 + b2) * (ell_0 + ell_VV) - b1B1 - b2B2),
+        b0 * ell_0 + my_Fp3::mul_by_non_residue(b2B2),
+        b0 * ell_VV + b1B1);
+
+    return Fp6_2over3_model<n, modulus>(
+        aA + Fp6_2over3_model<n, modulus>::mul_by_non_residue(bB),
+        (a + b) * my_Fp3(ell_VW, ell_0, ell_VV) - aA - bB);
 }
 
 template<mp_size_t n, const bigint<n> &modulus>
@@ -155,8 +163,8 @@ Fp6_2over3_model<n, modulus> Fp6_2over3_model<n, modulus>::mul_by_2345(
     const my_Fp3 &B = other.coeffs[1], &A = other.coeffs[0],
                  &b = this->coeffs[1], &a = this->coeffs[0];
     const my_Fp3 aA = my_Fp3(
-        a.coeffs[1] * A.coeffs[2] * non_residue,
-        a.coeffs[2] * A.coeffs[2] * non_residue,
+        my_Fp3::mul_by_non_residue(a.coeffs[1] * A.coeffs[2]),
+        my_Fp3::mul_by_non_residue(a.coeffs[2] * A.coeffs[2]),
         a.coeffs[0] * A.coeffs[2]);
     const my_Fp3 bB = b * B;
     const my_Fp3 beta_bB = Fp6_2over3_model<n, modulus>::mul_by_non_residue(bB);
@@ -232,9 +240,9 @@ Fp6_2over3_model<n, modulus> Fp6_2over3_model<n, modulus>::cyclotomic_squared()
     // my_Fp c_a = c0.coeffs[1]; // c = Fp2([c0[1],c1[2]])
     // my_Fp c_b = c1.coeffs[2];
 
-    my_Fp2 asq = a.squared();
-    my_Fp2 bsq = b.squared();
-    my_Fp2 csq = c.squared();
+    my_Fp2 asq = internal::fp6_2over3_Fp2_squared(a);
+    my_Fp2 bsq = internal::fp6_2over3_Fp2_squared(b);
+    my_Fp2 csq = internal::fp6_2over3_Fp2_squared(c);
 
     // A = vector(3*a^2 - 2*Fp2([vector(a)[0],-vector(a)[1]]))
     // my_Fp A_a = my_Fp(3l) * asq_a - my_Fp(2l) * a_a;
@@ -247,7 +255,7 @@ Fp6_2over3_model<n, modulus> Fp6_2over3_model<n, modulus>::cyclotomic_squared()
     // B = vector(3*Fp2([non_residue*c2[1],c2[0]]) +
     // 2*Fp2([vector(b)[0],-vector(b)[1]])) my_Fp B_a = my_Fp(3l) *
     // my_Fp3::non_residue * csq_b + my_Fp(2l) * b_a;
-    my_Fp B_tmp = my_Fp3::non_residue * csq.coeffs[1];
+    my_Fp B_tmp = my_Fp3::mul_by_non_residue(csq.coeffs[1]);
     my_Fp B_a = B_tmp + b.coeffs[0];
     B_a = B_a + B_a + B_tmp;
 
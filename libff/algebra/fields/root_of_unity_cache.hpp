@@ -0,0 +1,105 @@
+/** @file
+ *****************************************************************************
+
+ Per-field cache of roots of unity and twiddle-factor tables, shared by
+ NTT/FFT consumers so that these values are not recomputed on every call.
+
+ For a transform of size n = 2^log_n, the twiddle table holds the n/2 values
+ omega_n^bitreverse(i, log_n - 1), 0 <= i < n/2 (and the same for the
+ inverse of omega_n), where omega_n = get_root_of_unity<FieldT>(n). Since
+ omega_{n/2} = omega_n^2, the table for size n begins with the table for
+ size n/2, so a single table (for the largest size requested so far) serves
+ all smaller sizes. In a radix-2 transform with natural-order input and
+ bit-reversed output, the j-th block of every layer uses twiddle j.
+
+ All functions are thread-safe. Tables are computed on first use and cached
+ up to a configurable memory limit. Larger tables are computed on each
+ request, and not retained.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ROOT_OF_UNITY_CACHE_HPP_
+#define ROOT_OF_UNITY_CACHE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libff
+{
+
+/// Default limit on the memory used by the cached twiddle tables of each
+/// field.
+static const size_t ROOT_OF_UNITY_CACHE_DEFAULT_MEMORY_LIMIT = 1ull << 30;
+
+template<typename FieldT> class twiddle_table
+{
+public:
+    /// The table serves transforms of size up to 2^max_log_n.
+    size_t max_log_n;
+    /// omega^bitreverse(i, max_log_n - 1), for omega of order 2^max_log_n.
+    std::vector<FieldT> twiddles;
+    /// As twiddles, for the inverse of omega.
+    std::vector<FieldT> inverse_twiddles;
+};
+
+template<typename FieldT> class root_of_unity_cache
+{
+public:
+    /// Root of unity of order 2^log_n (equal to get_root_of_unity(2^log_n)).
+    /// Throws std::invalid_argument if log_n > FieldT::s.
+    static FieldT root_of_unity(const size_t log_n);
+
+    /// Inverse of root_of_unity(log_n).
+    static FieldT inverse_root_of_unity(const size_t log_n);
+
+    /// Twiddle table supporting transforms of size (at least) 2^log_n. Throws
+    /// std::invalid_argument if log_n > FieldT::s.
+    static std::shared_ptr<const twiddle_table<FieldT>> twiddles(
+        const size_t log_n);
+
+    /// Set the maximum memory (in bytes) used by cached twiddle tables. A
+    /// cached table exceeding the new limit is released (callers holding it
+    /// keep a valid reference).
+    static void set_memory_limit(const size_t max_bytes);
+    static size_t memory_limit();
+
+    /// Memory (in bytes) used by the cached twiddle table.
+    static size_t memory_usage();
+
+    /// Release all cached values.
+    static void clear();
+
+protected:
+    class state
+    {
+    public:
+        std::mutex mutex;
+        std::vector<FieldT> roots;
+        std::vector<FieldT> inverse_roots;
+        std::shared_ptr<const twiddle_table<FieldT>> table;
+        size_t memory_limit = ROOT_OF_UNITY_CACHE_DEFAULT_MEMORY_LIMIT;
+    };
+
+    static state &get_state();
+
+    /// Populate the roots (if necessary). Must be called with the state
+    /// mutex held.
+    static void ensure_roots(state &st, const size_t log_n);
+
+    static size_t table_memory(const size_t log_n);
+
+    static std::shared_ptr<const twiddle_table<FieldT>> compute_table(
+        const size_t log_n, const FieldT &omega, const FieldT &omega_inv);
+};
+
+} // namespace libff
+
+#include "libff/algebra/fields/root_of_unity_cache.tcc"
+
+#endif // ROOT_OF_UNITY_CACHE_HPP_
@@ -0,0 +1,193 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the per-field cache of roots of unity and twiddle-factor
+ tables.
+
+ See root_of_unity_cache.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ROOT_OF_UNITY_CACHE_TCC_
+#define ROOT_OF_UNITY_CACHE_TCC_
+
+#include "libff/algebra/fields/root_of_unity_cache.hpp"
+
+#include <stdexcept>
+
+namespace libff
+{
+
+template<typename FieldT>
+FieldT root_of_unity_cache<FieldT>::root_of_unity(const size_t log_n)
+{
+    state &st = get_state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    ensure_roots(st, log_n);
+    return st.roots[log_n];
+}
+
+template<typename FieldT>
+FieldT root_of_unity_cache<FieldT>::inverse_root_of_unity(const size_t log_n)
+{
+    state &st = get_state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    ensure_roots(st, log_n);
+    return st.inverse_roots[log_n];
+}
+
+template<typename FieldT>
+std::shared_ptr<const twiddle_table<FieldT>> root_of_unity_cache<
+    FieldT>::twiddles(const size_t log_n)
+{
+    state &st = get_state();
+    std::unique_lock<std::mutex> lock(st.mutex);
+    ensure_roots(st, log_n);
+    if (st.table && st.table->max_log_n >= log_n) {
+        return st.table;
+    }
+
+    const FieldT omega = st.roots[log_n];
+    const FieldT omega_inv = st.inverse_roots[log_n];
+    if (table_memory(log_n) > st.memory_limit) {
+        // Too large to cache. Compute without blocking other callers.
+        lock.unlock();
+        return compute_table(log_n, omega, omega_inv);
+    }
+
+    // Cached tables are computed under the lock, so that concurrent callers
+    // do not duplicate the work.
+    st.table = compute_table(log_n, omega, omega_inv);
+    return st.table;
+}
+
+template<typename FieldT>
+void root_of_unity_cache<FieldT>::set_memory_limit(const size_t max_bytes)
+{
+    state &st = get_state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    st.memory_limit = max_bytes;
+    if (st.table && table_memory(st.table->max_log_n) > max_bytes) {
+        st.table.reset();
+    }
+}
+
+template<typename FieldT> size_t root_of_unity_cache<FieldT>::memory_limit()
+{
+    state &st = get_state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    return st.memory_limit;
+}
+
+template<typename FieldT> size_t root_of_unity_cache<FieldT>::memory_usage()
+{
+    state &st = get_state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    return st.table ? table_memory(st.table->max_log_n) : 0;
+}
+
+template<typename FieldT> void root_of_unity_cache<FieldT>::clear()
+{
+    state &st = get_state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    st.roots.clear();
+    st.inverse_roots.clear();
+    st.table.reset();
+}
+
+template<typename FieldT>
+typename root_of_unity_cache<FieldT>::state &root_of_unity_cache<
+    FieldT>::get_state()
+{
+    static state st;
+    return st;
+}
+
+template<typename FieldT>
+void root_of_unity_cache<FieldT>::ensure_roots(state &st, const size_t log_n)
+{
+    if (log_n > FieldT::s) {
+        throw std::invalid_argument(
+            "libff::root_of_unity_cache: expected log_n <= FieldT::s");
+    }
+
+    // Recompute if the field parameters have been (re-)initialized since the
+    // roots were computed.
+    if (!st.roots.empty() && st.roots[FieldT::s] == FieldT::root_of_unity) {
+        return;
+    }
+
+    st.roots.resize(FieldT::s + 1);
+    st.inverse_roots.resize(FieldT::s + 1);
+    st.roots[FieldT::s] = FieldT::root_of_unity;
+    st.inverse_roots[FieldT::s] = FieldT::root_of_unity.inverse();
+    for (size_t i = FieldT::s; i > 0; --i) {
+        st.roots[i - 1] = st.roots[i].squared();
+        st.inverse_roots[i - 1] = st.inverse_roots[i].squared();
+    }
+    st.table.reset();
+}
+
+template<typename FieldT>
+size_t root_of_unity_cache<FieldT>::table_memory(const size_t log_n)
+{
+    return (log_n == 0) ? 0 : (2 * sizeof(FieldT)) << (log_n - 1);
+}
+
+template<typename FieldT>
+std::shared_ptr<const twiddle_table<FieldT>> root_of_unity_cache<
+    FieldT>::compute_table(
+    const size_t log_n, const FieldT &omega, const FieldT &omega_inv)
+{
+    std::shared_ptr<twiddle_table<FieldT>> table =
+        std::make_shared<twiddle_table<FieldT>>();
+    table->max_log_n = log_n;
+    if (log_n == 0) {
+        return table;
+    }
+
+    // With L = log_n - 1, bitreverse(i + 2^k, L) = bitreverse(i, L) +
+    // 2^(L-1-k) for i < 2^k, so the second half of each prefix of length
+    // 2^(k+1) is the first half multiplied by omega^(2^(L-1-k)).
+    const size_t half = 1ull << (log_n - 1);
+    table->twiddles.resize(half);
+    table->inverse_twiddles.resize(half);
+    table->twiddles[0] = FieldT::one();
+    table->inverse_twiddles[0] = FieldT::one();
+
+    // multipliers[k] = omega^(2^(L-1-k)), i.e. the root of order 2^(k+2).
+    FieldT step = omega;
+    FieldT step_inv = omega_inv;
+    std::vector<FieldT> multipliers(log_n - 1);
+    std::vector<FieldT> inverse_multipliers(log_n - 1);
+    for (size_t k = log_n - 1; k > 0; --k) {
+        multipliers[k - 1] = step;
+        inverse_multipliers[k - 1] = step_inv;
+        step = step.squared();
+        step_inv = step_inv.squared();
+    }
+
+    for (size_t k = 0; k + 1 < log_n; ++k) {
+        const size_t len = 1ull << k;
+        const FieldT m = multipliers[k];
+        const FieldT m_inv = inverse_multipliers[k];
+#ifdef MULTICORE
+#pragma omp parallel for if (len >= 4096)
+#endif
+        for (size_t i = 0; i < len; ++i) {
+            table->twiddles[len + i] = table->twiddles[i] * m;
+            table->inverse_twiddles[len + i] =
+                table->inverse_twiddles[i] * m_inv;
+        }
+    }
+
+    return table;
+}
+
+} // namespace libff
+
+#endif // ROOT_OF_UNITY_CACHE_TCC_
@@ -8,11 +8,13 @@
 #include <gtest/gtest.h>
 #include <libff/algebra/curves/bls12_377/bls12_377_pp.hpp>
 #include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/curves/bw6_761/bw6_761_pp.hpp>
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
 #include <libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp>
 #include <libff/algebra/curves/mnt/mnt6/mnt6_pp.hpp>
 #include <libff/algebra/fields/field_serialization.hpp>
 #include <libff/algebra/fields/field_utils.hpp>
+#include <libff/algebra/fields/root_of_unity_cache.hpp>
 #include <libff/common/profiling.hpp>
 #ifdef CURVE_BN128
 #include <libff/algebra/curves/bn128/bn128_pp.hpp>
@@ -70,6 +72,54 @@ template<typename FieldT> void test_sqrt()
     }
 }
 
+template<typename FieldT> void test_is_square()
+{
+    ASSERT_TRUE(FieldT::zero().is_square());
+    ASSERT_TRUE(FieldT::one().is_square());
+    ASSERT_FALSE(FieldT::nqr.is_square());
+    for (size_t i = 0; i < 10; ++i) {
+        const FieldT a = FieldT::random_element();
+        ASSERT_TRUE(a.squared().is_square());
+        if (!a.is_zero()) {
+            ASSERT_FALSE((a.squared() * FieldT::nqr).is_square());
+        }
+    }
+}
+
+template<typename FieldT> void test_exponentiation_plan()
+{
+    typedef typename FieldT::my_Fp::bigint_t bigint_t;
+    const FieldT a = FieldT::random_element();
+
+    ASSERT_EQ(FieldT::one(), power(a, exponentiation_plan()));
+    ASSERT_EQ(FieldT::one(), power(a, exponentiation_plan(bigint_t(0ul))));
+    for (unsigned long e : {1ul, 2ul, 3ul, 5ul, 8ul, 0xfffful, 0x10001ul}) {
+        const bigint_t b(e);
+        ASSERT_EQ(a ^ b, power(a, exponentiation_plan(b)));
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        const bigint_t e = FieldT::my_Fp::random_element().as_bigint();
+        const exponentiation_plan plan(e);
+        ASSERT_EQ(a ^ e, power(a, plan));
+        // At most one squaring per bit (including that of the table), and
+        // roughly one multiplication per window.
+        ASSERT_LE(plan.num_squarings(), e.num_bits());
+        ASSERT_LT(plan.num_multiplications(), e.num_bits() / 4 + 32);
+    }
+
+    // Explicit plans: x^2, x^3 = x^2 * x, x^6 = (x^3)^2.
+    const exponentiation_plan six(3, 2, {{1, 0, 0}, {2, 1, 0}, {2, 2, 2}});
+    ASSERT_EQ(a ^ bigint_t(6ul), power(a, six));
+    ASSERT_EQ(2u, six.num_squarings());
+    ASSERT_EQ(1u, six.num_multiplications());
+    ASSERT_THROW(
+        exponentiation_plan(3, 2, {{1, 0, 0}, {2, 2, 1}}),
+        std::invalid_argument);
+    ASSERT_THROW(exponentiation_plan(2, 1, {{0, 0, 0}}), std::invalid_argument);
+    ASSERT_THROW(exponentiation_plan(2, 2, {{1, 0, 0}}), std::invalid_argument);
+    ASSERT_THROW(exponentiation_plan(2, 1, {}), std::invalid_argument);
+}
+
 template<typename FieldT> void test_two_squarings()
 {
     FieldT a = FieldT::random_element();
@@ -138,6 +188,73 @@ template<> void test_cyclotomic_squaring<Fqk<mnt6_pp>>()
     ASSERT_EQ(beta.cyclotomic_squared(), beta.squared());
 }
 
+#ifdef PROFILE_OP_COUNTS
+/// Number of multiplications (including squarings) in the base field of
+/// Fp6T performed by f().
+template<typename Fp6T, typename F> long long count_base_field_muls(F f)
+{
+    typedef typename Fp6T::my_Fp my_Fp;
+    const long long before = my_Fp::mul_cnt + my_Fp::sqr_cnt;
+    f();
+    return my_Fp::mul_cnt + my_Fp::sqr_cnt - before;
+}
+#endif
+
+template<typename Fp6T> void test_Fp6_2over3_arithmetic()
+{
+    typedef typename Fp6T::my_Fp my_Fp;
+    typedef typename Fp6T::my_Fp3 my_Fp3;
+
+    const my_Fp x = my_Fp::random_element();
+    ASSERT_EQ(my_Fp3::non_residue * x, my_Fp3::mul_by_non_residue(x));
+    ASSERT_EQ(-my_Fp3::non_residue * x, my_Fp3::mul_by_non_residue(-x));
+
+    const my_Fp3 u = my_Fp3::random_element();
+    const my_Fp3 v = my_Fp3::random_element();
+    ASSERT_EQ(u * u, u.squared());
+    ASSERT_EQ(my_Fp3::one(), u * u.inverse());
+
+    const Fp6T a = Fp6T::random_element();
+    const Fp6T b = Fp6T::random_element();
+    const my_Fp ell_0 = my_Fp::random_element();
+    const my_Fp ell_VW = my_Fp::random_element();
+    const my_Fp ell_VV = my_Fp::random_element();
+    const Fp6T line(
+        my_Fp3(ell_VW, my_Fp::zero(), my_Fp::zero()),
+        my_Fp3(my_Fp::zero(), ell_0, ell_VV));
+    ASSERT_EQ(a * line, a.mul_by_045(ell_0, ell_VW, ell_VV));
+    ASSERT_EQ(a * a, a.squared());
+    ASSERT_EQ(Fp6T::one(), a * a.inverse());
+
+    // beta = a^((q^3-1)*(q+1)) is in the cyclotomic subgroup.
+    const Fp6T a_unitary = a.Frobenius_map(3) * a.inverse();
+    const Fp6T beta = a_unitary.Frobenius_map(1) * a_unitary;
+    ASSERT_EQ(beta.squared(), beta.cyclotomic_squared());
+
+#ifdef PROFILE_OP_COUNTS
+    // With a small non_residue, multiplication by it takes no
+    // multiplications.
+    if (my_Fp3::small_non_residue != 0) {
+        ASSERT_EQ(0, count_base_field_muls<Fp6T>([&] {
+                      (void)my_Fp3::mul_by_non_residue(x);
+                  }));
+        ASSERT_EQ(6, count_base_field_muls<Fp6T>([&] { (void)(u * v); }));
+        ASSERT_EQ(5, count_base_field_muls<Fp6T>([&] { (void)u.squared(); }));
+        ASSERT_EQ(18, count_base_field_muls<Fp6T>([&] { (void)(a * b); }));
+        ASSERT_EQ(12, count_base_field_muls<Fp6T>([&] { (void)a.squared(); }));
+        ASSERT_EQ(14, count_base_field_muls<Fp6T>([&] {
+                      (void)a.mul_by_045(ell_0, ell_VW, ell_VV);
+                  }));
+        ASSERT_EQ(6, count_base_field_muls<Fp6T>([&] {
+                      (void)beta.cyclotomic_squared();
+                  }));
+    }
+#else
+    (void)v;
+    (void)b;
+#endif
+}
+
 template<typename ppT> void test_all_fields()
 {
     test_field<Fr<ppT>>();
@@ -149,6 +266,10 @@ template<typename ppT> void test_all_fields()
     test_sqrt<Fq<ppT>>();
     test_sqrt<Fqe<ppT>>();
 
+    test_is_square<Fr<ppT>>();
+    test_is_square<Fq<ppT>>();
+    test_is_square<Fqe<ppT>>();
+
     test_Frobenius<Fqe<ppT>>();
     test_Frobenius<Fqk<ppT>>();
 
@@ -442,6 +563,113 @@ template<typename ppT> void test_serialization()
     test_field_serialization_all_configs<Fqk<ppT>>();
 }
 
+template<typename FieldT> void test_root_of_unity_cache()
+{
+    using cache = root_of_unity_cache<FieldT>;
+
+    // Roots have the expected order, and match repeated squaring.
+    FieldT omega = FieldT::root_of_unity;
+    for (size_t log_n = FieldT::s; log_n <= FieldT::s; --log_n) {
+        ASSERT_EQ(omega, cache::root_of_unity(log_n));
+        ASSERT_EQ(omega, get_root_of_unity<FieldT>(1ull << log_n));
+        ASSERT_EQ(FieldT::one(), omega * cache::inverse_root_of_unity(log_n));
+        ASSERT_EQ(FieldT::one(), omega ^ (1ull << log_n));
+        if (log_n > 0) {
+            ASSERT_NE(FieldT::one(), omega ^ (1ull << (log_n - 1)));
+        }
+        omega = omega.squared();
+    }
+    ASSERT_THROW(cache::root_of_unity(FieldT::s + 1), std::invalid_argument);
+
+    // Twiddles are bit-reversed powers of the root, and the table for a
+    // larger size serves smaller sizes.
+    const size_t log_n = 6;
+    const FieldT omega_n = cache::root_of_unity(log_n);
+    const FieldT omega_n_inv = cache::inverse_root_of_unity(log_n);
+    const std::shared_ptr<const twiddle_table<FieldT>> table =
+        cache::twiddles(log_n);
+    ASSERT_LE((1ull << (log_n - 1)), table->twiddles.size());
+    for (size_t i = 0; i < (1ull << (log_n - 1)); ++i) {
+        const size_t e = bitreverse(i, log_n - 1);
+        ASSERT_EQ(omega_n ^ e, table->twiddles[i]);
+        ASSERT_EQ(omega_n_inv ^ e, table->inverse_twiddles[i]);
+    }
+    ASSERT_EQ(table, cache::twiddles(log_n - 2));
+    ASSERT_LT(0, cache::memory_usage());
+
+    // Tables exceeding the memory limit are computed, but not retained.
+    const size_t limit = cache::memory_limit();
+    cache::set_memory_limit(0);
+    ASSERT_EQ(0, cache::memory_usage());
+    const std::shared_ptr<const twiddle_table<FieldT>> uncached =
+        cache::twiddles(log_n);
+    ASSERT_EQ(table->twiddles, uncached->twiddles);
+    ASSERT_EQ(0, cache::memory_usage());
+    cache::set_memory_limit(limit);
+}
+
+template<typename FieldT> void test_word_conversions()
+{
+    // Compare against the bit_vector functions, for sizes which do not fall
+    // on word or element boundaries.
+    std::vector<FieldT> elements(131);
+    for (FieldT &el : elements) {
+        el = FieldT::random_element();
+    }
+    elements[0] = -FieldT::one();
+    const bit_vector bits =
+        convert_field_element_vector_to_bit_vector(elements);
+
+    std::vector<uint64_t> words(
+        field_element_vector_num_words<FieldT>(elements.size()), ~0ull);
+    ASSERT_EQ(div_ceil(bits.size(), 64), words.size());
+    convert_field_element_vector_to_words(elements, words.data());
+    for (size_t i = 0; i < bits.size(); ++i) {
+        ASSERT_EQ(bits[i], ((words[i / 64] >> (i % 64)) & 1) == 1);
+    }
+
+    std::vector<uint64_t> element_words(
+        field_element_vector_num_words<FieldT>(1));
+    convert_field_element_to_words(elements[1], element_words.data());
+    ASSERT_EQ(
+        elements[1],
+        convert_words_to_field_element<FieldT>(
+            element_words.data(), FieldT::size_in_bits()));
+
+    for (const size_t num_bits : {0, 1, 63, 64, 65, 1000, 4097}) {
+        const bit_vector prefix(bits.begin(), bits.begin() + num_bits);
+        ASSERT_EQ(
+            pack_bit_vector_into_field_element_vector<FieldT>(prefix),
+            pack_words_into_field_element_vector<FieldT>(
+                words.data(), num_bits));
+        ASSERT_EQ(
+            pack_bit_vector_into_field_element_vector<FieldT>(prefix, 100),
+            pack_words_into_field_element_vector<FieldT>(
+                words.data(), num_bits, 100));
+        ASSERT_EQ(
+            convert_bit_vector_to_field_element_vector<FieldT>(prefix),
+            convert_words_to_field_element_vector<FieldT>(
+                words.data(), num_bits));
+        if (num_bits <= FieldT::size_in_bits()) {
+            ASSERT_EQ(
+                convert_bit_vector_to_field_element<FieldT>(prefix),
+                convert_words_to_field_element<FieldT>(
+                    words.data(), num_bits));
+        }
+    }
+}
+
+template<typename FieldT> void test_random_field_element_bits()
+{
+    for (const size_t num_bits : {1, 63, 64, 65, 128}) {
+        for (size_t i = 0; i < 16; ++i) {
+            const FieldT r = random_field_element_bits<FieldT>(num_bits);
+            ASSERT_FALSE(r.is_zero());
+            ASSERT_LE(r.as_bigint().num_bits(), num_bits);
+        }
+    }
+}
+
 TEST(FieldsTest, BigInt)
 {
     const std::string a_str("0");
@@ -528,6 +756,7 @@ TEST(FieldsTest, Edwards)
     test_serialization<edwards_pp>();
     test_all_fields<edwards_pp>();
     test_cyclotomic_squaring<Fqk<edwards_pp>>();
+    test_Fp6_2over3_arithmetic<edwards_Fq6>();
 }
 
 TEST(FieldsTest, MNT4)
@@ -546,6 +775,17 @@ TEST(FieldsTest, MNT6)
     test_serialization<mnt6_pp>();
     test_all_fields<mnt6_pp>();
     test_cyclotomic_squaring<Fqk<mnt6_pp>>();
+    test_Fp6_2over3_arithmetic<mnt6_Fq6>();
+}
+
+TEST(FieldsTest, BW6_761)
+{
+    bw6_761_pp::init_public_params();
+    test_field<bw6_761_Fq3>();
+    test_field<bw6_761_Fq6>();
+    test_sqrt<bw6_761_Fq3>();
+    test_is_square<bw6_761_Fq3>();
+    test_Fp6_2over3_arithmetic<bw6_761_Fq6>();
 }
 
 TEST(FieldsTest, ALT_BN128)
@@ -557,6 +797,8 @@ TEST(FieldsTest, ALT_BN128)
     test_all_fields<alt_bn128_pp>();
     test_Fp12_2over3over2_mul_by_024<alt_bn128_Fq12>();
     test_signed_digits<alt_bn128_Fr>();
+    test_root_of_unity_cache<alt_bn128_Fr>();
+    test_word_conversions<alt_bn128_Fr>();
 
     test_field_get_digit_alt_bn128();
 }
@@ -592,4 +834,9 @@ TEST(FieldsTest, BLS12_381)
     test_all_fields<bls12_381_pp>();
     test_Fp12_2over3over2_mul_by_024<bls12_381_Fq12>();
     test_signed_digits<bls12_381_Fr>();
+    test_root_of_unity_cache<bls12_381_Fr>();
+    test_word_conversions<bls12_381_Fr>();
+    test_random_field_element_bits<bls12_381_Fr>();
+    test_exponentiation_plan<bls12_381_Fq>();
+    test_exponentiation_plan<bls12_381_Fq2>();
 }
@@ -0,0 +1,162 @@
+/** @file
+ *****************************************************************************
+
+ KZG polynomial commitments [KZG10] over the pairing-friendly curves defined
+ via public_params.hpp.
+
+ For a structured reference string (SRS) with secret tau, a polynomial p
+ (given by its coefficients, lowest degree first) is committed to as
+ C = [p(tau)]_1. An opening of p at z is the value y = p(z) together with the
+ witness W = [q(tau)]_1, where q(X) = (p(X) - y) / (X - z), and is verified
+ by checking
+
+     e(W, [tau]_2) * e(-(C - [y]_1 + z W), [1]_2) == 1
+
+ which requires a single (shared) Miller loop over both pairs and one final
+ exponentiation. The G2 elements of the SRS are precomputed once, when the
+ SRS is constructed.
+
+ Batched variants:
+   - Several polynomials opened at one point z share a single witness, by
+     opening the random linear combination \sum_i gamma^i p_i for a challenge
+     gamma (which the caller derives, e.g. via Fiat-Shamir, after the
+     commitments are fixed).
+   - Openings of any polynomials at any points are verified together by
+     combining the individual checks with random scalars, so that a single
+     (shared) Miller loop is required in total.
+
+ Commitments and witnesses are computed with multi_exp, using the given
+ number of chunks for parallelism.
+
+ References:
+
+ [KZG10]:
+   "Constant-Size Commitments to Polynomials and Their Applications",
+   Aniket Kate, Gregory M. Zaverucha, Ian Goldberg,
+   ASIACRYPT 2010
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef KZG_HPP_
+#define KZG_HPP_
+
+#include "libff/algebra/curves/public_params.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace libff
+{
+
+/// Method used for all KZG multi-exponentiations.
+static const multi_exp_method KZG_MULTI_EXP_METHOD =
+    multi_exp_method_auto;
+
+template<typename ppT> class kzg_srs
+{
+public:
+    /// [tau^i]_1 for 0 <= i < max_num_coefficients(), in special form.
+    std::vector<G1<ppT>> powers_of_tau_g1;
+    G2<ppT> tau_g2;
+
+    /// Precomputed [1]_2 and [tau]_2.
+    G2_precomp<ppT> one_g2_precomp;
+    G2_precomp<ppT> tau_g2_precomp;
+
+    /// Construct from the powers [tau^i]_1 and [tau]_2 (e.g. from a trusted
+    /// setup).
+    kzg_srs(std::vector<G1<ppT>> &&powers_of_tau_g1, const G2<ppT> &tau_g2);
+
+    /// Generate an SRS supporting polynomials with up to
+    /// max_num_coefficients coefficients, from a known secret tau. For
+    /// testing only.
+    static kzg_srs generate(
+        const size_t max_num_coefficients, const Fr<ppT> &tau);
+
+    size_t max_num_coefficients() const;
+};
+
+template<typename ppT> class kzg_opening
+{
+public:
+    /// The value p(z).
+    Fr<ppT> value;
+    /// [q(tau)]_1, where q(X) = (p(X) - p(z)) / (X - z).
+    G1<ppT> witness;
+};
+
+template<typename ppT> class kzg_multi_polynomial_opening
+{
+public:
+    /// The values p_i(z).
+    std::vector<Fr<ppT>> values;
+    /// The witness for \sum_i gamma^i p_i.
+    G1<ppT> witness;
+};
+
+/// Commit to the polynomial with the given coefficients. Throws
+/// std::invalid_argument if there are more coefficients than the SRS
+/// supports.
+template<typename ppT>
+G1<ppT> kzg_commit(
+    const kzg_srs<ppT> &srs,
+    const std::vector<Fr<ppT>> &coefficients,
+    const size_t chunks = 1);
+
+/// Open the polynomial with the given coefficients at z.
+template<typename ppT>
+kzg_opening<ppT> kzg_open(
+    const kzg_srs<ppT> &srs,
+    const std::vector<Fr<ppT>> &coefficients,
+    const Fr<ppT> &z,
+    const size_t chunks = 1);
+
+template<typename ppT>
+bool kzg_verify(
+    const kzg_srs<ppT> &srs,
+    const G1<ppT> &commitment,
+    const Fr<ppT> &z,
+    const kzg_opening<ppT> &opening);
+
+/// Open each of the given polynomials at z, with a single witness for the
+/// combination with challenge gamma.
+template<typename ppT>
+kzg_multi_polynomial_opening<ppT> kzg_open_multi_polynomial(
+    const kzg_srs<ppT> &srs,
+    const std::vector<std::vector<Fr<ppT>>> &polynomials,
+    const Fr<ppT> &z,
+    const Fr<ppT> &gamma,
+    const size_t chunks = 1);
+
+/// Verify an opening created by kzg_open_multi_polynomial, where
+/// commitments[i] is the commitment to the i-th polynomial.
+template<typename ppT>
+bool kzg_verify_multi_polynomial(
+    const kzg_srs<ppT> &srs,
+    const std::vector<G1<ppT>> &commitments,
+    const Fr<ppT> &z,
+    const Fr<ppT> &gamma,
+    const kzg_multi_polynomial_opening<ppT> &opening);
+
+/// Verify that each openings[i] is a valid opening, at points[i], of the
+/// polynomial with commitment commitments[i]. Invalid openings are detected
+/// except with negligible probability (over the internally generated random
+/// scalars). Throws std::invalid_argument if the sizes differ.
+template<typename ppT>
+bool kzg_batch_verify(
+    const kzg_srs<ppT> &srs,
+    const std::vector<G1<ppT>> &commitments,
+    const std::vector<Fr<ppT>> &points,
+    const std::vector<kzg_opening<ppT>> &openings,
+    const size_t chunks = 1);
+
+} // namespace libff
+
+#include "libff/algebra/kzg/kzg.tcc"
+
+#endif // KZG_HPP_
@@ -0,0 +1,285 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of KZG polynomial commitments.
+
+ See kzg.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef KZG_TCC_
+#define KZG_TCC_
+
+#include "libff/algebra/kzg/kzg.hpp"
+#include "libff/algebra/polynomial/polynomial.hpp"
+
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Divide the polynomial with the given coefficients by (X - z), returning
+/// the quotient and setting remainder to p(z).
+template<typename FieldT>
+std::vector<FieldT> kzg_divide(
+    const std::vector<FieldT> &coefficients, const FieldT &z, FieldT &remainder)
+{
+    const size_t n = coefficients.size();
+    if (n == 0) {
+        remainder = FieldT::zero();
+        return std::vector<FieldT>();
+    }
+
+    std::vector<FieldT> quotient(n - 1);
+    FieldT acc = coefficients[n - 1];
+    for (size_t i = n - 1; i > 0; --i) {
+        quotient[i - 1] = acc;
+        acc = coefficients[i - 1] + z * acc;
+    }
+    remainder = acc;
+    return quotient;
+}
+
+/// Check e(lhs, [tau]_2) == e(rhs, [1]_2).
+template<typename ppT>
+bool kzg_check_pairing(
+    const kzg_srs<ppT> &srs, const G1<ppT> &lhs, const G1<ppT> &rhs)
+{
+    // Both sides are in the prime-order subgroup, so if either is zero, the
+    // equation holds iff both are. This also avoids precomputing the point
+    // at infinity.
+    if (lhs.is_zero() || rhs.is_zero()) {
+        return lhs.is_zero() && rhs.is_zero();
+    }
+
+    const Fqk<ppT> f = ppT::double_miller_loop(
+        ppT::precompute_G1(lhs),
+        srs.tau_g2_precomp,
+        ppT::precompute_G1(-rhs),
+        srs.one_g2_precomp);
+    return ppT::final_exponentiation(f) == GT<ppT>::one();
+}
+
+template<typename ppT>
+G1<ppT> kzg_linear_combination(
+    const std::vector<G1<ppT>> &bases,
+    const std::vector<Fr<ppT>> &scalars,
+    const size_t chunks)
+{
+    assert(bases.size() == scalars.size());
+    if (bases.empty()) {
+        return G1<ppT>::zero();
+    }
+
+    return multi_exp<G1<ppT>, Fr<ppT>, KZG_MULTI_EXP_METHOD>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), chunks);
+}
+
+} // namespace internal
+
+template<typename ppT>
+kzg_srs<ppT>::kzg_srs(
+    std::vector<G1<ppT>> &&powers_of_tau_g1, const G2<ppT> &tau_g2)
+    : powers_of_tau_g1(std::move(powers_of_tau_g1))
+    , tau_g2(tau_g2)
+    , one_g2_precomp(ppT::precompute_G2(G2<ppT>::one()))
+    , tau_g2_precomp(ppT::precompute_G2(tau_g2))
+{
+    batch_to_special(this->powers_of_tau_g1);
+}
+
+template<typename ppT>
+kzg_srs<ppT> kzg_srs<ppT>::generate(
+    const size_t max_num_coefficients, const Fr<ppT> &tau)
+{
+    std::vector<Fr<ppT>> powers(max_num_coefficients);
+    Fr<ppT> power = Fr<ppT>::one();
+    for (Fr<ppT> &p : powers) {
+        p = power;
+        power *= tau;
+    }
+
+    const size_t scalar_size = Fr<ppT>::size_in_bits();
+    const size_t window = get_exp_window_size<G1<ppT>>(max_num_coefficients);
+    const window_table<G1<ppT>> table =
+        get_window_table(scalar_size, window, G1<ppT>::one());
+    std::vector<G1<ppT>> powers_of_tau_g1 =
+        batch_exp(scalar_size, window, table, powers);
+
+    return kzg_srs<ppT>(std::move(powers_of_tau_g1), tau * G2<ppT>::one());
+}
+
+template<typename ppT> size_t kzg_srs<ppT>::max_num_coefficients() const
+{
+    return powers_of_tau_g1.size();
+}
+
+template<typename ppT>
+G1<ppT> kzg_commit(
+    const kzg_srs<ppT> &srs,
+    const std::vector<Fr<ppT>> &coefficients,
+    const size_t chunks)
+{
+    if (coefficients.size() > srs.max_num_coefficients()) {
+        throw std::invalid_argument(
+            "libff::kzg_commit: polynomial degree exceeds SRS size");
+    }
+    if (coefficients.empty()) {
+        return G1<ppT>::zero();
+    }
+
+    return multi_exp<
+        G1<ppT>,
+        Fr<ppT>,
+        KZG_MULTI_EXP_METHOD,
+        multi_exp_base_form_special>(
+        srs.powers_of_tau_g1.begin(),
+        srs.powers_of_tau_g1.begin() + coefficients.size(),
+        coefficients.begin(),
+        coefficients.end(),
+        chunks);
+}
+
+template<typename ppT>
+kzg_opening<ppT> kzg_open(
+    const kzg_srs<ppT> &srs,
+    const std::vector<Fr<ppT>> &coefficients,
+    const Fr<ppT> &z,
+    const size_t chunks)
+{
+    kzg_opening<ppT> opening;
+    const std::vector<Fr<ppT>> quotient =
+        internal::kzg_divide(coefficients, z, opening.value);
+    opening.witness = kzg_commit(srs, quotient, chunks);
+    return opening;
+}
+
+template<typename ppT>
+bool kzg_verify(
+    const kzg_srs<ppT> &srs,
+    const G1<ppT> &commitment,
+    const Fr<ppT> &z,
+    const kzg_opening<ppT> &opening)
+{
+    const G1<ppT> rhs = commitment - opening.value * G1<ppT>::one() +
+                        z * opening.witness;
+    return internal::kzg_check_pairing(srs, opening.witness, rhs);
+}
+
+template<typename ppT>
+kzg_multi_polynomial_opening<ppT> kzg_open_multi_polynomial(
+    const kzg_srs<ppT> &srs,
+    const std::vector<std::vector<Fr<ppT>>> &polynomials,
+    const Fr<ppT> &z,
+    const Fr<ppT> &gamma,
+    const size_t chunks)
+{
+    kzg_multi_polynomial_opening<ppT> opening;
+    opening.values.reserve(polynomials.size());
+
+    std::vector<Fr<ppT>> combined;
+    Fr<ppT> gamma_i = Fr<ppT>::one();
+    for (const std::vector<Fr<ppT>> &p : polynomials) {
+        opening.values.push_back(polynomial_evaluate(p, z));
+        if (p.size() > combined.size()) {
+            combined.resize(p.size(), Fr<ppT>::zero());
+        }
+        for (size_t j = 0; j < p.size(); ++j) {
+            combined[j] += gamma_i * p[j];
+        }
+        gamma_i *= gamma;
+    }
+
+    Fr<ppT> value;
+    const std::vector<Fr<ppT>> quotient =
+        internal::kzg_divide(combined, z, value);
+    opening.witness = kzg_commit(srs, quotient, chunks);
+    return opening;
+}
+
+template<typename ppT>
+bool kzg_verify_multi_polynomial(
+    const kzg_srs<ppT> &srs,
+    const std::vector<G1<ppT>> &commitments,
+    const Fr<ppT> &z,
+    const Fr<ppT> &gamma,
+    const kzg_multi_polynomial_opening<ppT> &opening)
+{
+    if (commitments.size() != opening.values.size()) {
+        throw std::invalid_argument(
+            "libff::kzg_verify_multi_polynomial: expected one value per "
+            "commitment");
+    }
+
+    // Open the combined commitment \sum_i gamma^i C_i to the combined value
+    // \sum_i gamma^i y_i.
+    std::vector<Fr<ppT>> gamma_powers(commitments.size());
+    kzg_opening<ppT> combined;
+    combined.value = Fr<ppT>::zero();
+    combined.witness = opening.witness;
+    Fr<ppT> gamma_i = Fr<ppT>::one();
+    for (size_t i = 0; i < commitments.size(); ++i) {
+        gamma_powers[i] = gamma_i;
+        combined.value += gamma_i * opening.values[i];
+        gamma_i *= gamma;
+    }
+
+    const G1<ppT> commitment =
+        internal::kzg_linear_combination<ppT>(commitments, gamma_powers, 1);
+    return kzg_verify(srs, commitment, z, combined);
+}
+
+template<typename ppT>
+bool kzg_batch_verify(
+    const kzg_srs<ppT> &srs,
+    const std::vector<G1<ppT>> &commitments,
+    const std::vector<Fr<ppT>> &points,
+    const std::vector<kzg_opening<ppT>> &openings,
+    const size_t chunks)
+{
+    const size_t n = commitments.size();
+    if (points.size() != n || openings.size() != n) {
+        throw std::invalid_argument(
+            "libff::kzg_batch_verify: expected one point and opening per "
+            "commitment");
+    }
+
+    // For random r_i (with r_0 = 1), check
+    //   e(\sum_i r_i W_i, [tau]_2) ==
+    //       e(\sum_i r_i (C_i - [y_i]_1 + z_i W_i), [1]_2)
+    // where the right-hand side is computed as a single multi_exp over the
+    // commitments, the witnesses and [1]_1.
+    std::vector<G1<ppT>> witnesses(n);
+    std::vector<Fr<ppT>> r(n);
+    std::vector<G1<ppT>> rhs_bases(2 * n + 1);
+    std::vector<Fr<ppT>> rhs_scalars(2 * n + 1);
+    Fr<ppT> sum_r_y = Fr<ppT>::zero();
+    for (size_t i = 0; i < n; ++i) {
+        r[i] = (i == 0) ? Fr<ppT>::one() : Fr<ppT>::random_element();
+        witnesses[i] = openings[i].witness;
+        rhs_bases[i] = commitments[i];
+        rhs_scalars[i] = r[i];
+        rhs_bases[n + i] = openings[i].witness;
+        rhs_scalars[n + i] = r[i] * points[i];
+        sum_r_y += r[i] * openings[i].value;
+    }
+    rhs_bases[2 * n] = G1<ppT>::one();
+    rhs_scalars[2 * n] = -sum_r_y;
+
+    const G1<ppT> lhs =
+        internal::kzg_linear_combination<ppT>(witnesses, r, chunks);
+    const G1<ppT> rhs =
+        internal::kzg_linear_combination<ppT>(rhs_bases, rhs_scalars, chunks);
+    return internal::kzg_check_pairing(srs, lhs, rhs);
+}
+
+} // namespace libff
+
+#endif // KZG_TCC_
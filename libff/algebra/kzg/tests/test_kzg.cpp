@@ -0,0 +1,115 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/kzg/kzg.hpp"
+#include "libff/algebra/polynomial/polynomial.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libff;
+
+namespace
+{
+
+template<typename FieldT>
+std::vector<FieldT> random_vector(const size_t n)
+{
+    std::vector<FieldT> v(n);
+    for (FieldT &x : v) {
+        x = FieldT::random_element();
+    }
+    return v;
+}
+
+template<typename ppT> void test_kzg()
+{
+    using Field = Fr<ppT>;
+    const size_t max_size = 64;
+    const Field tau = Field::random_element();
+    const kzg_srs<ppT> srs = kzg_srs<ppT>::generate(max_size, tau);
+    ASSERT_EQ(max_size, srs.max_num_coefficients());
+
+    // Commitments are [p(tau)]_1.
+    const std::vector<Field> p = random_vector<Field>(max_size);
+    const G1<ppT> commitment = kzg_commit(srs, p);
+    ASSERT_EQ(polynomial_evaluate(p, tau) * G1<ppT>::one(), commitment);
+    ASSERT_EQ(commitment, kzg_commit(srs, p, 4));
+    ASSERT_THROW(
+        kzg_commit(srs, random_vector<Field>(max_size + 1)),
+        std::invalid_argument);
+
+    // Single openings.
+    const Field z = Field::random_element();
+    kzg_opening<ppT> opening = kzg_open(srs, p, z);
+    ASSERT_EQ(polynomial_evaluate(p, z), opening.value);
+    ASSERT_TRUE(kzg_verify(srs, commitment, z, opening));
+    ASSERT_FALSE(kzg_verify(srs, commitment, z + Field::one(), opening));
+    opening.value += Field::one();
+    ASSERT_FALSE(kzg_verify(srs, commitment, z, opening));
+
+    // Constant polynomials have a zero witness.
+    const std::vector<Field> constant = random_vector<Field>(1);
+    const kzg_opening<ppT> constant_opening = kzg_open(srs, constant, z);
+    ASSERT_TRUE(constant_opening.witness.is_zero());
+    ASSERT_TRUE(
+        kzg_verify(srs, kzg_commit(srs, constant), z, constant_opening));
+    ASSERT_FALSE(kzg_verify(srs, commitment, z, constant_opening));
+
+    // Several polynomials (of different sizes) at one point.
+    std::vector<std::vector<Field>> polynomials;
+    std::vector<G1<ppT>> commitments;
+    for (size_t size : {max_size, (size_t)3, (size_t)17, (size_t)0}) {
+        polynomials.push_back(random_vector<Field>(size));
+        commitments.push_back(kzg_commit(srs, polynomials.back()));
+    }
+    const Field gamma = Field::random_element();
+    kzg_multi_polynomial_opening<ppT> multi_opening =
+        kzg_open_multi_polynomial(srs, polynomials, z, gamma);
+    ASSERT_EQ(polynomials.size(), multi_opening.values.size());
+    ASSERT_TRUE(
+        kzg_verify_multi_polynomial(srs, commitments, z, gamma, multi_opening));
+    ASSERT_FALSE(kzg_verify_multi_polynomial(
+        srs, commitments, z, gamma + Field::one(), multi_opening));
+    multi_opening.values[2] += Field::one();
+    ASSERT_FALSE(
+        kzg_verify_multi_polynomial(srs, commitments, z, gamma, multi_opening));
+
+    // Several polynomials at different points.
+    std::vector<Field> points = random_vector<Field>(polynomials.size());
+    std::vector<kzg_opening<ppT>> openings;
+    for (size_t i = 0; i < polynomials.size(); ++i) {
+        openings.push_back(kzg_open(srs, polynomials[i], points[i]));
+    }
+    ASSERT_TRUE(kzg_batch_verify(srs, commitments, points, openings));
+    ASSERT_TRUE(kzg_batch_verify(srs, commitments, points, openings, 2));
+    ASSERT_TRUE(kzg_batch_verify<ppT>(srs, {}, {}, {}));
+    std::swap(openings[0], openings[1]);
+    ASSERT_FALSE(kzg_batch_verify(srs, commitments, points, openings));
+    std::swap(openings[0], openings[1]);
+    openings[3].witness = openings[3].witness + G1<ppT>::one();
+    ASSERT_FALSE(kzg_batch_verify(srs, commitments, points, openings));
+    points.pop_back();
+    ASSERT_THROW(
+        kzg_batch_verify(srs, commitments, points, openings),
+        std::invalid_argument);
+}
+
+TEST(KZGTest, AltBN128)
+{
+    alt_bn128_pp::init_public_params();
+    test_kzg<alt_bn128_pp>();
+}
+
+TEST(KZGTest, BLS12_381)
+{
+    bls12_381_pp::init_public_params();
+    test_kzg<bls12_381_pp>();
+}
+
+} // namespace
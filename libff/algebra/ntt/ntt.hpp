@@ -0,0 +1,114 @@
+/** @file
+ *****************************************************************************
+
+ Number-theoretic transforms (NTTs) over finite fields with a power-of-two
+ root of unity (i.e. FieldT::s > 0).
+
+ For a vector a of size n = 2^log_n, the forward transform computes
+     A_k = \sum_j a_j omega^(j * k)
+ where omega = get_root_of_unity<FieldT>(n), and the inverse transform
+ recovers a from A.
+
+ The forward transform is a radix-2/4 Cooley-Tukey network taking input in
+ natural order and producing output in bit-reversed order, and the inverse
+ is the corresponding Gentleman-Sande network taking bit-reversed input.
+ Callers that only combine transformed values pointwise (e.g. polynomial
+ multiplication) can therefore skip bit-reversal entirely by requesting
+ ntt_order_bit_reversed. Twiddle factors are shared via
+ root_of_unity_cache.
+
+ Larger transforms use a cache-blocked (four-step) layout: the first half of
+ the layers is computed as independent transforms over strided columns
+ (gathered into contiguous buffers), and the remaining layers as independent
+ transforms over contiguous rows. Columns and rows are processed in parallel
+ when MULTICORE is enabled.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef NTT_HPP_
+#define NTT_HPP_
+
+#include "libff/algebra/fields/root_of_unity_cache.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libff
+{
+
+/// Order of transformed values.
+enum ntt_order {
+    ntt_order_natural,
+    ntt_order_bit_reversed,
+};
+
+template<typename FieldT> class ntt_domain
+{
+public:
+    /// Domain of size n. Throws std::invalid_argument if n is not a power of
+    /// 2, or exceeds 2^FieldT::s.
+    explicit ntt_domain(const size_t n);
+
+    size_t size() const;
+    size_t log_size() const;
+
+    /// Generator of the domain (root of unity of order n).
+    const FieldT &omega() const;
+
+    /// The elements omega^0, omega^1, ..., omega^(n-1) of the domain.
+    std::vector<FieldT> elements() const;
+
+    /// In-place forward transform of a (of size n, in natural order).
+    void forward(
+        std::vector<FieldT> &a,
+        const ntt_order output_order = ntt_order_natural) const;
+
+    /// In-place inverse transform of a (of size n, in input_order). The
+    /// output is in natural order.
+    void inverse(
+        std::vector<FieldT> &a,
+        const ntt_order input_order = ntt_order_natural) const;
+
+    /// Forward transform of the polynomial with coefficients a, evaluated
+    /// over the coset g * <omega>, i.e. A_k = \sum_j a_j (g omega^k)^j.
+    void coset_forward(
+        std::vector<FieldT> &a,
+        const FieldT &g,
+        const ntt_order output_order = ntt_order_natural) const;
+
+    /// Inverse of coset_forward.
+    void coset_inverse(
+        std::vector<FieldT> &a,
+        const FieldT &g,
+        const ntt_order input_order = ntt_order_natural) const;
+
+protected:
+    void check_size(const std::vector<FieldT> &a) const;
+
+    /// Apply the forward network (natural to bit-reversed order).
+    void forward_network(std::vector<FieldT> &a) const;
+
+    /// Apply the inverse network (bit-reversed to natural order), without
+    /// scaling by 1/n.
+    void inverse_network(std::vector<FieldT> &a) const;
+
+    const size_t _n;
+    const size_t _log_n;
+    const FieldT _omega;
+    const FieldT _n_inv;
+    const std::shared_ptr<const twiddle_table<FieldT>> _table;
+};
+
+/// Permute a (whose size must be a power of 2) into bit-reversed order.
+template<typename FieldT> void ntt_bit_reverse(std::vector<FieldT> &a);
+
+} // namespace libff
+
+#include "libff/algebra/ntt/ntt.tcc"
+
+#endif // NTT_HPP_
@@ -0,0 +1,392 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of number-theoretic transforms.
+
+ See ntt.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef NTT_TCC_
+#define NTT_TCC_
+
+#include "libff/algebra/fields/field_utils.hpp"
+#include "libff/algebra/ntt/ntt.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Transforms of at least this (log) size use the cache-blocked layout.
+static const size_t NTT_BLOCKED_MIN_LOG_SIZE = 12;
+
+/// Number of adjacent columns gathered and transformed together in the
+/// column pass of the blocked layout, so that each cache line read from the
+/// strided input is fully used.
+static const size_t NTT_COLUMN_GROUP_SIZE = 4;
+
+/// Number of chunks used for parallel pointwise scaling.
+static const size_t NTT_SCALE_CHUNKS = 256;
+
+/// In-place forward (Cooley-Tukey) network over a transform of size
+/// 2^log_size, whose elements are each rows of width values in x. In the
+/// layer with m blocks, block b uses twiddle tw[base * m + b], so that the
+/// network can compute part of a larger transform (see ntt_domain).
+template<typename FieldT>
+void ntt_forward_kernel(
+    FieldT *x,
+    const size_t log_size,
+    const size_t width,
+    const FieldT *tw,
+    const size_t base)
+{
+    const size_t n = 1ull << log_size;
+    size_t m = 1;
+    size_t layer = 0;
+
+    // Radix-4: layers with m and 2m blocks together.
+    for (; layer + 2 <= log_size; layer += 2, m *= 4) {
+        const size_t q = (n / (4 * m)) * width;
+        for (size_t b = 0; b < m; ++b) {
+            const FieldT &w1 = tw[base * m + b];
+            const FieldT &w2 = tw[base * 2 * m + 2 * b];
+            const FieldT &w3 = tw[base * 2 * m + 2 * b + 1];
+            FieldT *const x0 = x + b * 4 * q;
+            FieldT *const x1 = x0 + q;
+            FieldT *const x2 = x1 + q;
+            FieldT *const x3 = x2 + q;
+            for (size_t j = 0; j < q; ++j) {
+                const FieldT t2 = w1 * x2[j];
+                const FieldT t3 = w1 * x3[j];
+                const FieldT y0 = x0[j] + t2;
+                const FieldT y2 = x0[j] - t2;
+                const FieldT u1 = w2 * (x1[j] + t3);
+                const FieldT u3 = w3 * (x1[j] - t3);
+                x0[j] = y0 + u1;
+                x1[j] = y0 - u1;
+                x2[j] = y2 + u3;
+                x3[j] = y2 - u3;
+            }
+        }
+    }
+
+    // Remaining radix-2 layer, for odd log_size.
+    if (layer < log_size) {
+        for (size_t b = 0; b < m; ++b) {
+            const FieldT &w = tw[base * m + b];
+            FieldT *const x0 = x + b * 2 * width;
+            FieldT *const x1 = x0 + width;
+            for (size_t j = 0; j < width; ++j) {
+                const FieldT t = w * x1[j];
+                x1[j] = x0[j] - t;
+                x0[j] = x0[j] + t;
+            }
+        }
+    }
+}
+
+/// In-place inverse (Gentleman-Sande) network, reversing
+/// ntt_forward_kernel up to a factor of 2^log_size. tw_inv holds the inverse
+/// twiddles.
+template<typename FieldT>
+void ntt_inverse_kernel(
+    FieldT *x,
+    const size_t log_size,
+    const size_t width,
+    const FieldT *tw_inv,
+    const size_t base)
+{
+    const size_t n = 1ull << log_size;
+
+    // Radix-2 layer (with n/2 blocks), for odd log_size.
+    if (log_size % 2 == 1) {
+        const size_t m = n / 2;
+        for (size_t b = 0; b < m; ++b) {
+            const FieldT &w = tw_inv[base * m + b];
+            FieldT *const x0 = x + b * 2 * width;
+            FieldT *const x1 = x0 + width;
+            for (size_t j = 0; j < width; ++j) {
+                const FieldT t = x0[j] - x1[j];
+                x0[j] = x0[j] + x1[j];
+                x1[j] = w * t;
+            }
+        }
+    }
+
+    // Radix-4: layers with 2m and m blocks together.
+    for (size_t layer = log_size - log_size % 2; layer >= 2; layer -= 2) {
+        const size_t m = 1ull << (layer - 2);
+        const size_t q = (n / (4 * m)) * width;
+        for (size_t b = 0; b < m; ++b) {
+            const FieldT &w1 = tw_inv[base * m + b];
+            const FieldT &w2 = tw_inv[base * 2 * m + 2 * b];
+            const FieldT &w3 = tw_inv[base * 2 * m + 2 * b + 1];
+            FieldT *const x0 = x + b * 4 * q;
+            FieldT *const x1 = x0 + q;
+            FieldT *const x2 = x1 + q;
+            FieldT *const x3 = x2 + q;
+            for (size_t j = 0; j < q; ++j) {
+                const FieldT y0 = x0[j] + x1[j];
+                const FieldT y1 = w2 * (x0[j] - x1[j]);
+                const FieldT y2 = x2[j] + x3[j];
+                const FieldT y3 = w3 * (x2[j] - x3[j]);
+                x0[j] = y0 + y2;
+                x2[j] = w1 * (y0 - y2);
+                x1[j] = y1 + y3;
+                x3[j] = w1 * (y1 - y3);
+            }
+        }
+    }
+}
+
+/// Column pass of the blocked layout: transforms over the num_columns
+/// columns (of 2^log_rows elements each) of a, viewed as a row-major matrix.
+template<typename FieldT, bool Inverse>
+void ntt_columns(
+    std::vector<FieldT> &a,
+    const size_t log_rows,
+    const size_t num_columns,
+    const FieldT *tw)
+{
+    const size_t num_rows = 1ull << log_rows;
+    const size_t group = NTT_COLUMN_GROUP_SIZE;
+
+#ifdef MULTICORE
+#pragma omp parallel
+#endif
+    {
+        std::vector<FieldT> buffer(num_rows * group);
+#ifdef MULTICORE
+#pragma omp for
+#endif
+        for (size_t c = 0; c < num_columns; c += group) {
+            for (size_t r = 0; r < num_rows; ++r) {
+                std::copy(
+                    a.begin() + r * num_columns + c,
+                    a.begin() + r * num_columns + c + group,
+                    buffer.begin() + r * group);
+            }
+            if (Inverse) {
+                ntt_inverse_kernel(buffer.data(), log_rows, group, tw, 0);
+            } else {
+                ntt_forward_kernel(buffer.data(), log_rows, group, tw, 0);
+            }
+            for (size_t r = 0; r < num_rows; ++r) {
+                std::copy(
+                    buffer.begin() + r * group,
+                    buffer.begin() + (r + 1) * group,
+                    a.begin() + r * num_columns + c);
+            }
+        }
+    }
+}
+
+/// Row pass of the blocked layout: transforms over each contiguous row (of
+/// 2^log_columns elements) of a. Row i is part of block i in the layers of
+/// the full transform.
+template<typename FieldT, bool Inverse>
+void ntt_rows(
+    std::vector<FieldT> &a,
+    const size_t log_columns,
+    const size_t num_rows,
+    const FieldT *tw)
+{
+    const size_t num_columns = 1ull << log_columns;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t r = 0; r < num_rows; ++r) {
+        FieldT *const row = a.data() + r * num_columns;
+        if (Inverse) {
+            ntt_inverse_kernel(row, log_columns, 1, tw, r);
+        } else {
+            ntt_forward_kernel(row, log_columns, 1, tw, r);
+        }
+    }
+}
+
+/// a[i] *= c * g^i
+template<typename FieldT>
+void ntt_scale_by_powers(
+    std::vector<FieldT> &a, const FieldT &g, const FieldT &c)
+{
+    const size_t n = a.size();
+    const size_t num_chunks = std::min(n, NTT_SCALE_CHUNKS);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i) {
+        const size_t begin = i * n / num_chunks;
+        const size_t end = (i + 1) * n / num_chunks;
+        FieldT x = c * (g ^ begin);
+        for (size_t j = begin; j < end; ++j) {
+            a[j] *= x;
+            x *= g;
+        }
+    }
+}
+
+} // namespace internal
+
+template<typename FieldT> void ntt_bit_reverse(std::vector<FieldT> &a)
+{
+    const size_t log_n = log2(a.size());
+    assert(a.size() == (1ull << log_n));
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < a.size(); ++i) {
+        const size_t j = bitreverse(i, log_n);
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+}
+
+template<typename FieldT>
+ntt_domain<FieldT>::ntt_domain(const size_t n)
+    : _n(n)
+    , _log_n(log2(n))
+    , _omega(
+          has_root_of_unity<FieldT>(n)
+              ? root_of_unity_cache<FieldT>::root_of_unity(_log_n)
+              : throw std::invalid_argument(
+                    "libff::ntt_domain: expected n == 2^k, k <= FieldT::s"))
+    , _n_inv(FieldT(n).inverse())
+    , _table(root_of_unity_cache<FieldT>::twiddles(_log_n))
+{
+}
+
+template<typename FieldT> size_t ntt_domain<FieldT>::size() const
+{
+    return _n;
+}
+
+template<typename FieldT> size_t ntt_domain<FieldT>::log_size() const
+{
+    return _log_n;
+}
+
+template<typename FieldT> const FieldT &ntt_domain<FieldT>::omega() const
+{
+    return _omega;
+}
+
+template<typename FieldT>
+std::vector<FieldT> ntt_domain<FieldT>::elements() const
+{
+    std::vector<FieldT> result(_n, FieldT::one());
+    internal::ntt_scale_by_powers(result, _omega, FieldT::one());
+    return result;
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::forward(
+    std::vector<FieldT> &a, const ntt_order output_order) const
+{
+    check_size(a);
+    forward_network(a);
+    if (output_order == ntt_order_natural) {
+        ntt_bit_reverse(a);
+    }
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::inverse(
+    std::vector<FieldT> &a, const ntt_order input_order) const
+{
+    check_size(a);
+    if (input_order == ntt_order_natural) {
+        ntt_bit_reverse(a);
+    }
+    inverse_network(a);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < _n; ++i) {
+        a[i] *= _n_inv;
+    }
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::coset_forward(
+    std::vector<FieldT> &a, const FieldT &g, const ntt_order output_order)
+    const
+{
+    check_size(a);
+    internal::ntt_scale_by_powers(a, g, FieldT::one());
+    forward(a, output_order);
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::coset_inverse(
+    std::vector<FieldT> &a, const FieldT &g, const ntt_order input_order)
+    const
+{
+    check_size(a);
+    if (input_order == ntt_order_natural) {
+        ntt_bit_reverse(a);
+    }
+    inverse_network(a);
+
+    // Scale by 1/n and undo the coset shift in a single pass.
+    internal::ntt_scale_by_powers(a, g.inverse(), _n_inv);
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::check_size(const std::vector<FieldT> &a) const
+{
+    if (a.size() != _n) {
+        throw std::invalid_argument("libff::ntt_domain: unexpected size");
+    }
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::forward_network(std::vector<FieldT> &a) const
+{
+    const FieldT *tw = _table->twiddles.data();
+    if (_log_n < internal::NTT_BLOCKED_MIN_LOG_SIZE) {
+        internal::ntt_forward_kernel(a.data(), _log_n, 1, tw, 0);
+        return;
+    }
+
+    // View a as a matrix with 2^log_rows rows. The first log_rows layers
+    // only combine elements within columns, and the remaining layers only
+    // combine elements within rows.
+    const size_t log_rows = _log_n / 2;
+    const size_t log_columns = _log_n - log_rows;
+    internal::ntt_columns<FieldT, false>(
+        a, log_rows, 1ull << log_columns, tw);
+    internal::ntt_rows<FieldT, false>(a, log_columns, 1ull << log_rows, tw);
+}
+
+template<typename FieldT>
+void ntt_domain<FieldT>::inverse_network(std::vector<FieldT> &a) const
+{
+    const FieldT *tw_inv = _table->inverse_twiddles.data();
+    if (_log_n < internal::NTT_BLOCKED_MIN_LOG_SIZE) {
+        internal::ntt_inverse_kernel(a.data(), _log_n, 1, tw_inv, 0);
+        return;
+    }
+
+    const size_t log_rows = _log_n / 2;
+    const size_t log_columns = _log_n - log_rows;
+    internal::ntt_rows<FieldT, true>(
+        a, log_columns, 1ull << log_rows, tw_inv);
+    internal::ntt_columns<FieldT, true>(
+        a, log_rows, 1ull << log_columns, tw_inv);
+}
+
+} // namespace libff
+
+#endif // NTT_TCC_
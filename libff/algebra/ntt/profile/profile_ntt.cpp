@@ -0,0 +1,127 @@
+/** @file
+ *****************************************************************************
+
+ Measure the time taken by forward and inverse NTTs (see ntt.hpp) of scalar
+ field vectors, for a range of sizes and each output order.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/ntt/ntt.hpp"
+#include "libff/common/profiling.hpp"
+
+#include <cstring>
+
+using namespace libff;
+
+static const size_t DEFAULT_MIN_LOG_SIZE = 10;
+static const size_t DEFAULT_MAX_LOG_SIZE = 20;
+
+template<typename FieldT>
+void profile_ntt_size(const size_t log_n, const ntt_order order)
+{
+    const size_t n = 1ull << log_n;
+    const ntt_domain<FieldT> domain(n);
+
+    std::vector<FieldT> a(n);
+    FieldT x = FieldT::random_element();
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = x;
+        x += FieldT::one();
+    }
+    const std::vector<FieldT> original = a;
+
+    const long long forward_start = get_nsec_time();
+    domain.forward(a, order);
+    const long long forward_nsec = get_nsec_time() - forward_start;
+
+    const long long inverse_start = get_nsec_time();
+    domain.inverse(a, order);
+    const long long inverse_nsec = get_nsec_time() - inverse_start;
+
+    if (a != original) {
+        throw std::runtime_error("inverse NTT did not recover input");
+    }
+
+    printf(
+        "%6zu  %-13s  %12.3f  %12.3f  %12.1f\n",
+        log_n,
+        (order == ntt_order_natural) ? "natural" : "bit-reversed",
+        forward_nsec * 1e-6,
+        inverse_nsec * 1e-6,
+        (double)forward_nsec / (n * log_n));
+}
+
+template<typename ppT>
+void profile_ntt(const size_t min_log_n, const size_t max_log_n)
+{
+    using FieldT = Fr<ppT>;
+    ppT::init_public_params();
+
+    printf(
+        "%6s  %-13s  %12s  %12s  %12s\n",
+        "log_n",
+        "order",
+        "forward ms",
+        "inverse ms",
+        "ns/(n log n)");
+    for (size_t log_n = min_log_n; log_n <= max_log_n; ++log_n) {
+        profile_ntt_size<FieldT>(log_n, ntt_order_natural);
+        profile_ntt_size<FieldT>(log_n, ntt_order_bit_reversed);
+    }
+}
+
+void usage(const char *const argv0)
+{
+    std::cout << "Usage: " << argv0 << " [flags]\n"
+              << "\n"
+              << "Flags:\n"
+              << "  --curve <curve>       One of alt_bn128, bls12_377, "
+                 "bls12_381 (default alt_bn128)\n"
+              << "  --min-log-size <n>    Smallest log2 size (default "
+              << DEFAULT_MIN_LOG_SIZE << ")\n"
+              << "  --max-log-size <n>    Largest log2 size (default "
+              << DEFAULT_MAX_LOG_SIZE << ")\n";
+}
+
+int main(const int argc, char const *const *const argv)
+{
+    std::string curve = "alt_bn128";
+    size_t min_log_n = DEFAULT_MIN_LOG_SIZE;
+    size_t max_log_n = DEFAULT_MAX_LOG_SIZE;
+
+    for (size_t i = 1; i < (size_t)argc; ++i) {
+        const char *const arg = argv[i];
+        if (!strcmp(arg, "--curve") && i + 1 < (size_t)argc) {
+            curve = argv[++i];
+        } else if (!strcmp(arg, "--min-log-size") && i + 1 < (size_t)argc) {
+            min_log_n = std::stoul(std::string(argv[++i]));
+        } else if (!strcmp(arg, "--max-log-size") && i + 1 < (size_t)argc) {
+            max_log_n = std::stoul(std::string(argv[++i]));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    inhibit_profiling_info = true;
+
+    if (curve == "alt_bn128") {
+        profile_ntt<alt_bn128_pp>(min_log_n, max_log_n);
+    } else if (curve == "bls12_377") {
+        profile_ntt<bls12_377_pp>(min_log_n, max_log_n);
+    } else if (curve == "bls12_381") {
+        profile_ntt<bls12_381_pp>(min_log_n, max_log_n);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/ntt/ntt.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libff;
+
+namespace
+{
+
+template<typename FieldT>
+std::vector<FieldT> random_vector(const size_t n)
+{
+    std::vector<FieldT> v(n);
+    for (FieldT &x : v) {
+        x = FieldT::random_element();
+    }
+    return v;
+}
+
+/// Evaluate the polynomial with coefficients a at x.
+template<typename FieldT>
+FieldT evaluate(const std::vector<FieldT> &a, const FieldT &x)
+{
+    FieldT result = FieldT::zero();
+    for (size_t i = a.size(); i > 0; --i) {
+        result = result * x + a[i - 1];
+    }
+    return result;
+}
+
+template<typename FieldT> void test_ntt_against_naive(const size_t n)
+{
+    const ntt_domain<FieldT> domain(n);
+    const std::vector<FieldT> a = random_vector<FieldT>(n);
+    const FieldT g = FieldT::multiplicative_generator;
+
+    std::vector<FieldT> natural = a;
+    domain.forward(natural);
+    std::vector<FieldT> bit_reversed = a;
+    domain.forward(bit_reversed, ntt_order_bit_reversed);
+    std::vector<FieldT> coset = a;
+    domain.coset_forward(coset, g);
+
+    const size_t log_n = domain.log_size();
+    FieldT x = FieldT::one();
+    for (size_t k = 0; k < n; ++k) {
+        const FieldT expect = evaluate(a, x);
+        ASSERT_EQ(expect, natural[k]);
+        ASSERT_EQ(expect, bit_reversed[bitreverse(k, log_n)]);
+        ASSERT_EQ(evaluate(a, g * x), coset[k]);
+        x *= domain.omega();
+    }
+
+    domain.inverse(natural);
+    ASSERT_EQ(a, natural);
+    domain.inverse(bit_reversed, ntt_order_bit_reversed);
+    ASSERT_EQ(a, bit_reversed);
+    domain.coset_inverse(coset, g);
+    ASSERT_EQ(a, coset);
+}
+
+template<typename FieldT> void test_ntt_blocked(const size_t n)
+{
+    // Compare a subset of the outputs of the blocked layout against direct
+    // evaluation, and check the round trip.
+    const ntt_domain<FieldT> domain(n);
+    const std::vector<FieldT> a = random_vector<FieldT>(n);
+
+    std::vector<FieldT> values = a;
+    domain.forward(values);
+    for (size_t k = 0; k < n; k += n / 16 + 1) {
+        ASSERT_EQ(evaluate(a, domain.omega() ^ k), values[k]);
+    }
+
+    domain.inverse(values);
+    ASSERT_EQ(a, values);
+
+    std::vector<FieldT> coset = a;
+    const FieldT g = FieldT::multiplicative_generator;
+    domain.coset_forward(coset, g, ntt_order_bit_reversed);
+    ASSERT_EQ(evaluate(a, g), coset[0]);
+    domain.coset_inverse(coset, g, ntt_order_bit_reversed);
+    ASSERT_EQ(a, coset);
+}
+
+template<typename FieldT> void test_ntt_polynomial_multiplication()
+{
+    // Multiply two polynomials of degree < n/2 via bit-reversed transforms.
+    const size_t n = 1 << 13;
+    const ntt_domain<FieldT> domain(n);
+    std::vector<FieldT> a = random_vector<FieldT>(n / 2);
+    std::vector<FieldT> b = random_vector<FieldT>(n / 2);
+    const FieldT x = FieldT::random_element();
+    const FieldT expect = evaluate(a, x) * evaluate(b, x);
+
+    a.resize(n, FieldT::zero());
+    b.resize(n, FieldT::zero());
+    domain.forward(a, ntt_order_bit_reversed);
+    domain.forward(b, ntt_order_bit_reversed);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] *= b[i];
+    }
+    domain.inverse(a, ntt_order_bit_reversed);
+
+    ASSERT_EQ(expect, evaluate(a, x));
+}
+
+template<typename FieldT> void test_ntt()
+{
+    for (size_t log_n = 0; log_n <= 9; ++log_n) {
+        test_ntt_against_naive<FieldT>(1ull << log_n);
+    }
+    for (size_t log_n = 12; log_n <= 15; ++log_n) {
+        test_ntt_blocked<FieldT>(1ull << log_n);
+    }
+    test_ntt_polynomial_multiplication<FieldT>();
+
+    ASSERT_THROW(ntt_domain<FieldT>(3), std::invalid_argument);
+    ASSERT_THROW(
+        ntt_domain<FieldT>(1ull << (FieldT::s + 1)), std::invalid_argument);
+    std::vector<FieldT> wrong_size(3);
+    ASSERT_THROW(
+        ntt_domain<FieldT>(4).forward(wrong_size), std::invalid_argument);
+}
+
+TEST(NTTTest, AltBN128)
+{
+    alt_bn128_pp::init_public_params();
+    test_ntt<alt_bn128_Fr>();
+}
+
+TEST(NTTTest, BLS12_381)
+{
+    bls12_381_pp::init_public_params();
+    test_ntt<bls12_381_Fr>();
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+/** @file
+ *****************************************************************************
+
+ Evaluation of polynomials over scalar fields (Fp_model), in coefficient form
+ or in Lagrange form over an NTT domain (see ntt.hpp).
+
+ Polynomials in coefficient form are given by their coefficients, lowest
+ degree first. Polynomials in Lagrange form are given by their values over
+ the elements omega^i of an ntt_domain H, in natural order (i.e. as returned
+ by ntt_domain::forward). The Lagrange basis polynomials of H are
+
+     L_i(X) = omega^i (X^n - 1) / (n (X - omega^i))
+
+ which are evaluated at points outside H using a single batched inversion of
+ the denominators (the barycentric formula). Z_H(X) = X^n - 1 denotes the
+ vanishing polynomial of H.
+
+ Large evaluations are performed in parallel when MULTICORE is enabled.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef POLYNOMIAL_HPP_
+#define POLYNOMIAL_HPP_
+
+#include "libff/algebra/ntt/ntt.hpp"
+
+#include <vector>
+
+namespace libff
+{
+
+/// Evaluate the polynomial with the given coefficients at x (Horner's rule).
+template<typename FieldT>
+FieldT polynomial_evaluate(
+    const std::vector<FieldT> &coefficients, const FieldT &x);
+
+/// Evaluate the polynomial with the given coefficients at each of points.
+template<typename FieldT>
+std::vector<FieldT> polynomial_evaluate_many(
+    const std::vector<FieldT> &coefficients, const std::vector<FieldT> &points);
+
+/// Z_H(x) = x^n - 1.
+template<typename FieldT>
+FieldT vanishing_polynomial_evaluate(
+    const ntt_domain<FieldT> &domain, const FieldT &x);
+
+/// The vanishing polynomial of the coset gH at x, i.e. x^n - g^n.
+template<typename FieldT>
+FieldT coset_vanishing_polynomial_evaluate(
+    const ntt_domain<FieldT> &domain, const FieldT &g, const FieldT &x);
+
+/// The values L_i(x) for 0 <= i < n.
+template<typename FieldT>
+std::vector<FieldT> lagrange_basis_evaluate(
+    const ntt_domain<FieldT> &domain, const FieldT &x);
+
+/// Evaluate the polynomial with the given values over the domain at x.
+/// Throws std::invalid_argument if evaluations.size() != domain.size().
+template<typename FieldT>
+FieldT lagrange_evaluate(
+    const ntt_domain<FieldT> &domain,
+    const std::vector<FieldT> &evaluations,
+    const FieldT &x);
+
+/// Evaluate the polynomial with the given values over the domain at each of
+/// points.
+template<typename FieldT>
+std::vector<FieldT> lagrange_evaluate_many(
+    const ntt_domain<FieldT> &domain,
+    const std::vector<FieldT> &evaluations,
+    const std::vector<FieldT> &points);
+
+/// Values over the domain of the polynomial with the given coefficients.
+/// Throws std::invalid_argument if there are more than domain.size()
+/// coefficients.
+template<typename FieldT>
+std::vector<FieldT> coefficients_to_lagrange(
+    const ntt_domain<FieldT> &domain, const std::vector<FieldT> &coefficients);
+
+/// Coefficients of the polynomial with the given values over the domain.
+template<typename FieldT>
+std::vector<FieldT> lagrange_to_coefficients(
+    const ntt_domain<FieldT> &domain, const std::vector<FieldT> &evaluations);
+
+} // namespace libff
+
+#include "libff/algebra/polynomial/polynomial.tcc"
+
+#endif // POLYNOMIAL_HPP_
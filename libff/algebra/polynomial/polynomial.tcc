@@ -0,0 +1,326 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of polynomial evaluation utilities.
+
+ See polynomial.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef POLYNOMIAL_TCC_
+#define POLYNOMIAL_TCC_
+
+#include "libff/algebra/fields/field_utils.hpp"
+#include "libff/algebra/polynomial/polynomial.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Polynomials (or vectors) of at least this size are split into chunks
+/// which are processed in parallel.
+static const size_t POLYNOMIAL_PARALLEL_MIN_SIZE = 4096;
+
+/// Number of chunks used for parallel evaluation and inversion.
+static const size_t POLYNOMIAL_CHUNKS = 256;
+
+/// Evaluate the polynomial with coefficients c[0], ..., c[n-1] at x.
+template<typename FieldT>
+FieldT polynomial_horner(const FieldT *c, const size_t n, const FieldT &x)
+{
+    FieldT result = FieldT::zero();
+    for (size_t i = n; i > 0; --i) {
+        result = result * x + c[i - 1];
+    }
+    return result;
+}
+
+/// batch_invert, with the vector split into chunks which are inverted in
+/// parallel (at the cost of one inversion per chunk).
+template<typename FieldT> void polynomial_batch_invert(std::vector<FieldT> &v)
+{
+    const size_t n = v.size();
+    if (n < POLYNOMIAL_PARALLEL_MIN_SIZE) {
+        batch_invert(v);
+        return;
+    }
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < POLYNOMIAL_CHUNKS; ++i) {
+        const size_t begin = i * n / POLYNOMIAL_CHUNKS;
+        const size_t end = (i + 1) * n / POLYNOMIAL_CHUNKS;
+        std::vector<FieldT> chunk(v.begin() + begin, v.begin() + end);
+        batch_invert(chunk);
+        std::copy(chunk.begin(), chunk.end(), v.begin() + begin);
+    }
+}
+
+/// \sum_i a[i] * b[i].
+template<typename FieldT>
+FieldT polynomial_inner_product(
+    const std::vector<FieldT> &a, const std::vector<FieldT> &b)
+{
+    const size_t n = a.size();
+    const size_t num_chunks =
+        (n < POLYNOMIAL_PARALLEL_MIN_SIZE) ? 1 : POLYNOMIAL_CHUNKS;
+    std::vector<FieldT> partial(num_chunks, FieldT::zero());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i) {
+        const size_t begin = i * n / num_chunks;
+        const size_t end = (i + 1) * n / num_chunks;
+        for (size_t j = begin; j < end; ++j) {
+            partial[i] += a[j] * b[j];
+        }
+    }
+
+    FieldT result = FieldT::zero();
+    for (const FieldT &p : partial) {
+        result += p;
+    }
+    return result;
+}
+
+/// Index of x in elements (which must contain x).
+template<typename FieldT>
+size_t polynomial_domain_index(
+    const std::vector<FieldT> &elements, const FieldT &x)
+{
+    const size_t index =
+        std::find(elements.begin(), elements.end(), x) - elements.begin();
+    assert(index < elements.size());
+    return index;
+}
+
+/// Evaluate the polynomial with the given values over the domain with the
+/// given elements at x, using denominators as scratch space.
+template<typename FieldT>
+FieldT lagrange_evaluate_serial(
+    const std::vector<FieldT> &elements,
+    const std::vector<FieldT> &evaluations,
+    const FieldT &n_inv,
+    const FieldT &x,
+    std::vector<FieldT> &denominators)
+{
+    const size_t n = elements.size();
+    const FieldT z = (x ^ n) - FieldT::one();
+    if (z.is_zero()) {
+        return evaluations[polynomial_domain_index(elements, x)];
+    }
+
+    denominators.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        denominators[i] = x - elements[i];
+    }
+    batch_invert(denominators);
+
+    FieldT sum = FieldT::zero();
+    for (size_t i = 0; i < n; ++i) {
+        sum += evaluations[i] * elements[i] * denominators[i];
+    }
+    return sum * z * n_inv;
+}
+
+template<typename FieldT>
+void polynomial_check_evaluations(
+    const ntt_domain<FieldT> &domain, const std::vector<FieldT> &evaluations)
+{
+    if (evaluations.size() != domain.size()) {
+        throw std::invalid_argument(
+            "libff::lagrange_evaluate: expected one value per domain element");
+    }
+}
+
+} // namespace internal
+
+template<typename FieldT>
+FieldT polynomial_evaluate(
+    const std::vector<FieldT> &coefficients, const FieldT &x)
+{
+    const size_t n = coefficients.size();
+    if (n < internal::POLYNOMIAL_PARALLEL_MIN_SIZE) {
+        return internal::polynomial_horner(coefficients.data(), n, x);
+    }
+
+    // p(x) = \sum_c x^(c * chunk_size) p_c(x), where p_c are the chunks of
+    // the coefficients. Evaluate the chunks in parallel, and combine them
+    // using Horner's rule in x^chunk_size.
+    const size_t chunk_size = div_ceil(n, internal::POLYNOMIAL_CHUNKS);
+    const size_t num_chunks = div_ceil(n, chunk_size);
+    std::vector<FieldT> partial(num_chunks);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_chunks; ++i) {
+        const size_t begin = i * chunk_size;
+        const size_t size = std::min(chunk_size, n - begin);
+        partial[i] = internal::polynomial_horner(
+            coefficients.data() + begin, size, x);
+    }
+
+    return internal::polynomial_horner(
+        partial.data(), num_chunks, x ^ chunk_size);
+}
+
+template<typename FieldT>
+std::vector<FieldT> polynomial_evaluate_many(
+    const std::vector<FieldT> &coefficients, const std::vector<FieldT> &points)
+{
+    std::vector<FieldT> result(points.size());
+
+    // Parallelize over the points if there are enough of them, and
+    // otherwise within each evaluation.
+    if (points.size() < internal::POLYNOMIAL_CHUNKS) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            result[i] = polynomial_evaluate(coefficients, points[i]);
+        }
+        return result;
+    }
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < points.size(); ++i) {
+        result[i] = internal::polynomial_horner(
+            coefficients.data(), coefficients.size(), points[i]);
+    }
+    return result;
+}
+
+template<typename FieldT>
+FieldT vanishing_polynomial_evaluate(
+    const ntt_domain<FieldT> &domain, const FieldT &x)
+{
+    return (x ^ domain.size()) - FieldT::one();
+}
+
+template<typename FieldT>
+FieldT coset_vanishing_polynomial_evaluate(
+    const ntt_domain<FieldT> &domain, const FieldT &g, const FieldT &x)
+{
+    return (x ^ domain.size()) - (g ^ domain.size());
+}
+
+template<typename FieldT>
+std::vector<FieldT> lagrange_basis_evaluate(
+    const ntt_domain<FieldT> &domain, const FieldT &x)
+{
+    const size_t n = domain.size();
+    std::vector<FieldT> elements = domain.elements();
+    const FieldT z = vanishing_polynomial_evaluate(domain, x);
+    if (z.is_zero()) {
+        // x = omega^k, so L_i(x) = 1 if i == k, and 0 otherwise.
+        const size_t k = internal::polynomial_domain_index(elements, x);
+        std::vector<FieldT> result(n, FieldT::zero());
+        result[k] = FieldT::one();
+        return result;
+    }
+
+    std::vector<FieldT> denominators(n);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        denominators[i] = x - elements[i];
+    }
+    internal::polynomial_batch_invert(denominators);
+
+    // Overwrite elements with the result.
+    const FieldT c = z * FieldT(n).inverse();
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        elements[i] *= denominators[i] * c;
+    }
+    return elements;
+}
+
+template<typename FieldT>
+FieldT lagrange_evaluate(
+    const ntt_domain<FieldT> &domain,
+    const std::vector<FieldT> &evaluations,
+    const FieldT &x)
+{
+    internal::polynomial_check_evaluations(domain, evaluations);
+    return internal::polynomial_inner_product(
+        evaluations, lagrange_basis_evaluate(domain, x));
+}
+
+template<typename FieldT>
+std::vector<FieldT> lagrange_evaluate_many(
+    const ntt_domain<FieldT> &domain,
+    const std::vector<FieldT> &evaluations,
+    const std::vector<FieldT> &points)
+{
+    internal::polynomial_check_evaluations(domain, evaluations);
+    std::vector<FieldT> result(points.size());
+
+    // As for polynomial_evaluate_many, parallelize over the points if there
+    // are enough of them.
+    if (points.size() < internal::POLYNOMIAL_CHUNKS) {
+        for (size_t i = 0; i < points.size(); ++i) {
+            result[i] = lagrange_evaluate(domain, evaluations, points[i]);
+        }
+        return result;
+    }
+
+    const std::vector<FieldT> elements = domain.elements();
+    const FieldT n_inv = FieldT(domain.size()).inverse();
+#ifdef MULTICORE
+#pragma omp parallel
+#endif
+    {
+        std::vector<FieldT> denominators;
+#ifdef MULTICORE
+#pragma omp for
+#endif
+        for (size_t i = 0; i < points.size(); ++i) {
+            result[i] = internal::lagrange_evaluate_serial(
+                elements, evaluations, n_inv, points[i], denominators);
+        }
+    }
+    return result;
+}
+
+template<typename FieldT>
+std::vector<FieldT> coefficients_to_lagrange(
+    const ntt_domain<FieldT> &domain, const std::vector<FieldT> &coefficients)
+{
+    if (coefficients.size() > domain.size()) {
+        throw std::invalid_argument(
+            "libff::coefficients_to_lagrange: degree exceeds domain size");
+    }
+
+    std::vector<FieldT> result(coefficients);
+    result.resize(domain.size(), FieldT::zero());
+    domain.forward(result);
+    return result;
+}
+
+template<typename FieldT>
+std::vector<FieldT> lagrange_to_coefficients(
+    const ntt_domain<FieldT> &domain, const std::vector<FieldT> &evaluations)
+{
+    std::vector<FieldT> result(evaluations);
+    domain.inverse(result);
+    return result;
+}
+
+} // namespace libff
+
+#endif // POLYNOMIAL_TCC_
@@ -0,0 +1,133 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/polynomial/polynomial.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace libff;
+
+namespace
+{
+
+template<typename FieldT>
+std::vector<FieldT> random_vector(const size_t n)
+{
+    std::vector<FieldT> v(n);
+    for (FieldT &x : v) {
+        x = FieldT::random_element();
+    }
+    return v;
+}
+
+/// Naive evaluation, computing each power of x.
+template<typename FieldT>
+FieldT naive_evaluate(const std::vector<FieldT> &a, const FieldT &x)
+{
+    FieldT result = FieldT::zero();
+    for (size_t i = 0; i < a.size(); ++i) {
+        result += a[i] * (x ^ i);
+    }
+    return result;
+}
+
+template<typename FieldT> void test_polynomial_evaluate()
+{
+    // Sizes below and above the parallel threshold, including a size which
+    // does not divide evenly into chunks.
+    for (const size_t n : {0, 1, 17, 5000}) {
+        const std::vector<FieldT> a = random_vector<FieldT>(n);
+        const std::vector<FieldT> points = random_vector<FieldT>(300);
+        const std::vector<FieldT> values = polynomial_evaluate_many(a, points);
+        ASSERT_EQ(points.size(), values.size());
+        for (size_t i = 0; i < points.size(); i += 37) {
+            ASSERT_EQ(naive_evaluate(a, points[i]), values[i]);
+            ASSERT_EQ(values[i], polynomial_evaluate(a, points[i]));
+        }
+    }
+}
+
+template<typename FieldT> void test_lagrange(const size_t n)
+{
+    const ntt_domain<FieldT> domain(n);
+    const std::vector<FieldT> a = random_vector<FieldT>(n);
+    const std::vector<FieldT> evaluations = coefficients_to_lagrange(domain, a);
+    ASSERT_EQ(a, lagrange_to_coefficients(domain, evaluations));
+
+    // Points outside the domain, and two of its elements.
+    std::vector<FieldT> points = random_vector<FieldT>(260);
+    points[0] = FieldT::one();
+    points[1] = domain.omega() ^ (n - 1);
+
+    const std::vector<FieldT> values =
+        lagrange_evaluate_many(domain, evaluations, points);
+    for (size_t i = 0; i < points.size(); i += 13) {
+        const FieldT expect = polynomial_evaluate(a, points[i]);
+        ASSERT_EQ(expect, values[i]);
+        ASSERT_EQ(expect, lagrange_evaluate(domain, evaluations, points[i]));
+    }
+    ASSERT_EQ(evaluations[0], values[0]);
+    ASSERT_EQ(evaluations[n - 1], values[1]);
+
+    // The basis sums to 1, and L_i(omega^k) = delta_ik.
+    const std::vector<FieldT> basis =
+        lagrange_basis_evaluate(domain, points[2]);
+    FieldT sum = FieldT::zero();
+    for (const FieldT &l : basis) {
+        sum += l;
+    }
+    ASSERT_EQ(FieldT::one(), sum);
+    const std::vector<FieldT> delta =
+        lagrange_basis_evaluate(domain, domain.omega());
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ((i == 1 % n) ? FieldT::one() : FieldT::zero(), delta[i]);
+    }
+
+    // Z_H vanishes exactly on the domain.
+    const std::vector<FieldT> elements = domain.elements();
+    for (const FieldT &w : elements) {
+        ASSERT_EQ(FieldT::zero(), vanishing_polynomial_evaluate(domain, w));
+    }
+    ASSERT_EQ(
+        (points[2] ^ n) - FieldT::one(),
+        vanishing_polynomial_evaluate(domain, points[2]));
+    const FieldT g = FieldT::multiplicative_generator;
+    ASSERT_EQ(
+        FieldT::zero(),
+        coset_vanishing_polynomial_evaluate(domain, g, g * elements[n / 2]));
+
+    ASSERT_THROW(
+        lagrange_evaluate(domain, random_vector<FieldT>(n + 1), points[2]),
+        std::invalid_argument);
+    ASSERT_THROW(
+        coefficients_to_lagrange(domain, random_vector<FieldT>(n + 1)),
+        std::invalid_argument);
+}
+
+template<typename FieldT> void test_polynomial()
+{
+    test_polynomial_evaluate<FieldT>();
+    test_lagrange<FieldT>(1);
+    test_lagrange<FieldT>(64);
+    test_lagrange<FieldT>(1 << 13);
+}
+
+TEST(PolynomialTest, AltBN128)
+{
+    alt_bn128_pp::init_public_params();
+    test_polynomial<alt_bn128_Fr>();
+}
+
+TEST(PolynomialTest, BLS12_381)
+{
+    bls12_381_pp::init_public_params();
+    test_polynomial<bls12_381_Fr>();
+}
+
+} // namespace
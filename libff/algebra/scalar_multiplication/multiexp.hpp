@@ -39,8 +39,27 @@ enum multi_exp_method {
     multi_exp_method_BDLO12,
     /// Similar to multi_exp_method_BDLO12, but using signed digits.
     multi_exp_method_BDLO12_signed,
+    /// Straus' interleaved method (see e.g. Section 3.2 of [2] above): each
+    /// scalar is written in wNAF form, a table of odd multiples is computed
+    /// for each base, and the digits of all scalars are processed together,
+    /// sharing a single chain of doublings. Faster than the bucket-based
+    /// methods for small numbers of entries.
+    multi_exp_method_straus,
+    /// Select multi_exp_method_straus for fewer than
+    /// MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES entries (per chunk), and
+    /// multi_exp_method_BDLO12_signed otherwise.
+    multi_exp_method_auto,
+    /// As multi_exp_method_BDLO12_signed, but accumulating the buckets in
+    /// extended Jacobian (XYZZ) coordinates (see xyzz_point.hpp). Base
+    /// elements in normal form are first converted to special form (with a
+    /// single batched inversion). Supports short Weierstrass curves only.
+    multi_exp_method_BDLO12_signed_xyzz,
 };
 
+/// Number of entries below which multi_exp_method_auto uses
+/// multi_exp_method_straus (see profile_multiexp).
+static const size_t MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES = 256;
+
 /// Form of base elements passed to multi_exp routines.
 enum multi_exp_base_form {
     /// Incoming base elements are not in special form.
@@ -72,6 +91,20 @@ T multi_exp(
     typename std::vector<FieldT>::const_iterator scalar_end,
     const size_t chunks);
 
+/// As above, for base elements held in contiguous memory outside of a
+/// std::vector (e.g. a shared_base_vector).
+template<
+    typename T,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm = multi_exp_base_form_normal>
+T multi_exp(
+    const T *vec_start,
+    const T *vec_end,
+    typename std::vector<FieldT>::const_iterator scalar_start,
+    typename std::vector<FieldT>::const_iterator scalar_end,
+    const size_t chunks);
+
 /// A variant of multi_exp which includes special pre-processing step to skip
 /// zeros, and directly sum base elements with factor 1. Remaining values are
 /// processed as usual via multi_exp.
@@ -87,6 +120,31 @@ T multi_exp_filter_one_zero(
     typename std::vector<FieldT>::const_iterator scalar_end,
     const size_t chunks);
 
+/// One instance of a batch of multi-exponentiations (see multi_exp_batch):
+///   \sum_i scalar_start[i] * vec_start[i]
+/// for the base elements from vec_start to vec_end.
+template<typename T, typename FieldT> class multi_exp_batch_instance
+{
+public:
+    typename std::vector<T>::const_iterator vec_start;
+    typename std::vector<T>::const_iterator vec_end;
+    typename std::vector<FieldT>::const_iterator scalar_start;
+};
+
+/// Compute many independent (typically small) multi-exponentiations, in
+/// parallel over the instances. Each instance is computed with
+/// multi_exp_method_auto (so that small instances use
+/// multi_exp_method_straus), without chunking, and the scratch space of each
+/// thread is reused across instances. If normalize is set, the results are
+/// converted to special form, with a single batched inversion.
+template<
+    typename T,
+    typename FieldT,
+    multi_exp_base_form BaseForm = multi_exp_base_form_normal>
+std::vector<T> multi_exp_batch(
+    const std::vector<multi_exp_batch_instance<T, FieldT>> &instances,
+    const bool normalize = false);
+
 /// A convenience function for calculating a pure inner product, where the more
 /// complicated methods are not required.
 template<typename T>
@@ -13,17 +13,18 @@
 
 #ifndef MULTIEXP_TCC_
 #define MULTIEXP_TCC_
-#include "../../../../../LOG_CONTROLS.hpp"
 #include <algorithm>
 #include <cassert>
 #include <libff/algebra/curves/curve_serialization.hpp>
+#include <libff/algebra/curves/xyzz_point.hpp>
 #include <libff/algebra/fields/bigint.hpp>
-#include <libff/algebra/fields/fp_aux.tcc>
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
 #include <libff/common/concurrent_fifo.hpp>
 #include <libff/common/profiling.hpp>
+#include <libff/common/trace.hpp>
 #include <libff/common/utils.hpp>
+#include <cstdlib>
 #include <type_traits>
 
 namespace libff
@@ -39,12 +40,37 @@ inline size_t pippenger_optimal_c(const size_t num_elements)
     return log2_num_elements - (log2_num_elements / 3 - 2);
 }
 
+template<multi_exp_base_form Form>
+using multi_exp_base_form_tag =
+    std::integral_constant<multi_exp_base_form, Form>;
+
+/// Add an element (in normal form) to an accumulator.
+template<typename AccumulatorT, typename ElementT>
+AccumulatorT multi_exp_add_element(
+    const AccumulatorT &accumulator,
+    const ElementT &element,
+    multi_exp_base_form_tag<multi_exp_base_form_normal>)
+{
+    return accumulator.add(element);
+}
+
+/// Add an element (in special form) to an accumulator, using mixed_add.
+template<typename AccumulatorT, typename ElementT>
+AccumulatorT multi_exp_add_element(
+    const AccumulatorT &accumulator,
+    const ElementT &element,
+    multi_exp_base_form_tag<multi_exp_base_form_special>)
+{
+    return accumulator.mixed_add(element);
+}
+
 /// Add/subtract base_element to/from the correct bucket, based on a signed
 /// digit, using and updating the bucket_hit flags. Supports regular / mixed
-/// addition, based on base element form.
-template<typename GroupT, multi_exp_base_form BaseForm>
+/// addition, based on base element form. BucketT is either GroupT, or
+/// xyzz_point<GroupT> (in which case base elements must be in special form).
+template<typename BucketT, multi_exp_base_form BaseForm, typename GroupT>
 void multi_exp_add_element_to_bucket_with_signed_digit(
-    std::vector<GroupT> &buckets,
+    std::vector<BucketT> &buckets,
     std::vector<bool> &bucket_hit,
     const GroupT &base_element,
     ssize_t digit)
@@ -53,28 +79,24 @@ void multi_exp_add_element_to_bucket_with_signed_digit(
         const size_t bucket_idx = (-digit) - 1;
         assert(bucket_idx < buckets.size());
         if (bucket_hit[bucket_idx]) {
-            if (BaseForm == multi_exp_base_form_special) {
-                buckets[bucket_idx] =
-                    buckets[bucket_idx].mixed_add(-base_element);
-            } else {
-                buckets[bucket_idx] = buckets[bucket_idx].add(-base_element);
-            }
+            buckets[bucket_idx] = multi_exp_add_element(
+                buckets[bucket_idx],
+                -base_element,
+                multi_exp_base_form_tag<BaseForm>());
         } else {
-            buckets[bucket_idx] = -base_element;
+            buckets[bucket_idx] = BucketT(-base_element);
             bucket_hit[bucket_idx] = true;
         }
     } else if (digit > 0) {
         const size_t bucket_idx = digit - 1;
         assert(bucket_idx < buckets.size());
         if (bucket_hit[bucket_idx]) {
-            if (BaseForm == multi_exp_base_form_special) {
-                buckets[bucket_idx] =
-                    buckets[bucket_idx].mixed_add(base_element);
-            } else {
-                buckets[bucket_idx] = buckets[bucket_idx].add(base_element);
-            }
+            buckets[bucket_idx] = multi_exp_add_element(
+                buckets[bucket_idx],
+                base_element,
+                multi_exp_base_form_tag<BaseForm>());
         } else {
-            buckets[bucket_idx] = base_element;
+            buckets[bucket_idx] = BucketT(base_element);
             bucket_hit[bucket_idx] = true;
         }
     }
@@ -112,11 +134,8 @@ GroupT multiexp_accumulate_buckets(
     while (i > 0) {
         --i;
         if (bucket_hit[i]) {
-            if (Form == multi_exp_base_form_special) {
-                accumulator = accumulator.mixed_add(buckets[i]);
-            } else {
-                accumulator = accumulator + buckets[i];
-            }
+            accumulator = multi_exp_add_element(
+                accumulator, buckets[i], multi_exp_base_form_tag<Form>());
         }
         sum = sum + accumulator;
     }
@@ -124,84 +143,79 @@ GroupT multiexp_accumulate_buckets(
     return sum;
 }
 
-template<mp_size_t n> class ordered_exponent
+/// a < b. The loop has a constant trip count, and is fully unrolled for each
+/// number of limbs.
+template<mp_size_t n>
+inline bool bos_coster_less(const bigint<n> &a, const bigint<n> &b)
+{
+    for (mp_size_t i = n; i-- > 0;) {
+        if (a.data[i] != b.data[i]) {
+            return a.data[i] < b.data[i];
+        }
+    }
+    return false;
+}
+
+/// a -= b, where a >= b.
+template<mp_size_t n>
+inline void bos_coster_subtract(bigint<n> &a, const bigint<n> &b)
+{
+    mp_limb_t borrow = 0;
+    for (mp_size_t i = 0; i < n; ++i) {
+        const mp_limb_t a_i = a.data[i];
+        const mp_limb_t diff = a_i - b.data[i];
+        a.data[i] = diff - borrow;
+        borrow = (mp_limb_t)(a_i < b.data[i]) | (mp_limb_t)(diff < borrow);
+    }
+}
+
+/// Scratch space for multi_exp_method_straus, reused across calls as for
+/// bos_coster_workspace below.
+template<typename GroupT, typename BigInt> class straus_workspace
 {
-    // to use std::push_heap and friends later
 public:
-    size_t idx;
-    bigint<n> r;
+    std::vector<size_t> indices;
+    std::vector<BigInt> bi_exponents;
+    std::vector<GroupT> table;
+    std::vector<std::vector<long>> nafs;
+    std::vector<GroupT> non_zero_table;
 
-    ordered_exponent(const size_t idx, const bigint<n> &r) : idx(idx), r(r){};
+    static straus_workspace &get()
+    {
+        static thread_local straus_workspace workspace;
+        return workspace;
+    }
+};
 
-    bool operator<(const ordered_exponent<n> &other) const
+/// Scratch space for multi_exp_method_bos_coster. There is one instance per
+/// thread, which is reused across calls (so that, after the first call of a
+/// given size, no memory is allocated), and chunks can be processed in
+/// parallel.
+template<typename GroupT, typename BigInt> class bos_coster_workspace
+{
+public:
+    std::vector<GroupT> bases;
+    std::vector<BigInt> scalars;
+    /// Max-heap of indices into bases and scalars, ordered by scalar.
+    std::vector<size_t> heap;
+
+    static bos_coster_workspace &get()
     {
-#if defined(__x86_64__) && defined(USE_ASM)
-        if (n == 3) {
-            long res;
-            __asm__(                                   // Preserve alignment
-                "// check for overflow           \n\t" //
-                "mov $0, %[res]                  \n\t" //
-                ADD_CMP(16)                            //
-                ADD_CMP(8)                             //
-                ADD_CMP(0)                             //
-                "jmp done%=                      \n\t" //
-                "subtract%=:                     \n\t" //
-                "mov $1, %[res]                  \n\t" //
-                "done%=:                         \n\t" //
-                : [res] "=&r"(res)
-                : [A] "r"(other.r.data), [mod] "r"(this->r.data)
-                : "cc", "%rax");
-            return res;
-        } else if (n == 4) {
-            long res;
-            __asm__(                                   // Preserve alignment
-                "// check for overflow           \n\t" //
-                "mov $0, %[res]                  \n\t" //
-                ADD_CMP(24)                            //
-                ADD_CMP(16)                            //
-                ADD_CMP(8)                             //
-                ADD_CMP(0)                             //
-                "jmp done%=                      \n\t" //
-                "subtract%=:                     \n\t" //
-                "mov $1, %[res]                  \n\t" //
-                "done%=:                         \n\t" //
-                : [res] "=&r"(res)
-                : [A] "r"(other.r.data), [mod] "r"(this->r.data)
-                : "cc", "%rax");
-            return res;
-        } else if (n == 5) {
-            long res;
-            __asm__(                                   // Preserve alignment
-                "// check for overflow           \n\t" //
-                "mov $0, %[res]                  \n\t" //
-                ADD_CMP(32)                            //
-                ADD_CMP(24)                            //
-                ADD_CMP(16)                            //
-                ADD_CMP(8)                             //
-                ADD_CMP(0)                             //
-                "jmp done%=                      \n\t" //
-                "subtract%=:                     \n\t" //
-                "mov $1, %[res]                  \n\t" //
-                "done%=:                         \n\t" //
-                : [res] "=&r"(res)
-                : [A] "r"(other.r.data), [mod] "r"(this->r.data)
-                : "cc", "%rax");
-            return res;
-        } else
-#endif
-        {
-            return (mpn_cmp(this->r.data, other.r.data, n) < 0);
-        }
+        static thread_local bos_coster_workspace workspace;
+        return workspace;
     }
 };
 
 // Class holding the specialized multi exp implementations. Must implement a
 // public static method of the form:
+//   template<typename BaseIterator>
 //   static GroupT multi_exp_inner(
-//       typename std::vector<GroupT>::const_iterator bases,
-//       typename std::vector<GroupT>::const_iterator bases_end,
+//       BaseIterator bases,
+//       BaseIterator bases_end,
 //       typename std::vector<FieldT>::const_iterator exponents,
 //       typename std::vector<FieldT>::const_iterator exponents_end);
+// where BaseIterator is a random access iterator over GroupT (e.g.
+// std::vector<GroupT>::const_iterator or const GroupT *).
 template<
     typename GroupT,
     typename FieldT,
@@ -216,15 +230,16 @@ template<typename GroupT, typename FieldT, multi_exp_base_form BaseForm>
 class multi_exp_implementation<GroupT, FieldT, multi_exp_method_naive, BaseForm>
 {
 public:
+    template<typename BaseIterator>
     static GroupT multi_exp_inner(
-        typename std::vector<GroupT>::const_iterator vec_start,
-        typename std::vector<GroupT>::const_iterator vec_end,
+        BaseIterator vec_start,
+        BaseIterator vec_end,
         typename std::vector<FieldT>::const_iterator scalar_start,
         typename std::vector<FieldT>::const_iterator scalar_end)
     {
         GroupT result(GroupT::zero());
 
-        typename std::vector<GroupT>::const_iterator vec_it;
+        BaseIterator vec_it;
         typename std::vector<FieldT>::const_iterator scalar_it;
 
         for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end;
@@ -250,15 +265,16 @@ class multi_exp_implementation<
     BaseForm>
 {
 public:
+    template<typename BaseIterator>
     static GroupT multi_exp_inner(
-        typename std::vector<GroupT>::const_iterator vec_start,
-        typename std::vector<GroupT>::const_iterator vec_end,
+        BaseIterator vec_start,
+        BaseIterator vec_end,
         typename std::vector<FieldT>::const_iterator scalar_start,
         typename std::vector<FieldT>::const_iterator scalar_end)
     {
         GroupT result(GroupT::zero());
 
-        typename std::vector<GroupT>::const_iterator vec_it;
+        BaseIterator vec_it;
         typename std::vector<FieldT>::const_iterator scalar_it;
 
         for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end;
@@ -281,34 +297,23 @@ class multi_exp_implementation<
     BaseForm>
 {
 public:
+    template<typename BaseIterator>
     static GroupT multi_exp_inner(
-        typename std::vector<GroupT>::const_iterator bases,
-        typename std::vector<GroupT>::const_iterator bases_end,
+        BaseIterator bases,
+        BaseIterator bases_end,
         typename std::vector<FieldT>::const_iterator exponents,
         typename std::vector<FieldT>::const_iterator exponents_end)
     {
         UNUSED(exponents_end);
         const size_t length = bases_end - bases;
         const size_t c = internal::pippenger_optimal_c(length);
-        int len = length;
-        
-        __LOG::logIntScalar(len);
-        __LOG::logScalarMSMNonMont(len);
 
         const mp_size_t exp_num_limbs =
             std::remove_reference<decltype(*exponents)>::type::num_limbs;
         std::vector<bigint<exp_num_limbs>> bi_exponents(length);
         size_t num_bits = 0;
-        for (int i = 0; i < (bases_end - bases); i++) {
-            __LOG::logG1MSM(bases[i]);
-        }
-        for (int i = 0; i < (exponents_end - exponents); i++) {
-            __LOG::logScalarMSM(exponents[i]);
-        }
-        //exit(1);
         for (size_t i = 0; i < length; i++) {
             bi_exponents[i] = exponents[i].as_bigint();
-            __LOG::logScalarMSMNonMont(bi_exponents[i]);
             num_bits = std::max(num_bits, bi_exponents[i].num_bits());
         }
 
@@ -386,10 +391,6 @@ public:
                 }
             }
         }
-        __LOG::logG1MSM(result);
-        #ifdef __EXIT_EARLY__
-            exit(1);
-        #endif
         return result;
     }
 };
@@ -402,119 +403,113 @@ class multi_exp_implementation<
     BaseForm>
 {
 public:
+    using BigInt =
+        typename std::decay<decltype(((FieldT *)nullptr)->mont_repr)>::type;
+
+    template<typename BaseIterator>
     static GroupT multi_exp_inner(
-        typename std::vector<GroupT>::const_iterator vec_start,
-        typename std::vector<GroupT>::const_iterator vec_end,
+        BaseIterator vec_start,
+        BaseIterator vec_end,
         typename std::vector<FieldT>::const_iterator scalar_start,
         typename std::vector<FieldT>::const_iterator scalar_end)
     {
-        const mp_size_t n =
-            std::remove_reference<decltype(*scalar_start)>::type::num_limbs;
-
-        if (vec_start == vec_end) {
-            return GroupT::zero();
-        }
-
-        if (vec_start + 1 == vec_end) {
-            return (*scalar_start) * (*vec_start);
-        }
-
-        std::vector<ordered_exponent<n>> opt_q;
-        const size_t vec_len = scalar_end - scalar_start;
-        const size_t odd_vec_len = (vec_len % 2 == 1 ? vec_len : vec_len + 1);
-        opt_q.reserve(odd_vec_len);
-        std::vector<GroupT> g;
-        g.reserve(odd_vec_len);
-
-        typename std::vector<GroupT>::const_iterator vec_it;
-        typename std::vector<FieldT>::const_iterator scalar_it;
-        size_t i;
-        for (i = 0, vec_it = vec_start, scalar_it = scalar_start;
-             vec_it != vec_end;
-             ++vec_it, ++scalar_it, ++i) {
-            g.emplace_back(*vec_it);
-
-            opt_q.emplace_back(ordered_exponent<n>(i, scalar_it->as_bigint()));
-        }
-        std::make_heap(opt_q.begin(), opt_q.end());
-        assert(scalar_it == scalar_end);
-
-        if (vec_len != odd_vec_len) {
-            g.emplace_back(GroupT::zero());
-            opt_q.emplace_back(
-                ordered_exponent<n>(odd_vec_len - 1, bigint<n>(0ul)));
+        UNUSED(scalar_end);
+        const size_t num_entries = vec_end - vec_start;
+        assert(scalar_end - scalar_start == (ssize_t)num_entries);
+
+        // Copy the entries with non-zero base and scalar into the workspace.
+        bos_coster_workspace<GroupT, BigInt> &workspace =
+            bos_coster_workspace<GroupT, BigInt>::get();
+        std::vector<GroupT> &bases = workspace.bases;
+        std::vector<BigInt> &scalars = workspace.scalars;
+        std::vector<size_t> &heap = workspace.heap;
+        bases.clear();
+        scalars.clear();
+        heap.clear();
+        for (size_t i = 0; i < num_entries; ++i) {
+            if (vec_start[i].is_zero() || scalar_start[i].is_zero()) {
+                continue;
+            }
+            heap.push_back(scalars.size());
+            bases.push_back(vec_start[i]);
+            scalars.push_back(scalar_start[i].as_bigint());
         }
-        assert(g.size() % 2 == 1);
-        assert(opt_q.size() == g.size());
-
-        GroupT opt_result = GroupT::zero();
 
-        while (true) {
-            ordered_exponent<n> &a = opt_q[0];
-            ordered_exponent<n> &b =
-                (opt_q[1] < opt_q[2] ? opt_q[2] : opt_q[1]);
-
-            const size_t abits = a.r.num_bits();
-
-            if (b.r.is_zero()) {
-                // opt_result = opt_result + (a.r * g[a.idx]);
-                opt_result =
-                    opt_result + opt_window_wnaf_exp(g[a.idx], a.r, abits);
+        std::make_heap(
+            heap.begin(), heap.end(), [&scalars](size_t a, size_t b) {
+                return bos_coster_less(scalars[a], scalars[b]);
+            });
+
+        GroupT result = GroupT::zero();
+        size_t heap_size = heap.size();
+        while (heap_size > 0) {
+            const size_t a = heap[0];
+            BigInt &a_scalar = scalars[a];
+            const size_t abits = a_scalar.num_bits();
+            if (heap_size == 1) {
+                result =
+                    result + opt_window_wnaf_exp(bases[a], a_scalar, abits);
                 break;
             }
 
-            const size_t bbits = b.r.num_bits();
-            const size_t limit = (abits - bbits >= 20 ? 20 : abits - bbits);
-
-            if (bbits < 1ul << limit) {
-                /*
-                  In this case, exponentiating to the power of a is cheaper than
-                  subtracting b from a multiple times, so let's do it directly
-                */
-                // opt_result = opt_result + (a.r * g[a.idx]);
-                opt_result =
-                    opt_result + opt_window_wnaf_exp(g[a.idx], a.r, abits);
-#ifdef DEBUG
-                printf(
-                    "Skipping the following pair (%zu bit number vs %zu "
-                    "bit):\n",
-                    abits,
-                    bbits);
-                a.r.print();
-                b.r.print();
-#endif
-                a.r.clear();
+            // Second largest scalar.
+            const size_t b =
+                (heap_size == 2 ||
+                 !bos_coster_less(scalars[heap[1]], scalars[heap[2]]))
+                    ? heap[1]
+                    : heap[2];
+            const size_t bbits = scalars[b].num_bits();
+            const size_t limit = std::min<size_t>(20, abits - bbits);
+
+            if (bbits < (1ul << limit)) {
+                // In this case, exponentiating to the power of a is cheaper
+                // than subtracting b from a multiple times, so do it
+                // directly.
+                result =
+                    result + opt_window_wnaf_exp(bases[a], a_scalar, abits);
+                a_scalar.clear();
             } else {
                 // x A + y B => (x-y) A + y (B+A)
-                mpn_sub_n(a.r.data, a.r.data, b.r.data, n);
-                g[b.idx] = g[b.idx] + g[a.idx];
+                bos_coster_subtract(a_scalar, scalars[b]);
+                bases[b] = bases[b] + bases[a];
             }
 
-            // regardless of whether a was cleared or subtracted from we push it
-            // down, then take back up
-
-            /* heapify A down */
-            size_t a_pos = 0;
-            while (2 * a_pos + 2 < odd_vec_len) {
-                // this is a max-heap so to maintain a heap property we swap
-                // with the largest of the two
-                if (opt_q[2 * a_pos + 1] < opt_q[2 * a_pos + 2]) {
-                    std::swap(opt_q[a_pos], opt_q[2 * a_pos + 2]);
-                    a_pos = 2 * a_pos + 2;
-                } else {
-                    std::swap(opt_q[a_pos], opt_q[2 * a_pos + 1]);
-                    a_pos = 2 * a_pos + 1;
-                }
+            // Drop a from the heap if it is now zero, and restore the heap
+            // property (only the root can be out of place).
+            if (a_scalar.is_zero()) {
+                heap[0] = heap[--heap_size];
             }
+            sift_down(heap, heap_size, scalars);
+        }
+
+        return result;
+    }
 
-            /* now heapify A up appropriate amount of times */
-            while (a_pos > 0 && opt_q[(a_pos - 1) / 2] < opt_q[a_pos]) {
-                std::swap(opt_q[a_pos], opt_q[(a_pos - 1) / 2]);
-                a_pos = (a_pos - 1) / 2;
+private:
+    static void sift_down(
+        std::vector<size_t> &heap,
+        const size_t heap_size,
+        const std::vector<BigInt> &scalars)
+    {
+        const size_t root = heap[0];
+        size_t pos = 0;
+        while (true) {
+            size_t child = 2 * pos + 1;
+            if (child >= heap_size) {
+                break;
             }
+            if (child + 1 < heap_size &&
+                bos_coster_less(
+                    scalars[heap[child]], scalars[heap[child + 1]])) {
+                ++child;
+            }
+            if (!bos_coster_less(scalars[root], scalars[heap[child]])) {
+                break;
+            }
+            heap[pos] = heap[child];
+            pos = child;
         }
-
-        return opt_result;
+        heap[pos] = root;
     }
 };
 
@@ -529,12 +524,15 @@ public:
     using BigInt =
         typename std::decay<decltype(((FieldT *)nullptr)->mont_repr)>::type;
 
-    /// buckets and bucket_hit should have at least 2^{c-1} entries.
-    static GroupT signed_digits_round(
-        typename std::vector<GroupT>::const_iterator bases,
-        typename std::vector<GroupT>::const_iterator bases_end,
+    /// buckets and bucket_hit should have at least 2^{c-1} entries. BucketT
+    /// is either GroupT or xyzz_point<GroupT> (see
+    /// multi_exp_add_element_to_bucket_with_signed_digit).
+    template<typename BaseIterator, typename BucketT>
+    static BucketT signed_digits_round(
+        BaseIterator bases,
+        BaseIterator bases_end,
         typename std::vector<BigInt>::const_iterator exponents,
-        std::vector<GroupT> &buckets,
+        std::vector<BucketT> &buckets,
         std::vector<bool> &bucket_hit,
         const size_t num_entries,
         const size_t num_buckets,
@@ -558,25 +556,40 @@ public:
                 continue;
             }
 
-            multi_exp_add_element_to_bucket_with_signed_digit<GroupT, BaseForm>(
-                buckets, bucket_hit, bases[i], digit);
+            multi_exp_add_element_to_bucket_with_signed_digit<
+                BucketT,
+                BaseForm>(buckets, bucket_hit, bases[i], digit);
             ++non_zero;
         }
 
         // Check up-front for the edge-case where no buckets have been touched.
         if (non_zero == 0) {
-            return GroupT::zero();
+            return BucketT::zero();
         }
 
         // TODO: consider converting buckets to special form
 
-        return multiexp_accumulate_buckets<GroupT, multi_exp_base_form_normal>(
+        return multiexp_accumulate_buckets<BucketT, multi_exp_base_form_normal>(
             buckets, bucket_hit, num_buckets);
     }
 
+    template<typename BaseIterator>
     static GroupT multi_exp_inner(
-        typename std::vector<GroupT>::const_iterator bases,
-        typename std::vector<GroupT>::const_iterator bases_end,
+        BaseIterator bases,
+        BaseIterator bases_end,
+        typename std::vector<FieldT>::const_iterator exponents,
+        typename std::vector<FieldT>::const_iterator exponents_end)
+    {
+        return multi_exp_inner_with_buckets<GroupT>(
+            bases, bases_end, exponents, exponents_end);
+    }
+
+    /// Compute the multi-exponentiation, accumulating in buckets of type
+    /// BucketT.
+    template<typename BucketT, typename BaseIterator>
+    static BucketT multi_exp_inner_with_buckets(
+        BaseIterator bases,
+        BaseIterator bases_end,
         typename std::vector<FieldT>::const_iterator exponents,
         typename std::vector<FieldT>::const_iterator exponents_end)
     {
@@ -606,14 +619,14 @@ public:
         const size_t num_buckets = 1 << (c - 1);
 
         // Allocate the round state once, and reuse it.
-        std::vector<GroupT> buckets(num_buckets);
+        std::vector<BucketT> buckets(num_buckets);
         std::vector<bool> bucket_hit(num_buckets);
         assert(buckets.size() == num_buckets);
         assert(bucket_hit.size() == num_buckets);
 
         // Compute from highest-order to lowest-order digits, accumulating at
         // the same time.
-        GroupT result = signed_digits_round(
+        BucketT result = signed_digits_round(
             bases,
             bases_end,
             bi_exponents.begin(),
@@ -629,7 +642,7 @@ public:
                 result = result.dbl();
             }
 
-            const GroupT round_result = signed_digits_round(
+            const BucketT round_result = signed_digits_round(
                 bases,
                 bases_end,
                 bi_exponents.begin(),
@@ -646,32 +659,246 @@ public:
     }
 };
 
-} // namespace internal
+template<typename GroupT, typename FieldT, multi_exp_base_form BaseForm>
+class multi_exp_implementation<
+    GroupT,
+    FieldT,
+    multi_exp_method_straus,
+    BaseForm>
+{
+public:
+    using BigInt =
+        typename std::decay<decltype(((FieldT *)nullptr)->mont_repr)>::type;
 
-static inline size_t bdlo12_signed_optimal_c(size_t num_entries)
+    template<typename BaseIterator>
+    static GroupT multi_exp_inner(
+        BaseIterator bases,
+        BaseIterator bases_end,
+        typename std::vector<FieldT>::const_iterator exponents,
+        typename std::vector<FieldT>::const_iterator exponents_end)
+    {
+        UNUSED(exponents_end);
+
+        const size_t num_entries = bases_end - bases;
+        assert(exponents_end - exponents == (ssize_t)num_entries);
+
+        straus_workspace<GroupT, BigInt> &workspace =
+            straus_workspace<GroupT, BigInt>::get();
+        std::vector<size_t> &indices = workspace.indices;
+        std::vector<BigInt> &bi_exponents = workspace.bi_exponents;
+        std::vector<GroupT> &table = workspace.table;
+        std::vector<std::vector<long>> &nafs = workspace.nafs;
+        std::vector<GroupT> &non_zero_table = workspace.non_zero_table;
+
+        // Skip entries with zero base or scalar.
+        indices.clear();
+        bi_exponents.clear();
+        size_t num_bits = 0;
+        for (size_t i = 0; i < num_entries; ++i) {
+            if (bases[i].is_zero() || exponents[i].is_zero()) {
+                continue;
+            }
+            indices.push_back(i);
+            bi_exponents.push_back(exponents[i].as_bigint());
+            num_bits = std::max(num_bits, bi_exponents.back().num_bits());
+        }
+        if (indices.empty()) {
+            return GroupT::zero();
+        }
+
+        // The table costs 2^{w-1} additions per base, and saves a fraction
+        // of the additions of the main loop, exactly as for a single wNAF
+        // exponentiation.
+        const size_t window_size =
+            std::max<size_t>(1, wnaf_opt_window_size<GroupT>(num_bits));
+        const size_t table_size = 1ul << (window_size - 1);
+
+        // table[j * table_size + k] = (2k + 1) * bases[indices[j]], and
+        // nafs[j] holds the wNAF digits of bi_exponents[j].
+        // (nafs may hold more vectors than needed, to retain their
+        // capacity across calls.)
+        const size_t num_bases = indices.size();
+        table.resize(num_bases * table_size);
+        if (nafs.size() < num_bases) {
+            nafs.resize(num_bases);
+        }
+        size_t num_digits = 0;
+        for (size_t j = 0; j < num_bases; ++j) {
+            const GroupT &base = bases[indices[j]];
+            const GroupT dbl = base.dbl();
+            GroupT *const base_table = &table[j * table_size];
+            base_table[0] = base;
+            for (size_t k = 1; k < table_size; ++k) {
+                base_table[k] = base_table[k - 1] + dbl;
+            }
+
+            update_wnaf(nafs[j], window_size, bi_exponents[j]);
+            num_digits = std::max(num_digits, nafs[j].size());
+        }
+
+        // All table entries are added many times, so convert them to special
+        // form (with a single inversion) and use mixed additions. Entries
+        // can only be zero for bases of small order.
+        non_zero_table.clear();
+        for (const GroupT &entry : table) {
+            if (!entry.is_zero()) {
+                non_zero_table.push_back(entry);
+            }
+        }
+        GroupT::batch_to_special_all_non_zeros(non_zero_table);
+        for (size_t i = 0, k = 0; i < table.size(); ++i) {
+            if (!table[i].is_zero()) {
+                table[i] = non_zero_table[k++];
+            }
+        }
+
+        GroupT result = GroupT::zero();
+        bool result_nonzero = false;
+        for (size_t i = num_digits; i-- > 0;) {
+            if (result_nonzero) {
+                result = result.dbl();
+            }
+
+            for (size_t j = 0; j < num_bases; ++j) {
+                if (i >= nafs[j].size() || nafs[j][i] == 0) {
+                    continue;
+                }
+
+                const long digit = nafs[j][i];
+                const GroupT &entry =
+                    table[j * table_size + (std::labs(digit) / 2)];
+                if (entry.is_zero()) {
+                    continue;
+                }
+                result = (digit > 0) ? result.mixed_add(entry)
+                                     : result.mixed_add(-entry);
+                result_nonzero = true;
+            }
+        }
+
+        return result;
+    }
+};
+
+/// Uses multi_exp_method_straus or multi_exp_method_BDLO12_signed depending
+/// on the number of entries.
+template<typename GroupT, typename FieldT, multi_exp_base_form BaseForm>
+class multi_exp_implementation<GroupT, FieldT, multi_exp_method_auto, BaseForm>
 {
-    // For now, this seems like a good estimate in most cases.
-    return internal::pippenger_optimal_c(num_entries) + 1;
-}
+public:
+    template<typename BaseIterator>
+    static GroupT multi_exp_inner(
+        BaseIterator bases,
+        BaseIterator bases_end,
+        typename std::vector<FieldT>::const_iterator exponents,
+        typename std::vector<FieldT>::const_iterator exponents_end)
+    {
+        if ((size_t)(bases_end - bases) < MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES) {
+            return multi_exp_implementation<
+                GroupT,
+                FieldT,
+                multi_exp_method_straus,
+                BaseForm>::
+                multi_exp_inner(bases, bases_end, exponents, exponents_end);
+        }
 
+        return multi_exp_implementation<
+            GroupT,
+            FieldT,
+            multi_exp_method_BDLO12_signed,
+            BaseForm>::
+            multi_exp_inner(bases, bases_end, exponents, exponents_end);
+    }
+};
+
+template<typename GroupT, typename FieldT, multi_exp_base_form BaseForm>
+class multi_exp_implementation<
+    GroupT,
+    FieldT,
+    multi_exp_method_BDLO12_signed_xyzz,
+    BaseForm>
+{
+public:
+    using signed_implementation = multi_exp_implementation<
+        GroupT,
+        FieldT,
+        multi_exp_method_BDLO12_signed,
+        multi_exp_base_form_special>;
+
+    template<typename BaseIterator>
+    static GroupT multi_exp_inner(
+        BaseIterator bases,
+        BaseIterator bases_end,
+        typename std::vector<FieldT>::const_iterator exponents,
+        typename std::vector<FieldT>::const_iterator exponents_end)
+    {
+        if (BaseForm == multi_exp_base_form_special) {
+            return signed_implementation::template multi_exp_inner_with_buckets<
+                       xyzz_point<GroupT>>(
+                       bases, bases_end, exponents, exponents_end)
+                .to_group();
+        }
+
+        // Buckets absorb base elements in special form, so convert a copy of
+        // the (non-zero) base elements, using a single inversion.
+        std::vector<GroupT> special_bases(bases, bases_end);
+        std::vector<GroupT> non_zero_bases;
+        non_zero_bases.reserve(special_bases.size());
+        for (const GroupT &base : special_bases) {
+            if (!base.is_zero()) {
+                non_zero_bases.push_back(base);
+            }
+        }
+        GroupT::batch_to_special_all_non_zeros(non_zero_bases);
+        auto non_zero_it = non_zero_bases.begin();
+        for (GroupT &base : special_bases) {
+            if (!base.is_zero()) {
+                base = *non_zero_it;
+                ++non_zero_it;
+            }
+        }
+
+        return signed_implementation::template multi_exp_inner_with_buckets<
+                   xyzz_point<GroupT>>(
+                   special_bases.cbegin(),
+                   special_bases.cend(),
+                   exponents,
+                   exponents_end)
+            .to_group();
+    }
+};
+
+/// Implementation of multi_exp for any random access iterator over base
+/// elements.
 template<
     typename GroupT,
     typename FieldT,
     multi_exp_method Method,
-    multi_exp_base_form BaseForm>
-GroupT multi_exp(
-    typename std::vector<GroupT>::const_iterator vec_start,
-    typename std::vector<GroupT>::const_iterator vec_end,
+    multi_exp_base_form BaseForm,
+    typename BaseIterator>
+GroupT multi_exp_chunked(
+    BaseIterator vec_start,
+    BaseIterator vec_end,
     typename std::vector<FieldT>::const_iterator scalar_start,
     typename std::vector<FieldT>::const_iterator scalar_end,
     const size_t chunks)
 {
+    LIBFF_TRACE_MULTI_EXP(
+        GroupT,
+        FieldT,
+        vec_start,
+        vec_end,
+        scalar_start,
+        Method,
+        BaseForm,
+        chunks);
+
     const size_t total = vec_end - vec_start;
     if ((total < chunks) || (chunks == 1)) {
         // no need to split into "chunks", can call implementation directly
-        return internal::
+        return LIBFF_TRACE_RESULT(
             multi_exp_implementation<GroupT, FieldT, Method, BaseForm>::
-                multi_exp_inner(vec_start, vec_end, scalar_start, scalar_end);
+                multi_exp_inner(vec_start, vec_end, scalar_start, scalar_end));
     }
 
     const size_t one = total / chunks;
@@ -682,7 +909,8 @@ GroupT multi_exp(
 #pragma omp parallel for
 #endif
     for (size_t i = 0; i < chunks; ++i) {
-        partial[i] = internal::
+        LIBFF_TRACE_MULTI_EXP_INNER();
+        partial[i] =
             multi_exp_implementation<GroupT, FieldT, Method, BaseForm>::
                 multi_exp_inner(
                     vec_start + i * one,
@@ -698,7 +926,47 @@ GroupT multi_exp(
         final = final + partial[i];
     }
 
-    return final;
+    return LIBFF_TRACE_RESULT(final);
+}
+
+} // namespace internal
+
+static inline size_t bdlo12_signed_optimal_c(size_t num_entries)
+{
+    // For now, this seems like a good estimate in most cases.
+    return internal::pippenger_optimal_c(num_entries) + 1;
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+GroupT multi_exp(
+    typename std::vector<GroupT>::const_iterator vec_start,
+    typename std::vector<GroupT>::const_iterator vec_end,
+    typename std::vector<FieldT>::const_iterator scalar_start,
+    typename std::vector<FieldT>::const_iterator scalar_end,
+    const size_t chunks)
+{
+    return internal::multi_exp_chunked<GroupT, FieldT, Method, BaseForm>(
+        vec_start, vec_end, scalar_start, scalar_end, chunks);
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+GroupT multi_exp(
+    const GroupT *vec_start,
+    const GroupT *vec_end,
+    typename std::vector<FieldT>::const_iterator scalar_start,
+    typename std::vector<FieldT>::const_iterator scalar_end,
+    const size_t chunks)
+{
+    return internal::multi_exp_chunked<GroupT, FieldT, Method, BaseForm>(
+        vec_start, vec_end, scalar_start, scalar_end, chunks);
 }
 
 template<
@@ -770,6 +1038,37 @@ GroupT multi_exp_filter_one_zero(
                      g.begin(), g.end(), p.begin(), p.end(), chunks);
 }
 
+template<typename T, typename FieldT, multi_exp_base_form BaseForm>
+std::vector<T> multi_exp_batch(
+    const std::vector<multi_exp_batch_instance<T, FieldT>> &instances,
+    const bool normalize)
+{
+    std::vector<T> results(instances.size());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const multi_exp_batch_instance<T, FieldT> &instance = instances[i];
+        results[i] = internal::multi_exp_implementation<
+            T,
+            FieldT,
+            multi_exp_method_auto,
+            BaseForm>::
+            multi_exp_inner(
+                instance.vec_start,
+                instance.vec_end,
+                instance.scalar_start,
+                instance.scalar_start +
+                    (instance.vec_end - instance.vec_start));
+    }
+
+    if (normalize) {
+        batch_to_special(results);
+    }
+    return results;
+}
+
 template<typename T>
 T inner_product(
     typename std::vector<T>::const_iterator a_start,
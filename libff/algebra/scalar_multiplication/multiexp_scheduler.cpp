@@ -0,0 +1,145 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the multi-exponentiation scheduler.
+
+ See multiexp_scheduler.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/scalar_multiplication/multiexp_scheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace libff
+{
+
+/// Multi-exponentiations are not split into slices smaller than this.
+static const size_t MULTI_EXP_SCHEDULER_MIN_SLICE_SIZE = 256;
+
+namespace
+{
+
+class scheduler_slice
+{
+public:
+    internal::multi_exp_scheduler_job *job;
+    size_t job_idx;
+    size_t slice_idx;
+    size_t begin;
+    size_t end;
+    double cost;
+};
+
+} // namespace
+
+size_t multi_exp_scheduler::num_jobs() const { return _jobs.size(); }
+
+void multi_exp_scheduler::run(const size_t num_threads)
+{
+    // Every promise must be set, so errors are delivered through them.
+    std::vector<std::exception_ptr> errors(_jobs.size());
+    try {
+        compute(num_threads, errors);
+    } catch (...) {
+        std::fill(errors.begin(), errors.end(), std::current_exception());
+    }
+
+    for (size_t i = 0; i < _jobs.size(); ++i) {
+        _jobs[i]->finish(errors[i]);
+    }
+    _jobs.clear();
+}
+
+void multi_exp_scheduler::compute(
+    const size_t num_threads, std::vector<std::exception_ptr> &errors)
+{
+    const size_t num_lanes_max = std::max<size_t>(1, num_threads);
+
+    // Split each job into a number of slices proportional to its share of
+    // the total cost.
+    double total_cost = 0;
+    for (const auto &job : _jobs) {
+        total_cost += job->estimate_cost(job->size());
+    }
+    const double target_cost = total_cost / num_lanes_max;
+
+    std::vector<scheduler_slice> slices;
+    for (size_t job_idx = 0; job_idx < _jobs.size(); ++job_idx) {
+        internal::multi_exp_scheduler_job *const job = _jobs[job_idx].get();
+        const size_t n = job->size();
+        if (n == 0) {
+            job->set_num_slices(0);
+            continue;
+        }
+
+        const double cost = job->estimate_cost(n);
+        const size_t max_slices =
+            std::max<size_t>(1, n / MULTI_EXP_SCHEDULER_MIN_SLICE_SIZE);
+        const size_t num_slices = std::min(
+            max_slices,
+            std::max<size_t>(1, (size_t)std::lround(cost / target_cost)));
+        job->set_num_slices(num_slices);
+
+        const size_t one = n / num_slices;
+        for (size_t i = 0; i < num_slices; ++i) {
+            const size_t begin = i * one;
+            const size_t end = (i == num_slices - 1) ? n : (begin + one);
+            slices.push_back(
+                {job,
+                 job_idx,
+                 i,
+                 begin,
+                 end,
+                 job->estimate_cost(end - begin)});
+        }
+    }
+
+    // Assign slices to lanes (threads), largest first, each to the lane with
+    // the smallest total cost so far.
+    std::sort(
+        slices.begin(),
+        slices.end(),
+        [](const scheduler_slice &a, const scheduler_slice &b) {
+            return a.cost > b.cost;
+        });
+    const size_t num_lanes =
+        std::max<size_t>(1, std::min(num_lanes_max, slices.size()));
+    std::vector<std::vector<const scheduler_slice *>> lanes(num_lanes);
+    std::vector<double> lane_costs(num_lanes, 0);
+    for (const scheduler_slice &slice : slices) {
+        const size_t lane =
+            std::min_element(lane_costs.begin(), lane_costs.end()) -
+            lane_costs.begin();
+        lanes[lane].push_back(&slice);
+        lane_costs[lane] += slice.cost;
+    }
+
+#ifdef MULTICORE
+#pragma omp parallel for num_threads(num_lanes) schedule(static, 1)
+#endif
+    for (size_t i = 0; i < num_lanes; ++i) {
+        for (const scheduler_slice *slice : lanes[i]) {
+            // Exceptions cannot leave the parallel region, so the first
+            // error of each job is recorded instead.
+            try {
+                slice->job->compute_slice(
+                    slice->slice_idx, slice->begin, slice->end);
+            } catch (...) {
+#ifdef MULTICORE
+#pragma omp critical
+#endif
+                if (!errors[slice->job_idx]) {
+                    errors[slice->job_idx] = std::current_exception();
+                }
+            }
+        }
+    }
+}
+
+} // namespace libff
@@ -0,0 +1,122 @@
+/** @file
+ *****************************************************************************
+
+ Concurrent scheduling of several independent multi-exponentiations (e.g.
+ the G1 and G2 multi-exponentiations of a prover), possibly of different
+ sizes and over different groups.
+
+ All multi-exponentiations are added up front, and run() computes them
+ together: the cost of each is estimated (from its size, the scalar size and
+ the measured cost of a group addition), each is split into slices so that
+ the threads receive a share of the work proportional to its cost, and the
+ slices of all multi-exponentiations are assigned to threads, largest first.
+ In this way, for example, a G2 multi-exponentiation runs concurrently with
+ the G1 multi-exponentiations, using a proportional number of threads,
+ rather than each multi-exponentiation running in turn over all threads
+ (with poor scaling at the tail of each).
+
+   multi_exp_scheduler scheduler;
+   std::future<G1> a = scheduler.add<G1, Fr, Method>(...);
+   std::future<G2> b = scheduler.add<G2, Fr, Method>(...);
+   scheduler.run(num_threads);
+   // a.get() and b.get() are now available.
+
+ Threads are used if MULTICORE is enabled.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SCHEDULER_HPP_
+#define MULTIEXP_SCHEDULER_HPP_
+
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// A multi-exponentiation added to a multi_exp_scheduler, computed in
+/// slices.
+class multi_exp_scheduler_job
+{
+public:
+    virtual ~multi_exp_scheduler_job() = default;
+
+    /// Number of entries.
+    virtual size_t size() const = 0;
+
+    /// Estimated cost of a slice of the given number of entries, in
+    /// nanoseconds.
+    virtual double estimate_cost(const size_t num_entries) const = 0;
+
+    /// Allocate the results of num_slices slices.
+    virtual void set_num_slices(const size_t num_slices) = 0;
+
+    /// Compute the result of the given slice, which covers the entries from
+    /// begin to end.
+    virtual void compute_slice(
+        const size_t slice_idx, const size_t begin, const size_t end) = 0;
+
+    /// Sum the results of all slices, fulfilling the promise, or, if error
+    /// is set (the first error of any slice), fail the promise with it.
+    virtual void finish(const std::exception_ptr &error) = 0;
+};
+
+} // namespace internal
+
+class multi_exp_scheduler
+{
+public:
+    multi_exp_scheduler() = default;
+    multi_exp_scheduler(const multi_exp_scheduler &) = delete;
+    multi_exp_scheduler &operator=(const multi_exp_scheduler &) = delete;
+
+    /// Add the multi-exponentiation
+    ///   \sum_i scalar_start[i] * vec_start[i]
+    /// to be computed with the given method by the next call to run(). The
+    /// base elements and scalars must remain valid until then. The returned
+    /// future is ready once run() returns.
+    template<
+        typename GroupT,
+        typename FieldT,
+        multi_exp_method Method,
+        multi_exp_base_form BaseForm = multi_exp_base_form_normal,
+        typename BaseIterator>
+    std::future<GroupT> add(
+        BaseIterator vec_start,
+        BaseIterator vec_end,
+        typename std::vector<FieldT>::const_iterator scalar_start,
+        typename std::vector<FieldT>::const_iterator scalar_end);
+
+    /// Number of multi-exponentiations added since the last call to run().
+    size_t num_jobs() const;
+
+    /// Compute all added multi-exponentiations, using up to num_threads
+    /// threads in total. If a multi-exponentiation fails, its future holds
+    /// the exception.
+    void run(const size_t num_threads);
+
+protected:
+    /// Compute the slices of all jobs, recording the first error of each
+    /// job in errors.
+    void compute(
+        const size_t num_threads, std::vector<std::exception_ptr> &errors);
+
+    std::vector<std::unique_ptr<internal::multi_exp_scheduler_job>> _jobs;
+};
+
+} // namespace libff
+
+#include "libff/algebra/scalar_multiplication/multiexp_scheduler.tcc"
+
+#endif // MULTIEXP_SCHEDULER_HPP_
@@ -0,0 +1,168 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the multi-exponentiation scheduler.
+
+ See multiexp_scheduler.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SCHEDULER_TCC_
+#define MULTIEXP_SCHEDULER_TCC_
+
+#include "libff/algebra/scalar_multiplication/multiexp_scheduler.hpp"
+#include "libff/common/profiling.hpp"
+#include "libff/common/utils.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Measured cost of an addition in GroupT, in nanoseconds: the median over
+/// several runs of a sequence of additions, so that a single interrupted or
+/// cold run does not skew the cost model. Measured once per group.
+template<typename GroupT> double multi_exp_scheduler_add_cost()
+{
+    static const double cost = []() {
+        const size_t num_runs = 7;
+        const size_t num_additions = 1024;
+        GroupT acc = GroupT::one();
+        const GroupT other = acc.dbl();
+        std::vector<double> run_costs(num_runs);
+        for (double &run_cost : run_costs) {
+            const long long start_time = get_nsec_time();
+            for (size_t i = 0; i < num_additions; ++i) {
+                acc = acc + other;
+            }
+            const long long time = get_nsec_time() - start_time;
+            run_cost = (double)time / num_additions;
+        }
+        std::nth_element(
+            run_costs.begin(),
+            run_costs.begin() + num_runs / 2,
+            run_costs.end());
+        // Ensure that the additions are not optimized away.
+        const double zero_adjust = acc.is_zero() ? 1.0 : 0.0;
+        return std::max(1.0, run_costs[num_runs / 2] + zero_adjust);
+    }();
+    return cost;
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm,
+    typename BaseIterator>
+class multi_exp_scheduler_job_impl : public multi_exp_scheduler_job
+{
+public:
+    multi_exp_scheduler_job_impl(
+        BaseIterator vec_start,
+        BaseIterator vec_end,
+        typename std::vector<FieldT>::const_iterator scalar_start,
+        typename std::vector<FieldT>::const_iterator scalar_end)
+        : _vec_start(vec_start)
+        , _scalar_start(scalar_start)
+        , _size(vec_end - vec_start)
+    {
+        assert(scalar_end - scalar_start == (ssize_t)_size);
+        UNUSED(scalar_end);
+    }
+
+    std::future<GroupT> get_future() { return _result.get_future(); }
+
+    size_t size() const override { return _size; }
+
+    double estimate_cost(const size_t num_entries) const override
+    {
+        // Additions of a signed-digit Pippenger multi-exponentiation: for
+        // each c-bit digit, one addition per entry and two per bucket.
+        if (num_entries == 0) {
+            return 0;
+        }
+        const size_t c = bdlo12_signed_optimal_c(num_entries);
+        const size_t num_bits = FieldT::size_in_bits();
+        const size_t num_rounds = (num_bits + c - 1) / c;
+        const double num_additions =
+            (double)num_rounds * (num_entries + (1ul << c)) + num_bits;
+        return num_additions * multi_exp_scheduler_add_cost<GroupT>();
+    }
+
+    void set_num_slices(const size_t num_slices) override
+    {
+        _partial.assign(num_slices, GroupT::zero());
+    }
+
+    void compute_slice(
+        const size_t slice_idx, const size_t begin, const size_t end) override
+    {
+        _partial[slice_idx] = multi_exp<GroupT, FieldT, Method, BaseForm>(
+            _vec_start + begin,
+            _vec_start + end,
+            _scalar_start + begin,
+            _scalar_start + end,
+            1);
+    }
+
+    void finish(const std::exception_ptr &error) override
+    {
+        if (error) {
+            _result.set_exception(error);
+            return;
+        }
+
+        GroupT result = GroupT::zero();
+        for (const GroupT &partial : _partial) {
+            result = result + partial;
+        }
+        _result.set_value(result);
+    }
+
+protected:
+    const BaseIterator _vec_start;
+    const typename std::vector<FieldT>::const_iterator _scalar_start;
+    const size_t _size;
+    std::vector<GroupT> _partial;
+    std::promise<GroupT> _result;
+};
+
+} // namespace internal
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm,
+    typename BaseIterator>
+std::future<GroupT> multi_exp_scheduler::add(
+    BaseIterator vec_start,
+    BaseIterator vec_end,
+    typename std::vector<FieldT>::const_iterator scalar_start,
+    typename std::vector<FieldT>::const_iterator scalar_end)
+{
+    using job_type = internal::multi_exp_scheduler_job_impl<
+        GroupT,
+        FieldT,
+        Method,
+        BaseForm,
+        BaseIterator>;
+    std::unique_ptr<job_type> job(
+        new job_type(vec_start, vec_end, scalar_start, scalar_end));
+    std::future<GroupT> result = job->get_future();
+    _jobs.emplace_back(std::move(job));
+    return result;
+}
+
+} // namespace libff
+
+#endif // MULTIEXP_SCHEDULER_TCC_
@@ -0,0 +1,223 @@
+/** @file
+ *****************************************************************************
+
+ A local multi-exponentiation service. A multi_exp_server holds a vector of
+ base elements and serves multi-exponentiation requests from other processes
+ on the same host over a Unix domain socket, so that large base vectors (e.g.
+ proving key elements) are loaded once per host rather than once per process.
+
+ The base elements are either owned by the server, or served directly from a
+ shared_base_vector (see shared_base_vector.hpp), in which case the single
+ decoded copy lives in POSIX shared memory or on huge pages, can be mapped by
+ other processes as well, and survives restarts of the server.
+
+ Requests from all connections are queued and processed in batches: each
+ request is split into slices, and the slices of all requests in a batch are
+ processed in parallel.
+
+ Elements are transferred in their in-memory representation, so server and
+ clients must be built from the same version of the library, for the same
+ architecture. The server rejects scalars that are not reduced modulo the
+ field characteristic.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SERVER_HPP_
+#define MULTIEXP_SERVER_HPP_
+
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+#include "libff/algebra/scalar_multiplication/shared_base_vector.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libff
+{
+
+static const uint32_t MULTI_EXP_SERVER_MAGIC = 0x4d534d31; // "MSM1"
+
+enum multi_exp_server_command : uint32_t {
+    /// Query the number of base elements held by the server.
+    multi_exp_server_command_info = 1,
+    /// Compute \sum_i scalars[i] * bases[base_offset + i]. The request header
+    /// is followed by num_scalars scalars.
+    multi_exp_server_command_multi_exp = 2,
+};
+
+enum multi_exp_server_status : uint32_t {
+    multi_exp_server_status_ok = 0,
+    multi_exp_server_status_invalid_request = 1,
+    multi_exp_server_status_out_of_range = 2,
+    /// The request was valid, but computing it failed.
+    multi_exp_server_status_error = 3,
+};
+
+/// Request header. scalar_size and group_size (sizeof(FieldT) and
+/// sizeof(GroupT) on the client) guard against mismatched curves.
+struct multi_exp_server_request {
+    uint32_t magic;
+    uint32_t command;
+    uint64_t base_offset;
+    uint64_t num_scalars;
+    uint32_t scalar_size;
+    uint32_t group_size;
+};
+
+/// Response header. For successful multi_exp requests, it is followed by the
+/// resulting group element.
+struct multi_exp_server_response {
+    uint32_t status;
+    uint32_t reserved;
+    uint64_t num_bases;
+};
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method = multi_exp_method_BDLO12_signed>
+class multi_exp_server
+{
+public:
+    multi_exp_server(const multi_exp_server &) = delete;
+    multi_exp_server &operator=(const multi_exp_server &) = delete;
+
+    /// Take ownership of bases (converting them to special form). num_slices
+    /// is the number of slices each large request is split into,
+    /// max_batch_size the maximum number of queued requests processed
+    /// together, and max_connections the maximum number of connections
+    /// served at a time (further connections wait in the listen backlog).
+    /// Connections on which no data arrives for receive_timeout_ms
+    /// milliseconds (while idle, or part-way through a request) are closed,
+    /// so that stalled clients do not hold connection slots (0 for no
+    /// timeout).
+    multi_exp_server(
+        std::vector<GroupT> &&bases,
+        size_t num_slices,
+        size_t max_batch_size = 16,
+        size_t max_connections = 64,
+        size_t receive_timeout_ms = 60000);
+
+    /// Serve the elements of a shared base vector (in either base form)
+    /// directly from its mapping, without copying them.
+    multi_exp_server(
+        shared_base_vector<GroupT> &&bases,
+        size_t num_slices,
+        size_t max_batch_size = 16,
+        size_t max_connections = 64,
+        size_t receive_timeout_ms = 60000);
+    ~multi_exp_server();
+
+    size_t num_bases() const;
+
+    /// Listen on socket_path and serve requests on background threads until
+    /// stop() is called.
+    void start(const std::string &socket_path);
+
+    /// Stop accepting connections, close existing connections and join all
+    /// threads.
+    void stop();
+
+    /// Compute a single request directly (bypassing the socket). Throws
+    /// std::out_of_range if the request exceeds the base elements.
+    GroupT multi_exp(
+        const std::vector<FieldT> &scalars, const size_t base_offset) const;
+
+protected:
+    class request
+    {
+    public:
+        std::vector<FieldT> scalars;
+        size_t base_offset;
+        std::promise<GroupT> result;
+    };
+
+    void accept_loop();
+    void connection_loop(int fd);
+    void join_finished_connections();
+    void scheduler_loop();
+    void process_batch(std::vector<std::shared_ptr<request>> &batch) const;
+    /// Sum the results of the requests of a batch into results, recording
+    /// the first error of each failed request in errors.
+    void compute_batch(
+        const std::vector<std::shared_ptr<request>> &batch,
+        std::vector<GroupT> &results,
+        std::vector<std::exception_ptr> &errors) const;
+
+    /// Exactly one of these holds the base elements, which are accessed via
+    /// _bases_begin and _bases_end.
+    std::vector<GroupT> _owned_bases;
+    shared_base_vector<GroupT> _shared_bases;
+    const GroupT *_bases_begin;
+    const GroupT *_bases_end;
+    multi_exp_base_form _base_form;
+
+    const size_t _num_slices;
+    const size_t _max_batch_size;
+    const size_t _max_connections;
+    const size_t _receive_timeout_ms;
+
+    std::string _socket_path;
+    int _listen_fd;
+    bool _running;
+    std::thread _accept_thread;
+    std::thread _scheduler_thread;
+
+    std::mutex _connections_mutex;
+    std::condition_variable _connections_cv;
+    bool _accepting;
+    /// Threads serving the open connections, by socket.
+    std::map<int, std::thread> _connections;
+    /// Threads of closed connections, not yet joined.
+    std::vector<std::thread> _finished_connections;
+
+    std::mutex _queue_mutex;
+    std::condition_variable _queue_cv;
+    std::deque<std::shared_ptr<request>> _queue;
+};
+
+/// Client for a multi_exp_server. Not thread-safe: concurrent users should
+/// each create their own client (connection).
+template<typename GroupT, typename FieldT> class multi_exp_client
+{
+public:
+    multi_exp_client(const multi_exp_client &) = delete;
+    multi_exp_client &operator=(const multi_exp_client &) = delete;
+
+    /// Connect to the server at socket_path. Throws std::runtime_error on
+    /// failure.
+    explicit multi_exp_client(const std::string &socket_path);
+    ~multi_exp_client();
+
+    /// Number of base elements held by the server.
+    size_t num_bases();
+
+    /// Compute \sum_i scalars[i] * bases[base_offset + i] on the server.
+    /// Throws std::out_of_range if the request exceeds the base elements.
+    GroupT multi_exp(
+        const std::vector<FieldT> &scalars, const size_t base_offset = 0);
+
+protected:
+    multi_exp_server_response send_request(
+        const multi_exp_server_request &request, const void *payload);
+
+    int _fd;
+};
+
+} // namespace libff
+
+#include "libff/algebra/scalar_multiplication/multiexp_server.tcc"
+
+#endif // MULTIEXP_SERVER_HPP_
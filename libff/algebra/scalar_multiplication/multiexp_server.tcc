@@ -0,0 +1,504 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the local multi-exponentiation service.
+
+ See multiexp_server.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SERVER_TCC_
+#define MULTIEXP_SERVER_TCC_
+
+#include "libff/algebra/scalar_multiplication/multiexp_server.hpp"
+#include "libff/common/unix_socket.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Requests are not split into slices smaller than this.
+static const size_t MULTI_EXP_SERVER_MIN_SLICE_SIZE = 256;
+
+/// True if the (Montgomery) representation of a scalar received from a
+/// client is reduced modulo the field characteristic. Unreduced values are
+/// not valid field elements.
+template<typename FieldT> bool multi_exp_server_scalar_is_valid(const FieldT &s)
+{
+    return mpn_cmp(s.mont_repr.data, FieldT::mod.data, FieldT::num_limbs) < 0;
+}
+
+} // namespace internal
+
+// multi_exp_server
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+multi_exp_server<GroupT, FieldT, Method>::multi_exp_server(
+    std::vector<GroupT> &&bases,
+    size_t num_slices,
+    size_t max_batch_size,
+    size_t max_connections,
+    size_t receive_timeout_ms)
+    : _owned_bases(std::move(bases))
+    , _bases_begin(nullptr)
+    , _bases_end(nullptr)
+    , _base_form(multi_exp_base_form_special)
+    , _num_slices(std::max<size_t>(1, num_slices))
+    , _max_batch_size(std::max<size_t>(1, max_batch_size))
+    , _max_connections(std::max<size_t>(1, max_connections))
+    , _receive_timeout_ms(receive_timeout_ms)
+    , _listen_fd(-1)
+    , _running(false)
+    , _accepting(false)
+{
+    batch_to_special(_owned_bases);
+    _bases_begin = _owned_bases.data();
+    _bases_end = _bases_begin + _owned_bases.size();
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+multi_exp_server<GroupT, FieldT, Method>::multi_exp_server(
+    shared_base_vector<GroupT> &&bases,
+    size_t num_slices,
+    size_t max_batch_size,
+    size_t max_connections,
+    size_t receive_timeout_ms)
+    : _shared_bases(std::move(bases))
+    , _bases_begin(_shared_bases.begin())
+    , _bases_end(_shared_bases.end())
+    , _base_form(_shared_bases.base_form())
+    , _num_slices(std::max<size_t>(1, num_slices))
+    , _max_batch_size(std::max<size_t>(1, max_batch_size))
+    , _max_connections(std::max<size_t>(1, max_connections))
+    , _receive_timeout_ms(receive_timeout_ms)
+    , _listen_fd(-1)
+    , _running(false)
+    , _accepting(false)
+{
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+multi_exp_server<GroupT, FieldT, Method>::~multi_exp_server()
+{
+    stop();
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+size_t multi_exp_server<GroupT, FieldT, Method>::num_bases() const
+{
+    return _bases_end - _bases_begin;
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::start(
+    const std::string &socket_path)
+{
+    if (_running) {
+        throw std::logic_error("multi_exp_server already started");
+    }
+
+    _socket_path = socket_path;
+    _listen_fd = unix_socket_listen(socket_path);
+    _running = true;
+    _accepting = true;
+    _scheduler_thread = std::thread([this]() { scheduler_loop(); });
+    _accept_thread = std::thread([this]() { accept_loop(); });
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::stop()
+{
+    if (!_running) {
+        return;
+    }
+
+    // Stop accepting connections.
+    {
+        std::lock_guard<std::mutex> lock(_connections_mutex);
+        _accepting = false;
+    }
+    _connections_cv.notify_all();
+    unix_socket_shutdown(_listen_fd);
+    _accept_thread.join();
+    unix_socket_close(_listen_fd);
+    _listen_fd = -1;
+
+    // Close all connections, and join their threads. Connection threads with
+    // requests in flight exit once the scheduler has processed them.
+    {
+        std::unique_lock<std::mutex> lock(_connections_mutex);
+        for (const auto &connection : _connections) {
+            unix_socket_shutdown(connection.first);
+        }
+        _connections_cv.wait(lock, [this]() { return _connections.empty(); });
+    }
+    join_finished_connections();
+
+    // Stop the scheduler, once the queue is empty.
+    {
+        std::lock_guard<std::mutex> lock(_queue_mutex);
+        _running = false;
+    }
+    _queue_cv.notify_all();
+    _scheduler_thread.join();
+
+    unix_socket_remove(_socket_path);
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+GroupT multi_exp_server<GroupT, FieldT, Method>::multi_exp(
+    const std::vector<FieldT> &scalars, const size_t base_offset) const
+{
+    if (base_offset > num_bases() ||
+        scalars.size() > num_bases() - base_offset) {
+        throw std::out_of_range("multi_exp request exceeds base elements");
+    }
+
+    std::vector<std::shared_ptr<request>> batch{std::make_shared<request>()};
+    batch[0]->scalars = scalars;
+    batch[0]->base_offset = base_offset;
+    std::future<GroupT> result = batch[0]->result.get_future();
+    process_batch(batch);
+    return result.get();
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::accept_loop()
+{
+    for (;;) {
+        // Wait for a free connection slot.
+        {
+            std::unique_lock<std::mutex> lock(_connections_mutex);
+            _connections_cv.wait(lock, [this]() {
+                return !_accepting || _connections.size() < _max_connections;
+            });
+            if (!_accepting) {
+                return;
+            }
+        }
+        join_finished_connections();
+
+        const int fd = unix_socket_accept(_listen_fd);
+        if (fd < 0) {
+            return;
+        }
+
+        // The connection thread removes itself from _connections (under the
+        // lock) when it exits, so it must be added while holding the lock.
+        std::lock_guard<std::mutex> lock(_connections_mutex);
+        _connections[fd] = std::thread([this, fd]() { connection_loop(fd); });
+    }
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::connection_loop(int fd)
+{
+    try {
+        unix_socket_set_receive_timeout(fd, _receive_timeout_ms);
+        multi_exp_server_request req;
+        while (unix_socket_read(fd, &req, sizeof(req))) {
+            multi_exp_server_response response{
+                multi_exp_server_status_ok, 0, num_bases()};
+
+            if (req.magic != MULTI_EXP_SERVER_MAGIC ||
+                req.scalar_size != sizeof(FieldT) ||
+                req.group_size != sizeof(GroupT) ||
+                (req.command != multi_exp_server_command_info &&
+                 req.command != multi_exp_server_command_multi_exp)) {
+                response.status = multi_exp_server_status_invalid_request;
+                unix_socket_write(fd, &response, sizeof(response));
+                break;
+            }
+
+            if (req.command == multi_exp_server_command_info) {
+                unix_socket_write(fd, &response, sizeof(response));
+                continue;
+            }
+
+            // The scalars cannot be skipped without reading them, so the
+            // connection is closed after an out-of-range request.
+            if (req.base_offset > num_bases() ||
+                req.num_scalars > num_bases() - req.base_offset) {
+                response.status = multi_exp_server_status_out_of_range;
+                unix_socket_write(fd, &response, sizeof(response));
+                break;
+            }
+
+            std::shared_ptr<request> r = std::make_shared<request>();
+            r->scalars.resize(req.num_scalars);
+            r->base_offset = req.base_offset;
+            if (!unix_socket_read(
+                    fd, r->scalars.data(), req.num_scalars * sizeof(FieldT))) {
+                break;
+            }
+
+            if (!std::all_of(
+                    r->scalars.begin(),
+                    r->scalars.end(),
+                    internal::multi_exp_server_scalar_is_valid<FieldT>)) {
+                response.status = multi_exp_server_status_invalid_request;
+                unix_socket_write(fd, &response, sizeof(response));
+                break;
+            }
+
+            std::future<GroupT> result = r->result.get_future();
+            {
+                std::lock_guard<std::mutex> lock(_queue_mutex);
+                _queue.push_back(r);
+            }
+            _queue_cv.notify_one();
+
+            // The request has been read in full, so the connection can be
+            // reused after a failure.
+            GroupT value;
+            try {
+                value = result.get();
+            } catch (const std::exception &) {
+                response.status = multi_exp_server_status_error;
+                unix_socket_write(fd, &response, sizeof(response));
+                continue;
+            }
+            unix_socket_write(fd, &response, sizeof(response));
+            unix_socket_write(fd, &value, sizeof(value));
+        }
+    } catch (const std::exception &) {
+        // Errors on one connection (e.g. the client disconnecting) only
+        // terminate that connection.
+    }
+
+    // Hand this thread over to be joined by the accept thread or stop().
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+    const auto it = _connections.find(fd);
+    _finished_connections.push_back(std::move(it->second));
+    _connections.erase(it);
+    unix_socket_close(fd);
+    _connections_cv.notify_all();
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::join_finished_connections()
+{
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(_connections_mutex);
+        finished.swap(_finished_connections);
+    }
+    for (std::thread &t : finished) {
+        t.join();
+    }
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::scheduler_loop()
+{
+    for (;;) {
+        std::vector<std::shared_ptr<request>> batch;
+        {
+            std::unique_lock<std::mutex> lock(_queue_mutex);
+            _queue_cv.wait(
+                lock, [this]() { return !_running || !_queue.empty(); });
+            if (_queue.empty()) {
+                return;
+            }
+
+            while (!_queue.empty() && batch.size() < _max_batch_size) {
+                batch.push_back(_queue.front());
+                _queue.pop_front();
+            }
+        }
+
+        process_batch(batch);
+    }
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::process_batch(
+    std::vector<std::shared_ptr<request>> &batch) const
+{
+    // Connection threads block on the promises, so each must be set, with
+    // an exception if the computation fails.
+    std::vector<GroupT> results(batch.size(), GroupT::zero());
+    std::vector<std::exception_ptr> errors(batch.size());
+    try {
+        compute_batch(batch, results, errors);
+    } catch (...) {
+        std::fill(errors.begin(), errors.end(), std::current_exception());
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (errors[i]) {
+            batch[i]->result.set_exception(errors[i]);
+        } else {
+            batch[i]->result.set_value(results[i]);
+        }
+    }
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+void multi_exp_server<GroupT, FieldT, Method>::compute_batch(
+    const std::vector<std::shared_ptr<request>> &batch,
+    std::vector<GroupT> &results,
+    std::vector<std::exception_ptr> &errors) const
+{
+    // Split every request into slices, and process all slices in parallel.
+    class slice
+    {
+    public:
+        size_t request_idx;
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<slice> slices;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const size_t n = batch[i]->scalars.size();
+        const size_t num_slices = std::max<size_t>(
+            1,
+            std::min(
+                _num_slices, n / internal::MULTI_EXP_SERVER_MIN_SLICE_SIZE));
+        const size_t one = n / num_slices;
+        for (size_t j = 0; j < num_slices && n > 0; ++j) {
+            const size_t begin = j * one;
+            slices.push_back(
+                {i, begin, (j == num_slices - 1) ? n : (begin + one)});
+        }
+    }
+
+    std::vector<GroupT> partial(slices.size());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < slices.size(); ++i) {
+        const slice &s = slices[i];
+        const request &r = *batch[s.request_idx];
+        const GroupT *const bases = _bases_begin + r.base_offset;
+        try {
+            if (_base_form == multi_exp_base_form_special) {
+                partial[i] = libff::multi_exp<
+                    GroupT,
+                    FieldT,
+                    Method,
+                    multi_exp_base_form_special>(
+                    bases + s.begin,
+                    bases + s.end,
+                    r.scalars.begin() + s.begin,
+                    r.scalars.begin() + s.end,
+                    1);
+            } else {
+                partial[i] = libff::multi_exp<
+                    GroupT,
+                    FieldT,
+                    Method,
+                    multi_exp_base_form_normal>(
+                    bases + s.begin,
+                    bases + s.end,
+                    r.scalars.begin() + s.begin,
+                    r.scalars.begin() + s.end,
+                    1);
+            }
+        } catch (...) {
+            // Exceptions cannot leave the parallel region, so the first
+            // error of each request is recorded instead.
+#ifdef MULTICORE
+#pragma omp critical
+#endif
+            if (!errors[s.request_idx]) {
+                errors[s.request_idx] = std::current_exception();
+            }
+        }
+    }
+
+    for (size_t i = 0; i < slices.size(); ++i) {
+        results[slices[i].request_idx] =
+            results[slices[i].request_idx] + partial[i];
+    }
+}
+
+// multi_exp_client
+
+template<typename GroupT, typename FieldT>
+multi_exp_client<GroupT, FieldT>::multi_exp_client(
+    const std::string &socket_path)
+    : _fd(unix_socket_connect(socket_path))
+{
+}
+
+template<typename GroupT, typename FieldT>
+multi_exp_client<GroupT, FieldT>::~multi_exp_client()
+{
+    unix_socket_close(_fd);
+}
+
+template<typename GroupT, typename FieldT>
+size_t multi_exp_client<GroupT, FieldT>::num_bases()
+{
+    const multi_exp_server_request request{
+        MULTI_EXP_SERVER_MAGIC,
+        multi_exp_server_command_info,
+        0,
+        0,
+        sizeof(FieldT),
+        sizeof(GroupT)};
+    return send_request(request, nullptr).num_bases;
+}
+
+template<typename GroupT, typename FieldT>
+GroupT multi_exp_client<GroupT, FieldT>::multi_exp(
+    const std::vector<FieldT> &scalars, const size_t base_offset)
+{
+    const multi_exp_server_request request{
+        MULTI_EXP_SERVER_MAGIC,
+        multi_exp_server_command_multi_exp,
+        base_offset,
+        scalars.size(),
+        sizeof(FieldT),
+        sizeof(GroupT)};
+    send_request(request, scalars.data());
+
+    GroupT result;
+    if (!unix_socket_read(_fd, &result, sizeof(result))) {
+        throw std::runtime_error("multi_exp_server closed connection");
+    }
+    return result;
+}
+
+template<typename GroupT, typename FieldT>
+multi_exp_server_response multi_exp_client<GroupT, FieldT>::send_request(
+    const multi_exp_server_request &request, const void *payload)
+{
+    unix_socket_write(_fd, &request, sizeof(request));
+    if (payload != nullptr) {
+        unix_socket_write(_fd, payload, request.num_scalars * sizeof(FieldT));
+    }
+
+    multi_exp_server_response response;
+    if (!unix_socket_read(_fd, &response, sizeof(response))) {
+        throw std::runtime_error("multi_exp_server closed connection");
+    }
+
+    switch (response.status) {
+    case multi_exp_server_status_ok:
+        return response;
+    case multi_exp_server_status_out_of_range:
+        throw std::out_of_range("multi_exp request exceeds base elements");
+    case multi_exp_server_status_error:
+        throw std::runtime_error("multi_exp_server failed to compute request");
+    default:
+        throw std::runtime_error("multi_exp_server rejected request");
+    }
+}
+
+} // namespace libff
+
+#endif // MULTIEXP_SERVER_TCC_
@@ -0,0 +1,153 @@
+/** @file
+ *****************************************************************************
+
+ Multi-exponentiation sharded across worker processes, for base vectors too
+ large for the memory (or memory bandwidth) of a single host.
+
+ The base vector is split into contiguous shards, each held by a
+ multi_exp_shard_worker (e.g. over a shared_base_vector, so that one decoded
+ copy serves several workers on a host, as in the multiexp_shard_worker
+ tool). A multi_exp_shard_coordinator
+ connects to the workers in shard order, sends each worker the slice of the
+ scalars for its shard, and sums the partial results, which the workers
+ compute in parallel with a local multi_exp.
+
+ The transport is a stream socket, with a binary protocol: fixed-size
+ request and response headers (in host byte order), followed by scalars and
+ group elements in the binary field and group encodings (see
+ field_serialization.hpp and curve_serialization.hpp), which do not depend
+ on the in-memory representation. Workers currently listen on Unix domain
+ sockets (see unix_socket.hpp), so all processes must be on one host; the
+ protocol itself only requires a connected stream socket.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SHARDED_HPP_
+#define MULTIEXP_SHARDED_HPP_
+
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace libff
+{
+
+static const uint32_t MULTI_EXP_SHARD_MAGIC = 0x4d534853; // "MSHS"
+
+enum multi_exp_shard_command : uint32_t {
+    /// Query the number of base elements in the shard.
+    multi_exp_shard_command_info = 1,
+    /// Compute \sum_i scalars[i] * bases[i] over the shard. The request
+    /// header is followed by num_scalars encoded scalars, and a successful
+    /// response by the encoded result.
+    multi_exp_shard_command_multi_exp = 2,
+    /// Respond, then close the connection and stop serving.
+    multi_exp_shard_command_shutdown = 3,
+};
+
+enum multi_exp_shard_status : uint32_t {
+    multi_exp_shard_status_ok = 0,
+    multi_exp_shard_status_invalid_request = 1,
+    multi_exp_shard_status_out_of_range = 2,
+};
+
+/// Request header. scalar_size and group_size (the sizes of the encoded
+/// elements) guard against mismatched curves.
+struct multi_exp_shard_request {
+    uint32_t magic;
+    uint32_t command;
+    uint64_t num_scalars;
+    uint32_t scalar_size;
+    uint32_t group_size;
+};
+
+struct multi_exp_shard_response {
+    uint32_t status;
+    uint32_t reserved;
+    uint64_t num_bases;
+};
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method = multi_exp_method_BDLO12_signed,
+    multi_exp_base_form BaseForm = multi_exp_base_form_normal>
+class multi_exp_shard_worker
+{
+public:
+    /// Serve the shard from bases_start to bases_end (e.g. the range of a
+    /// shared_base_vector), which must remain valid while the worker is
+    /// used. Each request is computed with the given number of chunks.
+    multi_exp_shard_worker(
+        const GroupT *bases_start, const GroupT *bases_end, size_t chunks);
+
+    size_t num_bases() const;
+
+    /// Listen on socket_path, and serve connections (one at a time) until a
+    /// shutdown request is received.
+    void serve(const std::string &socket_path) const;
+
+    /// Compute a request directly (bypassing the socket). Throws
+    /// std::out_of_range if there are more scalars than base elements.
+    GroupT multi_exp(const std::vector<FieldT> &scalars) const;
+
+protected:
+    /// Serve requests on a connection. Returns false after a shutdown
+    /// request.
+    bool serve_connection(int fd) const;
+
+    const GroupT *const _bases_start;
+    const GroupT *const _bases_end;
+    const size_t _chunks;
+};
+
+/// Client of a set of multi_exp_shard_workers. Not thread-safe.
+template<typename GroupT, typename FieldT> class multi_exp_shard_coordinator
+{
+public:
+    multi_exp_shard_coordinator(const multi_exp_shard_coordinator &) = delete;
+    multi_exp_shard_coordinator &operator=(
+        const multi_exp_shard_coordinator &) = delete;
+
+    /// Connect to the workers at the given socket paths, holding consecutive
+    /// shards of the base vector. Connections are retried for up to
+    /// connect_timeout_ms milliseconds (as workers may still be starting),
+    /// after which std::runtime_error is thrown.
+    explicit multi_exp_shard_coordinator(
+        const std::vector<std::string> &worker_paths,
+        size_t connect_timeout_ms = 5000);
+    ~multi_exp_shard_coordinator();
+
+    /// Total number of base elements over all shards.
+    size_t num_bases() const;
+
+    /// Compute \sum_i scalars[i] * bases[i]. Throws std::out_of_range if
+    /// there are more scalars than base elements. On any other error, all
+    /// connections are closed (leaving no unread responses to be mistaken
+    /// for those of a later request), and later calls throw
+    /// std::runtime_error.
+    GroupT multi_exp(const std::vector<FieldT> &scalars);
+
+    /// Ask all workers to stop serving, and close the connections.
+    void shutdown_workers();
+
+protected:
+    GroupT send_and_sum(const std::vector<FieldT> &scalars);
+    multi_exp_shard_response read_response(const size_t worker_idx);
+    void close_connections();
+
+    std::vector<int> _fds;
+    std::vector<size_t> _shard_sizes;
+};
+
+} // namespace libff
+
+#include "libff/algebra/scalar_multiplication/multiexp_sharded.tcc"
+
+#endif // MULTIEXP_SHARDED_HPP_
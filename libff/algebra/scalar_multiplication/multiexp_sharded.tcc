@@ -0,0 +1,413 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of sharded multi-exponentiation.
+
+ See multiexp_sharded.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SHARDED_TCC_
+#define MULTIEXP_SHARDED_TCC_
+
+#include "libff/algebra/curves/curve_serialization.hpp"
+#include "libff/algebra/fields/field_serialization.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp_sharded.hpp"
+#include "libff/common/profiling.hpp"
+#include "libff/common/unix_socket.hpp"
+
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Size of the binary encoding of elements of FieldT.
+template<typename FieldT> size_t multi_exp_shard_scalar_size()
+{
+    std::ostringstream ss;
+    field_write<encoding_binary, form_plain>(FieldT::zero(), ss);
+    return ss.str().size();
+}
+
+/// Size of the (uncompressed) binary encoding of elements of GroupT.
+template<typename GroupT> size_t multi_exp_shard_group_size()
+{
+    std::ostringstream ss;
+    group_write<encoding_binary, form_plain, compression_off>(
+        GroupT::one(), ss);
+    return ss.str().size();
+}
+
+template<typename FieldT, typename GroupT>
+multi_exp_shard_request multi_exp_shard_make_request(
+    const multi_exp_shard_command command, const size_t num_scalars)
+{
+    return multi_exp_shard_request{
+        MULTI_EXP_SHARD_MAGIC,
+        command,
+        num_scalars,
+        (uint32_t)multi_exp_shard_scalar_size<FieldT>(),
+        (uint32_t)multi_exp_shard_group_size<GroupT>()};
+}
+
+/// Throw if the elements read from a socket stream were cut short by the
+/// connection closing.
+inline void multi_exp_shard_check_read(const std::istream &in_s)
+{
+    if (!in_s) {
+        throw std::runtime_error("multi_exp_shard: connection closed");
+    }
+}
+
+} // namespace internal
+
+// multi_exp_shard_worker
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+multi_exp_shard_worker<GroupT, FieldT, Method, BaseForm>::
+    multi_exp_shard_worker(
+        const GroupT *bases_start, const GroupT *bases_end, size_t chunks)
+    : _bases_start(bases_start)
+    , _bases_end(bases_end)
+    , _chunks(std::max<size_t>(1, chunks))
+{
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+size_t multi_exp_shard_worker<GroupT, FieldT, Method, BaseForm>::num_bases()
+    const
+{
+    return _bases_end - _bases_start;
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+void multi_exp_shard_worker<GroupT, FieldT, Method, BaseForm>::serve(
+    const std::string &socket_path) const
+{
+    const int listen_fd = unix_socket_listen(socket_path);
+    try {
+        for (;;) {
+            const int fd = unix_socket_accept(listen_fd);
+            if (fd < 0) {
+                break;
+            }
+
+            bool keep_serving = true;
+            try {
+                keep_serving = serve_connection(fd);
+            } catch (const std::exception &) {
+                // Errors on one connection (e.g. the coordinator
+                // disconnecting) only terminate that connection.
+            }
+            unix_socket_close(fd);
+            if (!keep_serving) {
+                break;
+            }
+        }
+    } catch (...) {
+        unix_socket_close(listen_fd);
+        unix_socket_remove(socket_path);
+        throw;
+    }
+
+    unix_socket_close(listen_fd);
+    unix_socket_remove(socket_path);
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+GroupT multi_exp_shard_worker<GroupT, FieldT, Method, BaseForm>::multi_exp(
+    const std::vector<FieldT> &scalars) const
+{
+    if (scalars.size() > num_bases()) {
+        throw std::out_of_range(
+            "libff::multi_exp_shard_worker::multi_exp: more scalars than "
+            "base elements");
+    }
+
+    return libff::multi_exp<GroupT, FieldT, Method, BaseForm>(
+        _bases_start,
+        _bases_start + scalars.size(),
+        scalars.begin(),
+        scalars.end(),
+        _chunks);
+}
+
+template<
+    typename GroupT,
+    typename FieldT,
+    multi_exp_method Method,
+    multi_exp_base_form BaseForm>
+bool multi_exp_shard_worker<GroupT, FieldT, Method, BaseForm>::
+    serve_connection(int fd) const
+{
+    const size_t scalar_size = internal::multi_exp_shard_scalar_size<FieldT>();
+    const size_t group_size = internal::multi_exp_shard_group_size<GroupT>();
+
+    multi_exp_shard_request req;
+    while (unix_socket_read(fd, &req, sizeof(req))) {
+        multi_exp_shard_response response{
+            multi_exp_shard_status_ok, 0, num_bases()};
+
+        if (req.magic != MULTI_EXP_SHARD_MAGIC ||
+            req.scalar_size != scalar_size || req.group_size != group_size ||
+            (req.command != multi_exp_shard_command_info &&
+             req.command != multi_exp_shard_command_multi_exp &&
+             req.command != multi_exp_shard_command_shutdown)) {
+            response.status = multi_exp_shard_status_invalid_request;
+            unix_socket_write(fd, &response, sizeof(response));
+            return true;
+        }
+
+        if (req.command == multi_exp_shard_command_info) {
+            unix_socket_write(fd, &response, sizeof(response));
+            continue;
+        }
+
+        if (req.command == multi_exp_shard_command_shutdown) {
+            unix_socket_write(fd, &response, sizeof(response));
+            return false;
+        }
+
+        // The scalars cannot be skipped without reading them, so the
+        // connection is closed after an out-of-range request.
+        if (req.num_scalars > num_bases()) {
+            response.status = multi_exp_shard_status_out_of_range;
+            unix_socket_write(fd, &response, sizeof(response));
+            return true;
+        }
+
+        // Scalars are decoded as they are received, in chunks.
+        unix_socket_streambuf scalars_buf(fd, req.num_scalars * scalar_size);
+        std::istream scalars_s(&scalars_buf);
+        scalars_s.exceptions(std::ios_base::badbit);
+        std::vector<FieldT> scalars(req.num_scalars);
+        for (FieldT &scalar : scalars) {
+            field_read<encoding_binary, form_plain>(scalar, scalars_s);
+        }
+        internal::multi_exp_shard_check_read(scalars_s);
+
+        const GroupT result = multi_exp(scalars);
+        unix_socket_write(fd, &response, sizeof(response));
+        unix_socket_streambuf result_buf(fd, 0, group_size);
+        std::ostream result_s(&result_buf);
+        result_s.exceptions(std::ios_base::badbit);
+        group_write<encoding_binary, form_plain, compression_off>(
+            result, result_s);
+        result_s.flush();
+    }
+
+    return true;
+}
+
+// multi_exp_shard_coordinator
+
+template<typename GroupT, typename FieldT>
+multi_exp_shard_coordinator<GroupT, FieldT>::multi_exp_shard_coordinator(
+    const std::vector<std::string> &worker_paths, size_t connect_timeout_ms)
+{
+    const long long deadline =
+        get_nsec_time() + (long long)connect_timeout_ms * 1000000;
+    try {
+        for (const std::string &path : worker_paths) {
+            for (;;) {
+                try {
+                    _fds.push_back(unix_socket_connect(path));
+                    break;
+                } catch (const std::runtime_error &) {
+                    if (get_nsec_time() >= deadline) {
+                        throw;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+        }
+
+        const multi_exp_shard_request request =
+            internal::multi_exp_shard_make_request<FieldT, GroupT>(
+                multi_exp_shard_command_info, 0);
+        for (size_t i = 0; i < _fds.size(); ++i) {
+            unix_socket_write(_fds[i], &request, sizeof(request));
+            _shard_sizes.push_back(read_response(i).num_bases);
+        }
+    } catch (...) {
+        for (const int fd : _fds) {
+            unix_socket_close(fd);
+        }
+        throw;
+    }
+}
+
+template<typename GroupT, typename FieldT>
+multi_exp_shard_coordinator<GroupT, FieldT>::~multi_exp_shard_coordinator()
+{
+    close_connections();
+}
+
+template<typename GroupT, typename FieldT>
+size_t multi_exp_shard_coordinator<GroupT, FieldT>::num_bases() const
+{
+    size_t total = 0;
+    for (const size_t shard_size : _shard_sizes) {
+        total += shard_size;
+    }
+    return total;
+}
+
+template<typename GroupT, typename FieldT>
+GroupT multi_exp_shard_coordinator<GroupT, FieldT>::multi_exp(
+    const std::vector<FieldT> &scalars)
+{
+    if (_fds.empty()) {
+        throw std::runtime_error(
+            "libff::multi_exp_shard_coordinator::multi_exp: not connected");
+    }
+    if (scalars.size() > num_bases()) {
+        throw std::out_of_range(
+            "libff::multi_exp_shard_coordinator::multi_exp: more scalars "
+            "than base elements");
+    }
+
+    try {
+        return send_and_sum(scalars);
+    } catch (...) {
+        // Requests may be half-sent, and responses unread, so the
+        // connections cannot be reused.
+        close_connections();
+        throw;
+    }
+}
+
+template<typename GroupT, typename FieldT>
+GroupT multi_exp_shard_coordinator<GroupT, FieldT>::send_and_sum(
+    const std::vector<FieldT> &scalars)
+{
+    // Send all requests before reading any result, so that the workers
+    // compute in parallel.
+    std::vector<bool> sent(_fds.size(), false);
+    size_t offset = 0;
+    for (size_t i = 0; i < _fds.size() && offset < scalars.size(); ++i) {
+        const size_t num_scalars =
+            std::min(_shard_sizes[i], scalars.size() - offset);
+        const multi_exp_shard_request request =
+            internal::multi_exp_shard_make_request<FieldT, GroupT>(
+                multi_exp_shard_command_multi_exp, num_scalars);
+        unix_socket_write(_fds[i], &request, sizeof(request));
+
+        // Scalars are encoded into a fixed-size buffer, sent whenever it
+        // fills.
+        unix_socket_streambuf scalars_buf(_fds[i]);
+        std::ostream scalars_s(&scalars_buf);
+        scalars_s.exceptions(std::ios_base::badbit);
+        for (size_t j = 0; j < num_scalars; ++j) {
+            field_write<encoding_binary, form_plain>(
+                scalars[offset + j], scalars_s);
+        }
+        scalars_s.flush();
+        sent[i] = true;
+        offset += num_scalars;
+    }
+
+    const size_t group_size = internal::multi_exp_shard_group_size<GroupT>();
+    GroupT result = GroupT::zero();
+    for (size_t i = 0; i < _fds.size(); ++i) {
+        if (!sent[i]) {
+            continue;
+        }
+        read_response(i);
+        unix_socket_streambuf partial_buf(_fds[i], group_size, group_size);
+        std::istream partial_s(&partial_buf);
+        partial_s.exceptions(std::ios_base::badbit);
+        GroupT partial;
+        group_read<encoding_binary, form_plain, compression_off>(
+            partial, partial_s);
+        internal::multi_exp_shard_check_read(partial_s);
+        // Invalid points (e.g. from a faulty worker) are not summed, as the
+        // group law is only defined for points on the curve.
+        if (!partial.is_well_formed()) {
+            throw std::runtime_error(
+                "multi_exp_shard: worker returned an invalid group element");
+        }
+        result = result + partial;
+    }
+
+    return result;
+}
+
+template<typename GroupT, typename FieldT>
+void multi_exp_shard_coordinator<GroupT, FieldT>::shutdown_workers()
+{
+    const multi_exp_shard_request request =
+        internal::multi_exp_shard_make_request<FieldT, GroupT>(
+            multi_exp_shard_command_shutdown, 0);
+    try {
+        for (size_t i = 0; i < _fds.size(); ++i) {
+            unix_socket_write(_fds[i], &request, sizeof(request));
+            read_response(i);
+        }
+    } catch (...) {
+        close_connections();
+        throw;
+    }
+    close_connections();
+}
+
+template<typename GroupT, typename FieldT>
+void multi_exp_shard_coordinator<GroupT, FieldT>::close_connections()
+{
+    for (const int fd : _fds) {
+        unix_socket_close(fd);
+    }
+    _fds.clear();
+    _shard_sizes.clear();
+}
+
+template<typename GroupT, typename FieldT>
+multi_exp_shard_response multi_exp_shard_coordinator<GroupT, FieldT>::
+    read_response(const size_t worker_idx)
+{
+    multi_exp_shard_response response;
+    if (!unix_socket_read(_fds[worker_idx], &response, sizeof(response))) {
+        throw std::runtime_error("multi_exp_shard: worker closed connection");
+    }
+
+    switch (response.status) {
+    case multi_exp_shard_status_ok:
+        return response;
+    case multi_exp_shard_status_out_of_range:
+        throw std::out_of_range("multi_exp_shard: request exceeds shard");
+    default:
+        throw std::runtime_error("multi_exp_shard: worker rejected request");
+    }
+}
+
+} // namespace libff
+
+#endif // MULTIEXP_SHARDED_TCC_
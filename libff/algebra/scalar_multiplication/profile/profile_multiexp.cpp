@@ -5,6 +5,7 @@
 #include "libff/common/profiling.hpp"
 #include "libff/common/rng.hpp"
 
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
 #include <sys/stat.h>
@@ -32,13 +33,15 @@ test_instances_t<GroupT> generate_group_elements(size_t num_elements)
     // generate NUM_DIFFERENT_ELEMENTS, and repeat them. Note, some methods
     // require input to be in special form.
 
+    const size_t num_different =
+        std::min(num_elements, NUM_DIFFERENT_ELEMENTS);
     size_t i;
-    for (i = 0; i < NUM_DIFFERENT_ELEMENTS; ++i) {
+    for (i = 0; i < num_different; ++i) {
         GroupT x = GroupT::random_element();
         x.to_special();
         result.push_back(x);
     }
-    assert(result.size() == NUM_DIFFERENT_ELEMENTS);
+    assert(result.size() == num_different);
 
     for (; i < num_elements; ++i) {
         assert(result.size() == i);
@@ -282,11 +285,12 @@ void print_performance_csv(
 {
     std::cout << "Profiling " << tag << "\n";
     printf(
-        "\t%16s\t%16s\t%16s\t%16s\t%16s\t%16s\t%16s\n",
+        "\t%16s\t%16s\t%16s\t%16s\t%16s\t%16s\t%16s\t%16s\n",
         "bos-coster",
         "djb",
         "djb_signed",
         "djb_signed_mixed",
+        "djb_signed_xyzz",
         "from_stream",
         "from_stream_precompute",
         "naive");
@@ -345,6 +349,23 @@ void print_performance_csv(
                     "Answers NOT MATCHING (djb_signed != djb_signed_mixed)\n");
             }
 
+            run_result_t<GroupT> result_djb_signed_xyzz = profile_multiexp<
+                GroupT,
+                FieldT,
+                multi_exp_method_BDLO12_signed_xyzz,
+                multi_exp_base_form_special>(group_elements, scalars);
+            printf("\t%16lld", result_djb_signed_xyzz.first);
+            fflush(stdout);
+
+            if (compare_answers &&
+                (result_djb_signed_mixed.second !=
+                 result_djb_signed_xyzz.second)) {
+                fprintf(
+                    stderr,
+                    "Answers NOT MATCHING (djb_signed_mixed != "
+                    "djb_signed_xyzz)\n");
+            }
+
             run_result_t<GroupT> result_stream =
                 profile_multiexp_stream<FORM, COMP, GroupT, FieldT>(
                     tag, scalars);
@@ -398,12 +419,66 @@ void print_performance_csv(
     }
 }
 
+/// Compare the methods suited to small numbers of elements, to calibrate
+/// MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES.
+template<typename GroupT, typename FieldT>
+void print_small_performance_csv(const std::string &tag)
+{
+    std::cout << "Profiling " << tag << " (small)\n";
+    printf(
+        "\t%16s\t%16s\t%16s\t%16s\n",
+        "naive",
+        "straus",
+        "djb_signed",
+        "auto");
+    for (const size_t n : {2, 4, 8, 16, 32, 64, 128, 256, 384, 512}) {
+        printf("%zu", n);
+        fflush(stdout);
+
+        const test_instances_t<GroupT> group_elements =
+            generate_group_elements<GroupT>(n);
+        const test_instances_t<FieldT> scalars = generate_scalars<FieldT>(n);
+
+        const run_result_t<GroupT> result_naive =
+            profile_multiexp<GroupT, FieldT, multi_exp_method_naive>(
+                group_elements, scalars);
+        printf("\t%16lld", result_naive.first);
+
+        const run_result_t<GroupT> result_straus =
+            profile_multiexp<GroupT, FieldT, multi_exp_method_straus>(
+                group_elements, scalars);
+        printf("\t%16lld", result_straus.first);
+
+        const run_result_t<GroupT> result_djb_signed = profile_multiexp<
+            GroupT,
+            FieldT,
+            multi_exp_method_BDLO12_signed>(group_elements, scalars);
+        printf("\t%16lld", result_djb_signed.first);
+
+        const run_result_t<GroupT> result_auto =
+            profile_multiexp<GroupT, FieldT, multi_exp_method_auto>(
+                group_elements, scalars);
+        printf("\t%16lld\n", result_auto.first);
+
+        if ((result_naive.second != result_straus.second) ||
+            (result_naive.second != result_djb_signed.second) ||
+            (result_naive.second != result_auto.second)) {
+            fprintf(stderr, "Answers NOT MATCHING (small)\n");
+        }
+    }
+}
+
 int main(void)
 {
     print_compilation_info();
 
     alt_bn128_pp::init_public_params();
 
+    print_small_performance_csv<G1<alt_bn128_pp>, Fr<alt_bn128_pp>>(
+        "alt_bn128_g1");
+    print_small_performance_csv<G2<alt_bn128_pp>, Fr<alt_bn128_pp>>(
+        "alt_bn128_g2");
+
     print_performance_csv<G1<alt_bn128_pp>, Fr<alt_bn128_pp>>(
         "alt_bn128_g1", 8, 20, 14, true);
 
@@ -0,0 +1,715 @@
+/** @file
+ *****************************************************************************
+
+ Replay a trace recorded by a TRACE_OPS build (see libff/common/trace.hpp).
+
+ Recorded group operations and multi_exp calls are re-executed, optionally
+ with a different multi_exp_method, base form or number of threads. Results
+ are compared against the recorded outputs, and throughput is reported.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/bw6_761/bw6_761_pp.hpp"
+#include "libff/algebra/curves/edwards/edwards_pp.hpp"
+#include "libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp"
+#include "libff/algebra/curves/mnt/mnt6/mnt6_pp.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+#include "libff/common/profiling.hpp"
+#include "libff/common/trace.hpp"
+#ifdef CURVE_BN128 // BN128 has fancy dependencies so it may be disabled
+#include "libff/algebra/curves/bn128/bn128_pp.hpp"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace libff;
+
+/// Settings for re-executing recorded operations. Where use_recorded_* is
+/// set, the corresponding value is taken from each recorded multi_exp call.
+class replay_options
+{
+public:
+    bool use_recorded_method = true;
+    multi_exp_method method = multi_exp_method_BDLO12_signed;
+    bool use_recorded_base_form = true;
+    multi_exp_base_form base_form = multi_exp_base_form_normal;
+    /// 0 means: multi_exp calls use the recorded number of chunks, and
+    /// point operations are replayed on a single thread.
+    size_t num_threads = 0;
+    size_t num_iterations = 1;
+};
+
+template<typename GroupT> class recorded_point_op
+{
+public:
+    trace_event_t event;
+    GroupT a;
+    GroupT b;
+    GroupT expected;
+};
+
+template<typename GroupT, typename FieldT> class recorded_multi_exp
+{
+public:
+    trace_multi_exp_info info;
+    std::vector<GroupT> bases;
+    std::vector<FieldT> scalars;
+    GroupT expected;
+};
+
+const char *multi_exp_method_name(const multi_exp_method method)
+{
+    switch (method) {
+    case multi_exp_method_naive:
+        return "naive";
+    case multi_exp_method_naive_plain:
+        return "naive_plain";
+    case multi_exp_method_bos_coster:
+        return "bos_coster";
+    case multi_exp_method_BDLO12:
+        return "BDLO12";
+    case multi_exp_method_BDLO12_signed:
+        return "BDLO12_signed";
+    case multi_exp_method_straus:
+        return "straus";
+    case multi_exp_method_auto:
+        return "auto";
+    case multi_exp_method_BDLO12_signed_xyzz:
+        return "BDLO12_signed_xyzz";
+    }
+    throw std::invalid_argument("invalid multi_exp_method");
+}
+
+multi_exp_method multi_exp_method_from_name(const std::string &name)
+{
+    for (const multi_exp_method method :
+         {multi_exp_method_naive,
+          multi_exp_method_naive_plain,
+          multi_exp_method_bos_coster,
+          multi_exp_method_BDLO12,
+          multi_exp_method_BDLO12_signed,
+          multi_exp_method_straus,
+          multi_exp_method_auto,
+          multi_exp_method_BDLO12_signed_xyzz}) {
+        if (name == multi_exp_method_name(method)) {
+            return method;
+        }
+    }
+    throw std::invalid_argument("unknown multi_exp method: " + name);
+}
+
+std::vector<trace_record> read_trace(const std::string &filename)
+{
+    std::ifstream in_s(filename, std::ios_base::in | std::ios_base::binary);
+    if (!in_s) {
+        throw std::runtime_error("failed to open trace file: " + filename);
+    }
+
+    trace_file_header header;
+    in_s.read((char *)&header, sizeof(header));
+    if (!in_s ||
+        memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("not a trace file: " + filename);
+    }
+    if (header.version != TRACE_FILE_VERSION ||
+        header.record_size != sizeof(trace_record)) {
+        throw std::runtime_error("unsupported trace file version");
+    }
+
+    std::vector<trace_record> records;
+    trace_record record;
+    while (in_s.read((char *)&record, sizeof(record))) {
+        records.push_back(record);
+    }
+
+    return records;
+}
+
+template<typename T> T record_element(const trace_record &record)
+{
+    if (record.size != sizeof(T)) {
+        throw std::runtime_error("unexpected trace record payload size");
+    }
+    T v;
+    memcpy((void *)&v, record.payload, sizeof(T));
+    return v;
+}
+
+/// Extract complete operations from the records of a single thread, in the
+/// order they were recorded. Incomplete operations (for example, where
+/// recording stopped part-way through) are skipped.
+template<typename GroupT, typename FieldT>
+void parse_thread_records(
+    const std::vector<trace_record> &records,
+    const size_t begin,
+    const size_t end,
+    std::vector<recorded_point_op<GroupT>> &point_ops,
+    std::vector<recorded_multi_exp<GroupT, FieldT>> &multi_exps)
+{
+    size_t i = begin;
+    while (i < end) {
+        const trace_event_t event = (trace_event_t)records[i].event;
+        const trace_event_t event_out = (trace_event_t)(event + 1);
+        switch (event) {
+        case trace_event_add_in:
+        case trace_event_mixed_add_in:
+            if (i + 2 < end && records[i + 1].event == event &&
+                records[i + 2].event == event_out) {
+                point_ops.push_back(
+                    {event,
+                     record_element<GroupT>(records[i]),
+                     record_element<GroupT>(records[i + 1]),
+                     record_element<GroupT>(records[i + 2])});
+                i += 3;
+                continue;
+            }
+            break;
+        case trace_event_dbl_in:
+            if (i + 1 < end && records[i + 1].event == event_out) {
+                const GroupT a = record_element<GroupT>(records[i]);
+                point_ops.push_back(
+                    {event, a, a, record_element<GroupT>(records[i + 1])});
+                i += 2;
+                continue;
+            }
+            break;
+        case trace_event_msm_begin: {
+            recorded_multi_exp<GroupT, FieldT> msm;
+            msm.info = record_element<trace_multi_exp_info>(records[i]);
+            const size_t n = msm.info.num_entries;
+            if (i + 2 * n + 1 >= end) {
+                break;
+            }
+
+            size_t j = i + 1;
+            for (; j < i + 1 + n; ++j) {
+                if (records[j].event != trace_event_msm_base) {
+                    break;
+                }
+                msm.bases.push_back(record_element<GroupT>(records[j]));
+            }
+            for (; j < i + 1 + 2 * n; ++j) {
+                if (records[j].event != trace_event_msm_scalar) {
+                    break;
+                }
+                msm.scalars.push_back(record_element<FieldT>(records[j]));
+            }
+            if (j != i + 1 + 2 * n ||
+                records[j].event != trace_event_msm_result) {
+                i = j;
+                continue;
+            }
+
+            msm.expected = record_element<GroupT>(records[j]);
+            multi_exps.push_back(std::move(msm));
+            i = j + 1;
+            continue;
+        }
+        default:
+            break;
+        }
+
+        // Record does not start a complete operation.
+        ++i;
+    }
+}
+
+template<typename GroupT>
+GroupT replay_point_op(const recorded_point_op<GroupT> &op)
+{
+    switch (op.event) {
+    case trace_event_add_in:
+        return op.a + op.b;
+    case trace_event_mixed_add_in:
+        return op.a.mixed_add(op.b);
+    case trace_event_dbl_in:
+        return op.a.dbl();
+    default:
+        throw std::runtime_error("unexpected point operation");
+    }
+}
+
+template<typename GroupT, typename FieldT, multi_exp_method Method>
+GroupT replay_multi_exp_method(
+    const std::vector<GroupT> &bases,
+    const std::vector<FieldT> &scalars,
+    const multi_exp_base_form base_form,
+    const size_t chunks)
+{
+    if (base_form == multi_exp_base_form_special) {
+        return multi_exp<GroupT, FieldT, Method, multi_exp_base_form_special>(
+            bases.begin(), bases.end(), scalars.begin(), scalars.end(), chunks);
+    }
+    return multi_exp<GroupT, FieldT, Method, multi_exp_base_form_normal>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), chunks);
+}
+
+/// Groups supporting multi_exp_method_BDLO12_signed_xyzz (short Weierstrass
+/// curves implemented over libff fields).
+template<typename GroupT> class supports_xyzz : public std::true_type
+{
+};
+template<> class supports_xyzz<edwards_G1> : public std::false_type
+{
+};
+template<> class supports_xyzz<edwards_G2> : public std::false_type
+{
+};
+#ifdef CURVE_BN128
+template<> class supports_xyzz<bn128_G1> : public std::false_type
+{
+};
+template<> class supports_xyzz<bn128_G2> : public std::false_type
+{
+};
+#endif
+
+template<typename GroupT, typename FieldT>
+GroupT replay_multi_exp_xyzz(
+    const std::vector<GroupT> &bases,
+    const std::vector<FieldT> &scalars,
+    const multi_exp_base_form base_form,
+    const size_t chunks,
+    std::true_type)
+{
+    return replay_multi_exp_method<
+        GroupT,
+        FieldT,
+        multi_exp_method_BDLO12_signed_xyzz>(bases, scalars, base_form, chunks);
+}
+
+template<typename GroupT, typename FieldT>
+GroupT replay_multi_exp_xyzz(
+    const std::vector<GroupT> &,
+    const std::vector<FieldT> &,
+    const multi_exp_base_form,
+    const size_t,
+    std::false_type)
+{
+    throw std::invalid_argument(
+        "BDLO12_signed_xyzz requires a short Weierstrass curve");
+}
+
+template<typename GroupT, typename FieldT>
+GroupT replay_multi_exp(
+    const std::vector<GroupT> &bases,
+    const std::vector<FieldT> &scalars,
+    const multi_exp_method method,
+    const multi_exp_base_form base_form,
+    const size_t chunks)
+{
+    switch (method) {
+    case multi_exp_method_naive:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_naive>(bases, scalars, base_form, chunks);
+    case multi_exp_method_naive_plain:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_naive_plain>(bases, scalars, base_form, chunks);
+    case multi_exp_method_bos_coster:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_bos_coster>(bases, scalars, base_form, chunks);
+    case multi_exp_method_BDLO12:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_BDLO12>(bases, scalars, base_form, chunks);
+    case multi_exp_method_BDLO12_signed:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_BDLO12_signed>(bases, scalars, base_form, chunks);
+    case multi_exp_method_straus:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_straus>(bases, scalars, base_form, chunks);
+    case multi_exp_method_auto:
+        return replay_multi_exp_method<
+            GroupT,
+            FieldT,
+            multi_exp_method_auto>(bases, scalars, base_form, chunks);
+    case multi_exp_method_BDLO12_signed_xyzz:
+        return replay_multi_exp_xyzz<GroupT, FieldT>(
+            bases, scalars, base_form, chunks, supports_xyzz<GroupT>());
+    }
+    throw std::invalid_argument("invalid multi_exp_method");
+}
+
+void print_header()
+{
+    printf(
+        "  %-14s %-10s %-32s %8s %10s %10s %14s %14s\n",
+        "type",
+        "workload",
+        "config",
+        "count",
+        "mismatch",
+        "time (s)",
+        "calls/s",
+        "points/s");
+}
+
+void print_result(
+    const std::string &type_name,
+    const std::string &workload,
+    const std::string &config,
+    const size_t count,
+    const size_t num_mismatches,
+    const long long nsec,
+    const size_t num_points)
+{
+    const double sec = nsec * 1e-9;
+    printf(
+        "  %-14s %-10s %-32s %8zu %10zu %10.3f %14.0f %14.0f\n",
+        type_name.c_str(),
+        workload.c_str(),
+        config.c_str(),
+        count,
+        num_mismatches,
+        sec,
+        count / sec,
+        num_points / sec);
+    fflush(stdout);
+}
+
+/// Replay point operations in num_threads contiguous chunks, in parallel.
+/// Returns the number of results which do not match the trace.
+template<typename GroupT>
+size_t replay_point_ops(
+    const std::string &type_name,
+    const std::vector<recorded_point_op<GroupT>> &point_ops,
+    const replay_options &options)
+{
+    const size_t num_chunks = std::max<size_t>(1, options.num_threads);
+    const size_t one = point_ops.size() / num_chunks;
+    std::vector<size_t> chunk_mismatches(num_chunks, 0);
+
+    const long long start = get_nsec_time();
+    for (size_t iter = 0; iter < options.num_iterations; ++iter) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+        for (size_t i = 0; i < num_chunks; ++i) {
+            const size_t begin = i * one;
+            const size_t end =
+                (i == num_chunks - 1) ? point_ops.size() : (begin + one);
+            for (size_t j = begin; j < end; ++j) {
+                if (replay_point_op(point_ops[j]) != point_ops[j].expected) {
+                    ++chunk_mismatches[i];
+                }
+            }
+        }
+    }
+    const long long nsec = get_nsec_time() - start;
+
+    size_t num_mismatches = 0;
+    for (const size_t m : chunk_mismatches) {
+        num_mismatches += m;
+    }
+
+    const size_t count = point_ops.size() * options.num_iterations;
+    print_result(
+        type_name,
+        "point_ops",
+        "threads=" + std::to_string(num_chunks),
+        count,
+        num_mismatches,
+        nsec,
+        count);
+    return num_mismatches;
+}
+
+/// Replay multi_exp calls sequentially, each using the selected method, base
+/// form and number of chunks. Returns the number of results which do not
+/// match the trace.
+template<typename GroupT, typename FieldT>
+size_t replay_multi_exps(
+    const std::string &type_name,
+    std::vector<recorded_multi_exp<GroupT, FieldT>> &multi_exps,
+    const replay_options &options)
+{
+    // Calls are grouped by configuration, so that each is reported on its own
+    // line.
+    std::map<std::string, std::vector<size_t>> calls_by_config;
+    for (size_t i = 0; i < multi_exps.size(); ++i) {
+        recorded_multi_exp<GroupT, FieldT> &msm = multi_exps[i];
+        if (!options.use_recorded_method) {
+            msm.info.method = options.method;
+        }
+        if (!options.use_recorded_base_form) {
+            msm.info.base_form = options.base_form;
+        }
+        if (options.num_threads != 0) {
+            msm.info.chunks = options.num_threads;
+        }
+
+        // Bases recorded in normal form must be converted for methods which
+        // expect special form. This is not included in the timings.
+        if (msm.info.base_form == multi_exp_base_form_special) {
+            batch_to_special(msm.bases);
+        }
+
+        const std::string config =
+            std::string(
+                multi_exp_method_name((multi_exp_method)msm.info.method)) +
+            "/" +
+            ((msm.info.base_form == multi_exp_base_form_special) ? "special"
+                                                                 : "normal") +
+            "/chunks=" + std::to_string(msm.info.chunks);
+        calls_by_config[config].push_back(i);
+    }
+
+    size_t total_mismatches = 0;
+    for (const auto &entry : calls_by_config) {
+        size_t num_mismatches = 0;
+        size_t num_points = 0;
+        const long long start = get_nsec_time();
+        for (size_t iter = 0; iter < options.num_iterations; ++iter) {
+            for (const size_t i : entry.second) {
+                const recorded_multi_exp<GroupT, FieldT> &msm = multi_exps[i];
+                const GroupT result = replay_multi_exp(
+                    msm.bases,
+                    msm.scalars,
+                    (multi_exp_method)msm.info.method,
+                    (multi_exp_base_form)msm.info.base_form,
+                    msm.info.chunks);
+                if (result != msm.expected) {
+                    ++num_mismatches;
+                }
+                num_points += msm.bases.size();
+            }
+        }
+        const long long nsec = get_nsec_time() - start;
+
+        print_result(
+            type_name,
+            "multi_exp",
+            entry.first,
+            entry.second.size() * options.num_iterations,
+            num_mismatches,
+            nsec,
+            num_points);
+        total_mismatches += num_mismatches;
+    }
+
+    return total_mismatches;
+}
+
+/// Replay all records (which must all have the type corresponding to
+/// GroupT), thread by thread. Returns the number of mismatching results.
+template<typename ppT, typename GroupT>
+size_t replay_group(
+    const std::string &type_name,
+    const std::vector<trace_record> &records,
+    const replay_options &options)
+{
+    using FieldT = typename GroupT::scalar_field;
+
+    ppT::init_public_params();
+
+    std::vector<recorded_point_op<GroupT>> point_ops;
+    std::vector<recorded_multi_exp<GroupT, FieldT>> multi_exps;
+    size_t begin = 0;
+    while (begin < records.size()) {
+        size_t end = begin + 1;
+        while (end < records.size() &&
+               records[end].thread == records[begin].thread) {
+            ++end;
+        }
+        parse_thread_records(records, begin, end, point_ops, multi_exps);
+        begin = end;
+    }
+
+    size_t num_mismatches = 0;
+    if (!point_ops.empty()) {
+        num_mismatches += replay_point_ops(type_name, point_ops, options);
+    }
+    if (!multi_exps.empty()) {
+        num_mismatches += replay_multi_exps(type_name, multi_exps, options);
+    }
+    return num_mismatches;
+}
+
+size_t replay_type(
+    const trace_type_t type,
+    const std::vector<trace_record> &records,
+    const replay_options &options)
+{
+    switch (type) {
+    case trace_type_alt_bn128_G1:
+        return replay_group<alt_bn128_pp, alt_bn128_G1>(
+            "alt_bn128_G1", records, options);
+    case trace_type_alt_bn128_G2:
+        return replay_group<alt_bn128_pp, alt_bn128_G2>(
+            "alt_bn128_G2", records, options);
+    case trace_type_bls12_377_G1:
+        return replay_group<bls12_377_pp, bls12_377_G1>(
+            "bls12_377_G1", records, options);
+    case trace_type_bls12_377_G2:
+        return replay_group<bls12_377_pp, bls12_377_G2>(
+            "bls12_377_G2", records, options);
+    case trace_type_bls12_381_G1:
+        return replay_group<bls12_381_pp, bls12_381_G1>(
+            "bls12_381_G1", records, options);
+    case trace_type_bls12_381_G2:
+        return replay_group<bls12_381_pp, bls12_381_G2>(
+            "bls12_381_G2", records, options);
+#ifdef CURVE_BN128
+    case trace_type_bn128_G1:
+        return replay_group<bn128_pp, bn128_G1>("bn128_G1", records, options);
+    case trace_type_bn128_G2:
+        return replay_group<bn128_pp, bn128_G2>("bn128_G2", records, options);
+#endif
+    case trace_type_bw6_761_G1:
+        return replay_group<bw6_761_pp, bw6_761_G1>(
+            "bw6_761_G1", records, options);
+    case trace_type_bw6_761_G2:
+        return replay_group<bw6_761_pp, bw6_761_G2>(
+            "bw6_761_G2", records, options);
+    case trace_type_edwards_G1:
+        return replay_group<edwards_pp, edwards_G1>(
+            "edwards_G1", records, options);
+    case trace_type_edwards_G2:
+        return replay_group<edwards_pp, edwards_G2>(
+            "edwards_G2", records, options);
+    case trace_type_mnt4_G1:
+        return replay_group<mnt4_pp, mnt4_G1>("mnt4_G1", records, options);
+    case trace_type_mnt4_G2:
+        return replay_group<mnt4_pp, mnt4_G2>("mnt4_G2", records, options);
+    case trace_type_mnt6_G1:
+        return replay_group<mnt6_pp, mnt6_G1>("mnt6_G1", records, options);
+    case trace_type_mnt6_G2:
+        return replay_group<mnt6_pp, mnt6_G2>("mnt6_G2", records, options);
+    default:
+        printf(
+            "  (skipping %zu records of unsupported type %d)\n",
+            records.size(),
+            (int)type);
+        return 0;
+    }
+}
+
+void usage(const char *const argv0)
+{
+    std::cout << "Usage: " << argv0 << " [flags] <trace-file>\n"
+              << "\n"
+              << "Flags:\n"
+              << "  --method <method>     One of naive, naive_plain, "
+                 "bos_coster, BDLO12, BDLO12_signed,\n"
+              << "                        straus, auto, BDLO12_signed_xyzz "
+                 "(default: as recorded)\n"
+              << "  --base-form <form>    One of normal, special (default: "
+                 "as recorded)\n"
+              << "  --threads <n>         Chunks per multi_exp, and threads "
+                 "for point operations\n"
+              << "                        (default: as recorded, and 1)\n"
+              << "  --iterations <n>      Number of times to replay the "
+                 "trace (default 1)\n";
+}
+
+int main(const int argc, char const *const *const argv)
+{
+    replay_options options;
+    std::string filename;
+
+    try {
+        for (size_t i = 1; i < (size_t)argc; ++i) {
+            const char *const arg = argv[i];
+            if (!strcmp(arg, "--method") && i + 1 < (size_t)argc) {
+                options.use_recorded_method = false;
+                options.method = multi_exp_method_from_name(argv[++i]);
+            } else if (!strcmp(arg, "--base-form") && i + 1 < (size_t)argc) {
+                const std::string form = argv[++i];
+                if (form != "normal" && form != "special") {
+                    throw std::invalid_argument("unknown base form: " + form);
+                }
+                options.use_recorded_base_form = false;
+                options.base_form = (form == "special")
+                                        ? multi_exp_base_form_special
+                                        : multi_exp_base_form_normal;
+            } else if (!strcmp(arg, "--threads") && i + 1 < (size_t)argc) {
+                options.num_threads = std::stoul(std::string(argv[++i]));
+            } else if (!strcmp(arg, "--iterations") && i + 1 < (size_t)argc) {
+                options.num_iterations = std::stoul(std::string(argv[++i]));
+            } else if (arg[0] != '-' && filename.empty()) {
+                filename = arg;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (filename.empty() || options.num_iterations == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // The profiling output from the library (e.g. batch conversion to special
+    // form) would otherwise be interleaved with the results.
+    inhibit_profiling_info = true;
+
+    std::vector<trace_record> records = read_trace(filename);
+    std::cout << "Read " << records.size() << " records from " << filename
+              << "\n";
+
+    // Group records by type, then by thread, preserving the recorded order
+    // within each thread.
+    std::stable_sort(
+        records.begin(),
+        records.end(),
+        [](const trace_record &a, const trace_record &b) {
+            if (a.type != b.type) {
+                return a.type < b.type;
+            }
+            if (a.thread != b.thread) {
+                return a.thread < b.thread;
+            }
+            return a.sequence < b.sequence;
+        });
+
+    print_header();
+    size_t num_mismatches = 0;
+    size_t begin = 0;
+    while (begin < records.size()) {
+        size_t end = begin + 1;
+        while (end < records.size() &&
+               records[end].type == records[begin].type) {
+            ++end;
+        }
+        const std::vector<trace_record> type_records(
+            records.begin() + begin, records.begin() + end);
+        num_mismatches += replay_type(
+            (trace_type_t)records[begin].type, type_records, options);
+        begin = end;
+    }
+
+    if (num_mismatches != 0) {
+        std::cerr << num_mismatches << " results did not match the trace\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/** @file
+ *****************************************************************************
+
+ Read-only vectors of base elements held in shared memory, so that many
+ processes on a host (e.g. prover workers) can use one decoded copy of a
+ large base vector (e.g. proving key elements) rather than one copy each.
+
+ One process decodes the elements once into a named segment (see
+ shared_memory.hpp, which also describes POSIX shared memory and hugetlbfs
+ names), and other processes open the segment and pass the elements directly
+ to multi_exp, without copying:
+
+   const shared_base_vector<GroupT> bases =
+       shared_base_vector<GroupT>::open("/proving_key_g1");
+   multi_exp<GroupT, FieldT, Method, multi_exp_base_form_special>(
+       bases.begin(), bases.end(), scalars.begin(), scalars.end(), chunks);
+
+ The segment starts with a header, which is validated on open. Elements are
+ stored in their in-memory representation, so all processes must be built
+ from the same version of the library, for the same architecture.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef SHARED_BASE_VECTOR_HPP_
+#define SHARED_BASE_VECTOR_HPP_
+
+#include "libff/algebra/curves/curve_serialization.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp.hpp"
+#include "libff/common/shared_memory.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace libff
+{
+
+static const char SHARED_BASE_VECTOR_MAGIC[8] = {
+    'L', 'I', 'B', 'F', 'F', 'S', 'B', 'V'};
+static const uint32_t SHARED_BASE_VECTOR_VERSION = 1;
+
+/// Elements start at this offset from the start of the segment.
+static const size_t SHARED_BASE_VECTOR_DATA_OFFSET = 64;
+
+/// Header at the start of each segment. group_type is the trace_type_t of
+/// the group (see trace.hpp), or trace_type_unknown for other groups.
+struct shared_base_vector_header {
+    char magic[8];
+    uint32_t version;
+    /// Set to 1 (with release semantics) once all elements are written.
+    uint32_t complete;
+    uint32_t element_size;
+    uint32_t group_type;
+    uint32_t base_form;
+    uint32_t reserved;
+    uint64_t num_elements;
+    uint64_t data_offset;
+};
+
+template<typename GroupT> class shared_base_vector
+{
+public:
+    shared_base_vector() = default;
+    shared_base_vector(shared_base_vector &&other) = default;
+    shared_base_vector &operator=(shared_base_vector &&other) = default;
+
+    /// Create a segment holding a copy of elements, converted to base_form.
+    /// Throws std::runtime_error if a segment with the same name exists (see
+    /// remove).
+    static shared_base_vector create(
+        const std::string &name,
+        const std::vector<GroupT> &elements,
+        multi_exp_base_form base_form = multi_exp_base_form_special);
+
+    /// Create a segment holding num_elements elements decoded from in_s (as
+    /// written by group_write_vector), converted to base_form. Elements are
+    /// decoded in batches directly into the segment. If decoding fails, the
+    /// incomplete segment remains (open() rejects it) until removed.
+    template<encoding_t Enc, form_t Form, compression_t Comp>
+    static shared_base_vector create_from_stream(
+        const std::string &name,
+        std::istream &in_s,
+        size_t num_elements,
+        multi_exp_base_form base_form = multi_exp_base_form_special);
+
+    /// Open an existing segment. Throws std::runtime_error if the segment
+    /// does not exist, is incomplete, or does not hold elements of GroupT.
+    static shared_base_vector open(const std::string &name);
+
+    /// Remove the named segment (see shared_memory_segment::remove).
+    static void remove(const std::string &name);
+
+    const GroupT *begin() const;
+    const GroupT *end() const;
+    const GroupT &operator[](size_t i) const;
+    size_t size() const;
+    multi_exp_base_form base_form() const;
+
+protected:
+    static shared_memory_segment create_segment(
+        const std::string &name, size_t num_elements);
+    static void finalize_segment(
+        shared_memory_segment &segment,
+        size_t num_elements,
+        multi_exp_base_form base_form);
+
+    explicit shared_base_vector(shared_memory_segment &&segment);
+
+    const shared_base_vector_header &header() const;
+
+    shared_memory_segment _segment;
+};
+
+} // namespace libff
+
+#include "libff/algebra/scalar_multiplication/shared_base_vector.tcc"
+
+#endif // SHARED_BASE_VECTOR_HPP_
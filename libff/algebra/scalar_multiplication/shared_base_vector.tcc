@@ -0,0 +1,216 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of read-only base element vectors in shared memory.
+
+ See shared_base_vector.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef SHARED_BASE_VECTOR_TCC_
+#define SHARED_BASE_VECTOR_TCC_
+
+#include "libff/algebra/scalar_multiplication/shared_base_vector.hpp"
+#include "libff/common/trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace internal
+{
+
+/// Number of elements converted (and decoded) at a time when creating a
+/// segment.
+static const size_t SHARED_BASE_VECTOR_BATCH_SIZE = 1 << 16;
+
+} // namespace internal
+
+template<typename GroupT>
+shared_base_vector<GroupT>::shared_base_vector(
+    shared_memory_segment &&segment)
+    : _segment(std::move(segment))
+{
+}
+
+template<typename GroupT>
+shared_base_vector<GroupT> shared_base_vector<GroupT>::create(
+    const std::string &name,
+    const std::vector<GroupT> &elements,
+    multi_exp_base_form base_form)
+{
+    shared_memory_segment segment = create_segment(name, elements.size());
+    GroupT *const dest = (GroupT *)(
+        (uint8_t *)segment.data() + SHARED_BASE_VECTOR_DATA_OFFSET);
+
+    for (size_t i = 0; i < elements.size();
+         i += internal::SHARED_BASE_VECTOR_BATCH_SIZE) {
+        const size_t batch_end = std::min(
+            elements.size(), i + internal::SHARED_BASE_VECTOR_BATCH_SIZE);
+        std::vector<GroupT> batch(
+            elements.begin() + i, elements.begin() + batch_end);
+        if (base_form == multi_exp_base_form_special) {
+            batch_to_special(batch);
+        }
+        std::copy(batch.begin(), batch.end(), dest + i);
+    }
+
+    finalize_segment(segment, elements.size(), base_form);
+    return shared_base_vector(std::move(segment));
+}
+
+template<typename GroupT>
+template<encoding_t Enc, form_t Form, compression_t Comp>
+shared_base_vector<GroupT> shared_base_vector<GroupT>::create_from_stream(
+    const std::string &name,
+    std::istream &in_s,
+    size_t num_elements,
+    multi_exp_base_form base_form)
+{
+    shared_memory_segment segment = create_segment(name, num_elements);
+    GroupT *const dest = (GroupT *)(
+        (uint8_t *)segment.data() + SHARED_BASE_VECTOR_DATA_OFFSET);
+
+    // On failure, the segment is left incomplete (and rejected by open()),
+    // rather than removed here: only an explicit remove() deletes a segment.
+    std::vector<GroupT> batch;
+    for (size_t i = 0; i < num_elements;
+         i += internal::SHARED_BASE_VECTOR_BATCH_SIZE) {
+        batch.resize(std::min(
+            num_elements - i, internal::SHARED_BASE_VECTOR_BATCH_SIZE));
+        group_read_vector<Enc, Form, Comp>(batch, in_s);
+        if (!in_s) {
+            throw std::runtime_error("failed to read base elements");
+        }
+        if (base_form == multi_exp_base_form_special) {
+            batch_to_special(batch);
+        }
+        std::copy(batch.begin(), batch.end(), dest + i);
+    }
+
+    finalize_segment(segment, num_elements, base_form);
+    return shared_base_vector(std::move(segment));
+}
+
+template<typename GroupT>
+shared_base_vector<GroupT> shared_base_vector<GroupT>::open(
+    const std::string &name)
+{
+    shared_memory_segment segment = shared_memory_segment::open(name);
+    if (segment.size() < SHARED_BASE_VECTOR_DATA_OFFSET) {
+        throw std::runtime_error("shared base vector too small: " + name);
+    }
+
+    const shared_base_vector_header &h =
+        *(const shared_base_vector_header *)segment.data();
+    if (memcmp(h.magic, SHARED_BASE_VECTOR_MAGIC, sizeof(h.magic)) != 0 ||
+        h.version != SHARED_BASE_VECTOR_VERSION) {
+        throw std::runtime_error("not a shared base vector: " + name);
+    }
+    if (__atomic_load_n(&h.complete, __ATOMIC_ACQUIRE) != 1) {
+        throw std::runtime_error("incomplete shared base vector: " + name);
+    }
+    if (h.element_size != sizeof(GroupT) ||
+        h.group_type != trace_type<GroupT>::id) {
+        throw std::runtime_error("unexpected group in " + name);
+    }
+    if ((h.base_form != multi_exp_base_form_normal &&
+         h.base_form != multi_exp_base_form_special) ||
+        h.data_offset != SHARED_BASE_VECTOR_DATA_OFFSET ||
+        h.num_elements >
+            (segment.size() - SHARED_BASE_VECTOR_DATA_OFFSET) /
+                sizeof(GroupT)) {
+        throw std::runtime_error("invalid shared base vector header: " + name);
+    }
+
+    return shared_base_vector(std::move(segment));
+}
+
+template<typename GroupT>
+void shared_base_vector<GroupT>::remove(const std::string &name)
+{
+    shared_memory_segment::remove(name);
+}
+
+template<typename GroupT>
+const GroupT *shared_base_vector<GroupT>::begin() const
+{
+    return (const GroupT *)(
+        (const uint8_t *)_segment.data() + SHARED_BASE_VECTOR_DATA_OFFSET);
+}
+
+template<typename GroupT>
+const GroupT *shared_base_vector<GroupT>::end() const
+{
+    return begin() + size();
+}
+
+template<typename GroupT>
+const GroupT &shared_base_vector<GroupT>::operator[](size_t i) const
+{
+    return begin()[i];
+}
+
+template<typename GroupT> size_t shared_base_vector<GroupT>::size() const
+{
+    return (_segment.data() == nullptr) ? 0 : header().num_elements;
+}
+
+template<typename GroupT>
+multi_exp_base_form shared_base_vector<GroupT>::base_form() const
+{
+    return (multi_exp_base_form)header().base_form;
+}
+
+template<typename GroupT>
+shared_memory_segment shared_base_vector<GroupT>::create_segment(
+    const std::string &name, size_t num_elements)
+{
+    static_assert(
+        sizeof(shared_base_vector_header) <= SHARED_BASE_VECTOR_DATA_OFFSET,
+        "shared_base_vector_header too large");
+    static_assert(
+        SHARED_BASE_VECTOR_DATA_OFFSET % alignof(GroupT) == 0,
+        "shared_base_vector elements misaligned");
+
+    // The header is written (and the segment marked complete) only after
+    // all elements, so readers never see a partially written segment.
+    return shared_memory_segment::create(
+        name, SHARED_BASE_VECTOR_DATA_OFFSET + num_elements * sizeof(GroupT));
+}
+
+template<typename GroupT>
+void shared_base_vector<GroupT>::finalize_segment(
+    shared_memory_segment &segment,
+    size_t num_elements,
+    multi_exp_base_form base_form)
+{
+    shared_base_vector_header &h =
+        *(shared_base_vector_header *)segment.data();
+    memcpy(h.magic, SHARED_BASE_VECTOR_MAGIC, sizeof(h.magic));
+    h.version = SHARED_BASE_VECTOR_VERSION;
+    h.element_size = sizeof(GroupT);
+    h.group_type = trace_type<GroupT>::id;
+    h.base_form = base_form;
+    h.reserved = 0;
+    h.num_elements = num_elements;
+    h.data_offset = SHARED_BASE_VECTOR_DATA_OFFSET;
+    __atomic_store_n(&h.complete, 1, __ATOMIC_RELEASE);
+}
+
+template<typename GroupT>
+const shared_base_vector_header &shared_base_vector<GroupT>::header() const
+{
+    return *(const shared_base_vector_header *)_segment.data();
+}
+
+} // namespace libff
+
+#endif // SHARED_BASE_VECTOR_TCC_
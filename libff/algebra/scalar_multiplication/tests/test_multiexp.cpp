@@ -1,9 +1,23 @@
 #include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
 #include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
 #include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/bw6_761/bw6_761_pp.hpp"
+#include "libff/algebra/curves/curve_serialization.hpp"
 #include "libff/algebra/scalar_multiplication/multiexp.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp_scheduler.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp_server.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp_sharded.hpp"
+#include "libff/algebra/scalar_multiplication/shared_base_vector.hpp"
+#include "libff/common/unix_socket.hpp"
 
+#include <csignal>
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 using namespace libff;
 
@@ -281,6 +295,79 @@ template<typename GroupT> void test_multi_exp()
     test_multi_exp_group_method<GroupT, multi_exp_method_bos_coster>();
     test_multi_exp_group_method<GroupT, multi_exp_method_BDLO12>();
     test_multi_exp_group_method<GroupT, multi_exp_method_BDLO12_signed>();
+    test_multi_exp_group_method<GroupT, multi_exp_method_straus>();
+    test_multi_exp_group_method<GroupT, multi_exp_method_auto>();
+    test_multi_exp_group_method<GroupT, multi_exp_method_BDLO12_signed_xyzz>();
+}
+
+/// Compare the given method against multi_exp_method_naive_plain for random
+/// full-size scalars, where some bases and scalars are zero.
+template<typename GroupT, multi_exp_method Method, multi_exp_base_form BaseForm>
+void test_multi_exp_random(const size_t num_elements, const size_t chunks = 1)
+{
+    using Field = typename GroupT::scalar_field;
+
+    std::vector<GroupT> base_elements(num_elements);
+    std::vector<Field> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i) {
+        base_elements[i] =
+            (i % 7 == 3) ? GroupT::zero() : GroupT::random_element();
+        scalars[i] = (i % 5 == 2) ? Field::zero() : Field::random_element();
+    }
+    if (BaseForm == multi_exp_base_form_special) {
+        batch_to_special(base_elements);
+    }
+
+    const GroupT expect =
+        multi_exp<GroupT, Field, multi_exp_method_naive_plain>(
+            base_elements.begin(),
+            base_elements.end(),
+            scalars.begin(),
+            scalars.end(),
+            1);
+    const GroupT result = multi_exp<GroupT, Field, Method, BaseForm>(
+        base_elements.begin(),
+        base_elements.end(),
+        scalars.begin(),
+        scalars.end(),
+        chunks);
+    ASSERT_EQ(expect, result);
+}
+
+template<typename GroupT> void test_multi_exp_bos_coster()
+{
+    for (const size_t n : {2, 3, 50, 257}) {
+        test_multi_exp_random<
+            GroupT,
+            multi_exp_method_bos_coster,
+            multi_exp_base_form_normal>(n);
+    }
+    test_multi_exp_random<
+        GroupT,
+        multi_exp_method_bos_coster,
+        multi_exp_base_form_special>(100, 4);
+}
+
+template<typename GroupT> void test_multi_exp_straus()
+{
+    for (const size_t n : {1, 2, 5, 16, 50}) {
+        test_multi_exp_random<
+            GroupT,
+            multi_exp_method_straus,
+            multi_exp_base_form_normal>(n);
+        test_multi_exp_random<
+            GroupT,
+            multi_exp_method_straus,
+            multi_exp_base_form_special>(n);
+    }
+    test_multi_exp_random<
+        GroupT,
+        multi_exp_method_auto,
+        multi_exp_base_form_normal>(MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES - 1);
+    test_multi_exp_random<
+        GroupT,
+        multi_exp_method_auto,
+        multi_exp_base_form_normal>(MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES);
 }
 
 TEST(MultiExpTest, TestMultiExpAccumulateBucketsAltBN128)
@@ -325,6 +412,233 @@ TEST(MultiExpTest, TestMultiExpBLS12_381)
     test_multi_exp<bls12_381_G2>();
 }
 
+TEST(MultiExpTest, TestMultiExpBosCoster)
+{
+    test_multi_exp_bos_coster<alt_bn128_G1>();
+    test_multi_exp_bos_coster<bls12_381_G1>();
+    // Scalars of 6 limbs.
+    test_multi_exp_bos_coster<bw6_761_G1>();
+}
+
+template<typename GroupT>
+void random_multi_exp_instance(
+    const size_t n,
+    std::vector<GroupT> &bases,
+    std::vector<typename GroupT::scalar_field> &scalars)
+{
+    bases.resize(n);
+    scalars.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        bases[i] = GroupT::random_element();
+        scalars[i] = GroupT::scalar_field::random_element();
+    }
+}
+
+TEST(MultiExpTest, TestMultiExpScheduler)
+{
+    using Field = alt_bn128_Fr;
+    const std::vector<size_t> g1_sizes{0, 1, 300, 1000};
+    const size_t g2_size = 600;
+
+    std::vector<std::vector<alt_bn128_G1>> g1_bases(g1_sizes.size());
+    std::vector<std::vector<Field>> g1_scalars(g1_sizes.size());
+    for (size_t i = 0; i < g1_sizes.size(); ++i) {
+        random_multi_exp_instance(g1_sizes[i], g1_bases[i], g1_scalars[i]);
+    }
+    std::vector<alt_bn128_G2> g2_bases;
+    std::vector<Field> g2_scalars;
+    random_multi_exp_instance(g2_size, g2_bases, g2_scalars);
+    batch_to_special(g2_bases);
+
+    for (const size_t num_threads : {1, 3, 8}) {
+        multi_exp_scheduler scheduler;
+        std::vector<std::future<alt_bn128_G1>> g1_results;
+        for (size_t i = 0; i < g1_sizes.size(); ++i) {
+            g1_results.push_back(scheduler.add<
+                                 alt_bn128_G1,
+                                 Field,
+                                 multi_exp_method_BDLO12_signed>(
+                g1_bases[i].begin(),
+                g1_bases[i].end(),
+                g1_scalars[i].begin(),
+                g1_scalars[i].end()));
+        }
+        std::future<alt_bn128_G2> g2_result = scheduler.add<
+            alt_bn128_G2,
+            Field,
+            multi_exp_method_auto,
+            multi_exp_base_form_special>(
+            g2_bases.data(),
+            g2_bases.data() + g2_bases.size(),
+            g2_scalars.begin(),
+            g2_scalars.end());
+        ASSERT_EQ(g1_sizes.size() + 1, scheduler.num_jobs());
+
+        scheduler.run(num_threads);
+        ASSERT_EQ(0, scheduler.num_jobs());
+
+        for (size_t i = 0; i < g1_sizes.size(); ++i) {
+            const alt_bn128_G1 expect = multi_exp<
+                alt_bn128_G1,
+                Field,
+                multi_exp_method_BDLO12_signed>(
+                g1_bases[i].begin(),
+                g1_bases[i].end(),
+                g1_scalars[i].begin(),
+                g1_scalars[i].end(),
+                1);
+            ASSERT_EQ(expect, g1_results[i].get());
+        }
+        const alt_bn128_G2 expect =
+            multi_exp<alt_bn128_G2, Field, multi_exp_method_BDLO12_signed>(
+                g2_bases.begin(),
+                g2_bases.end(),
+                g2_scalars.begin(),
+                g2_scalars.end(),
+                1);
+        ASSERT_EQ(expect, g2_result.get());
+    }
+}
+
+/// A scheduler job which fails while computing its slices.
+class failing_scheduler_job : public internal::multi_exp_scheduler_job
+{
+public:
+    std::promise<int> result;
+
+    size_t size() const override { return 1000; }
+    double estimate_cost(const size_t num_entries) const override
+    {
+        return (double)num_entries;
+    }
+    void set_num_slices(const size_t) override {}
+    void compute_slice(const size_t, const size_t, const size_t) override
+    {
+        throw std::runtime_error("failing_scheduler_job");
+    }
+    void finish(const std::exception_ptr &error) override
+    {
+        if (error) {
+            result.set_exception(error);
+        } else {
+            result.set_value(0);
+        }
+    }
+};
+
+class test_multi_exp_scheduler : public multi_exp_scheduler
+{
+public:
+    std::future<int> add_failing_job()
+    {
+        std::unique_ptr<failing_scheduler_job> job(new failing_scheduler_job);
+        std::future<int> result = job->result.get_future();
+        _jobs.emplace_back(std::move(job));
+        return result;
+    }
+};
+
+TEST(MultiExpTest, TestMultiExpSchedulerError)
+{
+    using Field = alt_bn128_Fr;
+    std::vector<alt_bn128_G1> bases;
+    std::vector<Field> scalars;
+    random_multi_exp_instance(1000, bases, scalars);
+    const alt_bn128_G1 expect =
+        multi_exp<alt_bn128_G1, Field, multi_exp_method_BDLO12_signed>(
+            bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+
+    // The error of one job is delivered through its future, and does not
+    // affect the other jobs.
+    for (const size_t num_threads : {1, 4}) {
+        test_multi_exp_scheduler scheduler;
+        std::future<int> failing = scheduler.add_failing_job();
+        std::future<alt_bn128_G1> result =
+            scheduler.add<alt_bn128_G1, Field, multi_exp_method_BDLO12_signed>(
+                bases.begin(), bases.end(), scalars.begin(), scalars.end());
+        scheduler.run(num_threads);
+        ASSERT_THROW(failing.get(), std::runtime_error);
+        ASSERT_EQ(expect, result.get());
+    }
+}
+
+template<typename GroupT> void test_multi_exp_batch()
+{
+    using Field = typename GroupT::scalar_field;
+
+    // Instances of sizes 0 to 32, and one above
+    // MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES, over shared vectors.
+    const size_t total = MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES + 64;
+    std::vector<GroupT> bases;
+    std::vector<Field> scalars;
+    random_multi_exp_instance(total, bases, scalars);
+
+    std::vector<multi_exp_batch_instance<GroupT, Field>> instances;
+    for (size_t i = 0; i < 100; ++i) {
+        const size_t begin = (i * 37) % (total - 32);
+        const size_t size = i % 33;
+        instances.push_back(
+            {bases.begin() + begin,
+             bases.begin() + begin + size,
+             scalars.begin() + begin});
+    }
+    instances.push_back(
+        {bases.begin(),
+         bases.begin() + MULTI_EXP_AUTO_STRAUS_MAX_ENTRIES + 1,
+         scalars.begin()});
+
+    for (const bool normalize : {false, true}) {
+        const std::vector<GroupT> results =
+            multi_exp_batch<GroupT, Field>(instances, normalize);
+        ASSERT_EQ(instances.size(), results.size());
+        for (size_t i = 0; i < instances.size(); ++i) {
+            const GroupT expect =
+                multi_exp<GroupT, Field, multi_exp_method_BDLO12_signed>(
+                    instances[i].vec_start,
+                    instances[i].vec_end,
+                    instances[i].scalar_start,
+                    instances[i].scalar_start +
+                        (instances[i].vec_end - instances[i].vec_start),
+                    1);
+            ASSERT_EQ(expect, results[i]);
+            if (normalize) {
+                ASSERT_TRUE(results[i].is_special());
+            }
+        }
+    }
+}
+
+TEST(MultiExpTest, TestMultiExpBatch)
+{
+    test_multi_exp_batch<alt_bn128_G1>();
+    test_multi_exp_batch<bls12_381_G2>();
+}
+
+TEST(MultiExpTest, TestMultiExpXYZZ)
+{
+    // Projective (rather than Jacobian) coordinates, and a larger field.
+    test_multi_exp_random<
+        bw6_761_G1,
+        multi_exp_method_BDLO12_signed_xyzz,
+        multi_exp_base_form_normal>(300);
+    test_multi_exp_random<
+        alt_bn128_G1,
+        multi_exp_method_BDLO12_signed_xyzz,
+        multi_exp_base_form_special>(1000, 2);
+    test_multi_exp_random<
+        bls12_381_G2,
+        multi_exp_method_BDLO12_signed_xyzz,
+        multi_exp_base_form_normal>(300);
+}
+
+TEST(MultiExpTest, TestMultiExpStraus)
+{
+    test_multi_exp_straus<alt_bn128_G1>();
+    test_multi_exp_straus<alt_bn128_G2>();
+    test_multi_exp_straus<bls12_377_G1>();
+    test_multi_exp_straus<bls12_381_G2>();
+}
+
 alt_bn128_Fr fr_from_string(const std::string &str)
 {
     std::istringstream ss(str);
@@ -389,6 +703,422 @@ TEST(MultiExpTest, TestEdgeCase1)
     ASSERT_EQ(expect, actual);
 }
 
+TEST(MultiExpTest, TestMultiExpServer)
+{
+    using GroupT = alt_bn128_G1;
+    using FieldT = alt_bn128_Fr;
+    const size_t num_bases = 1000;
+    const size_t base_offset = 100;
+    const std::string socket_path =
+        "/tmp/libff_test_multiexp_server_" + std::to_string(getpid());
+
+    std::vector<GroupT> bases(num_bases);
+    std::vector<FieldT> scalars(num_bases - base_offset);
+    for (size_t i = 0; i < num_bases; ++i) {
+        bases[i] = GroupT::random_element();
+    }
+    for (FieldT &s : scalars) {
+        s = FieldT::random_element();
+    }
+
+    const GroupT expect_all = multi_exp<
+        GroupT,
+        FieldT,
+        multi_exp_method_naive,
+        multi_exp_base_form_normal>(
+        bases.begin() + base_offset,
+        bases.end(),
+        scalars.begin(),
+        scalars.end(),
+        1);
+    const GroupT expect_small = multi_exp<
+        GroupT,
+        FieldT,
+        multi_exp_method_naive,
+        multi_exp_base_form_normal>(
+        bases.begin(),
+        bases.begin() + 3,
+        scalars.begin(),
+        scalars.begin() + 3,
+        1);
+
+    // At most 2 connections are served at a time.
+    multi_exp_server<GroupT, FieldT> server(
+        std::vector<GroupT>(bases), 4, 4, 2);
+    ASSERT_EQ(expect_all, server.multi_exp(scalars, base_offset));
+    server.start(socket_path);
+
+    // The socket of a running server is never taken over.
+    ASSERT_THROW(unix_socket_listen(socket_path), std::runtime_error);
+
+    // Concurrent clients, each on their own connection.
+    std::vector<GroupT> results(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            multi_exp_client<GroupT, FieldT> client(socket_path);
+            results[i] = client.multi_exp(scalars, base_offset);
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    for (const GroupT &result : results) {
+        ASSERT_EQ(expect_all, result);
+    }
+
+    multi_exp_client<GroupT, FieldT> client(socket_path);
+    ASSERT_EQ(num_bases, client.num_bases());
+    ASSERT_EQ(
+        expect_small,
+        client.multi_exp(
+            std::vector<FieldT>(scalars.begin(), scalars.begin() + 3)));
+    ASSERT_EQ(GroupT::zero(), client.multi_exp({}));
+    ASSERT_THROW(client.multi_exp(scalars, base_offset + 1), std::out_of_range);
+
+    // Scalars that are not reduced modulo the field characteristic are
+    // rejected.
+    FieldT unreduced;
+    unreduced.mont_repr = FieldT::mod;
+    multi_exp_client<GroupT, FieldT> bad_client(socket_path);
+    ASSERT_THROW(bad_client.multi_exp({unreduced}), std::runtime_error);
+
+    server.stop();
+
+    // Serve the bases from a shared base vector (in normal form).
+    const std::string name =
+        "/libff_test_multiexp_server_" + std::to_string(getpid());
+    shared_base_vector<GroupT>::create(
+        name, bases, multi_exp_base_form_normal);
+    // Connections stalled for 100 ms are closed.
+    multi_exp_server<GroupT, FieldT> shared_server(
+        shared_base_vector<GroupT>::open(name), 2, 16, 64, 100);
+    ASSERT_EQ(num_bases, shared_server.num_bases());
+    shared_server.start(socket_path);
+    ASSERT_EQ(
+        expect_all,
+        (multi_exp_client<GroupT, FieldT>(socket_path)
+             .multi_exp(scalars, base_offset)));
+
+    // A client stalled part-way through a request header is disconnected.
+    const int stalled_fd = unix_socket_connect(socket_path);
+    const uint32_t magic = MULTI_EXP_SERVER_MAGIC;
+    unix_socket_write(stalled_fd, &magic, sizeof(magic));
+    char unused;
+    ASSERT_FALSE(unix_socket_read(stalled_fd, &unused, sizeof(unused)));
+    unix_socket_close(stalled_fd);
+    shared_server.stop();
+    shared_base_vector<GroupT>::remove(name);
+}
+
+TEST(MultiExpTest, TestUnixSocketListen)
+{
+    const std::string path =
+        "/tmp/libff_test_unix_socket_" + std::to_string(getpid());
+
+    // A stale socket (whose listener has exited) is replaced.
+    unix_socket_close(unix_socket_listen(path));
+    const int fd = unix_socket_listen(path);
+    unix_socket_close(fd);
+    unix_socket_remove(path);
+
+    // Other files are never removed.
+    std::ofstream(path) << "not a socket";
+    ASSERT_THROW(unix_socket_listen(path), std::runtime_error);
+    ASSERT_TRUE(std::ifstream(path).good());
+    std::remove(path.c_str());
+}
+
+TEST(MultiExpTest, TestSharedBaseVector)
+{
+    using GroupT = alt_bn128_G1;
+    using FieldT = alt_bn128_Fr;
+    const size_t num_bases = 300;
+    const std::string name =
+        "/libff_test_shared_base_vector_" + std::to_string(getpid());
+
+    std::vector<GroupT> bases(num_bases);
+    std::vector<FieldT> scalars(num_bases);
+    for (size_t i = 0; i < num_bases; ++i) {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+    const GroupT expect = multi_exp<
+        GroupT,
+        FieldT,
+        multi_exp_method_naive,
+        multi_exp_base_form_normal>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+
+    // Create from a vector, then attach (as another process would).
+    {
+        const shared_base_vector<GroupT> created =
+            shared_base_vector<GroupT>::create(name, bases);
+        ASSERT_EQ(num_bases, created.size());
+    }
+    const shared_base_vector<GroupT> shared =
+        shared_base_vector<GroupT>::open(name);
+    ASSERT_EQ(num_bases, shared.size());
+    ASSERT_EQ(multi_exp_base_form_special, shared.base_form());
+    ASSERT_EQ(bases[7], shared[7]);
+    ASSERT_EQ(
+        expect,
+        (multi_exp<
+            GroupT,
+            FieldT,
+            multi_exp_method_BDLO12_signed,
+            multi_exp_base_form_special>(
+            shared.begin(), shared.end(), scalars.begin(), scalars.end(), 4)));
+
+    // Attaching with the wrong group type fails validation.
+    ASSERT_THROW(
+        shared_base_vector<alt_bn128_G2>::open(name), std::runtime_error);
+
+    // An existing segment is never replaced.
+    ASSERT_THROW(
+        shared_base_vector<GroupT>::create(name, bases), std::runtime_error);
+    shared_base_vector<GroupT>::remove(name);
+
+    // Create by decoding a stream.
+    std::stringstream ss;
+    group_write_vector<encoding_binary, form_montgomery, compression_off>(
+        bases, ss);
+    shared_base_vector<GroupT>::create_from_stream<
+        encoding_binary,
+        form_montgomery,
+        compression_off>(name, ss, num_bases, multi_exp_base_form_normal);
+    const shared_base_vector<GroupT> decoded =
+        shared_base_vector<GroupT>::open(name);
+    ASSERT_EQ(multi_exp_base_form_normal, decoded.base_form());
+    ASSERT_EQ(
+        expect,
+        (multi_exp<
+            GroupT,
+            FieldT,
+            multi_exp_method_BDLO12_signed,
+            multi_exp_base_form_normal>(
+            decoded.begin(),
+            decoded.end(),
+            scalars.begin(),
+            scalars.end(),
+            2)));
+
+    shared_base_vector<GroupT>::remove(name);
+    ASSERT_THROW(shared_base_vector<GroupT>::open(name), std::runtime_error);
+}
+
+/// Processes running the multiexp_shard_worker tool. Processes still running
+/// on destruction (e.g. after a failed assertion) are terminated.
+class shard_worker_processes
+{
+public:
+    ~shard_worker_processes()
+    {
+        for (const pid_t pid : _pids) {
+            kill(pid, SIGTERM);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+
+    void start(const std::vector<std::string> &args)
+    {
+        std::vector<char *> argv;
+        argv.push_back((char *)LIBFF_MULTIEXP_SHARD_WORKER);
+        for (const std::string &arg : args) {
+            argv.push_back((char *)arg.c_str());
+        }
+        argv.push_back(nullptr);
+
+        const pid_t pid = fork();
+        if (pid == 0) {
+            execv(argv[0], argv.data());
+            _exit(127);
+        }
+        ASSERT_GT(pid, 0);
+        _pids.push_back(pid);
+    }
+
+    /// Wait for all processes to exit. Returns true if all succeeded.
+    bool wait()
+    {
+        bool success = true;
+        for (const pid_t pid : _pids) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            success = success && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        _pids.clear();
+        return success;
+    }
+
+private:
+    std::vector<pid_t> _pids;
+};
+
+TEST(MultiExpTest, TestMultiExpSharded)
+{
+    using GroupT = alt_bn128_G1;
+    using FieldT = alt_bn128_Fr;
+    using WorkerT = multi_exp_shard_worker<
+        GroupT,
+        FieldT,
+        multi_exp_method_BDLO12_signed,
+        multi_exp_base_form_special>;
+    const size_t num_bases = 1000;
+    const size_t num_shards = 3;
+    const std::string name =
+        "/libff_test_multiexp_sharded_" + std::to_string(getpid());
+
+    std::vector<GroupT> bases;
+    std::vector<FieldT> scalars;
+    random_multi_exp_instance(num_bases, bases, scalars);
+    const GroupT expect_all = multi_exp<
+        GroupT,
+        FieldT,
+        multi_exp_method_naive,
+        multi_exp_base_form_normal>(
+        bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+    // Fewer scalars than bases, ending within the second shard.
+    const size_t num_partial = 500;
+    const GroupT expect_partial = multi_exp<
+        GroupT,
+        FieldT,
+        multi_exp_method_naive,
+        multi_exp_base_form_normal>(
+        bases.begin(),
+        bases.begin() + num_partial,
+        scalars.begin(),
+        scalars.begin() + num_partial,
+        1);
+
+    // Worker processes serve consecutive shards of a single shared copy of
+    // the bases.
+    shared_base_vector<GroupT>::create(name, bases);
+    const shared_base_vector<GroupT> shared =
+        shared_base_vector<GroupT>::open(name);
+    std::vector<std::string> paths;
+    shard_worker_processes workers;
+    for (size_t i = 0; i < num_shards; ++i) {
+        paths.push_back(
+            "/tmp/libff_test_multiexp_shard_" + std::to_string(getpid()) +
+            "_" + std::to_string(i));
+        workers.start(
+            {"--curve",
+             "alt_bn128",
+             "--shared-bases",
+             name,
+             "--begin",
+             std::to_string(i * num_bases / num_shards),
+             "--end",
+             std::to_string((i + 1) * num_bases / num_shards),
+             "--socket",
+             paths[i],
+             "--chunks",
+             "2"});
+    }
+
+    {
+        multi_exp_shard_coordinator<GroupT, FieldT> coordinator(paths);
+        ASSERT_EQ(num_bases, coordinator.num_bases());
+        ASSERT_EQ(expect_all, coordinator.multi_exp(scalars));
+        ASSERT_EQ(
+            expect_partial,
+            coordinator.multi_exp(std::vector<FieldT>(
+                scalars.begin(), scalars.begin() + num_partial)));
+        ASSERT_EQ(GroupT::zero(), coordinator.multi_exp({}));
+
+        std::vector<FieldT> too_many(scalars);
+        too_many.push_back(FieldT::one());
+        ASSERT_THROW(coordinator.multi_exp(too_many), std::out_of_range);
+
+        coordinator.shutdown_workers();
+    }
+    ASSERT_TRUE(workers.wait());
+
+    // A worker rejects requests for a different group.
+    const WorkerT worker(shared.begin(), shared.end(), 1);
+    ASSERT_EQ(expect_all, worker.multi_exp(scalars));
+    std::thread mismatched([&worker, &paths]() { worker.serve(paths[0]); });
+    ASSERT_THROW(
+        (multi_exp_shard_coordinator<alt_bn128_G2, FieldT>({paths[0]})),
+        std::runtime_error);
+    multi_exp_shard_coordinator<GroupT, FieldT>({paths[0]}).shutdown_workers();
+    mismatched.join();
+
+    shared_base_vector<GroupT>::remove(name);
+}
+
+TEST(MultiExpTest, TestMultiExpShardedInvalidPartial)
+{
+    using GroupT = alt_bn128_G1;
+    using FieldT = alt_bn128_Fr;
+    const size_t num_bases = 10;
+    const std::string path =
+        "/tmp/libff_test_multiexp_shard_invalid_" + std::to_string(getpid());
+    const std::string valid_path =
+        "/tmp/libff_test_multiexp_shard_valid_" + std::to_string(getpid());
+
+    // A faulty worker, which answers a multi_exp request with a point that
+    // is not on the curve.
+    GroupT invalid = GroupT::one();
+    invalid.X = invalid.X + alt_bn128_Fq::one();
+    std::ostringstream invalid_s;
+    group_write<encoding_binary, form_plain, compression_off>(
+        invalid, invalid_s);
+    const std::string invalid_bytes = invalid_s.str();
+
+    const int listen_fd = unix_socket_listen(path);
+    std::thread faulty([listen_fd, &invalid_bytes]() {
+        const int fd = unix_socket_accept(listen_fd);
+        const multi_exp_shard_response response{
+            multi_exp_shard_status_ok, 0, num_bases};
+        multi_exp_shard_request req;
+        while (unix_socket_read(fd, &req, sizeof(req))) {
+            std::vector<char> scalars(req.num_scalars * req.scalar_size);
+            unix_socket_read(fd, scalars.data(), scalars.size());
+            unix_socket_write(fd, &response, sizeof(response));
+            if (req.command == multi_exp_shard_command_multi_exp) {
+                unix_socket_write(
+                    fd, invalid_bytes.data(), invalid_bytes.size());
+            }
+        }
+        unix_socket_close(fd);
+    });
+
+    // A valid worker for the second shard, whose response is still unread
+    // when the first shard's result is rejected.
+    std::vector<GroupT> bases;
+    std::vector<FieldT> unused_scalars;
+    random_multi_exp_instance(num_bases, bases, unused_scalars);
+    const multi_exp_shard_worker<GroupT, FieldT> valid(
+        bases.data(), bases.data() + bases.size(), 1);
+    std::thread valid_thread([&valid, &valid_path]() {
+        valid.serve(valid_path);
+    });
+
+    {
+        // EXPECT rather than ASSERT, so that the threads are always joined.
+        multi_exp_shard_coordinator<GroupT, FieldT> coordinator(
+            {path, valid_path});
+        EXPECT_EQ(2 * num_bases, coordinator.num_bases());
+        const std::vector<FieldT> scalars(2 * num_bases, FieldT::one());
+        EXPECT_THROW(coordinator.multi_exp(scalars), std::runtime_error);
+
+        // The connections are closed after the failure, so that a later
+        // request cannot read the stale response of the valid worker.
+        EXPECT_EQ(0, coordinator.num_bases());
+        EXPECT_THROW(coordinator.multi_exp(scalars), std::runtime_error);
+        EXPECT_THROW(coordinator.multi_exp({}), std::runtime_error);
+    }
+    faulty.join();
+    unix_socket_close(listen_fd);
+    unix_socket_remove(path);
+
+    multi_exp_shard_coordinator<GroupT, FieldT>({valid_path})
+        .shutdown_workers();
+    valid_thread.join();
+}
+
 } // namespace
 
 int main(int argc, char **argv)
@@ -396,6 +1126,7 @@ int main(int argc, char **argv)
     libff::alt_bn128_pp::init_public_params();
     libff::bls12_377_pp::init_public_params();
     libff::bls12_381_pp::init_public_params();
+    libff::bw6_761_pp::init_public_params();
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
@@ -0,0 +1,212 @@
+/** @file
+ *****************************************************************************
+
+ Daemon serving multi-exponentiation requests over a Unix domain socket,
+ using a multi_exp_server (see multiexp_server.hpp), until the daemon
+ receives SIGINT or SIGTERM. Base elements are either read once at startup
+ from a file of binary, Montgomery-form, uncompressed group elements (as
+ written by group_write), or served directly from a shared memory segment
+ created by the shared_bases tool (see shared_base_vector.hpp), which other
+ processes and daemons on the host can map as well.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/bw6_761/bw6_761_pp.hpp"
+#include "libff/algebra/curves/curve_serialization.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp_server.hpp"
+#include "libff/common/profiling.hpp"
+
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace libff;
+
+static const form_t FORM = form_montgomery;
+static const compression_t COMP = compression_off;
+
+template<typename GroupT>
+std::vector<GroupT> read_base_elements(const std::string &filename)
+{
+    // Determine the number of elements from the file size.
+    std::ostringstream element_s;
+    group_write<encoding_binary, FORM, COMP>(GroupT::one(), element_s);
+    const size_t element_size = element_s.str().size();
+
+    std::ifstream in_s(filename, std::ios_base::in | std::ios_base::binary);
+    if (!in_s) {
+        throw std::runtime_error("failed to open " + filename);
+    }
+    in_s.exceptions(std::ios_base::badbit | std::ios_base::failbit);
+    in_s.seekg(0, std::ios_base::end);
+    const size_t file_size = in_s.tellg();
+    in_s.seekg(0, std::ios_base::beg);
+    if (file_size % element_size != 0) {
+        throw std::runtime_error("unexpected size of " + filename);
+    }
+
+    std::vector<GroupT> elements(file_size / element_size);
+    group_read_vector<encoding_binary, FORM, COMP>(elements, in_s);
+    return elements;
+}
+
+/// Block until SIGINT or SIGTERM is received. The signals must already be
+/// blocked (on all threads).
+void wait_for_termination(const sigset_t &signals)
+{
+    int signal;
+    sigwait(&signals, &signal);
+}
+
+class daemon_options
+{
+public:
+    std::string bases_filename;
+    std::string shared_bases_name;
+    std::string socket_path;
+    size_t num_slices;
+    size_t max_batch_size;
+    size_t max_connections;
+    size_t receive_timeout_ms;
+};
+
+template<typename ppT, typename GroupT>
+void run_daemon(const daemon_options &options, const sigset_t &signals)
+{
+    using FieldT = typename GroupT::scalar_field;
+    using server_type = multi_exp_server<GroupT, FieldT>;
+
+    ppT::init_public_params();
+    std::unique_ptr<server_type> server;
+    if (!options.shared_bases_name.empty()) {
+        server.reset(new server_type(
+            shared_base_vector<GroupT>::open(options.shared_bases_name),
+            options.num_slices,
+            options.max_batch_size,
+            options.max_connections,
+            options.receive_timeout_ms));
+    } else {
+        server.reset(new server_type(
+            read_base_elements<GroupT>(options.bases_filename),
+            options.num_slices,
+            options.max_batch_size,
+            options.max_connections,
+            options.receive_timeout_ms));
+    }
+
+    server->start(options.socket_path);
+    std::cout << "Serving " << server->num_bases() << " base elements on "
+              << options.socket_path << "\n";
+
+    wait_for_termination(signals);
+    server->stop();
+}
+
+void usage(const char *const argv0)
+{
+    std::cout << "Usage: " << argv0 << " [flags]\n"
+              << "\n"
+              << "Flags:\n"
+              << "  --curve <curve>       One of alt_bn128, bls12_377, "
+                 "bls12_381, bw6_761\n"
+              << "  --group <group>       One of g1, g2 (default g1)\n"
+              << "  --bases <file>        Base elements (binary, montgomery, "
+                 "uncompressed)\n"
+              << "  --shared-bases <name> Shared base vector to serve, "
+                 "instead of --bases\n"
+              << "  --socket <path>       Path of the socket to listen on\n"
+              << "  --slices <n>          Slices per request (default: "
+                 "hardware concurrency)\n"
+              << "  --max-batch <n>       Maximum requests per batch "
+                 "(default 16)\n"
+              << "  --max-connections <n> Maximum concurrent connections "
+                 "(default 64)\n"
+              << "  --receive-timeout <ms> Close connections idle for this "
+                 "long (default 60000, 0 for none)\n";
+}
+
+int main(const int argc, char const *const *const argv)
+{
+    std::string curve;
+    std::string group = "g1";
+    daemon_options options;
+    options.num_slices = std::max(1u, std::thread::hardware_concurrency());
+    options.max_batch_size = 16;
+    options.max_connections = 64;
+    options.receive_timeout_ms = 60000;
+
+    for (size_t i = 1; i < (size_t)argc; ++i) {
+        const char *const arg = argv[i];
+        if (!strcmp(arg, "--curve") && i + 1 < (size_t)argc) {
+            curve = argv[++i];
+        } else if (!strcmp(arg, "--group") && i + 1 < (size_t)argc) {
+            group = argv[++i];
+        } else if (!strcmp(arg, "--bases") && i + 1 < (size_t)argc) {
+            options.bases_filename = argv[++i];
+        } else if (!strcmp(arg, "--shared-bases") && i + 1 < (size_t)argc) {
+            options.shared_bases_name = argv[++i];
+        } else if (!strcmp(arg, "--socket") && i + 1 < (size_t)argc) {
+            options.socket_path = argv[++i];
+        } else if (!strcmp(arg, "--slices") && i + 1 < (size_t)argc) {
+            options.num_slices = std::stoul(std::string(argv[++i]));
+        } else if (!strcmp(arg, "--max-batch") && i + 1 < (size_t)argc) {
+            options.max_batch_size = std::stoul(std::string(argv[++i]));
+        } else if (
+            !strcmp(arg, "--max-connections") && i + 1 < (size_t)argc) {
+            options.max_connections = std::stoul(std::string(argv[++i]));
+        } else if (
+            !strcmp(arg, "--receive-timeout") && i + 1 < (size_t)argc) {
+            options.receive_timeout_ms = std::stoul(std::string(argv[++i]));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.bases_filename.empty() == options.shared_bases_name.empty() ||
+        options.socket_path.empty() || (group != "g1" && group != "g2")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    inhibit_profiling_info = true;
+
+    // Block termination signals before any threads are created, so that they
+    // are only delivered via sigwait.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    const bool g1 = (group == "g1");
+    if (curve == "alt_bn128") {
+        g1 ? run_daemon<alt_bn128_pp, alt_bn128_G1>(options, signals)
+           : run_daemon<alt_bn128_pp, alt_bn128_G2>(options, signals);
+    } else if (curve == "bls12_377") {
+        g1 ? run_daemon<bls12_377_pp, bls12_377_G1>(options, signals)
+           : run_daemon<bls12_377_pp, bls12_377_G2>(options, signals);
+    } else if (curve == "bls12_381") {
+        g1 ? run_daemon<bls12_381_pp, bls12_381_G1>(options, signals)
+           : run_daemon<bls12_381_pp, bls12_381_G2>(options, signals);
+    } else if (curve == "bw6_761") {
+        g1 ? run_daemon<bw6_761_pp, bw6_761_G1>(options, signals)
+           : run_daemon<bw6_761_pp, bw6_761_G2>(options, signals);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/** @file
+ *****************************************************************************
+
+ Worker process for sharded multi-exponentiation (see multiexp_sharded.hpp).
+ Serves the range [begin, end) of a shared memory segment created by the
+ shared_bases tool (see shared_base_vector.hpp) on a Unix domain socket,
+ until a multi_exp_shard_coordinator sends a shutdown request. Several
+ workers on a host can serve consecutive shards of one segment.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/bw6_761/bw6_761_pp.hpp"
+#include "libff/algebra/scalar_multiplication/multiexp_sharded.hpp"
+#include "libff/algebra/scalar_multiplication/shared_base_vector.hpp"
+#include "libff/common/profiling.hpp"
+
+#include <csignal>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+using namespace libff;
+
+class worker_options
+{
+public:
+    std::string shared_bases_name;
+    std::string socket_path;
+    size_t begin;
+    size_t end;
+    size_t num_chunks;
+};
+
+template<typename GroupT, multi_exp_base_form BaseForm>
+void serve_shard(
+    const worker_options &options, const shared_base_vector<GroupT> &bases)
+{
+    using FieldT = typename GroupT::scalar_field;
+    const multi_exp_shard_worker<
+        GroupT,
+        FieldT,
+        multi_exp_method_BDLO12_signed,
+        BaseForm>
+        worker(
+            bases.begin() + options.begin,
+            bases.begin() + options.end,
+            options.num_chunks);
+
+    std::cout << "Serving " << worker.num_bases() << " base elements on "
+              << options.socket_path << std::endl;
+    worker.serve(options.socket_path);
+}
+
+template<typename ppT, typename GroupT>
+void run_worker(worker_options options)
+{
+    ppT::init_public_params();
+    const shared_base_vector<GroupT> bases =
+        shared_base_vector<GroupT>::open(options.shared_bases_name);
+    options.end = std::min(options.end, bases.size());
+    if (options.begin > options.end) {
+        throw std::out_of_range("shard begins after the end of the bases");
+    }
+
+    if (bases.base_form() == multi_exp_base_form_special) {
+        serve_shard<GroupT, multi_exp_base_form_special>(options, bases);
+    } else {
+        serve_shard<GroupT, multi_exp_base_form_normal>(options, bases);
+    }
+}
+
+void usage(const char *const argv0)
+{
+    std::cout << "Usage: " << argv0 << " [flags]\n"
+              << "\n"
+              << "Flags:\n"
+              << "  --curve <curve>       One of alt_bn128, bls12_377, "
+                 "bls12_381, bw6_761\n"
+              << "  --group <group>       One of g1, g2 (default g1)\n"
+              << "  --shared-bases <name> Shared base vector holding the "
+                 "shard\n"
+              << "  --begin <i>           First base element of the shard "
+                 "(default 0)\n"
+              << "  --end <i>             End of the shard (default: end of "
+                 "the bases)\n"
+              << "  --socket <path>       Path of the socket to listen on\n"
+              << "  --chunks <n>          Chunks per request (default: "
+                 "hardware concurrency)\n";
+}
+
+int main(const int argc, char const *const *const argv)
+{
+    std::string curve;
+    std::string group = "g1";
+    worker_options options;
+    options.begin = 0;
+    options.end = std::numeric_limits<size_t>::max();
+    options.num_chunks = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 1; i < (size_t)argc; ++i) {
+        const char *const arg = argv[i];
+        if (!strcmp(arg, "--curve") && i + 1 < (size_t)argc) {
+            curve = argv[++i];
+        } else if (!strcmp(arg, "--group") && i + 1 < (size_t)argc) {
+            group = argv[++i];
+        } else if (!strcmp(arg, "--shared-bases") && i + 1 < (size_t)argc) {
+            options.shared_bases_name = argv[++i];
+        } else if (!strcmp(arg, "--begin") && i + 1 < (size_t)argc) {
+            options.begin = std::stoul(std::string(argv[++i]));
+        } else if (!strcmp(arg, "--end") && i + 1 < (size_t)argc) {
+            options.end = std::stoul(std::string(argv[++i]));
+        } else if (!strcmp(arg, "--socket") && i + 1 < (size_t)argc) {
+            options.socket_path = argv[++i];
+        } else if (!strcmp(arg, "--chunks") && i + 1 < (size_t)argc) {
+            options.num_chunks = std::stoul(std::string(argv[++i]));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.shared_bases_name.empty() || options.socket_path.empty() ||
+        (group != "g1" && group != "g2")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    inhibit_profiling_info = true;
+    signal(SIGPIPE, SIG_IGN);
+
+    const bool g1 = (group == "g1");
+    if (curve == "alt_bn128") {
+        g1 ? run_worker<alt_bn128_pp, alt_bn128_G1>(options)
+           : run_worker<alt_bn128_pp, alt_bn128_G2>(options);
+    } else if (curve == "bls12_377") {
+        g1 ? run_worker<bls12_377_pp, bls12_377_G1>(options)
+           : run_worker<bls12_377_pp, bls12_377_G2>(options);
+    } else if (curve == "bls12_381") {
+        g1 ? run_worker<bls12_381_pp, bls12_381_G1>(options)
+           : run_worker<bls12_381_pp, bls12_381_G2>(options);
+    } else if (curve == "bw6_761") {
+        g1 ? run_worker<bw6_761_pp, bw6_761_G1>(options)
+           : run_worker<bw6_761_pp, bw6_761_G2>(options);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
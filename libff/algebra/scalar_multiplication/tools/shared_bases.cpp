@@ -0,0 +1,157 @@
+/** @file
+ *****************************************************************************
+
+ Decode a file of base elements once into a named shared memory segment (see
+ shared_base_vector.hpp), which other processes on the host can then open
+ with shared_base_vector<GroupT>::open. Elements are read as binary,
+ Montgomery-form, uncompressed group elements (as written by group_write).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include "libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp"
+#include "libff/algebra/curves/bls12_377/bls12_377_pp.hpp"
+#include "libff/algebra/curves/bls12_381/bls12_381_pp.hpp"
+#include "libff/algebra/curves/bw6_761/bw6_761_pp.hpp"
+#include "libff/algebra/scalar_multiplication/shared_base_vector.hpp"
+#include "libff/common/profiling.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace libff;
+
+static const form_t FORM = form_montgomery;
+static const compression_t COMP = compression_off;
+
+template<typename ppT, typename GroupT>
+void create_shared_bases(
+    const std::string &bases_filename,
+    const std::string &name,
+    const multi_exp_base_form base_form)
+{
+    ppT::init_public_params();
+
+    // Determine the number of elements from the file size.
+    std::ostringstream element_s;
+    group_write<encoding_binary, FORM, COMP>(GroupT::one(), element_s);
+    const size_t element_size = element_s.str().size();
+
+    std::ifstream in_s(
+        bases_filename, std::ios_base::in | std::ios_base::binary);
+    if (!in_s) {
+        throw std::runtime_error("failed to open " + bases_filename);
+    }
+    in_s.seekg(0, std::ios_base::end);
+    const size_t file_size = in_s.tellg();
+    in_s.seekg(0, std::ios_base::beg);
+    if (file_size % element_size != 0) {
+        throw std::runtime_error("unexpected size of " + bases_filename);
+    }
+
+    const shared_base_vector<GroupT> bases =
+        shared_base_vector<GroupT>::template create_from_stream<
+            encoding_binary,
+            FORM,
+            COMP>(name, in_s, file_size / element_size, base_form);
+    std::cout << "Created " << name << " with " << bases.size()
+              << " base elements\n";
+}
+
+void usage(const char *const argv0)
+{
+    std::cout << "Usage: " << argv0 << " [flags]\n"
+              << "\n"
+              << "Flags:\n"
+              << "  --curve <curve>       One of alt_bn128, bls12_377, "
+                 "bls12_381, bw6_761\n"
+              << "  --group <group>       One of g1, g2 (default g1)\n"
+              << "  --bases <file>        Base elements (binary, montgomery, "
+                 "uncompressed)\n"
+              << "  --name <name>         Shared memory name (/name) or "
+                 "hugetlbfs path\n"
+              << "  --base-form <form>    One of normal, special (default "
+                 "special)\n"
+              << "  --remove              Remove the named segment\n";
+}
+
+int main(const int argc, char const *const *const argv)
+{
+    std::string curve;
+    std::string group = "g1";
+    std::string bases_filename;
+    std::string name;
+    std::string base_form = "special";
+    bool remove = false;
+
+    for (size_t i = 1; i < (size_t)argc; ++i) {
+        const char *const arg = argv[i];
+        if (!strcmp(arg, "--curve") && i + 1 < (size_t)argc) {
+            curve = argv[++i];
+        } else if (!strcmp(arg, "--group") && i + 1 < (size_t)argc) {
+            group = argv[++i];
+        } else if (!strcmp(arg, "--bases") && i + 1 < (size_t)argc) {
+            bases_filename = argv[++i];
+        } else if (!strcmp(arg, "--name") && i + 1 < (size_t)argc) {
+            name = argv[++i];
+        } else if (!strcmp(arg, "--base-form") && i + 1 < (size_t)argc) {
+            base_form = argv[++i];
+        } else if (!strcmp(arg, "--remove")) {
+            remove = true;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (name.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (remove) {
+        shared_memory_segment::remove(name);
+        return 0;
+    }
+    if (bases_filename.empty() || (group != "g1" && group != "g2") ||
+        (base_form != "normal" && base_form != "special")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    inhibit_profiling_info = true;
+
+    const multi_exp_base_form form = (base_form == "special")
+                                         ? multi_exp_base_form_special
+                                         : multi_exp_base_form_normal;
+    const bool g1 = (group == "g1");
+    if (curve == "alt_bn128") {
+        g1 ? create_shared_bases<alt_bn128_pp, alt_bn128_G1>(
+                 bases_filename, name, form)
+           : create_shared_bases<alt_bn128_pp, alt_bn128_G2>(
+                 bases_filename, name, form);
+    } else if (curve == "bls12_377") {
+        g1 ? create_shared_bases<bls12_377_pp, bls12_377_G1>(
+                 bases_filename, name, form)
+           : create_shared_bases<bls12_377_pp, bls12_377_G2>(
+                 bases_filename, name, form);
+    } else if (curve == "bls12_381") {
+        g1 ? create_shared_bases<bls12_381_pp, bls12_381_G1>(
+                 bases_filename, name, form)
+           : create_shared_bases<bls12_381_pp, bls12_381_G2>(
+                 bases_filename, name, form);
+    } else if (curve == "bw6_761") {
+        g1 ? create_shared_bases<bw6_761_pp, bw6_761_G1>(
+                 bases_filename, name, form)
+           : create_shared_bases<bw6_761_pp, bw6_761_G2>(
+                 bases_filename, name, form);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,648 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of structure-of-arrays complex vectors and their kernels.
+
+ See double_vector.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cmath>
+#include <libff/common/double_vector.hpp>
+#include <libff/common/utils.hpp>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DOUBLE_VECTOR_X86
+#include <immintrin.h>
+#endif
+
+namespace libff
+{
+
+namespace
+{
+
+const double PI = 3.141592653589793238460264338328L;
+
+/// Kernels over split real and imaginary arrays.
+struct double_vector_kernels {
+    void (*add)(
+        const double *ar,
+        const double *ai,
+        const double *br,
+        const double *bi,
+        double *rr,
+        double *ri,
+        size_t n);
+    void (*sub)(
+        const double *ar,
+        const double *ai,
+        const double *br,
+        const double *bi,
+        double *rr,
+        double *ri,
+        size_t n);
+    void (*mul)(
+        const double *ar,
+        const double *ai,
+        const double *br,
+        const double *bi,
+        double *rr,
+        double *ri,
+        size_t n);
+    void (*butterfly)(
+        double *xr,
+        double *xi,
+        double *yr,
+        double *yi,
+        const double *wr,
+        const double *wi,
+        size_t n);
+};
+
+void scalar_add(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        rr[i] = ar[i] + br[i];
+        ri[i] = ai[i] + bi[i];
+    }
+}
+
+void scalar_sub(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        rr[i] = ar[i] - br[i];
+        ri[i] = ai[i] - bi[i];
+    }
+}
+
+void scalar_mul(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const double re = ar[i] * br[i] - ai[i] * bi[i];
+        const double im = ar[i] * bi[i] + ai[i] * br[i];
+        rr[i] = re;
+        ri[i] = im;
+    }
+}
+
+void scalar_butterfly(
+    double *xr,
+    double *xi,
+    double *yr,
+    double *yi,
+    const double *wr,
+    const double *wi,
+    size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const double tr = wr[i] * yr[i] - wi[i] * yi[i];
+        const double ti = wr[i] * yi[i] + wi[i] * yr[i];
+        yr[i] = xr[i] - tr;
+        yi[i] = xi[i] - ti;
+        xr[i] = xr[i] + tr;
+        xi[i] = xi[i] + ti;
+    }
+}
+
+const double_vector_kernels scalar_kernels = {
+    scalar_add, scalar_sub, scalar_mul, scalar_butterfly};
+
+#ifdef DOUBLE_VECTOR_X86
+
+// Each kernel processes full vectors with intrinsics, and the remaining
+// elements with the scalar kernel.
+
+__attribute__((target("avx2,fma"))) void avx2_add(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d re =
+            _mm256_add_pd(_mm256_loadu_pd(ar + i), _mm256_loadu_pd(br + i));
+        const __m256d im =
+            _mm256_add_pd(_mm256_loadu_pd(ai + i), _mm256_loadu_pd(bi + i));
+        _mm256_storeu_pd(rr + i, re);
+        _mm256_storeu_pd(ri + i, im);
+    }
+    scalar_add(ar + i, ai + i, br + i, bi + i, rr + i, ri + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) void avx2_sub(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d re =
+            _mm256_sub_pd(_mm256_loadu_pd(ar + i), _mm256_loadu_pd(br + i));
+        const __m256d im =
+            _mm256_sub_pd(_mm256_loadu_pd(ai + i), _mm256_loadu_pd(bi + i));
+        _mm256_storeu_pd(rr + i, re);
+        _mm256_storeu_pd(ri + i, im);
+    }
+    scalar_sub(ar + i, ai + i, br + i, bi + i, rr + i, ri + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) void avx2_mul(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d a_re = _mm256_loadu_pd(ar + i);
+        const __m256d a_im = _mm256_loadu_pd(ai + i);
+        const __m256d b_re = _mm256_loadu_pd(br + i);
+        const __m256d b_im = _mm256_loadu_pd(bi + i);
+        const __m256d re =
+            _mm256_fmsub_pd(a_re, b_re, _mm256_mul_pd(a_im, b_im));
+        const __m256d im =
+            _mm256_fmadd_pd(a_re, b_im, _mm256_mul_pd(a_im, b_re));
+        _mm256_storeu_pd(rr + i, re);
+        _mm256_storeu_pd(ri + i, im);
+    }
+    scalar_mul(ar + i, ai + i, br + i, bi + i, rr + i, ri + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) void avx2_butterfly(
+    double *xr,
+    double *xi,
+    double *yr,
+    double *yi,
+    const double *wr,
+    const double *wi,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d w_re = _mm256_loadu_pd(wr + i);
+        const __m256d w_im = _mm256_loadu_pd(wi + i);
+        const __m256d y_re = _mm256_loadu_pd(yr + i);
+        const __m256d y_im = _mm256_loadu_pd(yi + i);
+        const __m256d x_re = _mm256_loadu_pd(xr + i);
+        const __m256d x_im = _mm256_loadu_pd(xi + i);
+        const __m256d t_re =
+            _mm256_fmsub_pd(w_re, y_re, _mm256_mul_pd(w_im, y_im));
+        const __m256d t_im =
+            _mm256_fmadd_pd(w_re, y_im, _mm256_mul_pd(w_im, y_re));
+        _mm256_storeu_pd(yr + i, _mm256_sub_pd(x_re, t_re));
+        _mm256_storeu_pd(yi + i, _mm256_sub_pd(x_im, t_im));
+        _mm256_storeu_pd(xr + i, _mm256_add_pd(x_re, t_re));
+        _mm256_storeu_pd(xi + i, _mm256_add_pd(x_im, t_im));
+    }
+    scalar_butterfly(xr + i, xi + i, yr + i, yi + i, wr + i, wi + i, n - i);
+}
+
+const double_vector_kernels avx2_kernels = {
+    avx2_add, avx2_sub, avx2_mul, avx2_butterfly};
+
+__attribute__((target("avx512f"))) void avx512_add(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d re =
+            _mm512_add_pd(_mm512_loadu_pd(ar + i), _mm512_loadu_pd(br + i));
+        const __m512d im =
+            _mm512_add_pd(_mm512_loadu_pd(ai + i), _mm512_loadu_pd(bi + i));
+        _mm512_storeu_pd(rr + i, re);
+        _mm512_storeu_pd(ri + i, im);
+    }
+    scalar_add(ar + i, ai + i, br + i, bi + i, rr + i, ri + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void avx512_sub(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d re =
+            _mm512_sub_pd(_mm512_loadu_pd(ar + i), _mm512_loadu_pd(br + i));
+        const __m512d im =
+            _mm512_sub_pd(_mm512_loadu_pd(ai + i), _mm512_loadu_pd(bi + i));
+        _mm512_storeu_pd(rr + i, re);
+        _mm512_storeu_pd(ri + i, im);
+    }
+    scalar_sub(ar + i, ai + i, br + i, bi + i, rr + i, ri + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void avx512_mul(
+    const double *ar,
+    const double *ai,
+    const double *br,
+    const double *bi,
+    double *rr,
+    double *ri,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d a_re = _mm512_loadu_pd(ar + i);
+        const __m512d a_im = _mm512_loadu_pd(ai + i);
+        const __m512d b_re = _mm512_loadu_pd(br + i);
+        const __m512d b_im = _mm512_loadu_pd(bi + i);
+        const __m512d re =
+            _mm512_fmsub_pd(a_re, b_re, _mm512_mul_pd(a_im, b_im));
+        const __m512d im =
+            _mm512_fmadd_pd(a_re, b_im, _mm512_mul_pd(a_im, b_re));
+        _mm512_storeu_pd(rr + i, re);
+        _mm512_storeu_pd(ri + i, im);
+    }
+    scalar_mul(ar + i, ai + i, br + i, bi + i, rr + i, ri + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void avx512_butterfly(
+    double *xr,
+    double *xi,
+    double *yr,
+    double *yi,
+    const double *wr,
+    const double *wi,
+    size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d w_re = _mm512_loadu_pd(wr + i);
+        const __m512d w_im = _mm512_loadu_pd(wi + i);
+        const __m512d y_re = _mm512_loadu_pd(yr + i);
+        const __m512d y_im = _mm512_loadu_pd(yi + i);
+        const __m512d x_re = _mm512_loadu_pd(xr + i);
+        const __m512d x_im = _mm512_loadu_pd(xi + i);
+        const __m512d t_re =
+            _mm512_fmsub_pd(w_re, y_re, _mm512_mul_pd(w_im, y_im));
+        const __m512d t_im =
+            _mm512_fmadd_pd(w_re, y_im, _mm512_mul_pd(w_im, y_re));
+        _mm512_storeu_pd(yr + i, _mm512_sub_pd(x_re, t_re));
+        _mm512_storeu_pd(yi + i, _mm512_sub_pd(x_im, t_im));
+        _mm512_storeu_pd(xr + i, _mm512_add_pd(x_re, t_re));
+        _mm512_storeu_pd(xi + i, _mm512_add_pd(x_im, t_im));
+    }
+    scalar_butterfly(xr + i, xi + i, yr + i, yi + i, wr + i, wi + i, n - i);
+}
+
+const double_vector_kernels avx512_kernels = {
+    avx512_add, avx512_sub, avx512_mul, avx512_butterfly};
+
+#endif // DOUBLE_VECTOR_X86
+
+const double_vector_kernels &kernels_for(const double_vector_simd level)
+{
+    switch (level) {
+#ifdef DOUBLE_VECTOR_X86
+    case double_vector_simd_avx512:
+        return avx512_kernels;
+    case double_vector_simd_avx2:
+        return avx2_kernels;
+#endif
+    default:
+        return scalar_kernels;
+    }
+}
+
+double_vector_simd detect_simd()
+{
+#ifdef DOUBLE_VECTOR_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return double_vector_simd_avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return double_vector_simd_avx2;
+    }
+#endif
+    return double_vector_simd_none;
+}
+
+double_vector_simd &current_simd()
+{
+    static double_vector_simd level = double_vector_simd_supported();
+    return level;
+}
+
+const double_vector_kernels &kernels()
+{
+    return kernels_for(current_simd());
+}
+
+void check_sizes(const double_vector &a, const double_vector &b)
+{
+    if (a.size() != b.size()) {
+        throw std::invalid_argument(
+            "libff::double_vector: mismatched vector sizes");
+    }
+}
+
+/// Twiddle tables for double_vector_fft. For each power of 2 len < max_n,
+/// entries [len, 2 * len) hold the powers of the root of order 2 * len (or
+/// its inverse), so a single table serves all sizes up to max_n.
+struct fft_twiddles {
+    size_t max_n;
+    double_vector forward;
+    double_vector inverse;
+};
+
+std::shared_ptr<const fft_twiddles> get_fft_twiddles(const size_t n)
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const fft_twiddles> cached;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cached && cached->max_n >= n) {
+        return cached;
+    }
+
+    std::shared_ptr<fft_twiddles> table = std::make_shared<fft_twiddles>();
+    table->max_n = n;
+    table->forward.resize(n);
+    table->inverse.resize(n);
+    for (size_t len = 1; len < n; len *= 2) {
+        for (size_t j = 0; j < len; ++j) {
+            const double angle = PI * j / len;
+            table->forward.real[len + j] = cos(angle);
+            table->forward.imag[len + j] = sin(angle);
+            table->inverse.real[len + j] = cos(angle);
+            table->inverse.imag[len + j] = -sin(angle);
+        }
+    }
+
+    cached = table;
+    return cached;
+}
+
+} // namespace
+
+double_vector::double_vector() {}
+
+double_vector::double_vector(const size_t n) : real(n), imag(n) {}
+
+double_vector::double_vector(const std::vector<Double> &v)
+    : real(v.size()), imag(v.size())
+{
+    for (size_t i = 0; i < v.size(); ++i) {
+        real[i] = v[i].val.real();
+        imag[i] = v[i].val.imag();
+    }
+}
+
+size_t double_vector::size() const { return real.size(); }
+
+void double_vector::resize(const size_t n)
+{
+    real.resize(n);
+    imag.resize(n);
+}
+
+Double double_vector::get(const size_t i) const
+{
+    return Double(real[i], imag[i]);
+}
+
+void double_vector::set(const size_t i, const Double &x)
+{
+    real[i] = x.val.real();
+    imag[i] = x.val.imag();
+}
+
+std::vector<Double> double_vector::to_vector() const
+{
+    std::vector<Double> result(size());
+    for (size_t i = 0; i < size(); ++i) {
+        result[i] = get(i);
+    }
+    return result;
+}
+
+double_vector double_vector::powers(const Double &g, const size_t n)
+{
+    double_vector result(n);
+    Double x = Double::one();
+    for (size_t i = 0; i < n; ++i) {
+        result.set(i, x);
+        x *= g;
+    }
+    return result;
+}
+
+double_vector double_vector::roots_of_unity(const size_t n)
+{
+    double_vector result(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double angle = 2 * PI * i / n;
+        result.real[i] = cos(angle);
+        result.imag[i] = sin(angle);
+    }
+    return result;
+}
+
+double_vector_simd double_vector_simd_supported()
+{
+    static const double_vector_simd supported = detect_simd();
+    return supported;
+}
+
+double_vector_simd double_vector_simd_level() { return current_simd(); }
+
+void set_double_vector_simd_level(const double_vector_simd level)
+{
+    if (level > double_vector_simd_supported()) {
+        throw std::invalid_argument(
+            "libff::set_double_vector_simd_level: unsupported level");
+    }
+    current_simd() = level;
+}
+
+void double_vector_add(
+    double_vector &result, const double_vector &a, const double_vector &b)
+{
+    check_sizes(a, b);
+    const size_t n = a.size();
+#ifdef PROFILE_OP_COUNTS
+    Double::add_cnt += n;
+#endif
+    result.resize(n);
+    kernels().add(
+        a.real.data(),
+        a.imag.data(),
+        b.real.data(),
+        b.imag.data(),
+        result.real.data(),
+        result.imag.data(),
+        n);
+}
+
+void double_vector_sub(
+    double_vector &result, const double_vector &a, const double_vector &b)
+{
+    check_sizes(a, b);
+    const size_t n = a.size();
+#ifdef PROFILE_OP_COUNTS
+    Double::sub_cnt += n;
+#endif
+    result.resize(n);
+    kernels().sub(
+        a.real.data(),
+        a.imag.data(),
+        b.real.data(),
+        b.imag.data(),
+        result.real.data(),
+        result.imag.data(),
+        n);
+}
+
+void double_vector_mul(
+    double_vector &result, const double_vector &a, const double_vector &b)
+{
+    check_sizes(a, b);
+    const size_t n = a.size();
+#ifdef PROFILE_OP_COUNTS
+    Double::mul_cnt += n;
+#endif
+    result.resize(n);
+    kernels().mul(
+        a.real.data(),
+        a.imag.data(),
+        b.real.data(),
+        b.imag.data(),
+        result.real.data(),
+        result.imag.data(),
+        n);
+}
+
+void double_vector_butterfly(
+    double_vector &a,
+    const size_t lo,
+    const size_t hi,
+    const size_t n,
+    const double_vector &twiddles,
+    const size_t twiddle_offset)
+{
+    if (lo + n > a.size() || hi + n > a.size() ||
+        twiddle_offset + n > twiddles.size()) {
+        throw std::invalid_argument(
+            "libff::double_vector_butterfly: range out of bounds");
+    }
+    if (lo < hi + n && hi < lo + n) {
+        throw std::invalid_argument(
+            "libff::double_vector_butterfly: overlapping ranges");
+    }
+#ifdef PROFILE_OP_COUNTS
+    Double::add_cnt += n;
+    Double::sub_cnt += n;
+    Double::mul_cnt += n;
+#endif
+    kernels().butterfly(
+        a.real.data() + lo,
+        a.imag.data() + lo,
+        a.real.data() + hi,
+        a.imag.data() + hi,
+        twiddles.real.data() + twiddle_offset,
+        twiddles.imag.data() + twiddle_offset,
+        n);
+}
+
+void double_vector_fft(double_vector &a, const bool inverse)
+{
+    const size_t n = a.size();
+    const size_t log_n = log2(n);
+    if (n != ((size_t)1 << log_n)) {
+        throw std::invalid_argument(
+            "libff::double_vector_fft: expected a power of 2 size");
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j = bitreverse(i, log_n);
+        if (i < j) {
+            std::swap(a.real[i], a.real[j]);
+            std::swap(a.imag[i], a.imag[j]);
+        }
+    }
+
+    const std::shared_ptr<const fft_twiddles> table = get_fft_twiddles(n);
+    const double_vector &twiddles = inverse ? table->inverse : table->forward;
+    const double_vector_kernels &k = kernels();
+    for (size_t len = 1; len < n; len *= 2) {
+        // Butterflies of each block use the contiguous twiddles at offset
+        // len. Blocks are independent.
+        const size_t num_blocks = n / (2 * len);
+#ifdef MULTICORE
+#pragma omp parallel for if (n >= 4096)
+#endif
+        for (size_t b = 0; b < num_blocks; ++b) {
+            const size_t lo = 2 * len * b;
+            k.butterfly(
+                a.real.data() + lo,
+                a.imag.data() + lo,
+                a.real.data() + lo + len,
+                a.imag.data() + lo + len,
+                twiddles.real.data() + len,
+                twiddles.imag.data() + len,
+                len);
+        }
+    }
+
+    if (inverse) {
+        const double n_inv = 1.0 / n;
+        for (size_t i = 0; i < n; ++i) {
+            a.real[i] *= n_inv;
+            a.imag[i] *= n_inv;
+        }
+    }
+}
+
+} // namespace libff
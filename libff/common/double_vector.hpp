@@ -0,0 +1,115 @@
+/** @file
+ *****************************************************************************
+
+ Structure-of-arrays vectors of complex values (see double.hpp), with bulk
+ arithmetic kernels for complex-domain FFTs.
+
+ A std::vector<Double> interleaves real and imaginary parts, and arithmetic
+ is performed one element at a time through Double's operators. double_vector
+ instead holds the real and imaginary parts in separate contiguous arrays, so
+ that the kernels below process 4 (AVX2) or 8 (AVX-512) complex values per
+ instruction using fused multiply-add.
+
+ The kernels are compiled for each instruction set independently of the
+ compiler flags, and the widest one supported by the CPU is selected at run
+ time (see double_vector_simd_level). On other architectures, only the scalar
+ kernels are available. Results may differ from Double's operators in the
+ last bits, since fused multiply-add rounds once rather than twice.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef DOUBLE_VECTOR_HPP_
+#define DOUBLE_VECTOR_HPP_
+
+#include <cstddef>
+#include <libff/common/double.hpp>
+#include <vector>
+
+namespace libff
+{
+
+class double_vector
+{
+public:
+    std::vector<double> real;
+    std::vector<double> imag;
+
+    double_vector();
+    explicit double_vector(const size_t n);
+    explicit double_vector(const std::vector<Double> &v);
+
+    size_t size() const;
+    void resize(const size_t n);
+
+    Double get(const size_t i) const;
+    void set(const size_t i, const Double &x);
+
+    std::vector<Double> to_vector() const;
+
+    /// The values g^0, g^1, ..., g^(n-1), computed by repeated
+    /// multiplication.
+    static double_vector powers(const Double &g, const size_t n);
+
+    /// The values omega^0, omega^1, ..., omega^(n-1), where omega =
+    /// get_root_of_unity<Double>(n). Each value is computed directly (rather
+    /// than by repeated multiplication), so there is no accumulated error.
+    static double_vector roots_of_unity(const size_t n);
+};
+
+/// Instruction sets for which double_vector kernels are available.
+enum double_vector_simd {
+    double_vector_simd_none,
+    double_vector_simd_avx2,
+    double_vector_simd_avx512,
+};
+
+/// The widest instruction set supported by this CPU.
+double_vector_simd double_vector_simd_supported();
+
+/// The instruction set currently used by the kernels (initially
+/// double_vector_simd_supported()).
+double_vector_simd double_vector_simd_level();
+
+/// Select the instruction set used by the kernels (for testing and
+/// benchmarking). Throws std::invalid_argument if the level is not supported.
+void set_double_vector_simd_level(const double_vector_simd level);
+
+/// result[i] = a[i] + b[i]. result may alias a or b. Throws
+/// std::invalid_argument if the sizes of a and b differ.
+void double_vector_add(
+    double_vector &result, const double_vector &a, const double_vector &b);
+
+/// result[i] = a[i] - b[i].
+void double_vector_sub(
+    double_vector &result, const double_vector &a, const double_vector &b);
+
+/// result[i] = a[i] * b[i].
+void double_vector_mul(
+    double_vector &result, const double_vector &a, const double_vector &b);
+
+/// Radix-2 butterflies with twiddle multiplication: for 0 <= i < n,
+///     t = twiddles[twiddle_offset + i] * a[hi + i]
+///     a[hi + i] = a[lo + i] - t
+///     a[lo + i] = a[lo + i] + t
+/// The ranges [lo, lo + n) and [hi, hi + n) must not overlap.
+void double_vector_butterfly(
+    double_vector &a,
+    const size_t lo,
+    const size_t hi,
+    const size_t n,
+    const double_vector &twiddles,
+    const size_t twiddle_offset);
+
+/// In-place FFT of a (whose size must be a power of 2) over the powers of
+/// omega = get_root_of_unity<Double>(n), i.e. A_k = \sum_j a_j omega^(j * k),
+/// with input and output in natural order. The inverse transform uses
+/// omega^-1 and scales by 1/n.
+void double_vector_fft(double_vector &a, const bool inverse = false);
+
+} // namespace libff
+
+#endif // DOUBLE_VECTOR_HPP_
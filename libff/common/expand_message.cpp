@@ -0,0 +1,135 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of expand_message_xmd.
+
+ See expand_message.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/common/expand_message.hpp>
+#include <openssl/evp.h>
+#include <stdexcept>
+
+namespace libff
+{
+
+namespace
+{
+
+const size_t SHA256_OUTPUT_BYTES = 32;
+const size_t SHA256_BLOCK_BYTES = 64;
+
+/// Incremental SHA-256, via the EVP interface (the low-level SHA256_*
+/// functions are deprecated in OpenSSL 3).
+class sha256_hasher
+{
+public:
+    sha256_hasher() : _ctx(EVP_MD_CTX_new())
+    {
+        if (_ctx == nullptr ||
+            EVP_DigestInit_ex(_ctx, EVP_sha256(), nullptr) != 1) {
+            EVP_MD_CTX_free(_ctx);
+            throw std::runtime_error("libff::expand_message: SHA-256 failed");
+        }
+    }
+
+    ~sha256_hasher() { EVP_MD_CTX_free(_ctx); }
+
+    sha256_hasher(const sha256_hasher &) = delete;
+    sha256_hasher &operator=(const sha256_hasher &) = delete;
+
+    void update(const uint8_t *data, const size_t size)
+    {
+        if (EVP_DigestUpdate(_ctx, data, size) != 1) {
+            throw std::runtime_error("libff::expand_message: SHA-256 failed");
+        }
+    }
+
+    void update_byte(const uint8_t byte) { update(&byte, 1); }
+
+    void final(uint8_t *out)
+    {
+        if (EVP_DigestFinal_ex(_ctx, out, nullptr) != 1) {
+            throw std::runtime_error("libff::expand_message: SHA-256 failed");
+        }
+    }
+
+private:
+    EVP_MD_CTX *_ctx;
+};
+
+} // namespace
+
+std::vector<uint8_t> expand_message_xmd_sha256(
+    const uint8_t *msg,
+    const size_t msg_len,
+    const std::string &dst,
+    const size_t len_in_bytes)
+{
+    const size_t ell =
+        (len_in_bytes + SHA256_OUTPUT_BYTES - 1) / SHA256_OUTPUT_BYTES;
+    if (ell > 255 || len_in_bytes > 65535) {
+        throw std::invalid_argument(
+            "libff::expand_message_xmd_sha256: len_in_bytes too large");
+    }
+    if (dst.size() > 255) {
+        throw std::invalid_argument(
+            "libff::expand_message_xmd_sha256: dst too long");
+    }
+
+    // DST_prime = DST || I2OSP(len(DST), 1)
+    std::vector<uint8_t> dst_prime(dst.begin(), dst.end());
+    dst_prime.push_back((uint8_t)dst.size());
+
+    // b_0 = H(Z_pad || msg || I2OSP(len_in_bytes, 2) || I2OSP(0, 1) ||
+    //         DST_prime)
+    uint8_t b_0[SHA256_OUTPUT_BYTES];
+    {
+        const uint8_t z_pad[SHA256_BLOCK_BYTES] = {0};
+        sha256_hasher h;
+        h.update(z_pad, sizeof(z_pad));
+        h.update(msg, msg_len);
+        h.update_byte((uint8_t)(len_in_bytes >> 8));
+        h.update_byte((uint8_t)len_in_bytes);
+        h.update_byte(0);
+        h.update(dst_prime.data(), dst_prime.size());
+        h.final(b_0);
+    }
+
+    // b_1 = H(b_0 || I2OSP(1, 1) || DST_prime)
+    // b_i = H(strxor(b_0, b_(i - 1)) || I2OSP(i, 1) || DST_prime)
+    std::vector<uint8_t> uniform_bytes(ell * SHA256_OUTPUT_BYTES);
+    uint8_t block[SHA256_OUTPUT_BYTES];
+    for (size_t i = 1; i <= ell; ++i) {
+        uint8_t *const b_i = &uniform_bytes[(i - 1) * SHA256_OUTPUT_BYTES];
+        for (size_t j = 0; j < SHA256_OUTPUT_BYTES; ++j) {
+            block[j] = b_0[j];
+            if (i > 1) {
+                block[j] ^= (b_i - SHA256_OUTPUT_BYTES)[j];
+            }
+        }
+
+        sha256_hasher h;
+        h.update(block, sizeof(block));
+        h.update_byte((uint8_t)i);
+        h.update(dst_prime.data(), dst_prime.size());
+        h.final(b_i);
+    }
+
+    uniform_bytes.resize(len_in_bytes);
+    return uniform_bytes;
+}
+
+std::vector<uint8_t> expand_message_xmd_sha256(
+    const std::string &msg, const std::string &dst, const size_t len_in_bytes)
+{
+    return expand_message_xmd_sha256(
+        (const uint8_t *)msg.data(), msg.size(), dst, len_in_bytes);
+}
+
+} // namespace libff
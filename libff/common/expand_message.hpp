@@ -0,0 +1,39 @@
+/** @file
+ *****************************************************************************
+
+ expand_message_xmd (RFC 9380, Section 5.3.1) instantiated with SHA-256, as
+ used by the hash_to_field step of hash-to-curve suites.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef EXPAND_MESSAGE_HPP_
+#define EXPAND_MESSAGE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace libff
+{
+
+/// Expand msg (of msg_len bytes) to len_in_bytes uniformly random bytes,
+/// using the domain separation tag dst. Throws std::invalid_argument if
+/// len_in_bytes > 8160 (255 SHA-256 blocks) or if dst is longer than 255
+/// bytes.
+std::vector<uint8_t> expand_message_xmd_sha256(
+    const uint8_t *msg,
+    const size_t msg_len,
+    const std::string &dst,
+    const size_t len_in_bytes);
+
+std::vector<uint8_t> expand_message_xmd_sha256(
+    const std::string &msg, const std::string &dst, const size_t len_in_bytes);
+
+} // namespace libff
+
+#endif // EXPAND_MESSAGE_HPP_
@@ -0,0 +1,167 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of named shared memory segments.
+
+ See shared_memory.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <libff/common/shared_memory.hpp>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+namespace libff
+{
+
+static std::runtime_error shared_memory_error(const std::string &what)
+{
+    return std::runtime_error(what + ": " + strerror(errno));
+}
+
+/// True for names referring to POSIX shared memory objects, false for file
+/// paths.
+static bool is_shm_name(const std::string &name)
+{
+    return name.size() > 1 && name[0] == '/' &&
+           name.find('/', 1) == std::string::npos;
+}
+
+static int shared_memory_open_fd(const std::string &name, int flags)
+{
+    const mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+    const int fd = is_shm_name(name) ? shm_open(name.c_str(), flags, mode)
+                                     : ::open(name.c_str(), flags, mode);
+    if (fd < 0) {
+        const std::string action = (flags & O_CREAT) ? "create" : "open";
+        throw shared_memory_error(
+            "failed to " + action + " shared memory " + name);
+    }
+    return fd;
+}
+
+shared_memory_segment::shared_memory_segment()
+    : _data(nullptr), _size(0), _writable(false)
+{
+}
+
+shared_memory_segment::shared_memory_segment(
+    void *data, size_t size, bool writable)
+    : _data(data), _size(size), _writable(writable)
+{
+}
+
+shared_memory_segment::shared_memory_segment(shared_memory_segment &&other)
+    : _data(other._data), _size(other._size), _writable(other._writable)
+{
+    other._data = nullptr;
+    other._size = 0;
+}
+
+shared_memory_segment &shared_memory_segment::operator=(
+    shared_memory_segment &&other)
+{
+    if (this != &other) {
+        if (_data != nullptr) {
+            munmap(_data, _size);
+        }
+        _data = other._data;
+        _size = other._size;
+        _writable = other._writable;
+        other._data = nullptr;
+        other._size = 0;
+    }
+    return *this;
+}
+
+shared_memory_segment::~shared_memory_segment()
+{
+    if (_data != nullptr) {
+        munmap(_data, _size);
+    }
+}
+
+shared_memory_segment shared_memory_segment::create(
+    const std::string &name, size_t size)
+{
+    // O_EXCL: never replace (or, for a file path, truncate) an existing
+    // segment or file, which other processes may be using.
+    const int fd = shared_memory_open_fd(name, O_RDWR | O_CREAT | O_EXCL);
+
+    // hugetlbfs requires the size to be a multiple of the huge page size,
+    // which it reports as the block size.
+    if (!is_shm_name(name)) {
+        struct statvfs fs;
+        if (fstatvfs(fd, &fs) == 0 && fs.f_bsize > 0) {
+            size = (size + fs.f_bsize - 1) / fs.f_bsize * fs.f_bsize;
+        }
+    }
+
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        remove(name);
+        throw shared_memory_error("failed to resize shared memory " + name);
+    }
+
+    void *data =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        remove(name);
+        throw shared_memory_error("failed to map shared memory " + name);
+    }
+
+    return shared_memory_segment(data, size, true);
+}
+
+shared_memory_segment shared_memory_segment::open(const std::string &name)
+{
+    const int fd = shared_memory_open_fd(name, O_RDONLY);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw shared_memory_error("failed to stat shared memory " + name);
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        throw std::runtime_error("empty shared memory segment " + name);
+    }
+
+    const size_t size = st.st_size;
+    void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw shared_memory_error("failed to map shared memory " + name);
+    }
+
+    return shared_memory_segment(data, size, false);
+}
+
+void shared_memory_segment::remove(const std::string &name)
+{
+    if (is_shm_name(name)) {
+        shm_unlink(name.c_str());
+    } else {
+        unlink(name.c_str());
+    }
+}
+
+void *shared_memory_segment::data() { return _data; }
+
+const void *shared_memory_segment::data() const { return _data; }
+
+size_t shared_memory_segment::size() const { return _size; }
+
+bool shared_memory_segment::writable() const { return _writable; }
+
+} // namespace libff
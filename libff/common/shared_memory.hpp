@@ -0,0 +1,71 @@
+/** @file
+ *****************************************************************************
+
+ Named memory segments shared between processes on the same host.
+
+ A segment name of the form "/name" (a single leading slash and no other
+ slashes) refers to a POSIX shared memory object (see shm_open(3)). Any other
+ name is treated as the path of a file, typically on a hugetlbfs mount (e.g.
+ /dev/hugepages/name), in which case the segment is backed by huge pages. The
+ size of file-backed segments is rounded up to the block size of the
+ filesystem (the huge page size on hugetlbfs).
+
+ All functions throw std::runtime_error on failure.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef __LIBFF_COMMON_SHARED_MEMORY_HPP__
+#define __LIBFF_COMMON_SHARED_MEMORY_HPP__
+
+#include <cstddef>
+#include <string>
+
+namespace libff
+{
+
+/// A mapping of a named shared memory segment into the address space of this
+/// process. The mapping is released on destruction, but the segment itself
+/// persists until shared_memory_segment::remove is called.
+class shared_memory_segment
+{
+public:
+    shared_memory_segment();
+    shared_memory_segment(shared_memory_segment &&other);
+    shared_memory_segment &operator=(shared_memory_segment &&other);
+    shared_memory_segment(const shared_memory_segment &) = delete;
+    shared_memory_segment &operator=(const shared_memory_segment &) = delete;
+    ~shared_memory_segment();
+
+    /// Create a segment of (at least) size bytes, mapped read-write. Fails if
+    /// a segment (or file) with the same name already exists: stale segments
+    /// must be removed explicitly with remove().
+    static shared_memory_segment create(const std::string &name, size_t size);
+
+    /// Map an existing segment read-only.
+    static shared_memory_segment open(const std::string &name);
+
+    /// Remove the named segment. Existing mappings remain valid.
+    static void remove(const std::string &name);
+
+    /// Segments returned by open() are mapped read-only, and must not be
+    /// written through data().
+    void *data();
+    const void *data() const;
+    size_t size() const;
+    bool writable() const;
+
+protected:
+    shared_memory_segment(void *data, size_t size, bool writable);
+
+    void *_data;
+    size_t _size;
+    bool _writable;
+};
+
+} // namespace libff
+
+#endif // __LIBFF_COMMON_SHARED_MEMORY_HPP__
@@ -6,9 +6,14 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include "libff/algebra/fields/field_utils.hpp"
 #include "libff/common/concurrent_fifo.hpp"
+#include "libff/common/double_vector.hpp"
+#include "libff/common/expand_message.hpp"
 
 #include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
 #include <thread>
 
 using namespace libff;
@@ -149,4 +154,118 @@ TEST(CommonTests, ConcurrentBufferFifoTest)
     test_concurrent_buffer_fifo(32, 256, 1024 * 1024);
 }
 
+void test_double_vector_kernels(const size_t n)
+{
+    const double_vector a(std::vector<Double>(n, Double(0.5, -1.25)));
+    double_vector b = double_vector::powers(Double(0.75, 0.5), n);
+    double_vector twiddles = double_vector::roots_of_unity(2 * n);
+
+    double_vector sum;
+    double_vector diff;
+    double_vector prod;
+    double_vector_add(sum, a, b);
+    double_vector_sub(diff, a, b);
+    double_vector_mul(prod, a, b);
+
+    double_vector butterflies(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        butterflies.set(i, a.get(i));
+        butterflies.set(n + i, b.get(i));
+    }
+    double_vector_butterfly(butterflies, 0, n, n, twiddles, n);
+
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(a.get(i) + b.get(i), sum.get(i));
+        ASSERT_EQ(a.get(i) - b.get(i), diff.get(i));
+        ASSERT_EQ(a.get(i) * b.get(i), prod.get(i));
+
+        const Double t = twiddles.get(n + i) * b.get(i);
+        ASSERT_EQ(a.get(i) + t, butterflies.get(i));
+        ASSERT_EQ(a.get(i) - t, butterflies.get(n + i));
+    }
+
+    // Results may alias the inputs.
+    double_vector_mul(b, a, b);
+    ASSERT_EQ(prod.to_vector(), b.to_vector());
+}
+
+void test_double_vector_fft(const size_t n)
+{
+    std::vector<Double> a(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = Double((double)(i % 7), (double)(i % 3) - 1);
+    }
+
+    double_vector values(a);
+    double_vector_fft(values);
+
+    const Double omega = get_root_of_unity<Double>(n);
+    const double_vector roots = double_vector::roots_of_unity(n);
+    for (size_t k = 0; k < n; ++k) {
+        Double expect = Double::zero();
+        for (size_t j = 0; j < n; ++j) {
+            expect += a[j] * roots.get((j * k) % n);
+        }
+        ASSERT_EQ(expect, values.get(k));
+        ASSERT_EQ(omega ^ k, roots.get(k));
+    }
+
+    double_vector_fft(values, true);
+    ASSERT_EQ(a, values.to_vector());
+}
+
+TEST(CommonTests, DoubleVectorTest)
+{
+    const double_vector_simd supported = double_vector_simd_supported();
+    for (int level = double_vector_simd_none; level <= supported; ++level) {
+        set_double_vector_simd_level((double_vector_simd)level);
+        for (size_t n : {0, 1, 3, 8, 37, 1024}) {
+            test_double_vector_kernels(n);
+        }
+        for (size_t n = 1; n <= 256; n *= 2) {
+            test_double_vector_fft(n);
+        }
+    }
+    set_double_vector_simd_level(supported);
+
+    double_vector a(4);
+    double_vector b(5);
+    ASSERT_THROW(double_vector_add(a, a, b), std::invalid_argument);
+    ASSERT_THROW(
+        double_vector_butterfly(a, 0, 1, 2, a, 0), std::invalid_argument);
+    ASSERT_THROW(double_vector_fft(b), std::invalid_argument);
+}
+
+std::string to_hex(const std::vector<uint8_t> &bytes)
+{
+    std::ostringstream ss;
+    for (const uint8_t b : bytes) {
+        ss << std::hex << std::setw(2) << std::setfill('0') << (unsigned)b;
+    }
+    return ss.str();
+}
+
+TEST(CommonTests, ExpandMessageXmdTest)
+{
+    // Test vectors from RFC 9380, Appendix K.1.
+    const std::string dst = "QUUX-V01-CS02-with-expander-SHA256-128";
+    ASSERT_EQ(
+        "d8ccab23b5985ccea865c6c97b6e5b8350e794e603b4b97902f53a8a0d605615",
+        to_hex(expand_message_xmd_sha256("abc", dst, 0x20)));
+    ASSERT_EQ(
+        "af84c27ccfd45d41914fdff5df25293e221afc53d8ad2ac06d5e3e29485dadbe"
+        "e0d121587713a3e0dd4d5e69e93eb7cd4f5df4cd103e188cf60cb02edc3edf18"
+        "eda8576c412b18ffb658e3dd6ec849469b979d444cf7b26911a08e63cf31f9dc"
+        "c541708d3491184472c2c29bb749d4286b004ceb5ee6b9a7fa5b646c993f0ced",
+        to_hex(expand_message_xmd_sha256("", dst, 0x80)));
+    ASSERT_EQ(5u, expand_message_xmd_sha256("abc", dst, 5).size());
+
+    ASSERT_THROW(
+        expand_message_xmd_sha256("abc", dst, 255 * 32 + 1),
+        std::invalid_argument);
+    ASSERT_THROW(
+        expand_message_xmd_sha256("abc", std::string(256, 'a'), 32),
+        std::invalid_argument);
+}
+
 } // namespace
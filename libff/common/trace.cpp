@@ -0,0 +1,228 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the operation tracing runtime.
+
+ See trace.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifdef TRACE_OPS
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <libff/common/concurrent_fifo.hpp>
+#include <libff/common/trace.hpp>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace libff
+{
+
+namespace internal
+{
+
+thread_local size_t trace_point_op_depth = 0;
+thread_local size_t trace_multi_exp_depth = 0;
+
+} // namespace internal
+
+namespace
+{
+
+/// Number of records buffered per thread before producers must wait for the
+/// writer.
+static const size_t TRACE_BUFFER_CAPACITY = 4096;
+
+using trace_buffer = concurrent_fifo_spsc<trace_record>;
+
+class trace_state
+{
+public:
+    /// Serializes trace_start and trace_stop.
+    std::mutex control_mutex;
+
+    /// Guards buffers. Buffers are registered the first time a thread writes
+    /// a record, and are never freed, since the thread may still hold them.
+    std::mutex buffers_mutex;
+    std::vector<trace_buffer *> buffers;
+
+    std::atomic<uint32_t> categories{0};
+    std::atomic<bool> writer_active{false};
+    std::atomic<uint64_t> sequence{0};
+    FILE *file = nullptr;
+    std::thread writer;
+};
+
+trace_state &get_trace_state()
+{
+    // Never destroyed, so that it remains valid for threads still running
+    // during static destruction.
+    static trace_state *state = new trace_state();
+    return *state;
+}
+
+thread_local trace_buffer *trace_thread_buffer = nullptr;
+thread_local uint32_t trace_thread_index = 0;
+
+void trace_register_thread(trace_state &state)
+{
+    std::lock_guard<std::mutex> lock(state.buffers_mutex);
+    trace_thread_buffer = new trace_buffer(TRACE_BUFFER_CAPACITY);
+    trace_thread_index = (uint32_t)state.buffers.size();
+    state.buffers.push_back(trace_thread_buffer);
+}
+
+std::vector<trace_buffer *> trace_get_buffers(trace_state &state)
+{
+    std::lock_guard<std::mutex> lock(state.buffers_mutex);
+    return state.buffers;
+}
+
+/// Consume all available records from all buffers, writing them to file if
+/// it is not null. Returns the number of records consumed.
+size_t trace_drain(trace_state &state, FILE *file)
+{
+    size_t num_records = 0;
+    for (trace_buffer *buffer : trace_get_buffers(state)) {
+        const trace_record *record = buffer->try_dequeue_begin();
+        while (record != nullptr) {
+            if (file != nullptr) {
+                fwrite(record, sizeof(trace_record), 1, file);
+            }
+            buffer->dequeue_end();
+            ++num_records;
+            record = buffer->try_dequeue_begin();
+        }
+    }
+    return num_records;
+}
+
+void trace_writer_loop(trace_state *state)
+{
+    for (;;) {
+        const bool active =
+            state->writer_active.load(std::memory_order_acquire);
+        if (trace_drain(*state, state->file) == 0) {
+            if (!active) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void trace_stop_at_exit() { trace_stop(); }
+
+class trace_auto_start
+{
+public:
+    trace_auto_start()
+    {
+        const char *filename = getenv("LIBFF_TRACE_FILE");
+        if (filename != nullptr && filename[0] != '\0') {
+            trace_start(filename);
+        }
+    }
+};
+
+static trace_auto_start auto_start;
+
+} // namespace
+
+void trace_start(const std::string &filename, uint32_t categories)
+{
+    trace_stop();
+
+    trace_state &state = get_trace_state();
+    std::lock_guard<std::mutex> lock(state.control_mutex);
+
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("failed to open trace file: " + filename);
+    }
+
+    trace_file_header header;
+    memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FILE_VERSION;
+    header.record_size = sizeof(trace_record);
+    fwrite(&header, sizeof(header), 1, file);
+
+    // Discard records from producers which raced with a previous trace_stop.
+    trace_drain(state, nullptr);
+
+    static bool registered_at_exit = false;
+    if (!registered_at_exit) {
+        atexit(trace_stop_at_exit);
+        registered_at_exit = true;
+    }
+
+    state.file = file;
+    state.sequence.store(0, std::memory_order_relaxed);
+    state.writer_active.store(true, std::memory_order_release);
+    state.writer = std::thread(trace_writer_loop, &state);
+    state.categories.store(categories, std::memory_order_release);
+}
+
+void trace_stop()
+{
+    trace_state &state = get_trace_state();
+    std::lock_guard<std::mutex> lock(state.control_mutex);
+    if (state.file == nullptr) {
+        return;
+    }
+
+    state.categories.store(0, std::memory_order_release);
+    state.writer_active.store(false, std::memory_order_release);
+    state.writer.join();
+
+    fclose(state.file);
+    state.file = nullptr;
+}
+
+uint32_t trace_active_categories()
+{
+    return get_trace_state().categories.load(std::memory_order_relaxed);
+}
+
+void trace_write(
+    trace_event_t event, trace_type_t type, const void *data, size_t size)
+{
+    trace_state &state = get_trace_state();
+    if (trace_thread_buffer == nullptr) {
+        trace_register_thread(state);
+    }
+
+    trace_record *record = trace_thread_buffer->try_enqueue_begin();
+    while (record == nullptr) {
+        // Drop the record, rather than wait forever, if the writer has gone.
+        if (!state.writer_active.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::this_thread::yield();
+        record = trace_thread_buffer->try_enqueue_begin();
+    }
+
+    size = std::min(size, TRACE_PAYLOAD_SIZE);
+    record->event = event;
+    record->type = type;
+    record->size = (uint16_t)size;
+    record->thread = trace_thread_index;
+    record->sequence = state.sequence.fetch_add(1, std::memory_order_relaxed);
+    memcpy(record->payload, data, size);
+    memset(record->payload + size, 0, TRACE_PAYLOAD_SIZE - size);
+    trace_thread_buffer->enqueue_end();
+}
+
+} // namespace libff
+
+#endif // TRACE_OPS
@@ -0,0 +1,252 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of the operation tracing interface.
+
+ When compiled with TRACE_OPS, group operations (add, mixed_add, dbl) and
+ multi-exponentiations record their inputs and outputs as fixed-size binary
+ records. Records are written to per-thread lock-free ring buffers, which are
+ drained to a file by a background writer thread. Without TRACE_OPS, the
+ LIBFF_TRACE_* macros expand to nothing and no code is generated.
+
+ Recording starts automatically if the LIBFF_TRACE_FILE environment variable
+ is set, or explicitly via trace_start().
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef __LIBFF_COMMON_TRACE_HPP__
+#define __LIBFF_COMMON_TRACE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace libff
+{
+
+/// Identifies the type of the element carried in a trace_record.
+enum trace_type_t : uint8_t {
+    trace_type_unknown = 0,
+    trace_type_alt_bn128_G1,
+    trace_type_alt_bn128_G2,
+    trace_type_bls12_377_G1,
+    trace_type_bls12_377_G2,
+    trace_type_bls12_381_G1,
+    trace_type_bls12_381_G2,
+    trace_type_bn128_G1,
+    trace_type_bn128_G2,
+    trace_type_bw6_761_G1,
+    trace_type_bw6_761_G2,
+    trace_type_edwards_G1,
+    trace_type_edwards_G2,
+    trace_type_mnt4_G1,
+    trace_type_mnt4_G2,
+    trace_type_mnt6_G1,
+    trace_type_mnt6_G2,
+};
+
+enum trace_event_t : uint8_t {
+    trace_event_add_in = 0,
+    trace_event_add_out,
+    trace_event_mixed_add_in,
+    trace_event_mixed_add_out,
+    trace_event_dbl_in,
+    trace_event_dbl_out,
+    /// Payload is a trace_multi_exp_info. Followed by num_entries
+    /// trace_event_msm_base records, num_entries trace_event_msm_scalar
+    /// records and a single trace_event_msm_result.
+    trace_event_msm_begin,
+    trace_event_msm_base,
+    trace_event_msm_scalar,
+    trace_event_msm_result,
+};
+
+/// Categories of events, used as a bit mask to select what is recorded.
+enum trace_category_t : uint32_t {
+    trace_category_point_ops = 1u << 0,
+    trace_category_multi_exp = 1u << 1,
+    trace_category_all = trace_category_point_ops | trace_category_multi_exp,
+};
+
+/// Large enough for the largest group element (mnt6_G2).
+static const size_t TRACE_PAYLOAD_SIZE = 368;
+
+/// A single trace record. Group and field elements are stored in their
+/// in-memory (Montgomery) representation, so trace files are only meaningful
+/// to binaries built for the same architecture.
+struct trace_record {
+    uint8_t event;
+    uint8_t type;
+    uint16_t size;
+    uint32_t thread;
+    uint64_t sequence;
+    uint8_t payload[TRACE_PAYLOAD_SIZE];
+};
+
+static_assert(sizeof(trace_record) == 384, "unexpected trace_record padding");
+
+/// Payload of trace_event_msm_begin records. method and base_form hold the
+/// multi_exp_method and multi_exp_base_form template parameters.
+struct trace_multi_exp_info {
+    uint64_t num_entries;
+    uint32_t method;
+    uint32_t base_form;
+    uint64_t chunks;
+};
+
+/// Trace files consist of this header followed by trace_records.
+struct trace_file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+static const char TRACE_FILE_MAGIC[8] = {
+    'L', 'I', 'B', 'F', 'F', 'T', 'R', 'C'};
+static const uint32_t TRACE_FILE_VERSION = 1;
+
+/// Maps group types to trace_type_t. Specialized for each group via
+/// LIBFF_TRACE_DECLARE_TYPE.
+template<typename T> class trace_type
+{
+public:
+    static const trace_type_t id = trace_type_unknown;
+};
+
+#define LIBFF_TRACE_DECLARE_TYPE(T)                                            \
+    template<> class trace_type<T>                                             \
+    {                                                                          \
+    public:                                                                    \
+        static const trace_type_t id = trace_type_##T;                         \
+    }
+
+#ifdef TRACE_OPS
+
+/// Start recording events in the given categories to filename, replacing any
+/// active trace. Throws std::runtime_error if the file cannot be opened.
+void trace_start(
+    const std::string &filename, uint32_t categories = trace_category_all);
+
+/// Stop recording, drain all buffered records and close the file.
+void trace_stop();
+
+/// Bit mask of categories currently being recorded (0 if not recording).
+uint32_t trace_active_categories();
+
+/// Append a record to the calling thread's buffer. data is truncated to
+/// TRACE_PAYLOAD_SIZE.
+void trace_write(
+    trace_event_t event, trace_type_t type, const void *data, size_t size);
+
+namespace internal
+{
+
+/// Nesting depths on the current thread. Only the outermost operation is
+/// recorded, and point operations are not recorded inside multi-exps.
+extern thread_local size_t trace_point_op_depth;
+extern thread_local size_t trace_multi_exp_depth;
+
+template<typename T>
+void trace_write_element(trace_event_t event, trace_type_t type, const T &v)
+{
+    static_assert(sizeof(T) <= TRACE_PAYLOAD_SIZE, "element too large");
+    trace_write(event, type, &v, sizeof(T));
+}
+
+template<typename GroupT> class trace_point_op_scope
+{
+public:
+    trace_point_op_scope(trace_event_t event_in, const GroupT &a);
+    trace_point_op_scope(
+        trace_event_t event_in, const GroupT &a, const GroupT &b);
+    ~trace_point_op_scope();
+
+    /// Record the result of the operation, and return it.
+    GroupT output(GroupT result) const;
+
+protected:
+    static bool enter();
+
+    trace_event_t _event_out;
+    bool _active;
+};
+
+template<typename GroupT, typename FieldT> class trace_multi_exp_scope
+{
+public:
+    template<typename BaseIterator>
+    trace_multi_exp_scope(
+        BaseIterator vec_start,
+        BaseIterator vec_end,
+        typename std::vector<FieldT>::const_iterator scalar_start,
+        uint32_t method,
+        uint32_t base_form,
+        size_t chunks);
+    ~trace_multi_exp_scope();
+
+    /// Record the result of the multi-exp, and return it.
+    GroupT output(GroupT result) const;
+
+protected:
+    bool _active;
+};
+
+/// Marks code running on behalf of a multi-exp on another thread, so that
+/// point operations there are not recorded.
+class trace_multi_exp_inner_scope
+{
+public:
+    trace_multi_exp_inner_scope() { ++trace_multi_exp_depth; }
+    ~trace_multi_exp_inner_scope() { --trace_multi_exp_depth; }
+};
+
+} // namespace internal
+
+#define LIBFF_TRACE_ADD(a, b)                                                  \
+    const ::libff::internal::trace_point_op_scope<                             \
+        typename std::decay<decltype(a)>::type>                                \
+        libff_trace_scope(::libff::trace_event_add_in, (a), (b))
+#define LIBFF_TRACE_MIXED_ADD(a, b)                                            \
+    const ::libff::internal::trace_point_op_scope<                             \
+        typename std::decay<decltype(a)>::type>                                \
+        libff_trace_scope(::libff::trace_event_mixed_add_in, (a), (b))
+#define LIBFF_TRACE_DBL(a)                                                     \
+    const ::libff::internal::trace_point_op_scope<                             \
+        typename std::decay<decltype(a)>::type>                                \
+        libff_trace_scope(::libff::trace_event_dbl_in, (a))
+#define LIBFF_TRACE_MULTI_EXP(                                                 \
+    GroupT, FieldT, vec_start, vec_end, scalar_start, method, form, chunks)    \
+    const ::libff::internal::trace_multi_exp_scope<GroupT, FieldT>             \
+        libff_trace_scope(                                                     \
+            vec_start, vec_end, scalar_start, method, form, chunks)
+#define LIBFF_TRACE_MULTI_EXP_INNER()                                          \
+    const ::libff::internal::trace_multi_exp_inner_scope                       \
+        libff_trace_inner_scope
+#define LIBFF_TRACE_RESULT(...) libff_trace_scope.output(__VA_ARGS__)
+
+#else // TRACE_OPS
+
+#define LIBFF_TRACE_ADD(a, b) ((void)0)
+#define LIBFF_TRACE_MIXED_ADD(a, b) ((void)0)
+#define LIBFF_TRACE_DBL(a) ((void)0)
+#define LIBFF_TRACE_MULTI_EXP(                                                 \
+    GroupT, FieldT, vec_start, vec_end, scalar_start, method, form, chunks)    \
+    ((void)0)
+#define LIBFF_TRACE_MULTI_EXP_INNER() ((void)0)
+#define LIBFF_TRACE_RESULT(...) (__VA_ARGS__)
+
+#endif // TRACE_OPS
+
+} // namespace libff
+
+#ifdef TRACE_OPS
+#include <libff/common/trace.tcc>
+#endif
+
+#endif // __LIBFF_COMMON_TRACE_HPP__
@@ -0,0 +1,120 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the templated parts of the operation tracing interface.
+
+ See trace.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef __LIBFF_COMMON_TRACE_TCC__
+#define __LIBFF_COMMON_TRACE_TCC__
+
+namespace libff
+{
+
+namespace internal
+{
+
+// trace_point_op_scope
+
+template<typename GroupT>
+trace_point_op_scope<GroupT>::trace_point_op_scope(
+    trace_event_t event_in, const GroupT &a)
+    : _event_out((trace_event_t)(event_in + 1)), _active(enter())
+{
+    if (_active) {
+        trace_write_element(event_in, trace_type<GroupT>::id, a);
+    }
+}
+
+template<typename GroupT>
+trace_point_op_scope<GroupT>::trace_point_op_scope(
+    trace_event_t event_in, const GroupT &a, const GroupT &b)
+    : _event_out((trace_event_t)(event_in + 1)), _active(enter())
+{
+    if (_active) {
+        trace_write_element(event_in, trace_type<GroupT>::id, a);
+        trace_write_element(event_in, trace_type<GroupT>::id, b);
+    }
+}
+
+template<typename GroupT> trace_point_op_scope<GroupT>::~trace_point_op_scope()
+{
+    --trace_point_op_depth;
+}
+
+template<typename GroupT> bool trace_point_op_scope<GroupT>::enter()
+{
+    return (trace_point_op_depth++ == 0) && (trace_multi_exp_depth == 0) &&
+           (trace_active_categories() & trace_category_point_ops);
+}
+
+template<typename GroupT>
+GroupT trace_point_op_scope<GroupT>::output(GroupT result) const
+{
+    if (_active) {
+        trace_write_element(_event_out, trace_type<GroupT>::id, result);
+    }
+    return result;
+}
+
+// trace_multi_exp_scope
+
+template<typename GroupT, typename FieldT>
+template<typename BaseIterator>
+trace_multi_exp_scope<GroupT, FieldT>::trace_multi_exp_scope(
+    BaseIterator vec_start,
+    BaseIterator vec_end,
+    typename std::vector<FieldT>::const_iterator scalar_start,
+    uint32_t method,
+    uint32_t base_form,
+    size_t chunks)
+    : _active(
+          (trace_type<GroupT>::id != trace_type_unknown) &&
+          (trace_multi_exp_depth++ == 0) &&
+          (trace_active_categories() & trace_category_multi_exp))
+{
+    if (!_active) {
+        return;
+    }
+
+    const trace_type_t type = trace_type<GroupT>::id;
+    const size_t num_entries = vec_end - vec_start;
+    const trace_multi_exp_info info{num_entries, method, base_form, chunks};
+    trace_write_element(trace_event_msm_begin, type, info);
+    for (size_t i = 0; i < num_entries; ++i) {
+        trace_write_element(trace_event_msm_base, type, vec_start[i]);
+    }
+    for (size_t i = 0; i < num_entries; ++i) {
+        trace_write_element(trace_event_msm_scalar, type, scalar_start[i]);
+    }
+}
+
+template<typename GroupT, typename FieldT>
+trace_multi_exp_scope<GroupT, FieldT>::~trace_multi_exp_scope()
+{
+    if (trace_type<GroupT>::id != trace_type_unknown) {
+        --trace_multi_exp_depth;
+    }
+}
+
+template<typename GroupT, typename FieldT>
+GroupT trace_multi_exp_scope<GroupT, FieldT>::output(GroupT result) const
+{
+    if (_active) {
+        trace_write_element(
+            trace_event_msm_result, trace_type<GroupT>::id, result);
+    }
+    return result;
+}
+
+} // namespace internal
+
+} // namespace libff
+
+#endif // __LIBFF_COMMON_TRACE_TCC__
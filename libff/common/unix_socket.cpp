@@ -0,0 +1,241 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of Unix domain socket helpers.
+
+ See unix_socket.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <libff/common/unix_socket.hpp>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Not available on all platforms, in which case SIGPIPE must be handled by
+// the application.
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace libff
+{
+
+static std::runtime_error unix_socket_error(const std::string &what)
+{
+    return std::runtime_error(what + ": " + strerror(errno));
+}
+
+static sockaddr_un unix_socket_address(const std::string &path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("socket path too long: " + path);
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+/// Remove the socket at path if it is left over from a process that has
+/// exited, i.e. if it refuses connections. Throws if path exists and is not
+/// such a socket.
+static void unix_socket_remove_stale(
+    const std::string &path, const sockaddr_un &address)
+{
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+        if (errno == ENOENT) {
+            return;
+        }
+        throw unix_socket_error("failed to stat " + path);
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        throw std::runtime_error("not a socket: " + path);
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw unix_socket_error("socket");
+    }
+    const int connected =
+        connect(fd, (const sockaddr *)&address, sizeof(address));
+    const int connect_errno = errno;
+    close(fd);
+    if (connected == 0) {
+        throw std::runtime_error("socket in use: " + path);
+    }
+    if (connect_errno != ECONNREFUSED) {
+        errno = connect_errno;
+        throw unix_socket_error("failed to connect to " + path);
+    }
+
+    unlink(path.c_str());
+}
+
+int unix_socket_listen(const std::string &path)
+{
+    const sockaddr_un address = unix_socket_address(path);
+    unix_socket_remove_stale(path, address);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw unix_socket_error("socket");
+    }
+
+    if (bind(fd, (const sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        throw unix_socket_error("failed to listen on " + path);
+    }
+
+    return fd;
+}
+
+int unix_socket_accept(int listen_fd)
+{
+    for (;;) {
+        const int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd >= 0) {
+            return fd;
+        }
+        if (errno == EINTR || errno == ECONNABORTED) {
+            continue;
+        }
+        if (errno == EINVAL || errno == EBADF) {
+            return -1;
+        }
+        throw unix_socket_error("accept");
+    }
+}
+
+int unix_socket_connect(const std::string &path)
+{
+    const sockaddr_un address = unix_socket_address(path);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw unix_socket_error("socket");
+    }
+
+    if (connect(fd, (const sockaddr *)&address, sizeof(address)) != 0) {
+        close(fd);
+        throw unix_socket_error("failed to connect to " + path);
+    }
+
+    return fd;
+}
+
+void unix_socket_write(int fd, const void *data, size_t size)
+{
+    const char *ptr = (const char *)data;
+    while (size > 0) {
+        const ssize_t written = send(fd, ptr, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw unix_socket_error("send");
+        }
+        ptr += written;
+        size -= written;
+    }
+}
+
+bool unix_socket_read(int fd, void *data, size_t size)
+{
+    char *ptr = (char *)data;
+    const size_t total = size;
+    while (size > 0) {
+        const ssize_t num_read = recv(fd, ptr, size, 0);
+        if (num_read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                throw std::runtime_error("recv: timed out");
+            }
+            throw unix_socket_error("recv");
+        }
+        if (num_read == 0) {
+            if (size == total) {
+                return false;
+            }
+            throw std::runtime_error("connection closed mid-message");
+        }
+        ptr += num_read;
+        size -= num_read;
+    }
+
+    return true;
+}
+
+void unix_socket_set_receive_timeout(int fd, size_t timeout_ms)
+{
+    timeval timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) !=
+        0) {
+        throw unix_socket_error("setsockopt");
+    }
+}
+
+void unix_socket_shutdown(int fd) { shutdown(fd, SHUT_RDWR); }
+
+void unix_socket_close(int fd) { close(fd); }
+
+void unix_socket_remove(const std::string &path) { unlink(path.c_str()); }
+
+unix_socket_streambuf::unix_socket_streambuf(
+    int fd, size_t read_limit, size_t buffer_size)
+    : _fd(fd)
+    , _read_remaining(read_limit)
+    , _buffer(std::max<size_t>(1, buffer_size))
+{
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+}
+
+unix_socket_streambuf::int_type unix_socket_streambuf::underflow()
+{
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    const size_t size = std::min(_read_remaining, _buffer.size());
+    if (size == 0 || !unix_socket_read(_fd, _buffer.data(), size)) {
+        return traits_type::eof();
+    }
+    _read_remaining -= size;
+    setg(_buffer.data(), _buffer.data(), _buffer.data() + size);
+    return traits_type::to_int_type(*gptr());
+}
+
+unix_socket_streambuf::int_type unix_socket_streambuf::overflow(int_type c)
+{
+    sync();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int unix_socket_streambuf::sync()
+{
+    unix_socket_write(_fd, pbase(), pptr() - pbase());
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    return 0;
+}
+
+} // namespace libff
@@ -0,0 +1,87 @@
+/** @file
+ *****************************************************************************
+
+ Minimal helpers for Unix domain stream sockets, used by local services such
+ as the multi-exponentiation server. All functions throw std::runtime_error
+ on failure.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef __LIBFF_COMMON_UNIX_SOCKET_HPP__
+#define __LIBFF_COMMON_UNIX_SOCKET_HPP__
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace libff
+{
+
+/// Create a socket bound to path and listening for connections. An existing
+/// socket at path is replaced only if it is stale (i.e. it refuses
+/// connections). Throws if path is any other file, or a live socket.
+int unix_socket_listen(const std::string &path);
+
+/// Accept a connection on a listening socket. Returns -1 if the listening
+/// socket has been shut down (see unix_socket_shutdown).
+int unix_socket_accept(int listen_fd);
+
+/// Connect to the socket at path.
+int unix_socket_connect(const std::string &path);
+
+/// Write exactly size bytes.
+void unix_socket_write(int fd, const void *data, size_t size);
+
+/// Read exactly size bytes. Returns false if the peer closed the connection
+/// before any data was read, and throws if it closed part-way, or if no data
+/// arrived within the receive timeout (see unix_socket_set_receive_timeout).
+bool unix_socket_read(int fd, void *data, size_t size);
+
+/// Make reads on fd fail if no data arrives for timeout_ms milliseconds (0
+/// for no timeout).
+void unix_socket_set_receive_timeout(int fd, size_t timeout_ms);
+
+/// Shut down both directions of a socket, waking any thread blocked on it.
+void unix_socket_shutdown(int fd);
+
+void unix_socket_close(int fd);
+
+/// Remove the socket file created by unix_socket_listen.
+void unix_socket_remove(const std::string &path);
+
+/// Stream buffer over a connected socket, so that data written with the
+/// stream-based serialization functions is sent (or received) in chunks of
+/// buffer_size bytes, without holding the whole message in memory. An
+/// instance is used either for writing or for reading. Written data is sent
+/// when the buffer is full or the stream is flushed. At most read_limit
+/// bytes are received, so that reading never consumes data beyond the
+/// message. Socket errors are reported through the stream state (and
+/// rethrown if badbit is set in the stream's exceptions()).
+class unix_socket_streambuf : public std::streambuf
+{
+public:
+    static const size_t default_buffer_size = 1 << 16;
+
+    explicit unix_socket_streambuf(
+        int fd,
+        size_t read_limit = 0,
+        size_t buffer_size = default_buffer_size);
+
+protected:
+    virtual int_type underflow();
+    virtual int_type overflow(int_type c);
+    virtual int sync();
+
+    const int _fd;
+    size_t _read_remaining;
+    std::vector<char> _buffer;
+};
+
+} // namespace libff
+
+#endif // __LIBFF_COMMON_UNIX_SOCKET_HPP__